@@ -90,6 +90,12 @@ import_array();
 // IN int32 no 2
 %apply (int* IN_ARRAY1, long DIM1) {(int *swig_np_int_in_v2,
                                      long n_swig_np_int_in_v2)};
+// IN int32 no 3
+%apply (int* IN_ARRAY1, long DIM1) {(int *swig_np_int_in_v3,
+                                     long n_swig_np_int_in_v3)};
+// IN int32 no 4
+%apply (int* IN_ARRAY1, long DIM1) {(int *swig_np_int_in_v4,
+                                     long n_swig_np_int_in_v4)};
 // IN float32 no 1
 %apply (float* IN_ARRAY1, long DIM1) {(float *swig_np_flt_in_v1,
                                        long n_swig_np_flt_in_v1)};
@@ -120,6 +126,14 @@ import_array();
 %apply (double* IN_ARRAY1, long DIM1) {(double *swig_np_dbl_in_v6,
                                         long n_swig_np_dbl_in_v6)};
 
+// IN float64 / double no 7
+%apply (double* IN_ARRAY1, long DIM1) {(double *swig_np_dbl_in_v7,
+                                        long n_swig_np_dbl_in_v7)};
+
+// IN float64 / double no 8
+%apply (double* IN_ARRAY1, long DIM1) {(double *swig_np_dbl_in_v8,
+                                        long n_swig_np_dbl_in_v8)};
+
 // ==INPLACE_FLAT=======================================================================
 
 // INPLACE_FLAT BOOL no 1
@@ -159,6 +173,10 @@ import_array();
 %apply (double* INPLACE_ARRAY_FLAT, long DIM_FLAT) {(double *swig_np_dbl_inplaceflat_v3,
                                                     long n_swig_np_dbl_inplaceflat_v3)};
 
+// INPLACE_FLAT DOUBLE no 4
+%apply (double* INPLACE_ARRAY_FLAT, long DIM_FLAT) {(double *swig_np_dbl_inplaceflat_v4,
+                                                    long n_swig_np_dbl_inplaceflat_v4)};
+
 // ==INPLACE 1D=========================================================================
 
 // INPLACE int no 1
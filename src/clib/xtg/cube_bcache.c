@@ -0,0 +1,713 @@
+/*
+ ***************************************************************************************
+ *
+ * NAME:
+ *    cube_bcache.c (file name)
+ *    cube_bcache_open_segy
+ *    cube_bcache_open_xtgbrick
+ *    cube_bcache_close
+ *    cube_bcache_stats
+ *    cube_bcache_deadtraces
+ *    cube_bcache_read
+ *    cube_bcache_value
+ *    cube_bcache_trace
+ *
+ * DESCRIPTION:
+ *    Brick cache for windowed (out-of-core) cubes, i.e. cubes where the values are
+ *    kept in file and only the parts in use are held in memory.
+ *
+ *    The cube (ncol, nrow, nlay) is divided in bricks of (bcol, brow, blay)
+ *    samples. A brick is read from file the first time one of its values is
+ *    requested, and kept in a cache with a fixed memory budget. When the budget
+ *    is used, the least recently used brick is evicted (LRU).
+ *
+ *    A cache is referred to by an integer handle (bcache), where a negative
+ *    handle means "no cache", i.e. an ordinary cube held in memory. Routines that
+ *    sample cube values (surf_slice_cube*, cube_get_randomline,
+ *    surf_cube_attr_intv, cube_value_xyz_*) take a bcache argument, and get
+ *    values through the CUBE_VALUE macro (libxtg_.h), which calls
+ *    cube_bcache_value for windowed cubes. Routines that read many values along
+ *    a column (surf_cube_attr_intv) copy a trace with cube_bcache_trace instead.
+ *
+ *    cube_bcache_open_segy:
+ *    Open a brick cache on a post-stack SEGY file with fixed trace length. The
+ *    file trace number per cube column (C order) is given, where negative means
+ *    a missing trace (values are zero), cf. cube_import_segy_traces.
+ *
+ *    cube_bcache_open_xtgbrick:
+ *    Open a brick cache on a bricked xtgeo cube file (cube_xtgbrick.c), where the
+ *    cache bricks are the bricks in file, so each miss is one read of one
+ *    (compressed) brick. Cube and brick dimensions are read from file.
+ *
+ *    cube_bcache_close:
+ *    Close the file and free all memory of the cache.
+ *
+ *    cube_bcache_stats:
+ *    Return number of cache hits, misses (bricks read from file) and the memory
+ *    in use (bytes).
+ *
+ *    cube_bcache_deadtraces:
+ *    Set (option 1) or clear (option 0) a value for dead traces, i.e. columns
+ *    with trace identification code 2. This is the windowed equivalent of
+ *    setting values for dead traces in the cube array.
+ *
+ *    cube_bcache_read:
+ *    Read a sub cube (inclusive, 1 based index ranges) as a C order array.
+ *
+ *    cube_bcache_value:
+ *    Return the value at a C order index. This is a private function.
+ *
+ *    cube_bcache_trace:
+ *    Copy a range of layers in one column to an array, with one cache lookup per
+ *    brick. This is a private function.
+ *
+ *    The cache is thread safe, in the sense that lookups are done in an OpenMP
+ *    critical section, but bricks are read serially. Hence, threaded callers
+ *    should copy traces with cube_bcache_trace and work on the copies, rather
+ *    than look up single values.
+ *
+ * ARGUMENTS:
+ *    file           i     SEGY or xtgbrickcube file name
+ *    offset         i     Byte offset of first trace header (3600 + extended headers)
+ *    tracebytes     i     Number of bytes per trace, including trace header
+ *    formatcode     i     Sample format code
+ *    ncol..nlay     i     Cube dimensions
+ *    traceno        i     File trace number per cube column, C order (with length)
+ *    bcol..blay     i     Brick dimensions
+ *    maxbytes       i     Memory budget for the cache (bytes), at least one brick
+ *                         will be kept
+ *    bcache         i     Cache handle
+ *    nhits..nbytes  o     Cache statistics
+ *    traceidcodes   i     Trace identification codes per column (with length)
+ *    deadvalue      i     Value to use for dead traces
+ *    option         i     1 for set, 0 for clear the dead trace value
+ *    i1..k2         i     Sub cube range, 1 based and inclusive
+ *    values         o     Sub cube values (with length)
+ *    ic             i     C order index in cube
+ *    icol           i     C order column index in cube, i.e. i * nrow + j
+ *    klo, khi       i     Layer range in trace, 0 based and inclusive
+ *    trace          o     Trace values for klo..khi
+ *
+ * RETURNS:
+ *    cube_bcache_open_segy and cube_bcache_open_xtgbrick: Handle (>= 0), or:
+ *    -1: cannot open file
+ *    -2: file is too short for the given traces, or corrupt
+ *    -3: unsupported sample format, or not a xtgbrickcube file
+ *    -4: inconsistent array lengths or dimensions
+ *    -5: too many open caches
+ *    -6: cannot allocate memory
+ *    Other functions: EXIT_SUCCESS or -1 if invalid handle, -4 for wrong
+ *    lengths. cube_bcache_read: -2 if bricks cannot be read from file, where the
+ *    values of those bricks are UNDEF. cube_bcache_value: The value, or UNDEF if
+ *    the brick cannot be read. cube_bcache_trace: EXIT_SUCCESS, or EXIT_FAILURE if
+ *    a brick cannot be read, where the values of that brick are UNDEF. The two
+ *    latter do not log, as they are called inside OpenMP parallel regions.
+ *
+ * TODO/ISSUES/BUGS:
+ *
+ * LICENCE:
+ *    cf. XTGeo LICENSE
+ ***************************************************************************************
+ */
+
+#include "libxtg.h"
+#include "libxtg_.h"
+#include "logger.h"
+#include <stdint.h>
+#include <string.h>
+
+#define BCACHE_MAX 64
+
+#define BC_MIN(a, b) ((a) < (b) ? (a) : (b))
+#define BC_MAX(a, b) ((a) > (b) ? (a) : (b))
+
+#ifdef _WIN32
+#define _fseek64 _fseeki64
+#define _ftell64 _ftelli64
+#else
+#define _fseek64 fseeko
+#define _ftell64 ftello
+#endif
+
+struct _bcache
+{
+    FILE *fc;
+    int64_t offset;
+    int64_t tracebytes;
+    int formatcode;
+    int nbytes;
+
+    int ncol, nrow, nlay;
+    int bcol, brow, blay;
+    int nbcol, nbrow, nblay;
+    long bsize; /* number of values in a brick */
+
+    int *traceno; /* file trace number per column, C order */
+    char *dead;   /* dead trace flag per column if a dead value is set, else NULL */
+    float deadvalue;
+
+    /* the cache: nslots bricks, and the LRU list as double linked list of slots */
+    int nslots;
+    float *data;
+    long *slotbrick; /* brick in slot, -1 if free */
+    int *brickslot;  /* slot for brick, -1 if not in cache */
+    int *prev;
+    int *next;
+    int head;
+    int tail;
+    int nused; /* number of slots holding a brick */
+
+    long lastbrick;
+    int lastslot;
+
+    unsigned char *rawbuf;
+
+    /* xtgbrickcube files: brick offsets in file, and decoding buffers */
+    int64_t *boffsets;
+    float *bvalues;
+    unsigned char *work;
+
+    long nhits;
+    long nmisses;
+};
+
+static struct _bcache *_caches[BCACHE_MAX];
+
+static struct _bcache *
+_get_cache(int bcache)
+{
+    if (bcache < 0 || bcache >= BCACHE_MAX)
+        return NULL;
+    return _caches[bcache];
+}
+
+static void
+_free_cache(struct _bcache *bc)
+{
+    if (bc->fc)
+        fclose(bc->fc);
+    free(bc->traceno);
+    free(bc->dead);
+    free(bc->data);
+    free(bc->slotbrick);
+    free(bc->brickslot);
+    free(bc->prev);
+    free(bc->next);
+    free(bc->rawbuf);
+    free(bc->boffsets);
+    free(bc->bvalues);
+    free(bc->work);
+    free(bc);
+}
+
+/* read brick from SEGY file into buffer; missing traces become zero */
+static int
+_read_brick_segy(struct _bcache *bc, long brick, float *buffer)
+{
+    int bk = brick % bc->nblay;
+    int bj = (brick / bc->nblay) % bc->nbrow;
+    int bi = brick / ((long)bc->nblay * bc->nbrow);
+
+    int i0 = bi * bc->bcol, j0 = bj * bc->brow, k0 = bk * bc->blay;
+    int ni = BC_MIN(bc->bcol, bc->ncol - i0);
+    int nj = BC_MIN(bc->brow, bc->nrow - j0);
+    int nk = BC_MIN(bc->blay, bc->nlay - k0);
+
+    memset(buffer, 0, bc->bsize * sizeof(float));
+
+    int i, j;
+    for (i = 0; i < ni; i++) {
+        for (j = 0; j < nj; j++) {
+            int trace = bc->traceno[(long)(i0 + i) * bc->nrow + j0 + j];
+            if (trace < 0)
+                continue;
+
+            int64_t pos = bc->offset + trace * bc->tracebytes + 240 +
+                          (int64_t)k0 * bc->nbytes;
+            if (_fseek64(bc->fc, pos, SEEK_SET) != 0 ||
+                fread(bc->rawbuf, bc->nbytes, nk, bc->fc) != (size_t)nk)
+                return EXIT_FAILURE;
+
+            float *trc = buffer + ((long)i * bc->brow + j) * bc->blay;
+            x_segy_decode_samples(bc->rawbuf, bc->formatcode, nk, trc);
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+/* read brick from xtgbrickcube file into buffer, where file bricks may be smaller
+   at the cube edges */
+static int
+_read_brick_xtgbrick(struct _bcache *bc, long brick, float *buffer)
+{
+    int bk = brick % bc->nblay;
+    int bj = (brick / bc->nblay) % bc->nbrow;
+    int bi = brick / ((long)bc->nblay * bc->nbrow);
+
+    int ni = BC_MIN(bc->bcol, bc->ncol - bi * bc->bcol);
+    int nj = BC_MIN(bc->brow, bc->nrow - bj * bc->brow);
+    int nk = BC_MIN(bc->blay, bc->nlay - bk * bc->blay);
+
+    long nblob = (long)(bc->boffsets[brick + 1] - bc->boffsets[brick]);
+    if (_fseek64(bc->fc, bc->boffsets[brick], SEEK_SET) != 0 ||
+        fread(bc->rawbuf, 1, nblob, bc->fc) != (size_t)nblob ||
+        x_xtgbrick_decode(bc->rawbuf, nblob, (long)ni * nj, nk, bc->bvalues,
+                          bc->work) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
+    if (ni * nj * nk == bc->bsize) {
+        memcpy(buffer, bc->bvalues, bc->bsize * sizeof(float));
+        return EXIT_SUCCESS;
+    }
+
+    memset(buffer, 0, bc->bsize * sizeof(float));
+    int i, j;
+    for (i = 0; i < ni; i++) {
+        for (j = 0; j < nj; j++) {
+            memcpy(buffer + ((long)i * bc->brow + j) * bc->blay,
+                   bc->bvalues + ((long)i * nj + j) * nk, nk * sizeof(float));
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+/* move slot to head of LRU list (most recently used) */
+static void
+_touch(struct _bcache *bc, int slot)
+{
+    if (bc->head == slot)
+        return;
+
+    /* unlink */
+    if (bc->prev[slot] >= 0)
+        bc->next[bc->prev[slot]] = bc->next[slot];
+    if (bc->next[slot] >= 0)
+        bc->prev[bc->next[slot]] = bc->prev[slot];
+    if (bc->tail == slot)
+        bc->tail = bc->prev[slot];
+
+    /* insert at head */
+    bc->prev[slot] = -1;
+    bc->next[slot] = bc->head;
+    if (bc->head >= 0)
+        bc->prev[bc->head] = slot;
+    bc->head = slot;
+    if (bc->tail < 0)
+        bc->tail = slot;
+}
+
+/* return cache slot holding the brick, read it from file if needed; -1 if failure.
+   Free slots are kept at the tail of the LRU list, so the tail is always the slot
+   to (re)use */
+static int
+_get_brick(struct _bcache *bc, long brick)
+{
+    if (brick == bc->lastbrick) {
+        bc->nhits++;
+        return bc->lastslot;
+    }
+
+    int slot = bc->brickslot[brick];
+    if (slot >= 0) {
+        bc->nhits++;
+        _touch(bc, slot);
+    } else {
+        bc->nmisses++;
+        slot = bc->tail;
+        if (bc->slotbrick[slot] >= 0) {
+            /* evict least recently used */
+            bc->brickslot[bc->slotbrick[slot]] = -1;
+            bc->slotbrick[slot] = -1;
+            bc->nused--;
+        }
+
+        float *buffer = bc->data + slot * bc->bsize;
+        int ier = bc->boffsets ? _read_brick_xtgbrick(bc, brick, buffer)
+                               : _read_brick_segy(bc, brick, buffer);
+        if (ier != EXIT_SUCCESS) {
+            /* the slot is left free at the tail; no logging here, as this may run
+               inside an OpenMP parallel region; the callers report failures */
+            bc->lastbrick = -1;
+            return -1;
+        }
+        _touch(bc, slot);
+        bc->slotbrick[slot] = brick;
+        bc->brickslot[brick] = slot;
+        bc->nused++;
+    }
+
+    bc->lastbrick = brick;
+    bc->lastslot = slot;
+    return slot;
+}
+
+/* first free handle, or -5 if none */
+static int
+_new_handle(void)
+{
+    int bcache;
+    for (bcache = 0; bcache < BCACHE_MAX; bcache++) {
+        if (_caches[bcache] == NULL)
+            return bcache;
+    }
+    logger_error(LI, FI, FU, "Too many open brick caches (max %d)", BCACHE_MAX);
+    return -5;
+}
+
+/* set brick geometry and allocate the cache slots and the LRU list */
+static int
+_setup_cache(struct _bcache *bc,
+             int ncol,
+             int nrow,
+             int nlay,
+             int bcol,
+             int brow,
+             int blay,
+             long maxbytes)
+{
+    bc->ncol = ncol;
+    bc->nrow = nrow;
+    bc->nlay = nlay;
+    bc->bcol = BC_MIN(bcol, ncol);
+    bc->brow = BC_MIN(brow, nrow);
+    bc->blay = BC_MIN(blay, nlay);
+    bc->nbcol = (ncol + bc->bcol - 1) / bc->bcol;
+    bc->nbrow = (nrow + bc->brow - 1) / bc->brow;
+    bc->nblay = (nlay + bc->blay - 1) / bc->blay;
+    bc->bsize = (long)bc->bcol * bc->brow * bc->blay;
+
+    long nbricks = (long)bc->nbcol * bc->nbrow * bc->nblay;
+    long nslots = maxbytes / (bc->bsize * (long)sizeof(float));
+    bc->nslots = (int)BC_MAX(1, BC_MIN(nslots, nbricks));
+
+    bc->data = malloc((size_t)bc->nslots * bc->bsize * sizeof(float));
+    bc->slotbrick = malloc(bc->nslots * sizeof(long));
+    bc->brickslot = malloc(nbricks * sizeof(int));
+    bc->prev = malloc(bc->nslots * sizeof(int));
+    bc->next = malloc(bc->nslots * sizeof(int));
+
+    if (!bc->data || !bc->slotbrick || !bc->brickslot || !bc->prev || !bc->next) {
+        logger_error(LI, FI, FU, "Cannot allocate memory for brick cache");
+        return -6;
+    }
+
+    long it;
+    for (it = 0; it < nbricks; it++)
+        bc->brickslot[it] = -1;
+    /* all slots are free, and linked in slot order */
+    for (it = 0; it < bc->nslots; it++) {
+        bc->slotbrick[it] = -1;
+        bc->prev[it] = (int)it - 1;
+        bc->next[it] = it < bc->nslots - 1 ? (int)it + 1 : -1;
+    }
+    bc->head = 0;
+    bc->tail = bc->nslots - 1;
+    bc->lastbrick = -1;
+    return EXIT_SUCCESS;
+}
+
+int
+cube_bcache_open_segy(char *file,
+                      long offset,
+                      long tracebytes,
+                      int formatcode,
+                      int ncol,
+                      int nrow,
+                      int nlay,
+                      int *traceno,
+                      long ntraceno,
+                      int bcol,
+                      int brow,
+                      int blay,
+                      long maxbytes)
+{
+    int nbytes = x_segy_sample_bytes(formatcode);
+    if (nbytes == 0) {
+        logger_error(LI, FI, FU, "Unsupported SEGY sample format code %d", formatcode);
+        return -3;
+    }
+
+    if (ncol < 1 || nrow < 1 || nlay < 1 || bcol < 1 || brow < 1 || blay < 1 ||
+        ntraceno != (long)ncol * nrow || tracebytes != 240 + (long)nlay * nbytes) {
+        logger_error(LI, FI, FU, "Inconsistent dimensions or lengths in %s", FU);
+        return -4;
+    }
+
+    int bcache = _new_handle();
+    if (bcache < 0)
+        return bcache;
+
+    struct _bcache *bc = calloc(1, sizeof(struct _bcache));
+    if (bc == NULL)
+        return -6;
+
+    bc->fc = fopen(file, "rb");
+    if (bc->fc == NULL) {
+        logger_error(LI, FI, FU, "Cannot open file %s", file);
+        free(bc);
+        return -1;
+    }
+    /* reads are trace segments at random positions; avoid stdio read ahead */
+    setvbuf(bc->fc, NULL, _IONBF, 0);
+
+    long it, nmax = -1;
+    for (it = 0; it < ntraceno; it++) {
+        if (traceno[it] > nmax)
+            nmax = traceno[it];
+    }
+    if (_fseek64(bc->fc, 0, SEEK_END) != 0 ||
+        offset + (nmax + 1) * (int64_t)tracebytes > (int64_t)_ftell64(bc->fc)) {
+        logger_error(LI, FI, FU, "File %s is too short for trace %ld", file, nmax);
+        _free_cache(bc);
+        return -2;
+    }
+
+    bc->offset = offset;
+    bc->tracebytes = tracebytes;
+    bc->formatcode = formatcode;
+    bc->nbytes = nbytes;
+
+    bc->traceno = malloc(ntraceno * sizeof(int));
+    bc->rawbuf = malloc((size_t)BC_MIN(blay, nlay) * nbytes);
+
+    if (_setup_cache(bc, ncol, nrow, nlay, bcol, brow, blay, maxbytes) !=
+          EXIT_SUCCESS ||
+        !bc->traceno || !bc->rawbuf) {
+        _free_cache(bc);
+        return -6;
+    }
+
+    memcpy(bc->traceno, traceno, ntraceno * sizeof(int));
+
+    logger_info(LI, FI, FU, "Brick cache %d on %s: %d x %d x %d bricks, %d slots",
+                bcache, file, bc->bcol, bc->brow, bc->blay, bc->nslots);
+
+    _caches[bcache] = bc;
+    return bcache;
+}
+
+int
+cube_bcache_open_xtgbrick(char *file, long maxbytes)
+{
+    int bcache = _new_handle();
+    if (bcache < 0)
+        return bcache;
+
+    struct _bcache *bc = calloc(1, sizeof(struct _bcache));
+    if (bc == NULL)
+        return -6;
+
+    bc->fc = fopen(file, "rb");
+    if (bc->fc == NULL) {
+        logger_error(LI, FI, FU, "Cannot open file %s", file);
+        free(bc);
+        return -1;
+    }
+    setvbuf(bc->fc, NULL, _IONBF, 0);
+
+    int dims[6];
+    long nbricks, ib, maxblob = 0;
+    int ier = x_xtgbrick_header(bc->fc, dims, &bc->boffsets, &nbricks);
+    if (ier != EXIT_SUCCESS) {
+        logger_error(LI, FI, FU, "Invalid xtgbrickcube file %s (code %d)", file, ier);
+        _free_cache(bc);
+        return ier;
+    }
+
+    for (ib = 0; ib < nbricks; ib++) {
+        if (bc->boffsets[ib + 1] - bc->boffsets[ib] > maxblob)
+            maxblob = (long)(bc->boffsets[ib + 1] - bc->boffsets[ib]);
+    }
+
+    if (_setup_cache(bc, dims[0], dims[1], dims[2], dims[3], dims[4], dims[5],
+                     maxbytes) != EXIT_SUCCESS) {
+        _free_cache(bc);
+        return -6;
+    }
+
+    bc->rawbuf = malloc(maxblob);
+    bc->bvalues = malloc(bc->bsize * sizeof(float));
+    bc->work = malloc(4 * bc->bsize);
+    if (!bc->rawbuf || !bc->bvalues || !bc->work) {
+        logger_error(LI, FI, FU, "Cannot allocate memory for brick cache");
+        _free_cache(bc);
+        return -6;
+    }
+
+    logger_info(LI, FI, FU, "Brick cache %d on %s: %d x %d x %d bricks, %d slots",
+                bcache, file, bc->bcol, bc->brow, bc->blay, bc->nslots);
+
+    _caches[bcache] = bc;
+    return bcache;
+}
+
+int
+cube_bcache_close(int bcache)
+{
+    struct _bcache *bc = _get_cache(bcache);
+    if (bc == NULL)
+        return -1;
+
+    _free_cache(bc);
+    _caches[bcache] = NULL;
+    return EXIT_SUCCESS;
+}
+
+int
+cube_bcache_stats(int bcache, long *nhits, long *nmisses, long *nbytes)
+{
+    struct _bcache *bc = _get_cache(bcache);
+    if (bc == NULL)
+        return -1;
+
+    *nhits = bc->nhits;
+    *nmisses = bc->nmisses;
+    *nbytes = (long)bc->nused * bc->bsize * (long)sizeof(float);
+    return EXIT_SUCCESS;
+}
+
+int
+cube_bcache_deadtraces(int bcache,
+                       int *traceidcodes,
+                       long ntraceidcodes,
+                       float deadvalue,
+                       int option)
+{
+    struct _bcache *bc = _get_cache(bcache);
+    if (bc == NULL)
+        return -1;
+
+    free(bc->dead);
+    bc->dead = NULL;
+    if (option == 0)
+        return EXIT_SUCCESS;
+
+    if (ntraceidcodes != (long)bc->ncol * bc->nrow)
+        return -4;
+
+    bc->dead = malloc(ntraceidcodes);
+    if (bc->dead == NULL)
+        return -6;
+
+    long ic;
+    for (ic = 0; ic < ntraceidcodes; ic++)
+        bc->dead[ic] = traceidcodes[ic] == 2;
+    bc->deadvalue = deadvalue;
+    return EXIT_SUCCESS;
+}
+
+float
+cube_bcache_value(int bcache, long ic)
+{
+    struct _bcache *bc = _caches[bcache];
+
+    long icol = ic / bc->nlay; /* column index, C order */
+    if (bc->dead && bc->dead[icol])
+        return bc->deadvalue;
+
+    int k = ic % bc->nlay;
+    int j = icol % bc->nrow;
+    int i = icol / bc->nrow;
+
+    long brick = ((long)(i / bc->bcol) * bc->nbrow + j / bc->brow) * bc->nblay +
+                 k / bc->blay;
+    long pos =
+      ((long)(i % bc->bcol) * bc->brow + j % bc->brow) * bc->blay + k % bc->blay;
+
+    float value = UNDEF;
+#pragma omp critical(cube_bcache)
+    {
+        int slot = _get_brick(bc, brick);
+        if (slot >= 0)
+            value = bc->data[slot * bc->bsize + pos];
+    }
+    return value;
+}
+
+int
+cube_bcache_trace(int bcache, long icol, int klo, int khi, float *trace)
+{
+    struct _bcache *bc = _caches[bcache];
+    int k;
+
+    if (bc->dead && bc->dead[icol]) {
+        for (k = klo; k <= khi; k++)
+            trace[k - klo] = bc->deadvalue;
+        return EXIT_SUCCESS;
+    }
+
+    int j = icol % bc->nrow;
+    int i = icol / bc->nrow;
+
+    long brick0 = ((long)(i / bc->bcol) * bc->nbrow + j / bc->brow) * bc->nblay;
+    long pos0 = ((long)(i % bc->bcol) * bc->brow + j % bc->brow) * bc->blay;
+
+    int ier = EXIT_SUCCESS;
+    for (k = klo; k <= khi;) {
+        int kb = k / bc->blay;
+        int nk = BC_MIN(khi, (kb + 1) * bc->blay - 1) - k + 1;
+        int slot;
+
+#pragma omp critical(cube_bcache)
+        {
+            slot = _get_brick(bc, brick0 + kb);
+            if (slot >= 0)
+                memcpy(trace + k - klo,
+                       bc->data + slot * bc->bsize + pos0 + k % bc->blay,
+                       nk * sizeof(float));
+        }
+
+        if (slot < 0) {
+            int kk;
+            for (kk = k; kk < k + nk; kk++)
+                trace[kk - klo] = UNDEF;
+            ier = EXIT_FAILURE;
+        }
+        k += nk;
+    }
+    return ier;
+}
+
+int
+cube_bcache_read(int bcache,
+                 int i1,
+                 int i2,
+                 int j1,
+                 int j2,
+                 int k1,
+                 int k2,
+                 float *values,
+                 long nvalues)
+{
+    double xprof_t0 = x_prof_tic();
+
+    struct _bcache *bc = _get_cache(bcache);
+    if (bc == NULL)
+        return -1;
+
+    if (i1 < 1 || i2 > bc->ncol || i1 > i2 || j1 < 1 || j2 > bc->nrow || j1 > j2 ||
+        k1 < 1 || k2 > bc->nlay || k1 > k2 ||
+        nvalues != (long)(i2 - i1 + 1) * (j2 - j1 + 1) * (k2 - k1 + 1)) {
+        logger_error(LI, FI, FU, "Invalid sub cube range or length in %s", FU);
+        return -4;
+    }
+
+    /* k is fastest, hence a brick is visited once per column it covers */
+    long ib = 0;
+    int i, j, ier = EXIT_SUCCESS;
+    for (i = i1; i <= i2; i++) {
+        for (j = j1; j <= j2; j++) {
+            long icol = (long)(i - 1) * bc->nrow + j - 1;
+            if (cube_bcache_trace(bcache, icol, k1 - 1, k2 - 1, values + ib) !=
+                EXIT_SUCCESS)
+                ier = -2;
+            ib += k2 - k1 + 1;
+        }
+    }
+
+    if (ier != EXIT_SUCCESS)
+        logger_error(LI, FI, FU, "Cannot read all bricks from file in %s", FU);
+
+    x_prof_toc(FU, xprof_t0, nvalues);
+    return ier;
+}
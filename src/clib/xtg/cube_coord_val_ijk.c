@@ -15,6 +15,7 @@
  *    rot_deg        i     Cube rotation
  *    yflip          i     yflip flag
  *    p_val_v        i     value array
+ *    bcache         i     Brick cache handle for windowed cube, or -1
  *    xcor .. zcor   o     Cube coordinates in cell IJK
  *    value          o     Cube value in IJK
  *    option         i     If option >= 10, then x y calc is skipped
@@ -51,6 +52,7 @@ cube_coord_val_ijk(int i,
                    double rot_deg,
                    int yflip,
                    float *p_val_v,
+                   int bcache,
                    double *xcor,
                    double *ycor,
                    double *zcor,
@@ -78,7 +80,7 @@ cube_coord_val_ijk(int i,
     *zcor = zori + (k - 1) * zinc;
 
     /* and now update the value: */
-    ier2 = cube_value_ijk(i, j, k, nx, ny, nz, p_val_v, value);
+    ier2 = cube_value_ijk(i, j, k, nx, ny, nz, p_val_v, bcache, value);
 
     if (ier2 == -1 && ier1 == 0) {
         return ier2;
@@ -107,21 +107,21 @@ cube_export_segy(char *sfile,
                  int option)
 {
 
-    int ic, i, j, k, nc, nn, ier, swap;
+    int ic, i, j, nc, nn, ier;
     int ixv, iyv;
     long nxy = 0;
     long ilc;
     unsigned char ubyte;
-    float aval;
 
     double *xv, *yv;
 
     xv = calloc(nx * ny, sizeof(double));
     yv = calloc(nx * ny, sizeof(double));
 
-    FILE *fc = fopen(sfile, "wb");
+    /* one trace of big endian samples, written in one chunk */
+    float *tracebuffer = calloc(nz, sizeof(float));
 
-    swap = x_swap_check();
+    FILE *fc = fopen(sfile, "wb");
 
     /*
      * ========================================================================
@@ -278,22 +278,21 @@ cube_export_segy(char *sfile,
              * ----------------------------------------------------------------
              */
 
-            for (k = 1; k <= nz; k++) {
-                ilc = x_ijk2ic(i, j, k, nx, ny, nz, 0);
-                aval = p_cube_v[ilc];
-
-                if (swap == 1)
-                    SWAP_FLOAT(aval);
-                if (fwrite(&aval, 4, 1, fc) != 1) {
-                    fclose(fc);
-                    return -9;
-                }
+            ilc = x_ijk2ic(i, j, 1, nx, ny, nz, 0);
+            x_float_to_ieee_be(p_cube_v + ilc, tracebuffer, nz);
+            if (fwrite(tracebuffer, 4, nz, fc) != (size_t)nz) {
+                fclose(fc);
+                free(tracebuffer);
+                free(xv);
+                free(yv);
+                return -9;
             }
         }
     }
 
     fclose(fc);
 
+    free(tracebuffer);
     free(xv);
     free(yv);
 
@@ -15,6 +15,7 @@
 *    yflip          i     If the cube is flipped in Y (1 or -1)
 *    nx ny nz       i     Cube dimensions
 *    p_val_v        i     3D cube values
+*    bcache         i     Brick cache handle for windowed cube, or -1
 *    value          o     Randomline array
 *    option         i     0: nearest value, 1: interpolate tri
 *
@@ -52,6 +53,7 @@ cube_get_randomline(double *xvec,
                     int nz,
                     float *p_val_v,
                     long ncube,
+                    int bcache,
                     double *values,
                     long nvalues,
                     int option)
@@ -59,6 +61,9 @@ cube_get_randomline(double *xvec,
     /* locals */
     int ib, ic, izc, ier;
     float val, zsam;
+    struct xtg_lattice lat;
+
+    x_lattice_init(&lat, xori, xinc, yori, yinc, nx, ny, yflip, rot_deg);
 
     zsam = (zmax - zmin) / (nzsam - 1);
 
@@ -72,13 +77,11 @@ cube_get_randomline(double *xvec,
             float zc = zmin + izc * zsam;
 
             if (option == 0) {
-                ier =
-                  cube_value_xyz_cell(xc, yc, zc, xori, xinc, yori, yinc, zori, zinc,
-                                      rot_deg, yflip, nx, ny, nz, p_val_v, &val, 0);
+                ier = cube_value_xyz_cell_lattice(&lat, xc, yc, zc, zori, zinc, nz,
+                                                  p_val_v, bcache, &val);
             } else {
-                ier =
-                  cube_value_xyz_interp(xc, yc, zc, xori, xinc, yori, yinc, zori, zinc,
-                                        rot_deg, yflip, nx, ny, nz, p_val_v, &val, 0);
+                ier = cube_value_xyz_interp_lattice(&lat, xc, yc, zc, zori, zinc, nz,
+                                                    p_val_v, bcache, &val, 0);
             }
 
             if (ier == 0)
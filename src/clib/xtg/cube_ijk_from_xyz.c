@@ -8,7 +8,13 @@
  *    Find the "best" (see flag) IJK index given one X Y Z
  *    point (e.g. a map value)
  *
+ *    cube_ijk_from_xyz_lattice is the same for a cube where the XY geometry is
+ *    precomputed once (cf. x_lattice.c), for callers that look up many points.
+ *    Here I J are always computed (flag >= 10 is treated as flag - 10), as this is
+ *    cheap with a precomputed lattice.
+ *
  * ARGUMENTS:
+ *    lat            i     Cube XY geometry (cube_ijk_from_xyz_lattice)
  *    i,j,k          o     Index to be returned (int pointers)
  *    rx,ry,rz       o     Relative to origo 0 for P, returned
  *    x,y,z          i     X Y Z location for point P
@@ -41,6 +47,61 @@
 #include "libxtg.h"
 #include "libxtg_.h"
 
+static int
+_k_from_z(int *k, double *rz, double z, double zori, double zinc, int nz, int flag)
+{
+    int kk;
+    double pz;
+
+    if (z < zori || z > zori + (nz - 1) * zinc) {
+        /* point is above or below cube (node wise thinking) */
+        return -1;
+    }
+
+    pz = z - zori;
+
+    if (flag == 0) {
+        kk = (int)((pz + 0.5 * zinc) / zinc) + 1;
+        if (kk < 1 || kk > nz) {
+            return -1;
+        }
+    } else {
+        kk = (int)(pz / zinc) + 1;
+        if (kk < 1 || kk >= nz) {
+            return -1;
+        }
+    }
+
+    *k = kk;
+    *rz = pz;
+
+    return EXIT_SUCCESS;
+}
+
+int
+cube_ijk_from_xyz_lattice(const struct xtg_lattice *lat,
+                          int *i,
+                          int *j,
+                          int *k,
+                          double *rx,
+                          double *ry,
+                          double *rz,
+                          double x,
+                          double y,
+                          double z,
+                          double zori,
+                          double zinc,
+                          int nz,
+                          int flag)
+{
+    flag = flag % 10;
+
+    if (x_lattice_ij_from_xy(lat, x, y, flag, i, j, rx, ry) != 0)
+        return -1;
+
+    return _k_from_z(k, rz, z, zori, zinc, nz, flag);
+}
+
 int
 cube_ijk_from_xyz(int *i,
                   int *j,
@@ -66,17 +127,12 @@ cube_ijk_from_xyz(int *i,
 {
     /* locals */
     static int ii = 0, jj = 0, ier = 0;
-    int kk;
-    double pz, usex, usey, usez;
     static double rrx = 0.0, rry = 0.0;
-
-    usex = x;
-    usey = y;
-    usez = z;
+    struct xtg_lattice lat;
 
     if (flag < 10) {
-        ier = sucu_ij_from_xy(&ii, &jj, &rrx, &rry, usex, usey, xori, xinc, yori, yinc,
-                              nx, ny, yflip, rot_deg, flag);
+        x_lattice_init(&lat, xori, xinc, yori, yinc, nx, ny, yflip, rot_deg);
+        ier = x_lattice_ij_from_xy(&lat, x, y, flag, &ii, &jj, &rrx, &rry);
     }
 
     *i = ii;
@@ -85,35 +141,8 @@ cube_ijk_from_xyz(int *i,
     *rx = rrx;
     *ry = rry;
 
-    if (z < zori || z > zori + (nz - 1) * zinc) {
-        /* point is above or below cube (node wise thinking) */
-        return -1;
-    }
-
-    if (ier == -1) {
-        return -1;
-    }
-
     if (ier != 0)
-        return ier;
-
-    pz = usez - zori;
-
-    if (flag == 0 || flag == 10) {
-        kk = (int)((pz + 0.5 * zinc) / zinc) + 1;
-        if (kk < 1 || kk > nz) {
-            return -1;
-        }
-        *k = kk;
-    } else {
-        kk = (int)(pz / zinc) + 1;
-        if (kk < 1 || kk >= nz) {
-            return -1;
-        }
-        *k = kk;
-    }
-
-    *rz = pz;
+        return -1;
 
-    return EXIT_SUCCESS;
+    return _k_from_z(k, rz, z, zori, zinc, nz, flag % 10);
 }
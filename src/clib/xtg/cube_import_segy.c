@@ -31,6 +31,7 @@
  *
  * RETURNS:
  *    Function: 0: upon success. If problems <> 0:
+ *    -1: Unsupported format, file cannot be read or invalid trace headers
  *
  * TODO/ISSUES/BUGS:
  *    - update ARGUMENT list above
@@ -43,9 +44,11 @@
 
 #include "libxtg.h"
 #include "libxtg_.h"
+#include "logger.h"
+#include <float.h>
 #include <limits.h>
 
-void
+int
 cube_import_segy(char *file,
                  int gn_hbitoffset,
                  int gn_formatcode,
@@ -75,26 +78,27 @@ cube_import_segy(char *file,
 
     FILE *fc, *fout = NULL;
 
-    int swap, i, nb, ic = 0, offset = 0, nzbytes = 4, ier;
+    int swap, i, nb, ic = 0, offset = 0, nzbytes = 4, ier, status = EXIT_SUCCESS;
     int n4;
     short n2;
     int ntrace[2], ninline[2], nxline[2], ntracecount = 0;
     int ntraces = 0, ninlines = 0, nxlines = 0, ntsamples, mi, mj, k;
     long ntotal, it, ib;
-    int ii, jj, kk, optscan2;
+    int ii, jj, optscan2;
 
     double zscalar, xyscalar, xpos[4], ypos[4];
 
-    int *itracedata = NULL;
     short *stracedata = NULL;
 
     char *ctracebuffer = NULL;
     char *ctracedata = NULL;
     float *ftracedata = NULL;
 
-    double trmin, trmax, ss, rot, rot2, rotrad;
+    double ss, rot, rot2, rotrad;
 
-    float tracepercent = 0.0, tracepercentcount = 0.0, myfloat = 0.0;
+    float tracepercent = 0.0, tracepercentcount = 0.0;
+    float ftrmin = FLT_MAX, ftrmax = -FLT_MAX;
+    long nlayer;
 
     /*
      * stuff needed to read the trace headers; consists of sets of integers
@@ -218,8 +222,6 @@ cube_import_segy(char *file,
 
     optscan2 = optscan;
 
-    trmin = 1000000000;
-    trmax = -1000000000;
 
     if (gn_formatcode == 1) {
         nzbytes = 4; /* 4 byte IBM float */
@@ -234,14 +236,15 @@ cube_import_segy(char *file,
     } else if (gn_formatcode == 8) {
         nzbytes = 1; /* 1 byte signed integer */
     } else {
-        exit(-1);
+        logger_error(LI, FI, FU, "Unsupported SEGY format code %d", gn_formatcode);
+        return -1;
     }
 
     /* The caller should do a check if file exist! */
     fc = fopen(file, "rb");
-
-    if (option == 1 && optscan == 1) {
-        fout = fopen(outfile, "w");
+    if (fc == NULL) {
+        logger_error(LI, FI, FU, "Cannot open file %s", file);
+        return -1;
     }
 
     /*
@@ -398,7 +401,9 @@ cube_import_segy(char *file,
         if (n2set2[1] < 0) {
             xyscalar = -1.0 / (double)n2set2[1];
         } else if (n2set2[1] == 0) {
-            exit(-1);
+            logger_error(LI, FI, FU, "Coordinate scalar is zero in trace header");
+            status = -1;
+            goto finally;
         }
 
         ntsamples = n2set3[13];
@@ -484,10 +489,11 @@ cube_import_segy(char *file,
             /* allocate space for traces */
             ctracebuffer = calloc(4 * ntsamples, sizeof(char));
             if (ctracebuffer == 0) {
-                exit(-1); /* Memory allocation failure of traces. STOP" */
+                logger_error(LI, FI, FU, "Memory allocation failure of traces");
+                status = -1;
+                goto finally;
             }
             ctracedata = ctracebuffer; /* why + 240?? */
-            itracedata = (int *)ctracedata;
             ftracedata = (float *)ctracedata;
             stracedata = (short *)ctracedata;
 
@@ -504,7 +510,9 @@ cube_import_segy(char *file,
             /* read the trace */
             ier = fread(ctracebuffer, nzbytes * ntsamples, 1, fc);
             if (ier != 1) {
-                exit(-1);
+                logger_error(LI, FI, FU, "Error reading trace %d", ntracecount);
+                status = -1;
+                goto finally;
             }
 
             ii = mi - ninline[0] + 1;
@@ -527,55 +535,30 @@ cube_import_segy(char *file,
                 ypos[1] = (double)n4set4[1] * xyscalar;
             }
 
-            /* 32 bit IBM float format */
-            if (gn_formatcode == 1) {
-
-                /* convert... */;
-                u_ibm_to_float(itracedata, itracedata, ntsamples, 1, swap);
-
-                for (k = 0; k < ntsamples; k++) {
-                    /* the cube coordinates are ii, jj, kk startin in 1 */
-                    kk = k + 1;
-
-                    ib = x_ijk2ib(ii, jj, kk, ninlines, nxlines, ntsamples, 0);
-
-                    if (ib < 0) {
-                        exit(9);
-                    }
-
-                    p_val_v[ib] = ftracedata[k];
-
-                    if (p_val_v[ib] < trmin)
-                        trmin = p_val_v[ib];
-                    if (p_val_v[ib] > trmax)
-                        trmax = p_val_v[ib];
-                }
+            /* the cube coordinates are ii, jj, k starting in 1 */
+            ib = x_ijk2ib(ii, jj, 1, ninlines, nxlines, ntsamples, 0);
+            if (ib < 0) {
+                logger_error(LI, FI, FU, "Trace outside cube: %d %d", mi, mj);
+                status = -1;
+                goto finally;
+            }
 
+            /* convert with byte swap and min/max in one pass (in place) */
+            if (gn_formatcode == 1) {
+                x_ibm_to_ieee(ctracebuffer, ftracedata, ntsamples, &ftrmin, &ftrmax);
             } else if (gn_formatcode == 5) {
-                /* IEEE 4 byte float */
-                for (k = 0; k < ntsamples; k++) {
-                    /* the cube coordinates are ii, jj, kk startin in 1 */
-                    kk = k + 1;
-
-                    ib = x_ijk2ib(ii, jj, kk, ninlines, nxlines, ntsamples, 0);
-                    myfloat = ftracedata[k];
-
-                    if (swap)
-                        SWAP_FLOAT(myfloat);
-
-                    p_val_v[ib] = myfloat;
-
-                    if (p_val_v[ib] < trmin)
-                        trmin = p_val_v[ib];
-                    if (p_val_v[ib] > trmax)
-                        trmax = p_val_v[ib];
-                }
-
+                x_ieee_be_to_float(ctracebuffer, ftracedata, ntsamples, &ftrmin,
+                                   &ftrmax);
+            } else {
+                logger_error(LI, FI, FU, "Unsupported format code %d", gn_formatcode);
+                status = -1;
+                goto finally;
             }
 
-            else {
-                exit(-1);
-            }
+            /* cube is in F order, so samples are ninlines * nxlines apart */
+            nlayer = (long)ninlines * nxlines;
+            for (k = 0; k < ntsamples; k++)
+                p_val_v[ib + k * nlayer] = ftracedata[k];
             if (ntracecount == ntraces) {
                 break;
             }
@@ -589,11 +572,9 @@ cube_import_segy(char *file,
     *ny = nxlines;
     *nz = ntsamples;
 
-    if (optscan == 1 || optscan == 9) {
-        fclose(fc);
-    } else {
-        *minval = trmin;
-        *maxval = trmax;
+    if (optscan != 1 && optscan != 9) {
+        *minval = ftrmin;
+        *maxval = ftrmax;
 
         *rotation = -9;
         *xori = xpos[0];
@@ -632,13 +613,16 @@ cube_import_segy(char *file,
 
             *zflip = 1;
         }
-
-        fclose(fc);
     }
 
-    if (option == 1 && optscan == 1) {
+finally:
+
+    free(ctracebuffer);
+    fclose(fc);
+    if (fout != NULL)
         fclose(fout);
-    }
+
+    return status;
 }
 
 /*
@@ -0,0 +1,349 @@
+/*
+ ***************************************************************************************
+ *
+ * NAME:
+ *    cube_import_segy_traces.c (file name)
+ *    cube_segy_trace_index
+ *    cube_import_segy_traces
+ *    x_segy_sample_bytes
+ *    x_segy_decode_samples
+ *
+ * DESCRIPTION:
+ *    Fast SEGY import for post-stack cubes with fixed trace length. The file is
+ *    memory mapped, and traces are accessed directly by position, i.e.
+ *
+ *        trace n starts at offset + n * tracebytes, tracebytes = 240 + ns * nbytes
+ *
+ *    cube_segy_trace_index:
+ *    Read the trace headers fields needed to build the inline/xline index and the
+ *    cube geometry, for all traces in one pass: inline and xline number (bytes
+ *    189-196), trace identification code (29-30) and the scaled CDP X and Y
+ *    coordinates (181-188, scalar in 71-72). The caller (Python) makes the
+ *    mapping from inline/xline to cube column and row.
+ *
+ *    cube_import_segy_traces:
+ *    Decode traces in parallel straight into the cube array (C order, i.e. each
+ *    trace is a contiguous slice of nsamples values). The trace position for each
+ *    cube column is given as a file trace number; a negative number means that
+ *    the trace is missing in the file, and values are then set to zero.
+ *
+ *    x_segy_sample_bytes and x_segy_decode_samples are private helpers, also used
+ *    by the brick cache for windowed cubes (cube_bcache.c).
+ *
+ *    Supported sample formats are 1 (4 byte IBM float), 2 (4 byte integer), 3 (2
+ *    byte integer), 5 (4 byte IEEE float) and 8 (1 byte integer). All headers and
+ *    samples are big endian, as in the SEGY standard.
+ *
+ *    Errors are reported as return codes, never by terminating the process.
+ *
+ * ARGUMENTS:
+ *    file           i     SEGY file name
+ *    offset         i     Byte offset of first trace header (3600 + extended headers)
+ *    tracebytes     i     Number of bytes per trace, including trace header
+ *    ntraces        i     Number of traces in file
+ *    ilines..cdpy   o     Trace header values, one per trace (with array lengths)
+ *    formatcode     i     Sample format code (binary header bytes 3225-3226)
+ *    nsamples       i     Number of samples per trace
+ *    traceno        i     File trace number per cube column, C order (with length)
+ *    values        i/o    Cube values, ncol * nrow * nsamples (with length)
+ *    nthreads       i     Number of threads, 0 or negative means all available
+ *
+ * RETURNS:
+ *    EXIT_SUCCESS, or:
+ *    -1: cannot open or map file
+ *    -2: file is too short for the given traces
+ *    -3: unsupported sample format
+ *    -4: inconsistent array lengths
+ *
+ * TODO/ISSUES/BUGS:
+ *    - Variable trace length (SEGY rev 1 feature) is not supported
+ *
+ * LICENCE:
+ *    cf. XTGeo LICENSE
+ ***************************************************************************************
+ */
+
+#include "libxtg.h"
+#include "libxtg_.h"
+#include "logger.h"
+#include <stdint.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+struct _segymap
+{
+    const unsigned char *data;
+    size_t size;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#endif
+};
+
+static int
+_map_file(const char *file, struct _segymap *map)
+{
+    map->data = NULL;
+    map->size = 0;
+
+#ifdef _WIN32
+    LARGE_INTEGER size;
+
+    map->file = CreateFileA(file, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, NULL);
+    if (map->file == INVALID_HANDLE_VALUE)
+        return EXIT_FAILURE;
+
+    if (!GetFileSizeEx(map->file, &size) || size.QuadPart == 0) {
+        CloseHandle(map->file);
+        return EXIT_FAILURE;
+    }
+    map->size = (size_t)size.QuadPart;
+
+    map->mapping = CreateFileMappingA(map->file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (map->mapping == NULL) {
+        CloseHandle(map->file);
+        return EXIT_FAILURE;
+    }
+    map->data = MapViewOfFile(map->mapping, FILE_MAP_READ, 0, 0, 0);
+    if (map->data == NULL) {
+        CloseHandle(map->mapping);
+        CloseHandle(map->file);
+        return EXIT_FAILURE;
+    }
+#else
+    struct stat st;
+
+    int fd = open(file, O_RDONLY);
+    if (fd < 0)
+        return EXIT_FAILURE;
+
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return EXIT_FAILURE;
+    }
+    map->size = (size_t)st.st_size;
+
+    void *data = mmap(NULL, map->size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); /* the mapping is kept after close */
+    if (data == MAP_FAILED)
+        return EXIT_FAILURE;
+
+    madvise(data, map->size, MADV_SEQUENTIAL);
+    map->data = data;
+#endif
+    return EXIT_SUCCESS;
+}
+
+static void
+_unmap_file(struct _segymap *map)
+{
+    if (map->data == NULL)
+        return;
+#ifdef _WIN32
+    UnmapViewOfFile(map->data);
+    CloseHandle(map->mapping);
+    CloseHandle(map->file);
+#else
+    munmap((void *)map->data, map->size);
+#endif
+    map->data = NULL;
+}
+
+/* big endian integers from byte buffer, independent of machine byte order */
+static inline int32_t
+_be_int32(const unsigned char *p)
+{
+    return (int32_t)(((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+                     ((uint32_t)p[2] << 8) | (uint32_t)p[3]);
+}
+
+static inline int16_t
+_be_int16(const unsigned char *p)
+{
+    return (int16_t)(((uint16_t)p[0] << 8) | (uint16_t)p[1]);
+}
+
+/* decode n big endian SEGY samples (format code 1, 2, 3, 5 or 8) to float */
+void
+x_segy_decode_samples(const unsigned char *data, int formatcode, long n, float *values)
+{
+    long k;
+    switch (formatcode) {
+        case 1:
+            x_ibm_to_ieee(data, values, n, NULL, NULL);
+            break;
+        case 2:
+            for (k = 0; k < n; k++)
+                values[k] = (float)_be_int32(data + 4 * k);
+            break;
+        case 3:
+            for (k = 0; k < n; k++)
+                values[k] = (float)_be_int16(data + 2 * k);
+            break;
+        case 5:
+            x_ieee_be_to_float(data, values, n, NULL, NULL);
+            break;
+        case 8:
+            for (k = 0; k < n; k++)
+                values[k] = (float)(signed char)data[k];
+            break;
+    }
+}
+
+int
+x_segy_sample_bytes(int formatcode)
+{
+    switch (formatcode) {
+        case 1:
+        case 2:
+        case 5:
+            return 4;
+        case 3:
+            return 2;
+        case 8:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+int
+cube_segy_trace_index(char *file,
+                      long offset,
+                      long tracebytes,
+                      long ntraces,
+                      int *ilines,
+                      long nilines,
+                      int *xlines,
+                      long nxlines,
+                      int *traceidcodes,
+                      long ntraceidcodes,
+                      double *cdpx,
+                      long ncdpx,
+                      double *cdpy,
+                      long ncdpy,
+                      int nthreads)
+{
+    double xprof_t0 = x_prof_tic();
+
+    struct _segymap map;
+
+    if (nilines != ntraces || nxlines != ntraces || ntraceidcodes != ntraces ||
+        ncdpx != ntraces || ncdpy != ntraces) {
+        logger_error(LI, FI, FU, "Inconsistent array lengths in %s", FU);
+        return -4;
+    }
+
+    if (_map_file(file, &map) != EXIT_SUCCESS) {
+        logger_error(LI, FI, FU, "Cannot open or map file %s", file);
+        return -1;
+    }
+
+    if ((size_t)offset + (size_t)ntraces * (size_t)tracebytes > map.size) {
+        logger_error(LI, FI, FU, "File %s is too short for %ld traces", file, ntraces);
+        _unmap_file(&map);
+        return -2;
+    }
+
+    nthreads = x_nthreads(nthreads);
+    logger_info(LI, FI, FU, "Index %ld SEGY trace headers (threads: %d)", ntraces,
+                nthreads);
+
+    long n;
+#pragma omp parallel for schedule(static) num_threads(nthreads)
+    for (n = 0; n < ntraces; n++) {
+        const unsigned char *hdr = map.data + offset + (size_t)n * tracebytes;
+
+        double scalar = (double)_be_int16(hdr + 70);
+        if (scalar < 0.0)
+            scalar = -1.0 / scalar;
+        else if (scalar == 0.0)
+            scalar = 1.0;
+
+        traceidcodes[n] = _be_int16(hdr + 28);
+        cdpx[n] = _be_int32(hdr + 180) * scalar;
+        cdpy[n] = _be_int32(hdr + 184) * scalar;
+        ilines[n] = _be_int32(hdr + 188);
+        xlines[n] = _be_int32(hdr + 192);
+    }
+
+    _unmap_file(&map);
+    x_prof_toc(FU, xprof_t0, ntraces);
+    return EXIT_SUCCESS;
+}
+
+int
+cube_import_segy_traces(char *file,
+                        long offset,
+                        long tracebytes,
+                        int formatcode,
+                        int nsamples,
+                        int *traceno,
+                        long ntraceno,
+                        float *values,
+                        long nvalues,
+                        int nthreads)
+{
+    double xprof_t0 = x_prof_tic();
+
+    struct _segymap map;
+
+    int nbytes = x_segy_sample_bytes(formatcode);
+    if (nbytes == 0) {
+        logger_error(LI, FI, FU, "Unsupported SEGY sample format code %d", formatcode);
+        return -3;
+    }
+
+    if (nvalues != ntraceno * nsamples || tracebytes != 240 + nsamples * nbytes) {
+        logger_error(LI, FI, FU, "Inconsistent array lengths in %s", FU);
+        return -4;
+    }
+
+    if (_map_file(file, &map) != EXIT_SUCCESS) {
+        logger_error(LI, FI, FU, "Cannot open or map file %s", file);
+        return -1;
+    }
+
+    long it, nmax = -1;
+    for (it = 0; it < ntraceno; it++) {
+        if (traceno[it] > nmax)
+            nmax = traceno[it];
+    }
+    if ((size_t)offset + (size_t)(nmax + 1) * tracebytes > map.size) {
+        logger_error(LI, FI, FU, "File %s is too short for trace %ld", file, nmax);
+        _unmap_file(&map);
+        return -2;
+    }
+
+    nthreads = x_nthreads(nthreads);
+    logger_info(LI, FI, FU, "Read %ld SEGY traces, format %d (threads: %d)", ntraceno,
+                formatcode, nthreads);
+
+#pragma omp parallel for schedule(dynamic, 64) num_threads(nthreads)
+    for (it = 0; it < ntraceno; it++) {
+        float *trace = values + it * nsamples;
+
+        if (traceno[it] < 0) {
+            memset(trace, 0, nsamples * sizeof(float));
+            continue;
+        }
+
+        const unsigned char *data =
+          map.data + offset + (size_t)traceno[it] * tracebytes + 240;
+
+        x_segy_decode_samples(data, formatcode, nsamples, trace);
+    }
+
+    _unmap_file(&map);
+    x_prof_toc(FU, xprof_t0, nvalues);
+    return EXIT_SUCCESS;
+}
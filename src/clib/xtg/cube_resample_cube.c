@@ -20,6 +20,7 @@
 *    yflip2           i     Cube YFLIP index
 *    p_cubeval2_v     i     1D Array of cube2 values of ncx*ncy*ncz size
 *    ncube            i     Length of cube2 array
+*    bcache2          i     Brick cache handle if cube 2 is windowed, or -1
 *    option1          i     Options:
 *                           0: use cube cell value (no interpolation;
 *                              nearest node)
@@ -70,6 +71,7 @@ cube_resample_cube(int ncx1,
                    int yflip2,
                    float *p_cubeval2_v,
                    long ncube2,
+                   int bcache2,
                    int option1,
                    int option2,
                    float ovalue)
@@ -81,9 +83,16 @@ cube_resample_cube(int ncx1,
     long icn1, nm = 0;
     double xc, yc, zc;
     float value;
+    struct xtg_lattice lat1, lat2;
 
     logger_info(LI, FI, FU, "Resampling cube ... <%s>", FU);
 
+    /* the XY geometries of both cubes are set up once, not per node */
+    x_lattice_init(&lat1, cxori1, cxinc1, cyori1, cyinc1, ncx1, ncy1, yflip1,
+                   crotation1);
+    x_lattice_init(&lat2, cxori2, cxinc2, cyori2, cyinc2, ncx2, ncy2, yflip2,
+                   crotation2);
+
     /* work with every cube1 node */
     for (ic1 = 1; ic1 <= ncx1; ic1++) {
 
@@ -91,8 +100,7 @@ cube_resample_cube(int ncx1,
             for (kc1 = 1; kc1 <= ncz1; kc1++) {
 
                 /* get the cube x, y, z for i j */
-                ier = cube_xy_from_ij(ic1, jc1, &xc, &yc, cxori1, cxinc1, cyori1,
-                                      cyinc1, ncx1, ncy1, yflip1, crotation1, 0);
+                x_lattice_xy_from_ij(&lat1, ic1, jc1, &xc, &yc);
 
                 zc = czori1 + czinc1 * (kc1 - 1);
 
@@ -100,14 +108,14 @@ cube_resample_cube(int ncx1,
 
                 if (option1 == 0) {
 
-                    ier = cube_value_xyz_cell(
-                      xc, yc, zc, cxori2, cxinc2, cyori2, cyinc2, czori2, czinc2,
-                      crotation2, yflip2, ncx2, ncy2, ncz2, p_cubeval2_v, &value, 0);
+                    ier = cube_value_xyz_cell_lattice(&lat2, xc, yc, zc, czori2, czinc2,
+                                                      ncz2, p_cubeval2_v, bcache2,
+                                                      &value);
                 } else if (option1 == 1) {
 
-                    ier = cube_value_xyz_interp(
-                      xc, yc, zc, cxori2, cxinc2, cyori2, cyinc2, czori2, czinc2,
-                      crotation2, yflip2, ncx2, ncy2, ncz2, p_cubeval2_v, &value, 0);
+                    ier = cube_value_xyz_interp_lattice(&lat2, xc, yc, zc, czori2,
+                                                        czinc2, ncz2, p_cubeval2_v,
+                                                        bcache2, &value, 0);
 
                 } else {
                     logger_error(LI, FI, FU, "Invalid option1 (%d) to %s", option1, FU);
@@ -127,7 +135,7 @@ cube_resample_cube(int ncx1,
         }
     }
     /* less than 10% sampled */
-    if (nm > 0 && nm < 0.1 * ncube2) {
+    if (nm > 0 && nm < 0.1 * ncx2 * ncy2 * ncz2) {
         return -4;
     }
 
@@ -20,7 +20,8 @@
 *    option              o     Options. 1=print to stdout
 *
 * RETURNS:
-*    Result pointers are updated
+*    Result pointers are updated. Function returns 0 upon success, or -1 if the
+*    file cannot be opened or read
 *
 * TODO/ISSUES/BUGS/NOTES:
 *
@@ -31,8 +32,9 @@
 
 #include "libxtg.h"
 #include "libxtg_.h"
+#include "logger.h"
 
-void
+int
 cube_scan_segy_hdr(char *file,
                    /* return stuff: */
                    int *gn_bitsheader,
@@ -131,7 +133,8 @@ cube_scan_segy_hdr(char *file,
     fc = fopen(file, "rb");
 
     if (fc == NULL) {
-        exit(-1); /* Could not open file */
+        logger_error(LI, FI, FU, "Could not open file %s", file);
+        return -1;
     }
     /*
      *-------------------------------------------------------------------------
@@ -142,7 +145,9 @@ cube_scan_segy_hdr(char *file,
 
     n = fread(ebcdicheader, 3200, 1, fc);
     if (n != 1) {
-        exit(-1); /* Error reading SEGY EBCDIC header */
+        logger_error(LI, FI, FU, "Error reading SEGY EBCDIC header in %s", file);
+        fclose(fc);
+        return -1;
     }
 
     /*
@@ -155,7 +160,9 @@ cube_scan_segy_hdr(char *file,
     for (i = 0; i < 40; i++) {
         asciiheader[i] = calloc(81, sizeof(char));
         if (asciiheader[i] == 0) {
-            exit(-1);
+            logger_error(LI, FI, FU, "Memory allocation failure");
+            fclose(fc);
+            return -1;
         }
     }
 
@@ -273,6 +280,11 @@ cube_scan_segy_hdr(char *file,
 
     if (option == 1)
         fclose(fout);
+
+    for (i = 0; i < 40; i++)
+        free(asciiheader[i]);
+
+    return EXIT_SUCCESS;
 }
 
 /* a function to simplify reading the binary items in the primary
@@ -12,6 +12,7 @@
 *    i j k          i     Position in cube
 *    nx ny nz       i     Cube dimensions
 *    p_val_v        i     3D cube values
+*    bcache         i     Brick cache handle for windowed cube, or -1
 *    value          i     Updated value
 *
 * RETURNS:
@@ -37,6 +38,7 @@ cube_value_ijk(int i,
                int ny,
                int nz,
                float *p_val_v,
+               int bcache,
                float *value)
 {
     /* locals */
@@ -49,7 +51,7 @@ cube_value_ijk(int i,
         *value = UNDEF;
         return (-1);
     } else {
-        *value = p_val_v[ib];
+        *value = CUBE_VALUE(p_val_v, bcache, ib);
         return EXIT_SUCCESS;
     }
 }
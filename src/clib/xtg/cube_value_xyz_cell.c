@@ -7,12 +7,17 @@
  * DESCRIPTION:
  *    Given X Y Z, return cell (nearest point) cube value.
  *
+ *    cube_value_xyz_cell_lattice takes the cube XY geometry as a precomputed
+ *    lattice (cf. x_lattice.c), so that callers sampling many points set it up once.
+ *
  * ARGUMENTS:
+ *    lat            i     Cube XY geometry incl. nx ny (cube_value_xyz_cell_lattice)
  *    x, y, z        i     Position in cube to request a value
  *    xinc..rot_deg  i     Cube geometry description
  *    yflip          i     If the cube is flipped in Y (1 or -1)
  *    nx ny nz       i     Cube dimensions
  *    p_val_v        i     3D cube values
+ *    bcache         i     Brick cache handle for windowed cube, or -1
  *    value          o     Updated cube cell value
  *    option         i     For later use
  *
@@ -31,6 +36,34 @@
 #include "libxtg.h"
 #include "libxtg_.h"
 
+int
+cube_value_xyz_cell_lattice(const struct xtg_lattice *lat,
+                            double x,
+                            double y,
+                            double z,
+                            double zori,
+                            double zinc,
+                            int nz,
+                            float *p_val_v,
+                            int bcache,
+                            float *value)
+{
+    int i, j, k;
+    double rx, ry, rz;
+
+    /* first get IJK value from XYZ point */
+    if (cube_ijk_from_xyz_lattice(lat, &i, &j, &k, &rx, &ry, &rz, x, y, z, zori, zinc,
+                                  nz, 0) != 0) {
+        *value = UNDEF;
+        return -1;
+    }
+
+    /* now get the cube cell value in IJK */
+    cube_value_ijk(i, j, k, lat->nx, lat->ny, nz, p_val_v, bcache, value);
+
+    return EXIT_SUCCESS;
+}
+
 int
 cube_value_xyz_cell(double x,
                     double y,
@@ -47,27 +80,14 @@ cube_value_xyz_cell(double x,
                     int ny,
                     int nz,
                     float *p_val_v,
+                    int bcache,
                     float *value,
                     int option)
 {
-    /* locals */
-    int i, j, k, istat;
-    float val;
-    double rx, ry, rz;
-
-    /* first get IJK value from XYZ point */
-    istat = cube_ijk_from_xyz(&i, &j, &k, &rx, &ry, &rz, x, y, z, xori, xinc, yori,
-                              yinc, zori, zinc, nx, ny, nz, rot_deg, yflip, 0);
+    struct xtg_lattice lat;
 
-    /* now get the cube cell value in IJK */
-    if (istat == 0) {
-        cube_value_ijk(i, j, k, nx, ny, nz, p_val_v, &val);
-        *value = val;
-
-    } else {
-        *value = UNDEF;
-        return -1;
-    }
+    x_lattice_init(&lat, xori, xinc, yori, yinc, nx, ny, yflip, rot_deg);
 
-    return EXIT_SUCCESS;
+    return cube_value_xyz_cell_lattice(&lat, x, y, z, zori, zinc, nz, p_val_v, bcache,
+                                       value);
 }
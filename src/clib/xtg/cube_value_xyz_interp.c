@@ -9,14 +9,21 @@
  *    interpolated by trilinear interpolation, i.e. 8 cell values are applied
  *    to estimate the value
  *
+ *    cube_value_xyz_interp_lattice takes the cube XY geometry as a precomputed
+ *    lattice (cf. x_lattice.c), so that callers sampling many points set it up once.
+ *    The corner nodes are then found directly from the lattice.
+ *
  * ARGUMENTS:
+ *    lat            i     Cube XY geometry incl. nx ny (cube_value_xyz_interp_lattice)
  *    x, y, z        i     Position in cube to request a value
  *    xinc.. yflip   i     Cube geometry settings
  *    nx ny nz       i     Cube dimensions
  *    p_val_v        i     3D cube values
+ *    bcache         i     Brick cache handle for windowed cube, or -1
  *    value          o     Updated value valid for X Y Z postion
  *    option         i     If 1: snap to nearest cube node in X Y
- *                   i     If >= 10: Skip I J calculation
+ *                   i     If >= 10: as option - 10 (earlier: skip I J calculation,
+ *                         which is not needed as the lattice lookup is cheap)
  *
  * RETURNS:
  *    Function:  0: upon success.
@@ -36,38 +43,31 @@
 #include "logger.h"
 
 int
-cube_value_xyz_interp(double xin,
-                      double yin,
-                      double zin,
-                      double xori,
-                      double xinc,
-                      double yori,
-                      double yinc,
-                      double zori,
-                      double zinc,
-                      double rot_deg,
-                      int yflip,
-                      int nx,
-                      int ny,
-                      int nz,
-                      float *p_val_v,
-                      float *value,
-                      int option)
+cube_value_xyz_interp_lattice(const struct xtg_lattice *lat,
+                              double xin,
+                              double yin,
+                              double zin,
+                              double zori,
+                              double zinc,
+                              int nz,
+                              float *p_val_v,
+                              int bcache,
+                              float *value,
+                              int option)
 {
     /* locals */
     long ib;
-    int ic, jc, kc, i, j, k, ier, ier1, flag;
-    double x_v[8], y_v[8], z_v[8], xx, yy, zz, rx, ry, rz;
+    int ic, jc, kc, i, j, k, ier, ier1;
+    int nx = lat->nx, ny = lat->ny;
+    double x_v[8], y_v[8], z_v[8], xx, yy, rx, ry, rz;
     float p_v[8], val;
 
+    option = option % 10;
+
     /* need to determine the lower left corner coordinates of the point ie
        need to run with flag = 1 */
-    flag = 1;
-    if (option >= 10)
-        flag = 11;
-
-    ier = cube_ijk_from_xyz(&ic, &jc, &kc, &rx, &ry, &rz, xin, yin, zin, xori, xinc,
-                            yori, yinc, zori, zinc, nx, ny, nz, rot_deg, yflip, flag);
+    ier = cube_ijk_from_xyz_lattice(lat, &ic, &jc, &kc, &rx, &ry, &rz, xin, yin, zin,
+                                    zori, zinc, nz, 1);
 
     if (ier == -1) {
         *value = UNDEF;
@@ -75,49 +75,29 @@ cube_value_xyz_interp(double xin,
     }
 
     /* make possibility to snap to nearest cube corner (auto4d request) */
-    if (option == 1 || option == 11) {
-        ib = 0;
+    if (option == 1) {
+        double previousdist = 10E20;
+        double usex = xin, usey = yin;
         for (k = 0; k <= 1; k++) {
             for (j = 0; j <= 1; j++) {
                 for (i = 0; i <= 1; i++) {
-                    ier = cube_coord_val_ijk(ic + i, jc + j, kc + k, nx, ny, nz, xori,
-                                             xinc, yori, yinc, zori, zinc, rot_deg,
-                                             yflip, p_val_v, &xx, &yy, &zz, &val, 0);
-                    if (ier == 0) {
-                        x_v[ib] = xx;
-                        y_v[ib] = yy;
-                        z_v[ib] = zz;
-                        ib++;
+                    if (cube_value_ijk(ic + i, jc + j, kc + k, nx, ny, nz, p_val_v,
+                                       bcache, &val) != 0)
+                        continue;
+                    /* find horizontal distance to the closest corner */
+                    x_lattice_xy_from_ij(lat, ic + i, jc + j, &xx, &yy);
+                    double dist = x_vector_len3d(xx, xin, yy, yin, zin, zin);
+                    if (dist < previousdist) {
+                        usex = xx;
+                        usey = yy;
+                        previousdist = dist;
                     }
                 }
             }
         }
-        long ibmax = ib;
-        /* determine closest corner: */
-        long useib = 0;
-        double previousdist = 10E20;
-        for (ib = 0; ib < ibmax; ib++) {
-            /* find horizontal distance; hence z1 and z2 are both zin */
-            double dist = x_vector_len3d(x_v[ib], xin, y_v[ib], yin, zin, zin);
-            if (dist < previousdist) {
-                useib = ib;
-                previousdist = dist;
-            }
-        }
-        double usex = x_v[useib];
-        double usey = y_v[useib];
-
-        double avginc = 0.5 * (xinc + yinc);
-        if (fabs(previousdist) > fabs(0.1 * avginc)) {
-            /* logger_warn("Warning, snapping distance is more than " */
-            /*             "10 percent of avg cell size in XY: %f vs %f (%s). " */
-            /*             "Consider to deactivate snapxy option?", */
-            /*             previousdist, avginc, FU); */
-        }
 
-        ier =
-          cube_ijk_from_xyz(&ic, &jc, &kc, &rx, &ry, &rz, usex, usey, zin, xori, xinc,
-                            yori, yinc, zori, zinc, nx, ny, nz, rot_deg, yflip, flag);
+        ier = cube_ijk_from_xyz_lattice(lat, &ic, &jc, &kc, &rx, &ry, &rz, usex, usey,
+                                        zin, zori, zinc, nz, 1);
 
         if (ier == -1) {
             *value = UNDEF;
@@ -125,15 +105,8 @@ cube_value_xyz_interp(double xin,
         }
     }
 
-    /* need to get coordinates and values from all 8 corner values */
+    /* need relative coordinates and values from all 8 corner values */
     ib = 0;
-
-    /* relative ccords applied! */
-    xori = 0.0;
-    yori = 0.0;
-    zori = 0.0;
-    rot_deg = 0.0;
-
     ier1 = 0;
 
     /* Note boundaries, and K as outer is intensional
@@ -143,14 +116,13 @@ cube_value_xyz_interp(double xin,
         for (j = 0; j <= 1; j++) {
             for (i = 0; i <= 1; i++) {
 
-                ier = cube_coord_val_ijk(ic + i, jc + j, kc + k, nx, ny, nz, xori, xinc,
-                                         yori, yinc, zori, zinc, rot_deg, yflip,
-                                         p_val_v, &xx, &yy, &zz, &val, flag);
+                ier = cube_value_ijk(ic + i, jc + j, kc + k, nx, ny, nz, p_val_v,
+                                     bcache, &val);
 
                 if (ier == 0) {
-                    x_v[ib] = xx;
-                    y_v[ib] = yy;
-                    z_v[ib] = zz;
+                    x_v[ib] = lat->xinc * (ic + i - 1);
+                    y_v[ib] = lat->yinc * (jc + j - 1);
+                    z_v[ib] = zinc * (kc + k - 1);
                     p_v[ib] = val;
                 } else {
                     ier1 = ier;
@@ -168,17 +140,42 @@ cube_value_xyz_interp(double xin,
     }
 
     /* now interpolate */
-    ier = -9;
-    if (ier1 == 0) {
-        ier = x_interp_cube_nodes(x_v, y_v, z_v, p_v, rx, ry, rz, &val, 1);
-    }
+    ier = x_interp_cube_nodes(x_v, y_v, z_v, p_v, rx, ry, rz, &val, 1);
 
     if (ier != 0) {
         *value = UNDEF;
         return (ier);
-    } else {
-        *value = val;
     }
 
+    *value = val;
+
     return EXIT_SUCCESS;
 }
+
+int
+cube_value_xyz_interp(double xin,
+                      double yin,
+                      double zin,
+                      double xori,
+                      double xinc,
+                      double yori,
+                      double yinc,
+                      double zori,
+                      double zinc,
+                      double rot_deg,
+                      int yflip,
+                      int nx,
+                      int ny,
+                      int nz,
+                      float *p_val_v,
+                      int bcache,
+                      float *value,
+                      int option)
+{
+    struct xtg_lattice lat;
+
+    x_lattice_init(&lat, xori, xinc, yori, yinc, nx, ny, yflip, rot_deg);
+
+    return cube_value_xyz_interp_lattice(&lat, xin, yin, zin, zori, zinc, nz, p_val_v,
+                                         bcache, value, option);
+}
@@ -0,0 +1,669 @@
+/*
+ ***************************************************************************************
+ *
+ * NAME:
+ *    cube_xtgbrick.c (file name)
+ *    cube_export_xtgbrick
+ *    cube_import_xtgbrick
+ *    x_xtgbrick_header
+ *    x_xtgbrick_decode
+ *
+ * DESCRIPTION:
+ *    Bricked cube format (xtgbrickcube), where the cube is stored as bricks of
+ *    fixed size, e.g. 64 x 64 x 64 samples, each brick optionally compressed. An
+ *    offset table gives the file position of each brick, so a sub volume can be
+ *    read without reading the full file (cf. the brick cache in cube_bcache.c).
+ *
+ *    The layout is (native byte order, swap indicator as for other xtg formats):
+ *
+ *        int32  swap indicator (1), magic number (1202), bytes per value (4)
+ *        int64  ncol, nrow, nlay
+ *        int32  bcol, brow, blay, compression (0 none, 1 lossless, 2 bounded)
+ *        double tolerance (max absolute error for bounded compression)
+ *        int64  nbricks
+ *        int64  offset table, nbricks + 1 file positions, where the last is the
+ *               end of the bricks (and the start of the metadata)
+ *        bricks, in order (bi, bj, bk) with bk fastest
+ *        "\nXTGMETA.v01\n" and JSON metadata (written by the Python layer)
+ *
+ *    A brick holds the ni * nj * nk values inside the cube (i.e. edge bricks are
+ *    smaller) in C order. Each brick starts with an int32 codec, and since a
+ *    brick is stored uncompressed if compression does not pay off, the codec may
+ *    differ from the file compression:
+ *
+ *        0: float32 values
+ *        1: lossless; the bit patterns are XOR'ed with the previous sample in the
+ *           trace, split in 4 byte planes and run length encoded. Seismic
+ *           samples vary smoothly along the trace, so the upper bytes (sign and
+ *           exponent) of the XOR'ed values are mostly zero.
+ *        2: bounded error; values are rounded to a multiple of 2 * tolerance
+ *           (a double), and the integer differences along the trace are stored
+ *           as zigzag variable length integers. If values are out of range, the
+ *           brick falls back to lossless.
+ *
+ *    cube_export_xtgbrick:
+ *    Write header, offset table and bricks. Bricks are compressed in parallel, in
+ *    batches, and each batch is then written in order.
+ *
+ *    cube_import_xtgbrick:
+ *    Read the full cube (C order), where bricks are decompressed in parallel.
+ *
+ *    x_xtgbrick_header and x_xtgbrick_decode are private helpers, also used by
+ *    the brick cache (cube_bcache.c).
+ *
+ * ARGUMENTS:
+ *    file           i     File name
+ *    ncol..nlay     i     Cube dimensions
+ *    values        i/o    Cube values, C order (with length)
+ *    bcol..blay     i     Brick dimensions
+ *    compression    i     0 none, 1 lossless, 2 bounded error
+ *    tolerance      i     Max absolute error for bounded error compression (> 0)
+ *    nthreads       i     Number of threads, 0 or negative means all available
+ *
+ * RETURNS:
+ *    EXIT_SUCCESS, or:
+ *    -1: cannot open file, or read/write error
+ *    -2: file is too short or corrupt
+ *    -3: not a xtgbrickcube file
+ *    -4: inconsistent dimensions, lengths or options
+ *    -6: cannot allocate memory
+ *
+ * TODO/ISSUES/BUGS:
+ *    - Dead traces (trace identification codes) are not stored
+ *
+ * LICENCE:
+ *    cf. XTGeo LICENSE
+ ***************************************************************************************
+ */
+
+#include "libxtg.h"
+#include "libxtg_.h"
+#include "logger.h"
+#include <stdint.h>
+#include <string.h>
+
+#define XTGBRICK_MAGIC 1202
+#define XTGBRICK_HEADER 68
+
+/* a batch of bricks to compress in parallel before writing, per thread */
+#define XTGBRICK_BATCH 4
+
+#define BR_MIN(a, b) ((a) < (b) ? (a) : (b))
+
+#ifdef _WIN32
+#define _fseek64 _fseeki64
+#define _ftell64 _ftelli64
+#else
+#define _fseek64 fseeko
+#define _ftell64 ftello
+#endif
+
+/* max blob size for a brick of n values (bounded error needs 5 bytes per value) */
+#define BLOB_MAXBYTES(n) (16 + 5 * (n) + (n) / 64)
+
+/*
+ * -------------------------------------------------------------------------------------
+ * Run length encoding: a control byte c < 128 is followed by c + 1 literal bytes,
+ * while c >= 128 is followed by one byte to be repeated c - 125 times (3..130)
+ * -------------------------------------------------------------------------------------
+ */
+
+static long
+_rle_encode(const unsigned char *in, long n, unsigned char *out)
+{
+    long i = 0, o = 0;
+    while (i < n) {
+        long run = 1;
+        while (i + run < n && run < 130 && in[i + run] == in[i])
+            run++;
+
+        if (run >= 3) {
+            out[o++] = (unsigned char)(run + 125);
+            out[o++] = in[i];
+            i += run;
+            continue;
+        }
+
+        long start = i;
+        while (i < n && i - start < 128) {
+            if (i + 2 < n && in[i] == in[i + 1] && in[i] == in[i + 2])
+                break;
+            i++;
+        }
+        out[o++] = (unsigned char)(i - start - 1);
+        memcpy(out + o, in + start, i - start);
+        o += i - start;
+    }
+    return o;
+}
+
+static int
+_rle_decode(const unsigned char *in, long nin, unsigned char *out, long n)
+{
+    long i = 0, o = 0;
+    while (i < nin && o < n) {
+        int c = in[i++];
+        if (c < 128) {
+            if (i + c + 1 > nin || o + c + 1 > n)
+                return EXIT_FAILURE;
+            memcpy(out + o, in + i, c + 1);
+            i += c + 1;
+            o += c + 1;
+        } else {
+            if (i >= nin || o + c - 125 > n)
+                return EXIT_FAILURE;
+            memset(out + o, in[i++], c - 125);
+            o += c - 125;
+        }
+    }
+    return o == n ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*
+ * -------------------------------------------------------------------------------------
+ * Brick codecs, where values are ntrace traces of nk samples; blobs include the codec
+ * -------------------------------------------------------------------------------------
+ */
+
+static long
+_encode_lossless(const float *values,
+                 long ntrace,
+                 int nk,
+                 unsigned char *blob,
+                 unsigned char *work)
+{
+    long n = ntrace * nk;
+
+    long it;
+    int k, b;
+    for (it = 0; it < ntrace; it++) {
+        uint32_t prev = 0;
+        for (k = 0; k < nk; k++) {
+            long iv = it * nk + k;
+            uint32_t bits;
+            memcpy(&bits, values + iv, 4);
+            uint32_t x = bits ^ prev;
+            prev = bits;
+            for (b = 0; b < 4; b++)
+                work[b * n + iv] = (unsigned char)(x >> (8 * b));
+        }
+    }
+
+    int32_t codec = 1;
+    memcpy(blob, &codec, 4);
+    return 4 + _rle_encode(work, 4 * n, blob + 4);
+}
+
+static int
+_decode_lossless(const unsigned char *data,
+                 long ndata,
+                 long ntrace,
+                 int nk,
+                 float *values,
+                 unsigned char *work)
+{
+    long n = ntrace * nk;
+    if (_rle_decode(data, ndata, work, 4 * n) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
+    long it;
+    int k, b;
+    for (it = 0; it < ntrace; it++) {
+        uint32_t prev = 0;
+        for (k = 0; k < nk; k++) {
+            long iv = it * nk + k;
+            uint32_t x = 0;
+            for (b = 0; b < 4; b++)
+                x |= (uint32_t)work[b * n + iv] << (8 * b);
+            prev ^= x;
+            memcpy(values + iv, &prev, 4);
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+/* returns blob length, or -1 if values cannot be quantized (non finite or too big) */
+static long
+_encode_bounded(const float *values,
+                long ntrace,
+                int nk,
+                double tolerance,
+                unsigned char *blob)
+{
+    double step = 2.0 * tolerance;
+
+    int32_t codec = 2;
+    memcpy(blob, &codec, 4);
+    memcpy(blob + 4, &step, 8);
+    long o = 12;
+
+    long it;
+    int k;
+    for (it = 0; it < ntrace; it++) {
+        int64_t prev = 0;
+        for (k = 0; k < nk; k++) {
+            double qval = values[it * nk + k] / step;
+            if (!(fabs(qval) < 1.0e9))
+                return -1;
+            int64_t q = (int64_t)llround(qval);
+            int64_t d = q - prev;
+            prev = q;
+
+            uint64_t z = ((uint64_t)d << 1) ^ (uint64_t)(d >> 63);
+            while (z >= 0x80) {
+                blob[o++] = (unsigned char)(z | 0x80);
+                z >>= 7;
+            }
+            blob[o++] = (unsigned char)z;
+        }
+    }
+    return o;
+}
+
+static int
+_decode_bounded(const unsigned char *data,
+                long ndata,
+                long ntrace,
+                int nk,
+                float *values)
+{
+    if (ndata < 8)
+        return EXIT_FAILURE;
+
+    double step;
+    memcpy(&step, data, 8);
+    long i = 8;
+
+    long it;
+    int k;
+    for (it = 0; it < ntrace; it++) {
+        int64_t q = 0;
+        for (k = 0; k < nk; k++) {
+            uint64_t z = 0;
+            int shift = 0;
+            do {
+                if (i >= ndata || shift > 63)
+                    return EXIT_FAILURE;
+                z |= (uint64_t)(data[i] & 0x7f) << shift;
+                shift += 7;
+            } while (data[i++] & 0x80);
+
+            q += (int64_t)(z >> 1) ^ -(int64_t)(z & 1);
+            values[it * nk + k] = (float)(q * step);
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+/* encode a brick with the given compression; falls back to uncompressed */
+static long
+_encode_brick(const float *values,
+              long ntrace,
+              int nk,
+              int compression,
+              double tolerance,
+              unsigned char *blob,
+              unsigned char *work)
+{
+    long n = ntrace * nk;
+    long nblob = -1;
+
+    if (compression == 2)
+        nblob = _encode_bounded(values, ntrace, nk, tolerance, blob);
+    if (compression == 1 || (compression == 2 && nblob < 0))
+        nblob = _encode_lossless(values, ntrace, nk, blob, work);
+
+    if (nblob < 0 || nblob >= 4 + 4 * n) {
+        int32_t codec = 0;
+        memcpy(blob, &codec, 4);
+        memcpy(blob + 4, values, 4 * n);
+        nblob = 4 + 4 * n;
+    }
+    return nblob;
+}
+
+int
+x_xtgbrick_decode(const unsigned char *blob,
+                  long nblob,
+                  long ntrace,
+                  int nk,
+                  float *values,
+                  unsigned char *work)
+{
+    long n = ntrace * nk;
+    if (nblob < 4)
+        return EXIT_FAILURE;
+
+    int32_t codec;
+    memcpy(&codec, blob, 4);
+
+    if (codec == 0) {
+        if (nblob != 4 + 4 * n)
+            return EXIT_FAILURE;
+        memcpy(values, blob + 4, 4 * n);
+        return EXIT_SUCCESS;
+    } else if (codec == 1) {
+        return _decode_lossless(blob + 4, nblob - 4, ntrace, nk, values, work);
+    } else if (codec == 2) {
+        return _decode_bounded(blob + 4, nblob - 4, ntrace, nk, values);
+    }
+    return EXIT_FAILURE;
+}
+
+/*
+ * -------------------------------------------------------------------------------------
+ * Brick geometry and file header
+ * -------------------------------------------------------------------------------------
+ */
+
+/* brick start and size (i0, j0, k0, ni, nj, nk); dims are ncol..blay */
+static void
+_brick_box(const int *dims, long brick, int *box)
+{
+    int nbrow = (dims[1] + dims[4] - 1) / dims[4];
+    int nblay = (dims[2] + dims[5] - 1) / dims[5];
+
+    box[0] = (brick / ((long)nblay * nbrow)) * dims[3];
+    box[1] = ((brick / nblay) % nbrow) * dims[4];
+    box[2] = (brick % nblay) * dims[5];
+    box[3] = BR_MIN(dims[3], dims[0] - box[0]);
+    box[4] = BR_MIN(dims[4], dims[1] - box[1]);
+    box[5] = BR_MIN(dims[5], dims[2] - box[2]);
+}
+
+/* copy brick values from cube (option 0) or to cube (option 1), both C order */
+static void
+_brick_copy(const int *dims, const int *box, float *cube, float *bvalues, int option)
+{
+    int i, j;
+    for (i = 0; i < box[3]; i++) {
+        for (j = 0; j < box[4]; j++) {
+            float *trc = cube + ((long)(box[0] + i) * dims[1] + box[1] + j) * dims[2] +
+                         box[2];
+            float *btrc = bvalues + ((long)i * box[4] + j) * box[5];
+            if (option == 0) {
+                memcpy(btrc, trc, box[5] * sizeof(float));
+            } else {
+                memcpy(trc, btrc, box[5] * sizeof(float));
+            }
+        }
+    }
+}
+
+int
+x_xtgbrick_header(FILE *fc, int *dims, int64_t **offsets, long *nbricks)
+{
+    int32_t ihead[3], bhead[4];
+    int64_t lhead[3], nbr;
+    double tolerance;
+
+    if (_fseek64(fc, 0, SEEK_SET) != 0 || fread(ihead, 4, 3, fc) != 3 ||
+        fread(lhead, 8, 3, fc) != 3 || fread(bhead, 4, 4, fc) != 4 ||
+        fread(&tolerance, 8, 1, fc) != 1 || fread(&nbr, 8, 1, fc) != 1)
+        return -2;
+
+    if (ihead[0] != 1 || ihead[1] != XTGBRICK_MAGIC || ihead[2] != 4)
+        return -3;
+
+    int i;
+    for (i = 0; i < 3; i++) {
+        dims[i] = (int)lhead[i];
+        dims[i + 3] = bhead[i];
+        if (dims[i] < 1 || dims[i + 3] < 1 || dims[i + 3] > dims[i])
+            return -2;
+    }
+    if (nbr != (int64_t)((dims[0] + dims[3] - 1) / dims[3]) *
+                 ((dims[1] + dims[4] - 1) / dims[4]) * ((dims[2] + dims[5] - 1) / dims[5]))
+        return -2;
+
+    *nbricks = (long)nbr;
+    *offsets = malloc((nbr + 1) * sizeof(int64_t));
+    if (*offsets == NULL)
+        return -6;
+
+    if (fread(*offsets, 8, nbr + 1, fc) != (size_t)(nbr + 1)) {
+        free(*offsets);
+        *offsets = NULL;
+        return -2;
+    }
+
+    /* offsets shall be increasing, and within the file */
+    int64_t iend = (*offsets)[nbr];
+    long ib;
+    int ok = (_fseek64(fc, 0, SEEK_END) == 0 && iend <= (int64_t)_ftell64(fc) &&
+              (*offsets)[0] == XTGBRICK_HEADER + 8 * (nbr + 1));
+    for (ib = 0; ok && ib < nbr; ib++)
+        ok = (*offsets)[ib + 1] - (*offsets)[ib] >= 4;
+
+    if (!ok) {
+        free(*offsets);
+        *offsets = NULL;
+        return -2;
+    }
+    return EXIT_SUCCESS;
+}
+
+/*
+ * -------------------------------------------------------------------------------------
+ * Export and import
+ * -------------------------------------------------------------------------------------
+ */
+
+int
+cube_export_xtgbrick(char *file,
+                     int ncol,
+                     int nrow,
+                     int nlay,
+                     float *values,
+                     long nvalues,
+                     int bcol,
+                     int brow,
+                     int blay,
+                     int compression,
+                     double tolerance,
+                     int nthreads)
+{
+    double xprof_t0 = x_prof_tic();
+
+    if (ncol < 1 || nrow < 1 || nlay < 1 || bcol < 1 || brow < 1 || blay < 1 ||
+        nvalues != (long)ncol * nrow * nlay || compression < 0 || compression > 2 ||
+        (compression == 2 && !(tolerance > 0.0))) {
+        logger_error(LI, FI, FU, "Inconsistent dimensions or options in %s", FU);
+        return -4;
+    }
+
+    int dims[6] = { ncol, nrow, nlay, BR_MIN(bcol, ncol), BR_MIN(brow, nrow),
+                    BR_MIN(blay, nlay) };
+    long nbricks = (long)((ncol + dims[3] - 1) / dims[3]) *
+                   ((nrow + dims[4] - 1) / dims[4]) * ((nlay + dims[5] - 1) / dims[5]);
+    long bsize = (long)dims[3] * dims[4] * dims[5];
+
+    nthreads = x_nthreads(nthreads);
+    long nbatch = BR_MIN((long)nthreads * XTGBRICK_BATCH, nbricks);
+
+    int64_t *offsets = malloc((nbricks + 1) * sizeof(int64_t));
+    long *nblob = malloc(nbatch * sizeof(long));
+    float *bvalues = malloc(nbatch * bsize * sizeof(float));
+    unsigned char *blobs = malloc(nbatch * BLOB_MAXBYTES(bsize));
+    unsigned char *work = malloc(nbatch * 4 * bsize);
+
+    if (!offsets || !nblob || !bvalues || !blobs || !work) {
+        logger_error(LI, FI, FU, "Cannot allocate memory in %s", FU);
+        x_free(5, offsets, nblob, bvalues, blobs, work);
+        return -6;
+    }
+
+    FILE *fc = fopen(file, "wb");
+    if (fc == NULL) {
+        logger_error(LI, FI, FU, "Cannot open file %s", file);
+        x_free(5, offsets, nblob, bvalues, blobs, work);
+        return -1;
+    }
+
+    logger_info(LI, FI, FU, "Export %ld bricks of %d x %d x %d, compression %d",
+                nbricks, dims[3], dims[4], dims[5], compression);
+
+    int32_t ihead[3] = { 1, XTGBRICK_MAGIC, 4 };
+    int64_t lhead[3] = { ncol, nrow, nlay };
+    int32_t bhead[4] = { dims[3], dims[4], dims[5], compression };
+    int64_t nbr = nbricks;
+
+    int ier = 0;
+    if (fwrite(ihead, 4, 3, fc) != 3 || fwrite(lhead, 8, 3, fc) != 3 ||
+        fwrite(bhead, 4, 4, fc) != 4 || fwrite(&tolerance, 8, 1, fc) != 1 ||
+        fwrite(&nbr, 8, 1, fc) != 1)
+        ier = -1;
+
+    /* the offset table is written when known, after the bricks */
+    offsets[0] = XTGBRICK_HEADER + 8 * (nbricks + 1);
+    if (ier == 0 && _fseek64(fc, offsets[0], SEEK_SET) != 0)
+        ier = -1;
+
+    long ib0, ib;
+    for (ib0 = 0; ier == 0 && ib0 < nbricks; ib0 += nbatch) {
+        long nb = BR_MIN(nbatch, nbricks - ib0);
+
+#pragma omp parallel for schedule(dynamic, 1) num_threads(nthreads)
+        for (ib = 0; ib < nb; ib++) {
+            int box[6];
+            _brick_box(dims, ib0 + ib, box);
+            float *bval = bvalues + ib * bsize;
+            _brick_copy(dims, box, values, bval, 0);
+            nblob[ib] = _encode_brick(bval, (long)box[3] * box[4], box[5], compression,
+                                      tolerance, blobs + ib * BLOB_MAXBYTES(bsize),
+                                      work + ib * 4 * bsize);
+        }
+
+        for (ib = 0; ib < nb; ib++) {
+            if (fwrite(blobs + ib * BLOB_MAXBYTES(bsize), 1, nblob[ib], fc) !=
+                (size_t)nblob[ib]) {
+                ier = -1;
+                break;
+            }
+            offsets[ib0 + ib + 1] = offsets[ib0 + ib] + nblob[ib];
+        }
+    }
+
+    if (ier == 0 && (_fseek64(fc, XTGBRICK_HEADER, SEEK_SET) != 0 ||
+                     fwrite(offsets, 8, nbricks + 1, fc) != (size_t)(nbricks + 1)))
+        ier = -1;
+
+    if (fclose(fc) != 0)
+        ier = -1;
+
+    if (ier != 0) {
+        logger_error(LI, FI, FU, "Error when writing to file %s", file);
+    } else {
+        logger_info(LI, FI, FU, "Bricks: %ld bytes, uncompressed %ld bytes",
+                    (long)(offsets[nbricks] - offsets[0]), 4 * nvalues);
+    }
+
+    x_free(5, offsets, nblob, bvalues, blobs, work);
+
+    x_prof_toc(FU, xprof_t0, nvalues);
+    return ier;
+}
+
+int
+cube_import_xtgbrick(char *file,
+                     int ncol,
+                     int nrow,
+                     int nlay,
+                     float *values,
+                     long nvalues,
+                     int nthreads)
+{
+    double xprof_t0 = x_prof_tic();
+
+    FILE *fc = fopen(file, "rb");
+    if (fc == NULL) {
+        logger_error(LI, FI, FU, "Cannot open file %s", file);
+        return -1;
+    }
+
+    int dims[6];
+    int64_t *offsets = NULL;
+    long nbricks = 0;
+    int ier = x_xtgbrick_header(fc, dims, &offsets, &nbricks);
+    if (ier != EXIT_SUCCESS) {
+        logger_error(LI, FI, FU, "Invalid xtgbrickcube file %s (code %d)", file, ier);
+        fclose(fc);
+        return ier;
+    }
+
+    if (dims[0] != ncol || dims[1] != nrow || dims[2] != nlay ||
+        nvalues != (long)ncol * nrow * nlay) {
+        logger_error(LI, FI, FU, "Inconsistent dimensions in %s", FU);
+        free(offsets);
+        fclose(fc);
+        return -4;
+    }
+
+    long bsize = (long)dims[3] * dims[4] * dims[5];
+
+    nthreads = x_nthreads(nthreads);
+    long nbatch = BR_MIN((long)nthreads * XTGBRICK_BATCH, nbricks);
+
+    long ib0, ib, maxblob = 0;
+    for (ib = 0; ib < nbricks; ib++) {
+        if (offsets[ib + 1] - offsets[ib] > maxblob)
+            maxblob = (long)(offsets[ib + 1] - offsets[ib]);
+    }
+    if (maxblob > BLOB_MAXBYTES(bsize)) {
+        logger_error(LI, FI, FU, "Corrupt offset table in file %s", file);
+        free(offsets);
+        fclose(fc);
+        return -2;
+    }
+
+    float *bvalues = malloc(nbatch * bsize * sizeof(float));
+    unsigned char *blobs = malloc(nbatch * maxblob);
+    unsigned char *work = malloc(nbatch * 4 * bsize);
+    int *status = malloc(nbatch * sizeof(int));
+
+    if (!bvalues || !blobs || !work || !status) {
+        logger_error(LI, FI, FU, "Cannot allocate memory in %s", FU);
+        x_free(5, offsets, bvalues, blobs, work, status);
+        fclose(fc);
+        return -6;
+    }
+
+    for (ib0 = 0; ier == 0 && ib0 < nbricks; ib0 += nbatch) {
+        long nb = BR_MIN(nbatch, nbricks - ib0);
+
+        /* bricks are consecutive in file, hence a batch is one read */
+        long nread = (long)(offsets[ib0 + nb] - offsets[ib0]);
+        if (_fseek64(fc, offsets[ib0], SEEK_SET) != 0 ||
+            fread(blobs, 1, nread, fc) != (size_t)nread) {
+            ier = -2;
+            break;
+        }
+
+#pragma omp parallel for schedule(dynamic, 1) num_threads(nthreads)
+        for (ib = 0; ib < nb; ib++) {
+            int box[6];
+            _brick_box(dims, ib0 + ib, box);
+            float *bval = bvalues + ib * bsize;
+            status[ib] = x_xtgbrick_decode(
+              blobs + (offsets[ib0 + ib] - offsets[ib0]),
+              (long)(offsets[ib0 + ib + 1] - offsets[ib0 + ib]), (long)box[3] * box[4],
+              box[5], bval, work + ib * 4 * bsize);
+            if (status[ib] == EXIT_SUCCESS)
+                _brick_copy(dims, box, values, bval, 1);
+        }
+
+        for (ib = 0; ib < nb; ib++) {
+            if (status[ib] != EXIT_SUCCESS)
+                ier = -2;
+        }
+    }
+
+    if (ier != 0)
+        logger_error(LI, FI, FU, "Corrupt brick in file %s", file);
+
+    x_free(5, offsets, bvalues, blobs, work, status);
+    fclose(fc);
+
+    x_prof_toc(FU, xprof_t0, nvalues);
+    return ier;
+}
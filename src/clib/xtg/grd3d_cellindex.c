@@ -0,0 +1,324 @@
+/*
+ ***************************************************************************************
+ *
+ * NAME:
+ *    grd3d_cellindex.c
+ *
+ * DESCRIPTION:
+ *    A spatial index for corner point grids, used for fast XYZ -> IJK lookups.
+ *
+ *    Each grid column (I, J) gets an axis aligned bounding box (XYZ). The XY
+ *    extent of the grid is divided into a regular, unrotated set of bins, and
+ *    each bin holds the list of columns whose box overlaps the bin, stored in
+ *    compressed form (binstart + bincells; binstart has nbin + 1 entries).
+ *
+ *    A lookup then only evaluates the few columns in one bin, regardless of
+ *    grid rotation and faults, instead of scanning a (potentially full) I J range.
+ *
+ *    The index is built in three steps (cf. _grid3d_fence.py):
+ *    1) grd3d_cellindex_colbox: compute bounding box per column
+ *    2) grd3d_cellindex_count: count number of columns per bin
+ *    3) grd3d_cellindex_fill: fill the column indices per bin (after binstart is
+ *       made from the counts, by cumulative sum)
+ *
+ *    A lookup is done with grd3d_cellindex_lookup, into a buffer sized by
+ *    grd3d_cellindex_maxcols.
+ *
+ *    Column index is 0 based and follows the ordering ic = (i - 1) + (j - 1) * nx
+ *
+ * ARGUMENTS:
+ *    nx, ny, nz       i     Grid dimensions
+ *    coordsv          i     Grid COORD, xtgformat=1
+ *    zcornsv          i     Grid ZCORN, xtgformat=1
+ *    colbox          i/o    Bounding box per column, 6 * nx * ny values as
+ *                           xmin, xmax, ymin, ymax, zmin, zmax
+ *    xmin, ymin       i     Lower left corner of bin layout
+ *    xbin, ybin       i     Bin size in X and Y
+ *    nbx, nby         i     Number of bins in X and Y
+ *    counts           o     Number of columns per bin, nbx * nby
+ *    binstart         i     Start position in bincells per bin, nbx * nby + 1
+ *    bincells         o     Column indices per bin
+ *
+ * RETURNS:
+ *    Function status, EXIT_SUCCESS or EXIT_FAILURE; update output arrays
+ *
+ * TODO/ISSUES/BUGS:
+ *
+ * LICENCE:
+ *    cf. XTGeo LICENSE
+ ***************************************************************************************
+ */
+
+#include "libxtg.h"
+#include "libxtg_.h"
+#include "logger.h"
+
+/*
+****************************************************************************************
+* private functions
+****************************************************************************************
+*/
+
+static void
+_bin_range(double *box,
+           double xmin,
+           double ymin,
+           double xbin,
+           double ybin,
+           int nbx,
+           int nby,
+           int *bx1,
+           int *bx2,
+           int *by1,
+           int *by2)
+{
+    /* the range of bins that a column box overlaps, clipped to the bin layout */
+
+    *bx1 = (int)floor((box[0] - xmin) / xbin);
+    *bx2 = (int)floor((box[1] - xmin) / xbin);
+    *by1 = (int)floor((box[2] - ymin) / ybin);
+    *by2 = (int)floor((box[3] - ymin) / ybin);
+
+    if (*bx1 < 0)
+        *bx1 = 0;
+    if (*by1 < 0)
+        *by1 = 0;
+    if (*bx2 >= nbx)
+        *bx2 = nbx - 1;
+    if (*by2 >= nby)
+        *by2 = nby - 1;
+}
+
+/*
+****************************************************************************************
+* public functions
+****************************************************************************************
+*/
+
+int
+grd3d_cellindex_colbox(int nx,
+                       int ny,
+                       int nz,
+                       double *coordsv,
+                       long ncoordin,
+                       double *zcornsv,
+                       long nzcornin,
+                       double *colbox,
+                       long ncolbox)
+{
+    logger_info(LI, FI, FU, "Column bounding boxes for cell index...");
+
+    if (ncolbox != 6 * (long)nx * ny) {
+        logger_error(LI, FI, FU, "Wrong length of colbox in %s", FU);
+        return EXIT_FAILURE;
+    }
+
+    int i, j;
+    for (j = 1; j <= ny; j++) {
+        for (i = 1; i <= nx; i++) {
+
+            /* z range of the column, all layers, as zcorn may be inconsistent */
+            double zmin = VERYLARGEPOSITIVE;
+            double zmax = VERYLARGENEGATIVE;
+            int k, n;
+            for (k = 1; k <= nz + 1; k++) {
+                long ib = x_ijk2ib(i, j, k, nx, ny, nz + 1, 0);
+                for (n = 0; n < 4; n++) {
+                    double zval = zcornsv[4 * ib + n];
+                    if (zval < zmin)
+                        zmin = zval;
+                    if (zval > zmax)
+                        zmax = zval;
+                }
+            }
+
+            /* pillars are straight lines, so XY extremes are found at zmin/zmax */
+            double *box = &colbox[6 * ((j - 1) * nx + i - 1)];
+            box[0] = VERYLARGEPOSITIVE;
+            box[1] = VERYLARGENEGATIVE;
+            box[2] = VERYLARGEPOSITIVE;
+            box[3] = VERYLARGENEGATIVE;
+            box[4] = zmin;
+            box[5] = zmax;
+
+            int im, jm;
+            for (jm = 0; jm < 2; jm++) {
+                for (im = 0; im < 2; im++) {
+                    double *pil = &coordsv[6 * ((j - 1 + jm) * (nx + 1) + i - 1 + im)];
+                    double zv[2] = { zmin, zmax };
+                    for (n = 0; n < 2; n++) {
+                        double xv = pil[0];
+                        double yv = pil[1];
+                        if (fabs(pil[5] - pil[2]) > 0.01) {
+                            xv = pil[0] - (zv[n] - pil[2]) * (pil[0] - pil[3]) /
+                                            (pil[5] - pil[2]);
+                            yv = pil[1] - (zv[n] - pil[2]) * (pil[1] - pil[4]) /
+                                            (pil[5] - pil[2]);
+                        }
+                        if (xv < box[0])
+                            box[0] = xv;
+                        if (xv > box[1])
+                            box[1] = xv;
+                        if (yv < box[2])
+                            box[2] = yv;
+                        if (yv > box[3])
+                            box[3] = yv;
+                    }
+                }
+            }
+        }
+    }
+    logger_info(LI, FI, FU, "Column bounding boxes for cell index... done");
+    return EXIT_SUCCESS;
+}
+
+int
+grd3d_cellindex_count(int nx,
+                      int ny,
+                      double *colbox,
+                      long ncolbox,
+                      double xmin,
+                      double ymin,
+                      double xbin,
+                      double ybin,
+                      int nbx,
+                      int nby,
+                      int *counts,
+                      long ncounts)
+{
+    if (ncounts != (long)nbx * nby || xbin <= 0.0 || ybin <= 0.0) {
+        logger_error(LI, FI, FU, "Invalid bin layout in %s", FU);
+        return EXIT_FAILURE;
+    }
+
+    long ib;
+    for (ib = 0; ib < ncounts; ib++)
+        counts[ib] = 0;
+
+    long ic;
+    for (ic = 0; ic < (long)nx * ny; ic++) {
+        int bx1, bx2, by1, by2, bx, by;
+        _bin_range(&colbox[6 * ic], xmin, ymin, xbin, ybin, nbx, nby, &bx1, &bx2, &by1,
+                   &by2);
+        for (by = by1; by <= by2; by++) {
+            for (bx = bx1; bx <= bx2; bx++) {
+                counts[by * nbx + bx]++;
+            }
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+int
+grd3d_cellindex_fill(int nx,
+                     int ny,
+                     double *colbox,
+                     long ncolbox,
+                     double xmin,
+                     double ymin,
+                     double xbin,
+                     double ybin,
+                     int nbx,
+                     int nby,
+                     int *binstart,
+                     long nbinstart,
+                     int *bincells,
+                     long nbincells)
+{
+    if (nbinstart != (long)nbx * nby + 1 || binstart[nbinstart - 1] != nbincells) {
+        logger_error(LI, FI, FU, "Inconsistent bin arrays in %s", FU);
+        return EXIT_FAILURE;
+    }
+
+    int *cursor = calloc(nbinstart, sizeof(int));
+    memcpy(cursor, binstart, nbinstart * sizeof(int));
+
+    long ic;
+    for (ic = 0; ic < (long)nx * ny; ic++) {
+        int bx1, bx2, by1, by2, bx, by;
+        _bin_range(&colbox[6 * ic], xmin, ymin, xbin, ybin, nbx, nby, &bx1, &bx2, &by1,
+                   &by2);
+        for (by = by1; by <= by2; by++) {
+            for (bx = bx1; bx <= bx2; bx++) {
+                long ib = by * nbx + bx;
+                if (cursor[ib] >= binstart[ib + 1]) {
+                    free(cursor);
+                    logger_error(LI, FI, FU, "Bin overflow in %s", FU);
+                    return EXIT_FAILURE;
+                }
+                bincells[cursor[ib]++] = (int)ic;
+            }
+        }
+    }
+
+    free(cursor);
+    return EXIT_SUCCESS;
+}
+
+/*
+ * Largest number of columns in any bin (at least 1). A cols buffer of this size
+ * holds every candidate a lookup can return, hence nothing is truncated.
+ */
+
+int
+grd3d_cellindex_maxcols(int nbx, int nby, int *binstart)
+{
+    int maxcols = 1;
+    long ib;
+    for (ib = 0; ib < (long)nbx * nby; ib++) {
+        int ncols = binstart[ib + 1] - binstart[ib];
+        if (ncols > maxcols)
+            maxcols = ncols;
+    }
+    return maxcols;
+}
+
+/*
+ * Find candidate columns for a point, i.e. columns where the bounding box
+ * contains the point. If z is UNDEF, the check is done in XY only. The
+ * candidate list is given as 0 based column indices, and number of
+ * candidates is returned (max ncols; use grd3d_cellindex_maxcols() to size
+ * cols so that all candidates are returned).
+ */
+
+int
+grd3d_cellindex_lookup(double x,
+                       double y,
+                       double z,
+                       double *colbox,
+                       double xmin,
+                       double ymin,
+                       double xbin,
+                       double ybin,
+                       int nbx,
+                       int nby,
+                       int *binstart,
+                       int *bincells,
+                       int *cols,
+                       int ncols)
+{
+    int bx = (int)floor((x - xmin) / xbin);
+    int by = (int)floor((y - ymin) / ybin);
+
+    if (bx < 0 || bx >= nbx || by < 0 || by >= nby)
+        return 0;
+
+    long ib = (long)by * nbx + bx;
+
+    int nfound = 0;
+    int n;
+    for (n = binstart[ib]; n < binstart[ib + 1]; n++) {
+        int ic = bincells[n];
+        double *box = &colbox[6 * (long)ic];
+
+        if (x < box[0] || x > box[1] || y < box[2] || y > box[3])
+            continue;
+        if (z < UNDEF_LIMIT && (z < box[4] || z > box[5]))
+            continue;
+
+        cols[nfound++] = ic;
+        if (nfound == ncols)
+            break;
+    }
+    return nfound;
+}
@@ -0,0 +1,83 @@
+/*
+ ***************************************************************************************
+ *
+ * NAME:
+ *    grd3d_geometry_cache.c
+ *
+ * DESCRIPTION:
+ *    Compute a per cell geometry cache; the 24 corners, the bounding box (AABB) and
+ *    the centroid of every cell. This version is for xtgformat=1, while the layout
+ *    of the result is the same as for grdcp3d_geometry_cache.c (see there), i.e.
+ *    cells are in C order.
+ *
+ * ARGUMENTS:
+ *    nx, ny, nz       i     Grid dimensions
+ *    coordsv          i     Grid Z coord for input
+ *    zcornsv          i     Grid Z corners for input
+ *    corners          o     Corners, 24 * ncell
+ *    aabb             o     Bounding boxes, 6 * ncell
+ *    centroids        o     Centroids, 3 * ncell
+ *    nthreads         i     Number of threads (if built with OpenMP); 0 or negative
+ *                           means all available.
+ *
+ * RETURNS:
+ *    Function status, EXIT_SUCCESS or EXIT_FAILURE if wrong array lengths
+ *
+ * TODO/ISSUES/BUGS:
+ *    None known
+ *
+ * LICENCE:
+ *    cf. XTGeo License
+ ***************************************************************************************
+ */
+
+#include "libxtg.h"
+#include "libxtg_.h"
+#include "logger.h"
+
+int
+grd3d_geometry_cache(int nx,
+                     int ny,
+                     int nz,
+                     double *coordsv,
+                     long ncoord,
+                     double *zcornsv,
+                     long nzcorn,
+                     double *corners,
+                     long ncorners,
+                     double *aabb,
+                     long naabb,
+                     double *centroids,
+                     long ncentroids,
+                     int nthreads)
+
+{
+    long ncell = (long)nx * ny * nz;
+
+    if (ncorners != 24 * ncell || naabb != 6 * ncell || ncentroids != 3 * ncell) {
+        logger_error(LI, FI, FU, "Wrong length of geometry cache arrays in %s", FU);
+        return EXIT_FAILURE;
+    }
+
+    nthreads = x_nthreads(nthreads);
+    logger_info(LI, FI, FU, "Cell geometry cache (threads: %d)...", nthreads);
+
+    int i, j;
+#pragma omp parallel for collapse(2) schedule(static) num_threads(nthreads)
+    for (i = 1; i <= nx; i++) {
+        for (j = 1; j <= ny; j++) {
+            int k;
+            for (k = 1; k <= nz; k++) {
+                long ic = x_ijk2ic(i, j, k, nx, ny, nz, 0);
+
+                grd3d_corners(i, j, k, nx, ny, nz, coordsv, ncoord, zcornsv, nzcorn,
+                              &corners[24 * ic]);
+                x_corners_aabb_centroid(&corners[24 * ic], &aabb[6 * ic],
+                                        &centroids[3 * ic]);
+            }
+        }
+    }
+
+    logger_info(LI, FI, FU, "Cell geometry cache... done");
+    return EXIT_SUCCESS;
+}
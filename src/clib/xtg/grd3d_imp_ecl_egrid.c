@@ -59,6 +59,7 @@ grd3d_imp_ecl_egrid(FILE *fc,
                     long *nact,
                     int option)
 {
+    double xprof_t0 = x_prof_tic();
 
     int *idum = NULL;
     float *fdum = NULL;
@@ -176,5 +177,6 @@ grd3d_imp_ecl_egrid(FILE *fc,
 
     logger_info(LI, FI, FU, "EGRID import ... done");
 
+    x_prof_toc(FU, xprof_t0, nxyz);
     return EXIT_SUCCESS;
 }
@@ -70,6 +70,7 @@
  * RETURNS:
  *    Function: 0: upon success (parameter OK). If problems <> 0:
  *    -1: parameter not found
+ *    -2: data or codes could not be read (e.g. truncated file)
  *    Various pointers are updated.
  *
  * TODO/ISSUES/BUGS/NOTES:
@@ -255,19 +256,27 @@ grd3d_imp_prop_roffbin(char *filename,
                                             "Error in reading ROFF as n != nx*ny*nz.");
                         }
 
+                        int ierr = EXIT_SUCCESS;
                         if (strcmp(ctype, "float") == 0) {
-                            x_roffgetfloatarray(p_ftmp_v, n, fc);
+                            ierr = x_roffgetfloatarray(p_ftmp_v, n, fc);
                             ntype = 1;
                         } else if (strcmp(ctype, "int") == 0) {
-                            x_roffgetintarray(p_itmp_v, n, fc);
+                            ierr = x_roffgetintarray(p_itmp_v, n, fc);
                             ntype = 2;
                         } else if (strcmp(ctype, "byte") == 0) {
-                            x_roffgetbytearray(p_btmp_v, n, fc);
+                            ierr = x_roffgetbytearray(p_btmp_v, n, fc);
                             ntype = 3;
                         } else {
                             logger_critical(LI, FI, FU, "Error code 9349 from %s", FU);
                         }
 
+                        if (ierr != EXIT_SUCCESS) {
+                            logger_error(LI, FI, FU, "Cannot read data for <%s>",
+                                         prop_name);
+                            propstatus = -2;
+                            goto finally;
+                        }
+
                         if (propstatus == 0) {
                             *p_type = ntype;
                         }
@@ -348,8 +357,12 @@ grd3d_imp_prop_roffbin(char *filename,
                         iok = fread(&ncodes, 4, 1, fc);
                         if (swap == 1)
                             SWAP_INT(ncodes);
-                        if (strcmp(ctype, "int") == 0) {
-                            x_roffgetintarray(p_itmp_v, ncodes, fc);
+                        if (strcmp(ctype, "int") == 0 &&
+                            x_roffgetintarray(p_itmp_v, ncodes, fc) != EXIT_SUCCESS) {
+                            logger_error(LI, FI, FU, "Cannot read codes for <%s>",
+                                         prop_name);
+                            propstatus = -2;
+                            goto finally;
                         }
                         if (storevalue == 1) {
                             for (i = 0; i < ncodes; i++) {
@@ -406,7 +419,7 @@ finally:
 
     fclose(fc);
 
-    if (propstatus < 0) {
+    if (propstatus == -1) {
         logger_warn(LI, FI, FU, "Requested property <%s> not found!", prop_name);
     }
 
@@ -21,7 +21,8 @@
  *
  * DESCRIPTION:
  *    This routine goes directly to the byte position(s) which are found from
- *    scanning, and reads the array. Map into XTGeo format.
+ *    scanning, and reads the array. Map into XTGeo format. The data are read in
+ *    blocks, cf. x_roffbin_read_prop().
  *
  * ARGUMENTS:
  *    fc              i     Filehandle (stream) to read from
@@ -37,7 +38,8 @@
  *    debug           i     Debug level
  *
  * RETURNS:
- *    Function: 0 if success. Updated pointers.
+ *    Function: 0 if success, EXIT_FAILURE if the array cannot be read.
+ *    Updated pointers.
  *
  * NOTES:
  *    Both byte and bool data will be stored as 32 bit ints in XTGeo.
@@ -70,62 +72,8 @@ grd3d_imp_roffbin_arr(FILE *fc,
 {
     /* Imports a ROFF binary array which has nx * ny * nz data points */
 
-    int anint;
-    float afloat;
-    double adouble;
-    char abyte;
+    /* ROFF char/bool/byte are all one byte, unsigned */
+    int rdtype = (dtype == 4 || dtype == 5) ? 6 : dtype;
 
-    int i, j, k, iok, kactual;
-    long ipos;
-
-    fseek(fc, bytepos, SEEK_SET);
-
-    ipos = -1;
-    for (i = 1; i <= nx; i++) {
-        for (j = 1; j <= ny; j++) {
-            for (k = nz; k >= 1; k--) {
-
-                kactual = nz - k + 1;
-
-                ipos = x_ijk2ic(i, j, k, nx, ny, nz, 0);
-
-                if (dtype == 1) {
-                    iok = fread(&anint, 4, 1, fc);
-                    if (swap == 1)
-                        SWAP_INT(anint);
-                    if (anint == -999)
-                        anint = UNDEF_INT;
-                    iarray[ipos] = anint;
-                }
-
-                else if (dtype == 2) {
-                    iok = fread(&afloat, 4, 1, fc);
-                    if (swap == 1)
-                        SWAP_FLOAT(afloat);
-                    if (afloat == -999.0)
-                        afloat = UNDEF;
-                    farray[ipos] = afloat;
-                }
-
-                else if (dtype == 3) {
-                    /* not sure if this ever happens; no double in ROFF? */
-                    iok = fread(&adouble, 8, 1, fc);
-                    if (swap == 1)
-                        SWAP_DOUBLE(adouble);
-                    if (adouble == -999.0)
-                        adouble = UNDEF;
-                    farray[ipos] = (float)adouble;
-                }
-
-                else if (dtype == 5) {
-                    iok = fread(&abyte, 1, 1, fc);
-                    anint = abyte; /* convert to int */
-                    if (anint == 255)
-                        anint = UNDEF_INT;
-                    iarray[ipos] = anint;
-                }
-            }
-        }
-    }
-    return EXIT_SUCCESS;
+    return x_roffbin_read_prop(fc, bytepos, swap, rdtype, nx, ny, nz, farray, iarray);
 }
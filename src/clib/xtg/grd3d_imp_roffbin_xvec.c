@@ -32,7 +32,7 @@
  *    n*vec           i     Length of float array
  *
  * RETURNS:
- *    Updated float pointer *vec
+ *    EXIT_SUCCESS, or EXIT_FAILURE if the array cannot be read. Updated *vec
  *
  * TODO/ISSUES/BUGS:
  *
@@ -46,19 +46,13 @@ grd3d_imp_roffbin_fvec(FILE *fc, int swap, long bytepos, float *fvec, long nfvec
 {
     /* Imports a ROFF binary array, update pointer */
 
-    float afloat;
-    long i;
-
-    fseek(fc, bytepos, SEEK_SET);
+    if (x_roffbin_read_block(fc, bytepos, swap, 4, nfvec, fvec) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
 
+    long i;
     for (i = 0; i < nfvec; i++) {
-        if (fread(&afloat, 4, 1, fc) != 1)
-            exit(EXIT_FAILURE);
-        if (swap == 1)
-            SWAP_FLOAT(afloat);
-        if (afloat == -999.0)
-            afloat = UNDEF;
-        fvec[i] = afloat;
+        if (fvec[i] == -999.0)
+            fvec[i] = UNDEF;
     }
 
     return EXIT_SUCCESS;
@@ -69,19 +63,13 @@ grd3d_imp_roffbin_ivec(FILE *fc, int swap, long bytepos, int *ivec, long nivec)
 {
     /* Imports a ROFF binary array, update pointer */
 
-    int anint;
-    long i;
-
-    fseek(fc, bytepos, SEEK_SET);
+    if (x_roffbin_read_block(fc, bytepos, swap, 4, nivec, ivec) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
 
+    long i;
     for (i = 0; i < nivec; i++) {
-        if (fread(&anint, 4, 1, fc) != 1)
-            exit(EXIT_FAILURE);
-        if (swap == 1)
-            SWAP_FLOAT(anint);
-        if (anint == -999.0)
-            anint = UNDEF_INT;
-        ivec[i] = anint;
+        if (ivec[i] == -999)
+            ivec[i] = UNDEF_INT;
     }
 
     return EXIT_SUCCESS;
@@ -92,20 +80,20 @@ grd3d_imp_roffbin_bvec(FILE *fc, int swap, long bytepos, int *bvec, long nbvec)
 {
     /* Imports a ROFF binary array if type , update pointer. NB convert to INT! */
 
-    unsigned char achar;
-    long i;
-    int anint;
+    unsigned char *buf = malloc(nbvec > 0 ? nbvec : 1);
+    if (buf == NULL)
+        return EXIT_FAILURE;
 
-    fseek(fc, bytepos, SEEK_SET);
+    if (x_roffbin_read_block(fc, bytepos, 0, 1, nbvec, buf) != EXIT_SUCCESS) {
+        free(buf);
+        return EXIT_FAILURE;
+    }
 
+    long i;
     for (i = 0; i < nbvec; i++) {
-        if (fread(&achar, 1, 1, fc) != 1)
-            exit(EXIT_FAILURE);
-        anint = (int)achar;
-        if (anint == 255)
-            anint = UNDEF_INT;
-        bvec[i] = anint;
+        bvec[i] = (buf[i] == 255) ? UNDEF_INT : (int)buf[i];
     }
 
+    free(buf);
     return EXIT_SUCCESS;
 }
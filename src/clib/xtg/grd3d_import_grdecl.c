@@ -3,9 +3,15 @@
 *
 * NAME:
 *    grd3d_import_grdecl.c
+*    grd3d_grdecl_specgrid
 *
 * DESCRIPTION:
-*    Import a grid on eclipse GRDECL format.
+*    Import a grid on eclipse GRDECL format. The file is parsed in one pass with a
+*    streaming tokenizer (x_grdecl_reader.c), which handles comments, repeat
+*    counts (N*value) and record terminators (/).
+*
+*    The grd3d_grdecl_specgrid() function reads the dimensions from SPECGRID, to
+*    be used for allocating arrays prior to import.
 *
 * ARGUMENTS:
 *    fc             i     File handler
@@ -16,10 +22,10 @@
 *    nact           o     Number of active cells
 *
 * RETURNS:
-*    Void, update pointer arrays and nact
+*    EXIT_SUCCESS, or EXIT_FAILURE if COORD or ZCORN are missing or invalid.
+*    If ACTNUM is missing, all cells are active. Update pointer arrays and nact
 *
 * TODO/ISSUES/BUGS:
-*    Improve this routine in general, e.g. when breaking the read loop
 *
 * LICENCE:
 *    CF XTGeo's LICENSE
@@ -29,7 +35,35 @@
 #include "libxtg_.h"
 #include "logger.h"
 
-void
+int
+grd3d_grdecl_specgrid(FILE *fc, int *nx, int *ny, int *nz)
+{
+    struct grdecl_reader rd;
+    double dims[3];
+    int status = EXIT_FAILURE;
+
+    *nx = *ny = *nz = 0;
+
+    if (x_grdecl_open(&rd, fc) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
+    rewind(fc);
+    if (x_grdecl_find_keyword(&rd, "SPECGRID") &&
+        x_grdecl_read_doubles(&rd, dims, 3, 1.0) == 3) {
+        *nx = (int)dims[0];
+        *ny = (int)dims[1];
+        *nz = (int)dims[2];
+        status = EXIT_SUCCESS;
+    } else {
+        logger_error(LI, FI, FU, "SPECGRID not found or invalid");
+    }
+
+    x_grdecl_close(&rd);
+    rewind(fc);
+    return status;
+}
+
+int
 grd3d_import_grdecl(FILE *fc,
                     int nx,
                     int ny,
@@ -43,90 +77,51 @@ grd3d_import_grdecl(FILE *fc,
                     int *nact)
 
 {
-    char cname[9];
-    int i, j, k, kk, ib, line, nnx, nny, nnz, num_cornerlines, kzread;
-    int ix, jy, kz, ier, nn;
-    int nfact = 0, nfzcorn = 0, nfcoord = 0;
-    double fvalue, fvalue1, fvalue2, xmin, xmax, ymin, ymax;
-    double x1, y1, x2, y2, x3, y3, cx, cy;
-    int dvalue, mamode;
-
-    /* initial settings of data (used if MAPAXES)*/
-    xmin = VERYLARGEFLOAT;
-    ymin = VERYLARGEFLOAT;
-    xmax = -1 * VERYLARGEFLOAT;
-    ymax = -1 * VERYLARGEFLOAT;
-
-    /* this is just a COORD sort of counter; track if X, Y, Z is read (for xmin etc)*/
-    ix = 1;
-    jy = 0;
-    kz = 0;
-
-    mamode = 0;
-
-    /*
-     *=================================================================================
-     * Loop file... It is NOT necessary to do many tests; that should be done
-     * by the calling PERL script?
-     *=================================================================================
-     */
-
-    num_cornerlines = 2 * 3 * (nx + 1) * (ny + 1);
-
-    for (line = 1; line < 9999999; line++) {
-
-        /* Get offsets */
-        if (fgets(cname, 9, fc) != NULL)
-            logger_info(LI, FI, FU, "CNAME is: %s", cname);
-
-        if (strncmp(cname, "SPECGRID", 8) == 0) {
-
-            ier = fscanf(fc, "%d %d %d", &nnx, &nny, &nnz);
-            if (ier != 3) {
-                logger_error(LI, FI, FU, "Error in reading SPECGRID");
-            }
-        }
+    double xprof_t0 = x_prof_tic();
+
+    struct grdecl_reader rd;
+    char token[33];
+    long i, j, k, kk, ib, nn = 0;
+    int nfact = 0, nfzcorn = 0, nfcoord = 0, mamode = 0, status = EXIT_SUCCESS;
+    double mapaxes[6], cx, cy;
+
+    long num_cornerlines = 2 * 3 * (nx + 1) * (ny + 1);
 
-        if (strncmp(cname, "MAPAXES", 7) == 0) {
-            ier = fscanf(fc, "%lf %lf %lf %lf %lf %lf", &x1, &y1, &x2, &y2, &x3, &y3);
-            if (ier != 6) {
+    if (x_grdecl_open(&rd, fc) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
+    /* buffer for one row of ZCORN values, or one layer of ACTNUM */
+    long nrowbuf = 2 * (long)nx > (long)nx * ny ? 2 * (long)nx : (long)nx * ny;
+    double *rowv = malloc(nrowbuf * sizeof(double));
+    if (rowv == NULL) {
+        x_grdecl_close(&rd);
+        return EXIT_FAILURE;
+    }
+
+    rewind(fc);
+
+    while (!(nfact && nfzcorn && nfcoord) && x_grdecl_token(&rd, token, 33) > 0) {
+
+        if (strcmp(token, "MAPAXES") == 0) {
+            if (x_grdecl_read_doubles(&rd, mapaxes, 6, 0.0) != 6) {
                 logger_error(LI, FI, FU, "Error in reading MAPAXES");
+            } else {
+                mamode = 1;
             }
-            mamode = 1;
         }
 
-        if (strncmp(cname, "COORD", 5) == 0) {
+        else if (strcmp(token, "COORD") == 0) {
             nfcoord = 1;
 
+            if (x_grdecl_read_doubles(&rd, coordsv, num_cornerlines, 0.0) !=
+                num_cornerlines) {
+                logger_error(LI, FI, FU, "Error in reading COORD");
+                status = EXIT_FAILURE;
+                break;
+            }
             for (i = 0; i < num_cornerlines; i++) {
-                if (fscanf(fc, "%lf", &fvalue) != 1)
-                    logger_error(LI, FI, FU, "Error in reading COORD");
-                if (fvalue == 9999900.0000) {
-                    fvalue = -9999.99;
-                }
-                coordsv[i] = fvalue;
-
-                if (ix == 1) {
-                    if (coordsv[i] < xmin)
-                        xmin = coordsv[i];
-                    if (coordsv[i] > xmax)
-                        xmax = coordsv[i];
-                    ix = 0;
-                    jy = 1;
-                    kz = 0;
-                } else if (jy == 1) {
-                    if (coordsv[i] < ymin)
-                        ymin = coordsv[i];
-                    if (coordsv[i] > ymax)
-                        ymax = coordsv[i];
-                    ix = 0;
-                    jy = 0;
-                    kz = 1;
-                } else {
-                    ix = 1;
-                    jy = 0;
-                    kz = 0;
-                }
+                if (coordsv[i] == 9999900.0000)
+                    coordsv[i] = -9999.99;
             }
         }
 
@@ -137,87 +132,93 @@ grd3d_import_grdecl(FILE *fc,
          *
          */
 
-        if (strncmp(cname, "ZCORN", 5) == 0) {
+        else if (strcmp(token, "ZCORN") == 0) {
             nfzcorn = 1;
 
-            ib = 0;
-            kzread = 0;
+            int kzread = 0;
             kk = 0;
-            for (k = 1; k <= 2 * nz; k++) {
-                if (kzread == 0) {
-                    kzread = 1;
-                } else {
-                    kzread = 0;
-                }
+            for (k = 1; k <= 2 * nz && status == EXIT_SUCCESS; k++) {
+                kzread = (kzread == 0) ? 1 : 0;
                 if (k == 2 * nz && kzread == 0)
                     kzread = 1;
-                if (kzread == 1) {
+                if (kzread == 1)
                     kk += 1;
-                }
+
                 for (j = 1; j <= ny; j++) {
-                    /* "left" cell margin */
-                    for (i = 1; i <= nx; i++) {
-                        if (fscanf(fc, "%lf", &fvalue1) != 1)
-                            logger_error(LI, FI, FU, "Error in reading ZCORN");
-                        if (fscanf(fc, "%lf", &fvalue2) != 1)
+                    /* "left" cell margin, then "right" cell margin */
+                    int side;
+                    for (side = 0; side < 2; side++) {
+                        if (x_grdecl_read_doubles(&rd, rowv, 2 * nx, 0.0) != 2 * nx) {
                             logger_error(LI, FI, FU, "Error in reading ZCORN");
-
-                        ib = x_ijk2ib(i, j, kk, nx, ny, nz + 1, 0);
-                        if (kzread == 1) {
-                            zcornsv[4 * ib + 1 * 1 - 1] = fvalue1;
-                            zcornsv[4 * ib + 1 * 2 - 1] = fvalue2;
+                            status = EXIT_FAILURE;
+                            break;
                         }
-                    }
-                    /* "right" cell margin */
-                    for (i = 1; i <= nx; i++) {
-                        if (fscanf(fc, "%lf", &fvalue1) != 1)
-                            logger_error(LI, FI, FU, "Error in reading ZCORN");
-                        if (fscanf(fc, "%lf", &fvalue2) != 1)
-                            logger_error(LI, FI, FU, "Error in reading ZCORN");
-                        ib = x_ijk2ib(i, j, kk, nx, ny, nz + 1, 0);
-                        if (kzread == 1) {
-                            zcornsv[4 * ib + 1 * 3 - 1] = fvalue1;
-                            zcornsv[4 * ib + 1 * 4 - 1] = fvalue2;
+                        if (kzread == 0)
+                            continue;
+                        for (i = 1; i <= nx; i++) {
+                            ib = x_ijk2ib(i, j, kk, nx, ny, nz + 1, 0);
+                            zcornsv[4 * ib + 2 * side] = rowv[2 * (i - 1)];
+                            zcornsv[4 * ib + 2 * side + 1] = rowv[2 * (i - 1) + 1];
                         }
                     }
+                    if (status != EXIT_SUCCESS)
+                        break;
                 }
             }
+            if (status != EXIT_SUCCESS)
+                break;
         }
 
-        nn = 0;
-        if (strncmp(cname, "ACTNUM", 6) == 0) {
+        else if (strcmp(token, "ACTNUM") == 0) {
             nfact = 1;
             ib = 0;
             for (k = 1; k <= nz; k++) {
-                for (j = 1; j <= ny; j++) {
-                    for (i = 1; i <= nx; i++) {
-                        if (fscanf(fc, "%d", &dvalue) == 1) {
-                            actnumsv[ib++] = dvalue;
-                            if (dvalue == 1)
-                                nn++;
-                        } else {
-                            logger_error(LI, FI, FU, "Error in reading...");
-                        }
-                    }
+                if (x_grdecl_read_doubles(&rd, rowv, (long)nx * ny, 1.0) !=
+                    (long)nx * ny) {
+                    logger_error(LI, FI, FU, "Error in reading ACTNUM");
+                    status = EXIT_FAILURE;
+                    break;
+                }
+                for (i = 0; i < (long)nx * ny; i++) {
+                    actnumsv[ib] = (int)rowv[i];
+                    if (actnumsv[ib++] == 1)
+                        nn++;
                 }
             }
+            if (status != EXIT_SUCCESS)
+                break;
         }
+    }
 
-        if (nfact == 1 && nfzcorn == 1 && nfcoord == 1) {
-            break;
-        }
+    free(rowv);
+    x_grdecl_close(&rd);
+
+    if (status == EXIT_SUCCESS && !(nfcoord && nfzcorn)) {
+        logger_error(LI, FI, FU, "COORD and/or ZCORN missing in GRDECL file");
+        status = EXIT_FAILURE;
+    }
+
+    if (status == EXIT_SUCCESS && !nfact) {
+        logger_info(LI, FI, FU, "No ACTNUM in GRDECL file, all cells are active");
+        for (ib = 0; ib < nactnum; ib++)
+            actnumsv[ib] = 1;
+        nn = nactnum;
     }
 
-    *nact = nn;
+    *nact = (int)nn;
 
     /* convert from MAPAXES, if present */
     if (mamode == 1) {
         for (ib = 0; ib < (nx + 1) * (ny + 1) * 6; ib = ib + 3) {
             cx = coordsv[ib];
             cy = coordsv[ib + 1];
-            x_mapaxes(mamode, &cx, &cy, x1, y1, x2, y2, x3, y3, 0);
+            x_mapaxes(mamode, &cx, &cy, mapaxes[0], mapaxes[1], mapaxes[2], mapaxes[3],
+                      mapaxes[4], mapaxes[5], 0);
             coordsv[ib] = cx;
             coordsv[ib + 1] = cy;
         }
     }
+
+    x_prof_toc(FU, xprof_t0, (long)nx * ny * nz);
+    return status;
 }
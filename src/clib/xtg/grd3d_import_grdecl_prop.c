@@ -14,6 +14,9 @@
  *    Also INT numbers are read by this routine; do foat to int conversion in
  *    Python.
  *
+ *    The file is parsed with a streaming tokenizer (x_grdecl_reader.c), so
+ *    comments and repeat counts (N*value) are handled. Keywords must match exactly.
+ *
  * ARGUMENTS:
  *    filename       i     File name to import from
  *    nx, ny, nz     i     Grid dimensions
@@ -24,7 +27,7 @@
  *    debug          i     Debug level
  *
  * RETURNS:
- *    0 if success, -1 if keyword not found. Pointer is updated.
+ *    0 if success, -1 if keyword not found or invalid. Pointer is updated.
  *
  * TODO/ISSUES/BUGS:
  *
@@ -48,49 +51,61 @@ grd3d_import_grdecl_prop(char *filename,
                          int option)
 
 {
-    char cname[33];
-    long ic, line;
-    int nchar, found = 0;
-    int icol, jrow, klay;
-    double fvalue;
+    double xprof_t0 = x_prof_tic();
+
+    struct grdecl_reader rd;
+    long ic, ib, nread;
+    int icol, jrow, klay, status = EXIT_SUCCESS;
     FILE *fc;
 
     logger_info(LI, FI, FU, "Import Property on Eclipse GRDECL format ...");
 
     fc = fopen(filename, "rb");
+    if (fc == NULL) {
+        logger_error(LI, FI, FU, "Cannot open file %s", filename);
+        return -1;
+    }
 
-    nchar = strlen(pname);
-
-    for (line = 1; line < 99999999; line++) {
+    if (x_grdecl_open(&rd, fc) != EXIT_SUCCESS) {
+        fclose(fc);
+        return -1;
+    }
 
-        /* Get word */
-        if (fgets(cname, 33, fc) == NULL) {
-            fclose(fc);
-            return -1;
-        }
+    if (!x_grdecl_find_keyword(&rd, pname)) {
+        x_grdecl_close(&rd);
+        fclose(fc);
+        return -1;
+    }
 
-        if (strncmp(cname, pname, nchar) == 0) {
-            found = 1;
-            for (klay = 1; klay <= nlay; klay++) {
-                for (jrow = 1; jrow <= nrow; jrow++) {
-                    for (icol = 1; icol <= ncol; icol++) {
-                        if (fscanf(fc, "%lf", &fvalue) != 1)
-                            logger_error(LI, FI, FU, "Error in reading %s", pname);
+    /* read in F order into a temporary array, then map to C order */
+    double *tmpv = malloc(nlen * sizeof(double));
+    if (tmpv == NULL) {
+        x_grdecl_close(&rd);
+        fclose(fc);
+        return -1;
+    }
 
-                        /* map directly to C order */
-                        ic = x_ijk2ic(icol, jrow, klay, ncol, nrow, nlay, 0);
-                        p_prop_v[ic] = fvalue;
-                    }
+    nread = x_grdecl_read_doubles(&rd, tmpv, nlen, UNDEF);
+    if (nread != nlen) {
+        logger_error(LI, FI, FU, "Error in reading %s, got %ld of %ld values", pname,
+                     nread, nlen);
+        status = -1;
+    } else {
+        ib = 0;
+        for (klay = 1; klay <= nlay; klay++) {
+            for (jrow = 1; jrow <= nrow; jrow++) {
+                for (icol = 1; icol <= ncol; icol++) {
+                    ic = x_ijk2ic(icol, jrow, klay, ncol, nrow, nlay, 0);
+                    p_prop_v[ic] = tmpv[ib++];
                 }
             }
-            break;
         }
     }
 
+    free(tmpv);
+    x_grdecl_close(&rd);
     fclose(fc);
 
-    if (found == 0)
-        return -1;
-
-    return EXIT_SUCCESS;
+    x_prof_toc(FU, xprof_t0, nlen);
+    return status;
 }
@@ -8,25 +8,39 @@
  * DESCRIPTION:
  *    Given X Y Z vectors, return the corresponding I J K vectors for the cell indices
  *    Certain tricks here are made in order to get it work fast:
- *    > Define maps with IJK indixes to search for I J ranges
+ *    > A spatial bin index of grid columns to find candidate columns
+ *      (cf. grd3d_cellindex.c)
  *    > A onelayer version of the grid
+ *    > A "last hit" warm start, as consecutive points (e.g. along a well path or
+ *      in a point cloud from a regular survey) often are in the same cell. When a
+ *      warm start cell is hit again, its face planes are precomputed once
+ *      (x_hexahedron_prepare()) so the following points in that cell are tested
+ *      with a plain multiply-add loop
+ *
+ *    The points may be processed in parallel (OpenMP). The input arrays are then
+ *    partitioned in contiguous chunks across threads, each thread having its own
+ *    warm start cell.
  *
  * ARGUMENTS:
  *    xvec, yvec, zvec    i     Arrays coords XYZ
  *    n*vec               i     length of input vectors (spesified for swig/numpy)
- *    mcol, mrow          i     Number of rows/cols for maps
- *    xori..rotation      i     Map settings
- *    maptopi..mapbasj    i     Map arrays for I J top/base
+ *    colbox              i     Cell index; bounding box per column
+ *    binstart, bincells  i     Cell index; columns per bin
+ *    xmin..nby           i     Cell index; bin layout
  *    nx ny nz            i     Grid dimensions
  *    zcornsv             i     Grid ZCORN
  *    coordsv             i     Grid COORD
  *    p_acnum_v           i     Grid ACTNUM
  *    p_val_v             i     3D Grid values
  *    p_zcornone_v        i     Grid ZCORN for onelayer grid
+ *    cornerscache        i     Optional precomputed cell corners (24 per cell, C order)
+ *                              cf. grd3d_geometry_cache(); length 0 for no cache
  *    p_acnumone_v        i     Grid ACTNUM for onelayer grid
  *    actnumoption        i     if 1, then only report if cell is active
  *    ivec, jvec, kvec    o     IJK arrays
  *    n*vec               i     array lengths (for swig/numpies)
+ *    nthreads            i     Number of threads; 0 or less for all available.
+ *                              Only in effect if compiled with OpenMP.
  *
  * RETURNS:
  *    Update IJK pointers, array length, -1 if fail
@@ -50,108 +64,39 @@
 ****************************************************************************************
 */
 
-static int
-_get_ij_range(int *i1,
-              int *i2,
-              int *j1,
-              int *j2,
-              double xc,
-              double yc,
-              int mcol,
-              int mrow,
-              double xori,
-              double yori,
-              double xinc,
-              double yinc,
-              int yflip,
-              double rotation,
-              double *maptopi,
-              double *maptopj,
-              double *mapbasi,
-              double *mapbasj,
-              int nx,
-              int ny)
+/*
+ * As x_ib2ijk() with base 0 IB and base 1 I J K, for a valid IB. Unlike x_ib2ijk()
+ * this never logs, as it is used inside the OpenMP region where the logger (static
+ * state) cannot be called.
+ */
+static void
+_ib2ijk(long ib, int *i, int *j, int *k, int nx, int ny)
 {
-    long nmap;
-    double itop, jtop, ibas, jbas;
-    int ii1, ii2, jj1, jj2;
-
-    if (nx < 4 || ny < 4) {
-        *i1 = 1;
-        *i2 = nx;
-        *j1 = 1;
-        *j2 = ny;
-        return 1;
-    }
-
-    nmap = mcol * mrow;
-
-    /* get map value for I J from x y */
-    itop = surf_get_z_from_xy(xc, yc, mcol, mrow, xori, yori, xinc, yinc, yflip,
-                              rotation, maptopi, nmap);
-    jtop = surf_get_z_from_xy(xc, yc, mcol, mrow, xori, yori, xinc, yinc, yflip,
-                              rotation, maptopj, nmap);
-    ibas = surf_get_z_from_xy(xc, yc, mcol, mrow, xori, yori, xinc, yinc, yflip,
-                              rotation, mapbasi, nmap);
-    jbas = surf_get_z_from_xy(xc, yc, mcol, mrow, xori, yori, xinc, yinc, yflip,
-                              rotation, mapbasj, nmap);
-
-    if (itop >= UNDEF_LIMIT || jtop >= UNDEF_LIMIT || ibas >= UNDEF_LIMIT ||
-        jbas >= UNDEF_LIMIT) {
-        return -1;
-    }
-
-    if (itop <= ibas) {
-        ii1 = (int)itop;
-        ii2 = (int)ibas;
-    } else {
-        ii1 = (int)ibas;
-        ii2 = (int)itop;
-    }
+    long nxy = (long)nx * ny;
+    *k = ib / nxy + 1;
+    *j = (ib % nxy) / nx + 1;
+    *i = ib % nx + 1;
+}
 
-    /* extend with one to avoid edge effects of missing values */
-    if (ii1 > 1)
-        ii1--;
-    if (ii2 < mcol)
-        ii2++;
-
-    if (jtop <= jbas) {
-        jj1 = (int)jtop;
-        jj2 = (int)jbas;
-    } else {
-        jj1 = (int)jbas;
-        jj2 = (int)jtop;
-    }
+static double *
+_grd3d_cell_corners(int ic,
+                    int jc,
+                    int kc,
+                    int nx,
+                    int ny,
+                    int nz,
+                    double *coordsv,
+                    double *zcornsv,
+                    double *cornerscache,
+                    double *cornersv)
+{
+    /* corners of the cell, from the cache or computed into cornersv */
 
-    /* extend with one to avoid edge effects missing values */
-    if (jj1 > 1)
-        jj1--;
-    if (jj2 < mrow)
-        jj2++;
-
-    /*  if numbers are unphysical for some reason, revert to grid limits */
-    if (ii1 < 1 || ii1 >= nx)
-        ii1 = 1;
-    if (ii2 <= 1 || ii2 > nx)
-        ii2 = nx;
-    if (jj1 < 1 || jj1 >= ny)
-        jj1 = 1;
-    if (jj2 <= 1 || jj2 > ny)
-        jj2 = ny;
-
-    if (ii2 <= ii1 || (ii2 - ii1) >= nx || jj2 <= jj1 || (jj2 - jj1) >= ny) {
-        ii1 = 1;
-        ii2 = nx;
-        jj1 = 1;
-        jj2 = ny;
+    if (cornerscache) {
+        return &cornerscache[24 * x_ijk2ic(ic, jc, kc, nx, ny, nz, 0)];
     }
-
-    *i1 = ii1;
-    *i2 = ii2;
-    *j1 = jj1;
-    *j2 = jj2;
-
-    return 1;
+    grd3d_corners(ic, jc, kc, nx, ny, nz, coordsv, 0, zcornsv, 0, cornersv);
+    return cornersv;
 }
 
 static long
@@ -166,6 +111,7 @@ _grd3d_point_in_cell(int ic,
                      int nz,
                      double *coordsv,
                      double *zcornsv,
+                     double *cornerscache,
                      int *score)
 
 {
@@ -178,6 +124,7 @@ _grd3d_point_in_cell(int ic,
      * nx, ny, nz    Dimensions
      * coordsv       Pillar coordinates (grid)
      * zcornsv       ZCORN (grid)
+     * cornerscache  Precomputed corners for the full grid, or NULL
      * score         This is a number telling how good the match is, going from -1 to 24
      */
 
@@ -186,8 +133,9 @@ _grd3d_point_in_cell(int ic,
     ib = x_ijk2ib(ic, jc, kc, nx, ny, nz, 0);
 
     /* get the corner for the cell */
-    double corners[24];
-    grd3d_corners(ic, jc, kc, nx, ny, nz, coordsv, 0, zcornsv, 0, corners);
+    double cornersv[24];
+    double *corners = _grd3d_cell_corners(ic, jc, kc, nx, ny, nz, coordsv, zcornsv,
+                                          cornerscache, cornersv);
 
     *score = x_point_in_hexahedron(xc, yc, zc, corners, 24, 1);
 
@@ -206,48 +154,44 @@ _point_val_ij(double xc,
               int ny,
               double *coordsv,
               double *p_zcornone_v,
-              int i1,
-              int i2,
-              int j1,
-              int j2,
+              int *cols,
+              int ncols,
               long ibfound[])
 {
     /*
      * The purpose here is to search the one layer grid for IJ location of point XYZ
-     * In case inside, IRES and JRES are assigned; otherwise, it will be UNDEF_INT
-     * This routine should be fast since the I1 I2 J1 J2 range is estimated in the
-     * previous step
+     * This routine should be fast since only candidate columns from the cell index
+     * are evaluated
      *
-     * ires, jres       Pointers to I J to be updated
      * xc, yc, zc       Points to evaluate if inside
      * nx, ny, nz       Dimensions
-     * coordsv         Coordinates COORD
-     * zcornsv          Coordinates ZCORN
-     * ibalts           It may be that several IB ranges may be valid
-     * i1, i2, j1, j2   I J search range
+     * coordsv          Coordinates COORD
+     * p_zcornone_v     Coordinates ZCORN, one layer grid
+     * cols, ncols      Candidate columns (0 based index) from cell index
+     * ibfound          It may be that several IB ranges may be valid
      */
 
-    int ii, jj;
-
     int score;
 
     int ibn = 0;
 
-    for (jj = j1; jj <= j2; jj++) {
-        for (ii = i1; ii <= i2; ii++) {
+    int n;
+    for (n = 0; n < ncols; n++) {
+
+        int ii = cols[n] % nx + 1;
+        int jj = cols[n] / nx + 1;
 
-            score = 0;
-            long ibfoundp = _grd3d_point_in_cell(ii, jj, 1, xc, yc, zc, nx, ny, 1,
-                                                 coordsv, p_zcornone_v, &score);
+        score = 0;
+        long ibfoundp = _grd3d_point_in_cell(ii, jj, 1, xc, yc, zc, nx, ny, 1, coordsv,
+                                             p_zcornone_v, NULL, &score);
 
-            if (score > 50) {
-                ibfound[ibn++] = ibfoundp;
+        if (score > 50) {
+            ibfound[ibn++] = ibfoundp;
+            return ibn;
+        } else if (score == 50) {
+            ibfound[ibn++] = ibfoundp;
+            if (ibn == 4)
                 return ibn;
-            } else if (score == 50) {
-                ibfound[ibn++] = ibfoundp;
-                if (ibn == 4)
-                    return ibn;
-            }
         }
     }
     return ibn;
@@ -262,6 +206,7 @@ _point_val_ijk(double xc,
                int nz,
                double *coordsv,
                double *zcornsv,
+               double *cornerscache,
                int *actnumsv,
                int actnumoption,
                int iin,
@@ -289,7 +234,7 @@ _point_val_ijk(double xc,
     nib = 0;
     for (k = 1; k <= nz; k++) {
         long ibfound = _grd3d_point_in_cell(iin, jin, k, xc, yc, zc, nx, ny, nz,
-                                            coordsv, zcornsv, &score);
+                                            coordsv, zcornsv, cornerscache, &score);
 
         if (score >= 50) {
             ibalts[nib] = ibfound;
@@ -298,10 +243,6 @@ _point_val_ijk(double xc,
             if (actnumoption == 0)
                 ibactive[nib] = 1;  // appear active
 
-            logger_debug(LI, FI, FU,
-                         "ZC = %6.2lf: I J K = %d %d %d (IB = %ld), score = %d", zc,
-                         iin, jin, k, ibalts[nib], ibscore[nib]);
-
             nib++;
         } else if (score == 0 && nib > 0) {
             break;
@@ -319,8 +260,6 @@ _point_val_ijk(double xc,
             if (ibscore[n] > hiscore && ibactive[n] == 1) {
                 hiscore = ibscore[n];
                 *ibchosen = ibalts[n];
-                logger_debug(LI, FI, FU, "IBCHOSEN is %ld with score %d", *ibchosen,
-                             hiscore);
             }
         }
         retvalue = hiscore;
@@ -330,8 +269,6 @@ _point_val_ijk(double xc,
     free(ibscore);
     free(ibactive);
 
-    logger_debug(LI, FI, FU, "Final IBCHOSEN is %ld with retvalue %d", *ibchosen,
-                 retvalue);
     return retvalue;
 }
 /*
@@ -348,19 +285,6 @@ grd3d_points_ijk_cells(double *xvec,
                        double *zvec,
                        long nzvec,
 
-                       int mcol,
-                       int mrow,
-                       double xori,
-                       double yori,
-                       double xinc,
-                       double yinc,
-                       double rotation,
-                       int yflip,
-                       double *maptopi,
-                       double *maptopj,
-                       double *mapbasi,
-                       double *mapbasj,
-
                        int nx,
                        int ny,
                        int nz,
@@ -374,6 +298,21 @@ grd3d_points_ijk_cells(double *xvec,
 
                        double *p_zcornone_v,
                        long nzcornonein,
+                       double *cornerscache,
+                       long ncornerscache,
+
+                       double *colbox,
+                       long ncolbox,
+                       int *binstart,
+                       long nbinstart,
+                       int *bincells,
+                       long nbincells,
+                       double xmin,
+                       double ymin,
+                       double xbin,
+                       double ybin,
+                       int nbx,
+                       int nby,
 
                        int actnumoption,
 
@@ -382,8 +321,10 @@ grd3d_points_ijk_cells(double *xvec,
                        int *jvec,
                        long njvec,
                        int *kvec,
-                       long nkvec)
+                       long nkvec,
+                       int nthreads)
 {
+    double xprof_t0 = x_prof_tic();
 
     logger_info(LI, FI, FU, "Entering routine %s", FU);
 
@@ -392,38 +333,95 @@ grd3d_points_ijk_cells(double *xvec,
     if (nivec != njvec || nivec != nkvec)
         logger_critical(LI, FI, FU, "Input bug");
 
-    int ic;
-    for (ic = 0; ic < nxvec; ic++) {
-        double xc = xvec[ic];
-        double yc = yvec[ic];
-        double zc = zvec[ic];
-
-        ivec[ic] = UNDEF_INT;
-        jvec[ic] = UNDEF_INT;
-        kvec[ic] = UNDEF_INT;
+    nthreads = x_nthreads(nthreads);
+    logger_info(LI, FI, FU, "Number of threads: %d", nthreads);
+
+    /* a cache of wrong length (or none) means corners are computed on the fly */
+    if (ncornerscache != 24 * (long)nx * ny * nz)
+        cornerscache = NULL;
+
+    /* candidate columns buffer per thread, sized for the largest bin */
+    int maxcols = grd3d_cellindex_maxcols(nbx, nby, binstart);
+    int nomem = 0;
+
+#pragma omp parallel num_threads(nthreads)
+    {
+        /* warm start; the last cell found (per thread), -1 if none. When the
+           warm start cell holds the next point as well, it is prepared for
+           repeated tests, cf. x_hexahedron_prepare() */
+        long iblast = -1;
+        int lastprepared = 0;
+        double lastprep[HEXA_NPREP];
+
+        int *cols = malloc(maxcols * sizeof(int));
+        if (cols == NULL) {
+#pragma omp atomic write
+            nomem = 1;
+        }
 
-        /*
-         * first get an approximate I and J range based on these maps
-         * This is based on xc, yc position in the regular map
-         */
+        long ic;
+#pragma omp for schedule(static)
+        for (ic = 0; ic < nxvec; ic++) {
+            double xc = xvec[ic];
+            double yc = yvec[ic];
+            double zc = zvec[ic];
+
+            ivec[ic] = UNDEF_INT;
+            jvec[ic] = UNDEF_INT;
+            kvec[ic] = UNDEF_INT;
+
+            if (cols == NULL)
+                continue;
+
+            int ires, jres, kres;
+
+            /*
+             * first try the previous hit cell; accept only if point is fully inside
+             * (score 100), otherwise do the complete search below
+             */
+            if (iblast >= 0) {
+                _ib2ijk(iblast, &ires, &jres, &kres, nx, ny);
+                int score;
+                if (lastprepared) {
+                    score = x_point_in_hexahedron_prepared(xc, yc, zc, lastprep);
+                } else {
+                    double cornersv[24];
+                    double *corners =
+                      _grd3d_cell_corners(ires, jres, kres, nx, ny, nz, coordsv,
+                                          zcornsv, cornerscache, cornersv);
+                    score = x_point_in_hexahedron(xc, yc, zc, corners, 24, 1);
+                    if (score == 100) {
+                        x_hexahedron_prepare(corners, lastprep);
+                        lastprepared = 1;
+                    }
+                }
+                if (score == 100) {
+                    ivec[ic] = ires;
+                    jvec[ic] = jres;
+                    kvec[ic] = kres;
+                    continue;
+                }
+            }
 
-        int i1, i2, j1, j2;
-        int ier =
-          _get_ij_range(&i1, &i2, &j1, &j2, xc, yc, mcol, mrow, xori, yori, xinc, yinc,
-                        yflip, rotation, maptopi, maptopj, mapbasi, mapbasj, nx, ny);
+            /*
+             * get candidate columns from the cell index, i.e. columns
+             * where the bounding box contains the point
+             */
 
-        if (ier < 0)
-            continue;
+            int ncols =
+              grd3d_cellindex_lookup(xc, yc, zc, colbox, xmin, ymin, xbin, ybin, nbx,
+                                     nby, binstart, bincells, cols, maxcols);
 
-        /*
-         * next check the onelayer version of the grid first (speed up)
-         * This should pin I J coordinate
-         */
-        long ibfound[4];
-        int nfound = _point_val_ij(xc, yc, zc, nx, ny, coordsv, p_zcornone_v, i1, i2,
-                                   j1, j2, ibfound);
+            if (ncols == 0)
+                continue;
 
-        if (nfound > 0) {
+            /*
+             * next check the onelayer version of the grid first (speed up)
+             * This should pin I J coordinate
+             */
+            long ibfound[4];
+            int nfound = _point_val_ij(xc, yc, zc, nx, ny, coordsv, p_zcornone_v, cols,
+                                       ncols, ibfound);
 
             int ibn;
             for (ibn = 0; ibn < nfound; ibn++) {
@@ -433,38 +431,40 @@ grd3d_points_ijk_cells(double *xvec,
                  * so now it is time to find exact K location
                  */
 
-                int ires, jres, kres;
-                x_ib2ijk(ibfound[ibn], &ires, &jres, &kres, nx, ny, 1, 0);
-
-                logger_debug(LI, FI, FU,
-                             "Onelayer hit found for point %.3lf %.3lf %.3lf"
-                             " for column I J = %d %d",
-                             xc, yc, zc, ires, jres);
+                _ib2ijk(ibfound[ibn], &ires, &jres, &kres, nx, ny);
 
                 long ibfound2;
                 int nscore =
-                  _point_val_ijk(xc, yc, zc, nx, ny, nz, coordsv, zcornsv, actnumsv,
-                                 actnumoption, ires, jres, &ibfound2);
+                  _point_val_ijk(xc, yc, zc, nx, ny, nz, coordsv, zcornsv, cornerscache,
+                                 actnumsv, actnumoption, ires, jres, &ibfound2);
                 if (ibfound2 >= 0 && nscore > 0) {
 
-                    x_ib2ijk(ibfound2, &ires, &jres, &kres, nx, ny, nz, 0);
+                    if (actnumoption == 1 && actnumsv[ibfound2] == 0) {
+                        /*  keep undef in inactive cell */
+                        break;
+                    }
+
+                    _ib2ijk(ibfound2, &ires, &jres, &kres, nx, ny);
                     ivec[ic] = ires;
                     jvec[ic] = jres;
                     kvec[ic] = kres;
-
-                    if (actnumoption == 1 && actnumsv[ibfound2] == 0) {
-                        /*  reset to undef in inactivecell */
-                        ivec[ic] = UNDEF_INT;
-                        jvec[ic] = UNDEF_INT;
-                        kvec[ic] = UNDEF_INT;
-                    }
+                    iblast = ibfound2;
+                    lastprepared = 0;
                     break;
                 }
             }
         }
+
+        free(cols);
+    }
+
+    if (nomem) {
+        logger_error(LI, FI, FU, "Cannot allocate column buffers in %s", FU);
+        return EXIT_FAILURE;
     }
 
     logger_info(LI, FI, FU, "Exit from routine %s", FU);
 
+    x_prof_toc(FU, xprof_t0, nxvec);
     return EXIT_SUCCESS;
 }
@@ -1,13 +1,14 @@
-
 #include "libxtg.h"
 #include "libxtg_.h"
 #include "logger.h"
+#include <string.h>
 
 /*
 ****************************************************************************************
 *
 * NAME:
 *    grd3d_read_eclrecord.c
+*    grd3d_read_eclrecord_dbl
 *
 * DESCRIPTION:
 *    Based on a scan, the record position in file and length is
@@ -22,15 +23,24 @@
 *              0          15           4           0           6          21
 *    ETC!....
 *
+*    Each Fortran block is read with one fread() directly into the result array,
+*    and then byte swapped as a whole (x_swap_block), a loop which the compiler
+*    will vectorize.
+*
+*    The grd3d_read_eclrecord_dbl() variant reads any numerical record type
+*    (INTE, REAL, DOUB, LOGI) into a double array, e.g. a REAL property is widened
+*    block by block, instead of going via a temporary float array.
+*
 * ARGUMENTS:
 *    fc               i     Filehandle (file must be open)
 *    recstart         i     Start of record in file, in bytes
-*    rectype          i     Type of record to read (1=INT, 2=FLT, 3=DBL)
-*    intv             o     Preallocated Int array (if rectype is 1 or 4)
+*    rectype          i     Type of record to read (1=INT, 2=FLT, 3=DBL, 5=LOGI)
+*    intv             o     Preallocated Int array (if rectype is 1 or 5)
 *    nint             i     The allocated record total length
 *    floatv           o     Preallocated Float array (if rectype is 2)
 *    nflt             i     The allocated record total length
-*    doublev          o     Preallocated Double array (if rectype is 3)
+*    doublev          o     Preallocated Double array (if rectype is 3, or any
+*                           rectype for the _dbl variant)
 *    ndbl             i     The allocated record total length if double
 *
 * RETURNS:
@@ -44,128 +54,175 @@
 ***************************************************************************************
 */
 
-int
-grd3d_read_eclrecord(FILE *fc,
-                     long recstart,
-                     int rectype,
-                     int *intv,
-                     long nint,
-                     float *floatv,
-                     long nflt,
-                     double *doublev,
-                     long ndbl)
+/* read record values into result; as double if todouble, otherwise native type */
+static long
+_read_ecl_blocks(FILE *fc,
+                 long recstart,
+                 int rectype,
+                 long reclength,
+                 void *result,
+                 int todouble)
 {
-
     const int FAIL = -99;
-    int ic, ier, myint, ftn1, ftn2, ftn_reclen = 0, nr, swap = 0;
-    float myfloat;
-    double mydouble;
-    long reclength = 0, nrecs, icc;
-
-    logger_info(LI, FI, FU, "Read binary ECL record from record position %ld",
-                recstart);
+    int ftn1, ftn2;
+    long icc = 0;
 
-    if (x_swap_check() == 1)
-        swap = 1;
+    int swap = (x_swap_check() == 1) ? 1 : 0;
 
-    if (fc == NULL)
-        logger_critical(LI, FI, FU, "Cannot use file (NULL pointer)");
+    size_t nbyte = (rectype == 3) ? 8 : 4;
+    size_t rbyte = todouble ? 8 : nbyte;
 
-    if (rectype == 1)
-        reclength = nint;
-    if (rectype == 2)
-        reclength = nflt;
-    if (rectype == 3)
-        reclength = ndbl;
-    if (rectype == 5)
-        reclength = nint; /* LOGI */
+    unsigned char *scratch = NULL;
+    size_t nscratch = 0;
 
-    /* go to file position */
-    ier = fseek(fc, recstart + 24, SEEK_SET); /* record header is 24 bytes */
+    if (fc == NULL) {
+        logger_error(LI, FI, FU, "Cannot use file (NULL pointer)");
+        return FAIL;
+    }
 
-    if (ier != 0) {
+    /* go to file position; record header is 24 bytes */
+    if (fseek(fc, recstart + 24, SEEK_SET) != 0) {
         logger_error(LI, FI, FU, "Could not set FSEEK position");
+        return FAIL;
     }
 
-    nrecs = reclength;
-
-    icc = 0;
-
-    while (nrecs > 0) {
+    while (icc < reclength) {
         if (fread(&ftn1, 4, 1, fc) != 1)
-            return FAIL;
+            break;
         if (swap)
             SWAP_INT(ftn1);
 
-        if (rectype == 1)
-            ftn_reclen = (ftn1 / sizeof(int));
-        if (rectype == 2)
-            ftn_reclen = (ftn1 / sizeof(float));
-        if (rectype == 3)
-            ftn_reclen = (ftn1 / sizeof(double));
-        if (rectype == 5)
-            ftn_reclen = (ftn1 / sizeof(int));
-
-        if (ftn_reclen < nrecs) {
-            nr = ftn_reclen;
-        } else {
-            nr = nrecs;
+        /* a block must hold a whole number of values, and fit in what is left */
+        if (ftn1 <= 0 || ftn1 % (long)nbyte != 0 ||
+            ftn1 / (long)nbyte > reclength - icc) {
+            logger_error(LI, FI, FU, "Invalid Fortran block length %d (%ld of %ld)",
+                         ftn1, icc, reclength);
+            break;
         }
-
-        /* read actual values with in the fortran block */
-        for (ic = 0; ic < nr; ic++) {
-            if (rectype == 1) {
-                ier = fread(&myint, 4, 1, fc);
-                if (ier != 1)
-                    return FAIL;
-                if (swap)
-                    SWAP_INT(myint);
-                intv[icc++] = myint;
-            } else if (rectype == 2) {
-                ier = fread(&myfloat, 4, 1, fc);
-                if (ier != 1)
-                    return FAIL;
-                if (swap)
-                    SWAP_FLOAT(myfloat);
-                floatv[icc++] = myfloat;
-            } else if (rectype == 3) {
-                ier = fread(&mydouble, 8, 1, fc);
-                if (ier != 1)
-                    return FAIL;
-                if (swap)
-                    SWAP_DOUBLE(mydouble);
-                doublev[icc++] = mydouble;
-            } else if (rectype == 5) {
-                /* LOGI is actually stored as INT, 0 forFalse, -1 for True */
-                ier = fread(&myint, 4, 1, fc);
-                if (ier != 1)
-                    return FAIL;
-                if (swap)
-                    SWAP_INT(myint);
-                myint *= -1; /* store True as 1 */
-                intv[icc++] = myint;
+        long nr = ftn1 / (long)nbyte;
+
+        unsigned char *dest = (unsigned char *)result + icc * rbyte;
+        if (rbyte != nbyte) {
+            /* widening: read the block into a scratch buffer first */
+            if ((size_t)nr * nbyte > nscratch) {
+                nscratch = (size_t)nr * nbyte;
+                unsigned char *tmp = realloc(scratch, nscratch);
+                if (tmp == NULL)
+                    break;
+                scratch = tmp;
             }
+            dest = scratch;
         }
 
-        /* end of record integer: */
+        if (fread(dest, nbyte, nr, fc) != (size_t)nr)
+            break;
+        if (swap)
+            x_swap_block(dest, nbyte, nr);
+
         if (fread(&ftn2, 4, 1, fc) != 1)
-            return FAIL;
+            break;
         if (swap)
             SWAP_INT(ftn2);
         if (ftn1 != ftn2)
-            return FAIL;
+            break;
+
+        if (rbyte != nbyte) {
+            double *dv = (double *)result + icc;
+            long i;
+            if (rectype == 2) {
+                float *fv = (float *)scratch;
+                for (i = 0; i < nr; i++)
+                    dv[i] = fv[i];
+            } else {
+                int *iv = (int *)scratch;
+                for (i = 0; i < nr; i++)
+                    dv[i] = iv[i];
+            }
+        }
 
-        /* remaining record length: */
-        nrecs = nrecs - ftn_reclen;
+        icc += nr;
     }
 
+    free(scratch);
+
     if (icc != reclength) {
         logger_error(LI, FI, FU,
                      "Something is wrong with record lengths... "
-                     "icc=%d, reclength=%d",
+                     "icc=%ld, reclength=%ld",
                      icc, reclength);
         return FAIL;
     }
 
-    return (icc);
+    return icc;
+}
+
+int
+grd3d_read_eclrecord(FILE *fc,
+                     long recstart,
+                     int rectype,
+                     int *intv,
+                     long nint,
+                     float *floatv,
+                     long nflt,
+                     double *doublev,
+                     long ndbl)
+{
+    long reclength = 0, icc = 0, i;
+    void *result = NULL;
+
+    logger_info(LI, FI, FU, "Read binary ECL record from record position %ld",
+                recstart);
+
+    if (rectype == 1 || rectype == 5) {
+        reclength = nint;
+        result = intv;
+    } else if (rectype == 2) {
+        reclength = nflt;
+        result = floatv;
+    } else if (rectype == 3) {
+        reclength = ndbl;
+        result = doublev;
+    }
+
+    if (result == NULL)
+        return -99;
+
+    double xprof_t0 = x_prof_tic();
+    icc = _read_ecl_blocks(fc, recstart, rectype, reclength, result, 0);
+    x_prof_toc(FU, xprof_t0, icc);
+
+    if (rectype == 5) {
+        /* LOGI is actually stored as INT, 0 for False, -1 for True; True as 1 */
+        for (i = 0; i < icc; i++)
+            intv[i] *= -1;
+    }
+
+    return (int)icc;
+}
+
+int
+grd3d_read_eclrecord_dbl(FILE *fc,
+                         long recstart,
+                         int rectype,
+                         double *doublev,
+                         long ndbl)
+{
+    long icc, i;
+
+    logger_info(LI, FI, FU, "Read binary ECL record as double from position %ld",
+                recstart);
+
+    if (rectype != 1 && rectype != 2 && rectype != 3 && rectype != 5)
+        return -99;
+
+    double xprof_t0 = x_prof_tic();
+    icc = _read_ecl_blocks(fc, recstart, rectype, ndbl, doublev, rectype != 3);
+    x_prof_toc(FU, xprof_t0, icc);
+
+    if (rectype == 5) {
+        for (i = 0; i < icc; i++)
+            doublev[i] *= -1;
+    }
+
+    return (int)icc;
 }
@@ -3,7 +3,7 @@
  *
  * NAME:
  *    grd3d_scan_eclbinary.c
- *
+ *    grd3d_scan_eclbinary_from
  *
  * DESCRIPTION:
  *    Quick scan Eclipse output (GRID/EGRID/INIT/UNRST...) and return:
@@ -14,6 +14,12 @@
  *
  *    This is the format for GRID, EGRID, INIT and restart files.
  *
+ *    The grd3d_scan_eclbinary_from() variant starts at a given byte position, and
+ *    will stop before an incomplete last record (i.e. a record that extends beyond
+ *    end of file). It is used for scanning in chunks, and for incremental scanning
+ *    of files that are still being written. A record which is invalid (e.g. wrong
+ *    Fortran record markers or unknown type) is an error.
+ *
  *    'INTEHEAD'         200 'INTE'
  *    -1617152669        9701           2       -2345       -2345       -2345
  *          -2345       -2345          20          15           8        1639
@@ -38,10 +44,13 @@
  *    reclengths      o     An array with record lengths (no of elements)
  *    recstarts       o     An array with record starts (in bytes)
  *    maxkw           i     Max number of kwords (allocated length of arrays)
- *    debug           i     Debug level
+ *    startpos        i     Byte position to start from (_from variant)
+ *    endpos          o     Byte position after last complete record (_from variant)
  *
  * RETURNS:
- *    Function: Number of keywords read. If problems, a negative value
+ *    Function: Number of keywords read. If problems, a negative value (-2 if
+ *    maxkw is exceeded). The _from variant returns number of keywords read, or -1
+ *    if an invalid record is met; endpos is then the start of that record.
  *    Resulting vectors
  *
  * TODO/ISSUES/BUGS:
@@ -53,60 +62,62 @@
 
 #include "libxtg.h"
 #include "libxtg_.h"
+#include "logger.h"
 
 /* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  * local function(s)
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  */
 
-int
+static int
 _scan_ecl_bin_record(FILE *fc,
+                     int swap,
+                     long filesize,
                      char *cname,
                      int *cntype,
                      long *rnlen,
                      long npos1,
                      long *npos2)
 {
-    int swap = 0;
-    int ftn, ier, doread, rlen, nbyte, nval;
+    int ftn, ftn2, rlen, nbyte;
+    long nval;
     const int FAIL = -88;
+    const int INCOMPLETE = -77;
     char ctype[5] = "NNNN";
     long ncum = 0;
 
-    if (x_swap_check() == 1)
-        swap = 1;
-
-    /* read the description line, as e.g.:
+    /* read the description line in one go, as e.g.:
        [<16>'CORNERS '          24 'REAL'<16>] where <16> are 4 byte int
        determining record length, here (8+4+4 = 16 bytes)
     */
 
-    ier = fread(&ftn, 4, 1, fc);
+    unsigned char head[24];
+    size_t nhead = fread(head, 1, 24, fc);
 
-    if (ier != 1) {
-        if (ier == 0)
-            return EOF;
-        if (ier == EOF)
-            return EOF;
-        if (ier != EOF)
-            return FAIL;
-    }
+    if (nhead == 0)
+        return EOF;
+    if (nhead != 24)
+        return INCOMPLETE;
 
-    if (swap)
+    /* the header is one Fortran record of 16 bytes */
+    memcpy(&ftn, head, 4);
+    memcpy(&ftn2, head + 20, 4);
+    if (swap) {
         SWAP_INT(ftn);
+        SWAP_INT(ftn2);
+    }
+    if (ftn != 16 || ftn2 != 16)
+        return FAIL;
 
     /* read keyword, arraylength and type */
-    if ((ier = fread(cname, 8, 1, fc)) != 1)
-        return FAIL;
+    memcpy(cname, head + 4, 8);
     cname[8] = '\0';
 
-    if ((ier = fread(&rlen, 4, 1, fc)) != 1)
-        return FAIL;
+    memcpy(&rlen, head + 12, 4);
     if (swap)
         SWAP_INT(rlen);
 
-    if ((ier = fread(ctype, 4, 1, fc)) != 1)
-        return FAIL;
+    memcpy(ctype, head + 16, 4);
     ctype[4] = '\0';
 
     *cntype = -1;
@@ -123,15 +134,16 @@ _scan_ecl_bin_record(FILE *fc,
     if (strcmp(ctype, "MESS") == 0)
         *cntype = 6;
 
-    if (*cntype == -1)
+    if (*cntype == -1 || rlen < 0)
         return FAIL;
 
-    ier = fread(&ftn, 4, 1, fc);
-    if (swap)
-        SWAP_INT(ftn);
-
-    if (ier != 1)
-        return FAIL;
+    nbyte = 4;
+    if (*cntype > 2)
+        nbyte = 8;
+    if (*cntype == 5)
+        nbyte = 1;
+    if (*cntype == 6)
+        nbyte = 4; /* MESS, correct?? */
 
     /*
      * Report the end byte position of this record. The challenge is that
@@ -140,32 +152,27 @@ _scan_ecl_bin_record(FILE *fc,
      */
     ncum = npos1 + 4 + 8 + 4 + 4 + 4; /* [ftn KEYWORD nlen TYPE ftn] */
 
-    doread = rlen;
     nval = 0;
-    while (doread) {
+    while (nval < rlen) {
         if (fread(&ftn, 4, 1, fc) != 1)
-            return FAIL;
+            return INCOMPLETE;
         if (swap)
             SWAP_INT(ftn);
 
-        nbyte = 4;
-        if (*cntype > 2)
-            nbyte = 8;
-        if (*cntype == 5)
-            nbyte = 1;
-        if (*cntype == 6)
-            nbyte = 4; /* MESS, correct?? */
+        if (ftn <= 0)
+            return FAIL;
 
         ncum = ncum + ftn + 4 + 4;
 
+        /* a record which is not complete (e.g. a file being written) */
+        if (ncum > filesize)
+            return INCOMPLETE;
+
         if (fseek(fc, ncum, SEEK_SET) != 0)
             return FAIL;
 
         /* count used amount of the array length */
         nval += ftn / nbyte;
-
-        if (nval >= rlen)
-            doread = 0;
     }
 
     *npos2 = ncum;
@@ -175,55 +182,98 @@ _scan_ecl_bin_record(FILE *fc,
 }
 
 long
-grd3d_scan_eclbinary(FILE *fc,
-                     char *keywords,
-                     int *rectypes,
-                     long *reclengths,
-                     long *recstarts,
-                     long maxkw)
+grd3d_scan_eclbinary_from(FILE *fc,
+                          long startpos,
+                          char *keywords,
+                          int *rectypes,
+                          long *reclengths,
+                          long *recstarts,
+                          long maxkw,
+                          long *endpos)
 {
+    double xprof_t0 = x_prof_tic();
+
+    /*
+     * Scan from startpos, which must be the start of a record (or end of file), and
+     * stop at end of file or when maxkw keywords are found. A last record which is
+     * incomplete is not included. The endpos is the byte position after the last
+     * record included, i.e. the startpos for a continued scan.
+     */
 
     char cname[9] = "unset";
-    int ios, cntype;
+    int ios = 0, cntype;
     long i = 0, npos1, npos2, rnlen;
-    const int FAIL = -99;
-    const int _FAIL = -88;
+    const int FAIL = -88;
+    const int INCOMPLETE = -77;
 
-    npos1 = 0;
+    int swap = (x_swap_check() == 1) ? 1 : 0;
 
-    ios = 0;
+    fseek(fc, 0, SEEK_END);
+    long filesize = ftell(fc);
 
     keywords[0] = '\0';
+    char *kwend = keywords;
 
-    rewind(fc);
+    npos1 = startpos;
+    *endpos = startpos;
 
-    while (ios == 0) {
-        ios = _scan_ecl_bin_record(fc, cname, &cntype, &rnlen, npos1, &npos2);
+    if (fseek(fc, startpos, SEEK_SET) != 0)
+        return -1;
+
+    while (i < maxkw) {
+        ios = _scan_ecl_bin_record(fc, swap, filesize, cname, &cntype, &rnlen, npos1,
+                                   &npos2);
 
         if (ios != 0)
             break;
 
-        strcat(keywords, cname);
-        strcat(keywords, "|");
+        /* append to keywords at end pointer; strcat will be O(n^2) */
+        memcpy(kwend, cname, 8);
+        kwend[8] = '|';
+        kwend += 9;
 
         reclengths[i] = rnlen;
         rectypes[i] = cntype;
         recstarts[i] = npos1;
 
-        if (i >= maxkw) {
-            return -2;
-        }
-
         i++;
         npos1 = npos2;
+        *endpos = npos2;
     }
 
-    if (ios == FAIL || ios == _FAIL) {
-        return -1;
+    if (ios == INCOMPLETE) {
+        logger_warn(LI, FI, FU, "Incomplete record at byte %ld", npos1);
+    } else if (ios == FAIL) {
+        logger_error(LI, FI, FU, "Invalid record at byte %ld", npos1);
+        i = -1;
     }
 
     /* remove last | */
-    keywords[strlen(keywords) - 1] = 0;
+    if (kwend > keywords)
+        kwend--;
+    *kwend = '\0';
+
+    x_prof_toc(FU, xprof_t0, i);
+    return i;
+}
+
+long
+grd3d_scan_eclbinary(FILE *fc,
+                     char *keywords,
+                     int *rectypes,
+                     long *reclengths,
+                     long *recstarts,
+                     long maxkw)
+{
+    long endpos;
+    long nkeys = grd3d_scan_eclbinary_from(fc, 0, keywords, rectypes, reclengths,
+                                           recstarts, maxkw, &endpos);
+
+    /* as before, fail if the file was not scanned to the end */
+    fseek(fc, 0, SEEK_END);
+    if (endpos != ftell(fc)) {
+        return (nkeys >= maxkw) ? -2 : -1;
+    }
 
-    return (i); /* return number of actual keywords */
+    return nkeys; /* return number of actual keywords */
 }
@@ -16,6 +16,9 @@
  *    actnumsv           i     Grid ACTNUM parameter
  *    p_zcorn_onelay_v   i     Grid Z corners, top bot only
  *    p_actnum_onelay_v  i     Grid ACTNUM parameter top bot only
+ *    colbox             i     Cell index; bounding box per column
+ *    binstart, bincells i     Cell index; columns per bin
+ *    xmin..nby          i     Cell index; bin layout (cf. grd3d_cellindex.c)
  *    nval               i     Position of last point for well log
  *    p_utme_v           i     East coordinate vector for well log
  *    p_utmn_v           i     North coordinate vector for well log
@@ -43,6 +46,59 @@
 
 #define DEBUG 0
 
+/*
+ * Find the cell for a point when the (local) search around the start cell
+ * failed, using the cell index to get candidate columns (into cols, which has
+ * room for maxcols). The columns are then searched in the onelayer grid first
+ * and then along K in the full grid.
+ */
+
+static long
+_search_by_index(double xcor,
+                 double ycor,
+                 double zcor,
+                 int nx,
+                 int ny,
+                 int nz,
+                 double *coordsv,
+                 double *zcornsv,
+                 double *p_zcorn_onelay_v,
+                 double *colbox,
+                 int *binstart,
+                 int *bincells,
+                 double xmin,
+                 double ymin,
+                 double xbin,
+                 double ybin,
+                 int nbx,
+                 int nby,
+                 int *cols,
+                 int maxcols)
+{
+    int ncols = grd3d_cellindex_lookup(xcor, ycor, zcor, colbox, xmin, ymin, xbin, ybin,
+                                       nbx, nby, binstart, bincells, cols, maxcols);
+
+    int nc;
+    for (nc = 0; nc < ncols; nc++) {
+        int i = cols[nc] % nx + 1;
+        int j = cols[nc] / nx + 1;
+        double corners[24];
+
+        grd3d_corners(i, j, 1, nx, ny, 1, coordsv, 0, p_zcorn_onelay_v, 0, corners);
+        if (x_chk_point_in_cell(xcor, ycor, zcor, corners, 1) <= 0)
+            continue;
+
+        int k;
+        for (k = 1; k <= nz; k++) {
+            grd3d_corners(i, j, k, nx, ny, nz, coordsv, 0, zcornsv, 0, corners);
+            if (x_chk_point_in_cell(xcor, ycor, zcor, corners, 1) > 0) {
+                return x_ijk2ib(i, j, k, nx, ny, nz, 0);
+            }
+        }
+    }
+    return -1;
+}
+
 int
 grd3d_well_ijk(int nx,
                int ny,
@@ -60,6 +116,19 @@ grd3d_well_ijk(int nx,
                int *p_actnum_onelay_v,
                long nactonein,
 
+               double *colbox,
+               long ncolbox,
+               int *binstart,
+               long nbinstart,
+               int *bincells,
+               long nbincells,
+               double xmin,
+               double ymin,
+               double xbin,
+               double ybin,
+               int nbx,
+               int nby,
+
                int nval,
                double *p_utme_v,
                double *p_utmn_v,
@@ -82,6 +151,14 @@ grd3d_well_ijk(int nx,
     double zconst = 0.000001;
     grd3d_make_z_consistent(nx, ny, nz, zcornsv, 0, zconst);
 
+    /* candidate columns buffer for the cell index, sized for the largest bin */
+    int maxcols = grd3d_cellindex_maxcols(nbx, nby, binstart);
+    int *cols = malloc(maxcols * sizeof(int));
+    if (cols == NULL) {
+        logger_error(LI, FI, FU, "Cannot allocate column buffer in %s", FU);
+        return EXIT_FAILURE;
+    }
+
     /*
      * ========================================================================
      * Need to loop through each well point and sample zonelog from grid
@@ -98,8 +175,8 @@ grd3d_well_ijk(int nx,
     /* initial search options in grd3d_point_in_cell */
     int maxradsearch = 5;
     int nradsearch;
-    int sflag = 1; /* SFLAG=1 means that search shall take full grid as a last
-                      attempt */
+    int sflag = 0; /* SFLAG=0 means no full grid search as a last attempt; the
+                      cell index is applied instead */
 
     int mnum;
     int icol = 0, jrow = 0, klay = 0;
@@ -125,11 +202,21 @@ grd3d_well_ijk(int nx,
                                        coordsv, p_zcorn_onelay_v, p_actnum_onelay_v,
                                        maxradsearch, sflag, &nradsearch, 0);
 
+        long ib2 = -1;
         if (ib1 >= 0) {
             outside = 0;
             ibstart2 = ib1;
         } else {
+            /* not near the previous point; use the cell index */
+            ib2 = _search_by_index(xcor, ycor, zcor, nx, ny, nz, coordsv, zcornsv,
+                                   p_zcorn_onelay_v, colbox, binstart, bincells, xmin,
+                                   ymin, xbin, ybin, nbx, nby, cols, maxcols);
             outside = -777;
+            if (ib2 >= 0) {
+                outside = 0;
+                x_ib2ijk(ib2, &icol, &jrow, &klay, nx, ny, nz, 0);
+                ibstart2 = x_ijk2ib(icol, jrow, 1, nx, ny, 1, 0);
+            }
         }
 
         logger_info(LI, FI, FU, "Check grid envelope DONE, outside status: %d",
@@ -139,10 +226,17 @@ grd3d_well_ijk(int nx,
 
         if (outside == 0) {
 
-            /* loop cells in full grid */
-            long ib2 = grd3d_point_in_cell(ibstart, 0, xcor, ycor, zcor, nx, ny, nz,
-                                           coordsv, zcornsv, actnumsv, maxradsearch,
-                                           sflag, &nradsearch, 0);
+            /* loop cells in full grid, near the start cell, then by cell index */
+            if (ib2 < 0) {
+                ib2 = grd3d_point_in_cell(ibstart, 0, xcor, ycor, zcor, nx, ny, nz,
+                                          coordsv, zcornsv, actnumsv, maxradsearch,
+                                          sflag, &nradsearch, 0);
+            }
+            if (ib2 < 0) {
+                ib2 = _search_by_index(xcor, ycor, zcor, nx, ny, nz, coordsv, zcornsv,
+                                       p_zcorn_onelay_v, colbox, binstart, bincells,
+                                       xmin, ymin, xbin, ybin, nbx, nby, cols, maxcols);
+            }
 
             if (ib2 >= 0) {
 
@@ -164,6 +258,8 @@ grd3d_well_ijk(int nx,
         }
     }
 
+    free(cols);
+
     logger_info(LI, FI, FU, "Exit from %s", FU);
     return EXIT_SUCCESS;
 }
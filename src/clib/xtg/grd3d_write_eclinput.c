@@ -10,6 +10,10 @@
 
 #include "libxtg.h"
 #include "libxtg_.h"
+#include "logger.h"
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
 
 /*
  ******************************************************************************
@@ -25,6 +29,14 @@
  *    This is the format for DATA files. The input fmt is not checked
  *    for inconsistencies.
  *
+ *    Runs of equal values are written with Eclipse repeat notation, e.g.
+ *    4*0 5*1 instead of 0 0 0 0 1 1 1 1 1. A repeat counts as one column.
+ *
+ *    The text is formatted into a large buffer which is written in blocks.
+ *    Simple formats ("%8.2f", "%d" etc., with leading spaces) are formatted
+ *    directly from integer arithmetics, giving the same result as printf();
+ *    other formats (e.g. "%e") use snprintf().
+ *
  * ARGUMENTS:
  *    fc               i     Filehandle (file must be open)
  *    recname          i     Name of record to write
@@ -40,14 +52,141 @@
  *    Function: EXIT_SUCCESS upon success
  *
  * TODO/ISSUES/BUGS:
- *    - Some clever type cast may simplify?
- *    - Compressed formats, such as 4*0 5*1 instead of 0 0 0 0 1 1 1 1 1
  *
  * LICENCE:
  *    CF XTGeo
  ******************************************************************************
  */
 
+#define ECLINPUT_BUFSIZE 4194304
+#define ECLINPUT_MAXITEM 128
+
+static const double pow10tab[] = { 1e0, 1e1, 1e2,  1e3,  1e4,  1e5,  1e6, 1e7,
+                                   1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14 };
+
+/*
+ * the format as parsed; simple is 1 if on form <spaces>%[width][.prec](f|d), and
+ * the item then fits in ECLINPUT_MAXITEM. The nspace is limited to half of that,
+ * as it is also used for separating repeated values (N*value)
+ */
+struct _eclfmt
+{
+    int simple;
+    int nspace;
+    int width;
+    int prec;
+    char conv;
+};
+
+static void
+_parse_fmt(const char *fmt, struct _eclfmt *efmt)
+{
+    const char *p = fmt;
+
+    efmt->simple = 0;
+    efmt->nspace = 0;
+    efmt->width = 0;
+    efmt->prec = 6;
+
+    int nspace = 0;
+    while (*p == ' ') {
+        nspace++;
+        p++;
+    }
+    efmt->nspace = nspace < ECLINPUT_MAXITEM / 2 ? nspace : ECLINPUT_MAXITEM / 2;
+    if (*p++ != '%')
+        return;
+
+    while (*p >= '0' && *p <= '9')
+        efmt->width = efmt->width * 10 + (*p++ - '0');
+
+    if (*p == '.') {
+        p++;
+        efmt->prec = 0;
+        while (*p >= '0' && *p <= '9')
+            efmt->prec = efmt->prec * 10 + (*p++ - '0');
+    }
+
+    efmt->conv = *p++;
+    if ((efmt->conv == 'f' || efmt->conv == 'd') && *p == '\0' &&
+        nspace < ECLINPUT_MAXITEM / 2 && efmt->width < ECLINPUT_MAXITEM / 2 &&
+        efmt->prec <= 14)
+        efmt->simple = 1;
+}
+
+/* write unsigned integer digits backwards from end; return start */
+static char *
+_utoa_rev(char *end, uint64_t value)
+{
+    do {
+        *--end = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    return end;
+}
+
+/* format one value according to fmt into out; return length */
+static int
+_format_value(char *out, const char *fmt, const struct _eclfmt *efmt, double value,
+              int isint)
+{
+    char tmp[ECLINPUT_MAXITEM];
+    char *end = tmp + ECLINPUT_MAXITEM;
+    char *start;
+    int negative = 0;
+
+    if (efmt->simple && efmt->conv == 'd' && isint) {
+        long ival = (long)value;
+        negative = ival < 0;
+        start = _utoa_rev(end, negative ? (uint64_t)(-ival) : (uint64_t)ival);
+    } else if (efmt->simple && efmt->conv == 'f' && !isint && isfinite(value) &&
+               fabs(value) * pow10tab[efmt->prec] < 4.0e15) {
+        double scaled = fabs(value) * pow10tab[efmt->prec];
+        double fl = floor(scaled);
+
+        /* close to a tie the exact binary value decides; leave that to printf */
+        if (fabs(scaled - fl - 0.5) < 1.0e-12 * (scaled > 1.0 ? scaled : 1.0))
+            return snprintf(out, ECLINPUT_MAXITEM, fmt, value);
+
+        uint64_t n = (uint64_t)fl + (scaled - fl > 0.5 ? 1 : 0);
+        negative = signbit(value) != 0;
+        start = end;
+        if (efmt->prec > 0) {
+            int i;
+            for (i = 0; i < efmt->prec; i++) {
+                *--start = (char)('0' + n % 10);
+                n /= 10;
+            }
+            *--start = '.';
+        }
+        start = _utoa_rev(start, n);
+    } else if (isint) {
+        return snprintf(out, ECLINPUT_MAXITEM, fmt, (int)value);
+    } else {
+        return snprintf(out, ECLINPUT_MAXITEM, fmt, value);
+    }
+
+    if (negative)
+        *--start = '-';
+    while (end - start < efmt->width)
+        *--start = ' ';
+
+    memset(out, ' ', efmt->nspace);
+    memcpy(out + efmt->nspace, start, end - start);
+    return efmt->nspace + (int)(end - start);
+}
+
+/* get value as double (exact for int and float); undefined values are 0 */
+static inline double
+_value_at(int rectype, int *intv, float *floatv, double *doublev, long icc)
+{
+    if (rectype == 1)
+        return intv[icc] > UNDEF_INT_LIMIT ? 0.0 : intv[icc];
+    if (rectype == 2)
+        return floatv[icc] > UNDEF_LIMIT ? 0.0 : floatv[icc];
+    return doublev[icc] > UNDEF_LIMIT ? 0.0 : doublev[icc];
+}
+
 int
 grd3d_write_eclinput(FILE *fc,
                      char *recname,
@@ -59,61 +198,71 @@ grd3d_write_eclinput(FILE *fc,
                      char *fmt,
                      int ncolumns)
 {
+    double xprof_t0 = x_prof_tic();
 
     int icwrap = 0;
-    long icc = 0;
+    long icc = 0, nrep;
+    size_t pos = 0;
+    struct _eclfmt efmt;
+    char item[ECLINPUT_MAXITEM];
+
+    char *buf = malloc(ECLINPUT_BUFSIZE);
+    if (buf == NULL)
+        return EXIT_FAILURE;
+
+    _parse_fmt(fmt, &efmt);
 
     fprintf(fc, "%-8s\n", recname);
 
-    if (rectype == 1) {
-        icwrap = 0;
-        for (icc = 0; icc < nrecs; icc++) {
-            int itmp = intv[icc];
-            if (itmp > UNDEF_INT_LIMIT)
-                itmp = 0;
-            fprintf(fc, fmt, itmp);
-            icwrap++;
-            if (icwrap >= ncolumns) {
-                fprintf(fc, "\n");
-                icwrap = 0;
-            }
+    while (icc < nrecs) {
+        /* the value, and how many times it is repeated */
+        double value = _value_at(rectype, intv, floatv, doublev, icc);
+        nrep = 1;
+        while (icc + nrep < nrecs &&
+               _value_at(rectype, intv, floatv, doublev, icc + nrep) == value)
+            nrep++;
+
+        int len = _format_value(item, fmt, &efmt, value, rectype == 1);
+        if (len >= ECLINPUT_MAXITEM)
+            len = ECLINPUT_MAXITEM - 1;
+
+        if (nrep > 1) {
+            /* repeat notation; N*value must be without spaces */
+            int skip = 0;
+            while (skip < len && item[skip] == ' ')
+                skip++;
+            int nsp = efmt.nspace > 0 ? efmt.nspace : 1;
+            memset(buf + pos, ' ', nsp);
+            pos += nsp;
+            pos += sprintf(buf + pos, "%ld*", nrep);
+            memcpy(buf + pos, item + skip, len - skip);
+            pos += len - skip;
+        } else {
+            memcpy(buf + pos, item, len);
+            pos += len;
         }
-    }
+        icc += nrep;
 
-    if (rectype == 2) {
-        icwrap = 0;
-        for (icc = 0; icc < nrecs; icc++) {
-            float ftmp = floatv[icc];
-            if (ftmp > UNDEF_LIMIT)
-                ftmp = 0.0;
-            fprintf(fc, fmt, ftmp);
-            icwrap++;
-            if (icwrap >= ncolumns) {
-                fprintf(fc, "\n");
-                icwrap = 0;
-            }
+        icwrap++;
+        if (icwrap >= ncolumns) {
+            buf[pos++] = '\n';
+            icwrap = 0;
         }
-    }
 
-    if (rectype == 3) {
-        icwrap = 0;
-        for (icc = 0; icc < nrecs; icc++) {
-            double dtmp = doublev[icc];
-            if (dtmp > UNDEF_LIMIT)
-                dtmp = 0.0;
-            fprintf(fc, fmt, dtmp);
-            icwrap++;
-            if (icwrap >= ncolumns) {
-                fprintf(fc, "\n");
-                icwrap = 0;
-            }
+        if (pos > ECLINPUT_BUFSIZE - 2 * ECLINPUT_MAXITEM) {
+            fwrite(buf, 1, pos, fc);
+            pos = 0;
         }
     }
 
+    fwrite(buf, 1, pos, fc);
+    free(buf);
+
     if (icwrap == 0)
         fprintf(fc, "/\n\n");
     if (icwrap > 0)
         fprintf(fc, "\n/\n\n");
 
+    x_prof_toc(FU, xprof_t0, nrecs);
     return EXIT_SUCCESS;
 }
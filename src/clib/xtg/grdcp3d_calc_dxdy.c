@@ -0,0 +1,110 @@
+/*
+ ***************************************************************************************
+ *
+ * NAME:
+ *    grdcp3d_calc_dxdy.c
+ *
+ * DESCRIPTION:
+ *    Computes the DX DY avg per cell, xtgformat=2 version of grd3d_calc_dxdy()
+ *
+ * ARGUMENTS:
+ *    ncol..nlay     i     Dimensions
+ *    coordsv        i     Coordinates (with size)
+ *    zcornsv        i     Z corners (with size)
+ *    actnumsv       i     ACTNUM (with size)
+ *    dx            i/o    Array to be updated
+ *    dy            i/o    Array to be updated
+ *    option1        i     If 1, set dx dy to UNDEF for inactive cells
+ *    option2        i     Unused
+ *
+ * RETURNS:
+ *    Success (0) or failure. Pointers to arrays are updated
+ *
+ * NOTES:
+ *    The returned arrays are C order, as in grd3d_calc_dxdy()
+ *
+ * LICENCE:
+ *    cf. XTGeo LICENSE
+ ***************************************************************************************
+ */
+
+#include "libxtg.h"
+#include "libxtg_.h"
+#include "logger.h"
+
+int
+grdcp3d_calc_dxdy(long ncol,
+                  long nrow,
+                  long nlay,
+                  double *coordsv,
+                  long ncoord,
+                  float *zcornsv,
+                  long nzcorn,
+                  int *actnumsv,
+                  long nactnum,
+                  double *dx,
+                  long ndx,
+                  double *dy,
+                  long ndy,
+                  int option1,
+                  int option2)
+
+{
+    logger_info(LI, FI, FU, "Compute DX DY...");
+
+    long ntot = ncol * nrow * nlay;
+    if (nactnum != ntot || ndx != ntot || ndy != ntot)
+        logger_critical(LI, FI, FU, "Bug: Errors in array lengths checks in %s", FU);
+
+    if (option2 == 0)
+        logger_debug(LI, FI, FU, "Option2 not in use");
+
+    long i, j, k;
+    for (i = 0; i < ncol; i++) {
+        for (j = 0; j < nrow; j++) {
+            for (k = 0; k < nlay; k++) {
+
+                long ic = i * nrow * nlay + j * nlay + k;
+
+                if (option1 == 1 && actnumsv[ic] == 0) {
+                    dx[ic] = UNDEF;
+                    dy[ic] = UNDEF;
+                    continue;
+                }
+
+                double c[24];
+                grdcp3d_corners(i, j, k, ncol, nrow, nlay, coordsv, ncoord, zcornsv,
+                                nzcorn, c);
+
+                double plen, vlen, arad, adeg;
+                int n, ii;
+
+                /* get the length of all lines forming DX */
+                plen = 0.0;
+                for (n = 0; n <= 3; n++) {
+                    ii = 0 + n * 6;
+                    x_vector_info2(c[ii], c[ii + 3], c[ii + 1], c[ii + 4], &vlen, &arad,
+                                   &adeg, 1);
+                    plen = plen + vlen;
+                }
+                dx[ic] = plen / 4.0;
+
+                /* get the length of all lines forming DY */
+                plen = 0.0;
+                for (n = 0; n <= 3; n++) {
+                    ii = 0 + n * 3;
+                    if (n >= 2)
+                        ii = 6 + n * 3;
+
+                    x_vector_info2(c[ii], c[ii + 6], c[ii + 1], c[ii + 7], &vlen, &arad,
+                                   &adeg, 1);
+                    plen = plen + vlen;
+                }
+                dy[ic] = plen / 4.0;
+            }
+        }
+    }
+
+    logger_info(LI, FI, FU, "Compute DX DY... done");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,117 @@
+/*
+ ***************************************************************************************
+ *
+ * NAME:
+ *    grdcp3d_cellindex_colbox.c
+ *
+ * DESCRIPTION:
+ *    Bounding box per grid column for the cell index, cf. grd3d_cellindex.c. This
+ *    is the xtgformat=2 version of grd3d_cellindex_colbox(); the result is given
+ *    in the same column order, ic = i + j * ncol (base 0), so that the other cell
+ *    index routines can be applied for both formats.
+ *
+ * ARGUMENTS:
+ *    ncol,nrow,nlay   i     Grid dimensions
+ *    coordsv          i     Grid COORD, xtgformat=2
+ *    zcornsv          i     Grid ZCORN, xtgformat=2
+ *    colbox           o     Bounding box per column, 6 * ncol * nrow values as
+ *                           xmin, xmax, ymin, ymax, zmin, zmax
+ *
+ * RETURNS:
+ *    Function status, EXIT_SUCCESS or EXIT_FAILURE; update colbox
+ *
+ * TODO/ISSUES/BUGS:
+ *
+ * LICENCE:
+ *    cf. XTGeo LICENSE
+ ***************************************************************************************
+ */
+
+#include "libxtg.h"
+#include "libxtg_.h"
+#include "logger.h"
+
+int
+grdcp3d_cellindex_colbox(long ncol,
+                         long nrow,
+                         long nlay,
+                         double *coordsv,
+                         long ncoord,
+                         float *zcornsv,
+                         long nzcorn,
+                         double *colbox,
+                         long ncolbox)
+{
+    logger_info(LI, FI, FU, "Column bounding boxes for cell index...");
+
+    if (ncolbox != 6 * ncol * nrow) {
+        logger_error(LI, FI, FU, "Wrong length of colbox in %s", FU);
+        return EXIT_FAILURE;
+    }
+
+    long nnrow = nrow + 1;
+    long nnlay = nlay + 1;
+    long nnodes = nnrow * nnlay;
+
+    long i, j;
+    for (j = 0; j < nrow; j++) {
+        for (i = 0; i < ncol; i++) {
+
+            /* z range of the column, all layers, as zcorn may be inconsistent */
+            double zmin = VERYLARGEPOSITIVE;
+            double zmax = VERYLARGENEGATIVE;
+            long k;
+            for (k = 0; k < nnlay; k++) {
+                double zval[4];
+                zval[0] = zcornsv[4 * ((i + 0) * nnodes + (j + 0) * nnlay + k) + 3];
+                zval[1] = zcornsv[4 * ((i + 1) * nnodes + (j + 0) * nnlay + k) + 2];
+                zval[2] = zcornsv[4 * ((i + 0) * nnodes + (j + 1) * nnlay + k) + 1];
+                zval[3] = zcornsv[4 * ((i + 1) * nnodes + (j + 1) * nnlay + k) + 0];
+                int n;
+                for (n = 0; n < 4; n++) {
+                    if (zval[n] < zmin)
+                        zmin = zval[n];
+                    if (zval[n] > zmax)
+                        zmax = zval[n];
+                }
+            }
+
+            /* pillars are straight lines, so XY extremes are found at zmin/zmax */
+            double *box = &colbox[6 * (j * ncol + i)];
+            box[0] = VERYLARGEPOSITIVE;
+            box[1] = VERYLARGENEGATIVE;
+            box[2] = VERYLARGEPOSITIVE;
+            box[3] = VERYLARGENEGATIVE;
+            box[4] = zmin;
+            box[5] = zmax;
+
+            int im, jm, n;
+            for (jm = 0; jm < 2; jm++) {
+                for (im = 0; im < 2; im++) {
+                    double *pil = &coordsv[6 * ((i + im) * nnrow + j + jm)];
+                    double zv[2] = { zmin, zmax };
+                    for (n = 0; n < 2; n++) {
+                        double xv = pil[0];
+                        double yv = pil[1];
+                        if (fabs(pil[5] - pil[2]) > 0.01) {
+                            xv = pil[0] - (zv[n] - pil[2]) * (pil[0] - pil[3]) /
+                                            (pil[5] - pil[2]);
+                            yv = pil[1] - (zv[n] - pil[2]) * (pil[1] - pil[4]) /
+                                            (pil[5] - pil[2]);
+                        }
+                        if (xv < box[0])
+                            box[0] = xv;
+                        if (xv > box[1])
+                            box[1] = xv;
+                        if (yv < box[2])
+                            box[2] = yv;
+                        if (yv > box[3])
+                            box[3] = yv;
+                    }
+                }
+            }
+        }
+    }
+    logger_info(LI, FI, FU, "Column bounding boxes for cell index... done");
+    return EXIT_SUCCESS;
+}
@@ -14,7 +14,13 @@
  *    zcornsv          i     Grid Z corners for input
  *    actnumsv         i     Actnum array
  *    cellvolsv        o     Array, cellvol as property
+ *    cornerscache     i     Optional precomputed cell corners (24 per cell, C order),
+ *                           cf. grdcp3d_geometry_cache(). Length 0 means computing
+ *                           corners on the fly.
  *    option           i     0: do not compute for inactive cells (assign UNDEF)
+ *    nthreads         i     Number of threads (if built with OpenMP); 0 or negative
+ *                           means all available. Each cell is computed independently,
+ *                           so the result is identical to the serial run.
  *
  *
  * RETURNS:
@@ -29,6 +35,7 @@
  */
 
 #include "libxtg.h"
+#include "libxtg_.h"
 #include "logger.h"
 
 void
@@ -43,17 +50,26 @@ grdcp3d_cellvol(long ncol,
                 long nact,
                 double *cellvolsv,
                 long ncell,
+                double *cornerscache,
+                long ncornerscache,
                 int presision,
-                int option)
+                int option,
+                int nthreads)
 
 {
+    double xprof_t0 = x_prof_tic();
 
-    logger_info(LI, FI, FU, "Cell bulk volume...");
-    double *corners = calloc(24, sizeof(double));
+    nthreads = x_nthreads(nthreads);
+    int usecache = (ncornerscache > 0 && ncornerscache == 24 * ncol * nrow * nlay);
+    logger_info(LI, FI, FU, "Cell bulk volume (threads: %d, cached corners: %d)...",
+                nthreads, usecache);
 
-    long i, j, k;
+    long i, j;
+#pragma omp parallel for collapse(2) schedule(static) num_threads(nthreads)
     for (i = 0; i < ncol; i++) {
         for (j = 0; j < nrow; j++) {
+            double corners[24];
+            long k;
             for (k = 0; k < nlay; k++) {
 
                 long ic = i * nrow * nlay + j * nlay + k;
@@ -63,6 +79,12 @@ grdcp3d_cellvol(long ncol,
                     continue;
                 }
 
+                if (usecache) {
+                    cellvolsv[ic] =
+                      x_hexahedron_volume(&cornerscache[24 * ic], 24, presision);
+                    continue;
+                }
+
                 grdcp3d_corners(i, j, k, ncol, nrow, nlay, coordsv, ncoord, zcornsv,
                                 nzcorn, corners);
 
@@ -71,6 +93,7 @@ grdcp3d_cellvol(long ncol,
         }
     }
 
-    free(corners);
     logger_info(LI, FI, FU, "Cell bulk volume... done");
-}
\ No newline at end of file
+
+    x_prof_toc(FU, xprof_t0, ncol * nrow * nlay);
+}
@@ -45,6 +45,8 @@ grdcp3d_export_xtgeo_grid(long ncol,
                           FILE *fc)
 
 {
+    double xprof_t0 = x_prof_tic();
+
     /*
      *----------------------------------------------------------------------------------
      * Initial part
@@ -107,4 +109,6 @@ grdcp3d_export_xtgeo_grid(long ncol,
     fprintf(fc, "%s", metadata);
 
     logger_info(LI, FI, FU, "Export done");
+
+    x_prof_toc(FU, xprof_t0, ncol * nrow * nlay);
 }
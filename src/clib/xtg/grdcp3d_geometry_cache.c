@@ -0,0 +1,92 @@
+/*
+ ***************************************************************************************
+ *
+ * NAME:
+ *    grdcp3d_geometry_cache.c
+ *
+ * DESCRIPTION:
+ *    Compute a per cell geometry cache; the 24 corners, the bounding box (AABB) and
+ *    the centroid of every cell. Routines that evaluate the same cells repeatedly
+ *    can then use these directly instead of deriving the corners from COORD and
+ *    ZCORN again for each call (cf. grdcp3d_corners).
+ *
+ *    All arrays are contiguous, with cells in C order, i.e.
+ *    ic = i * nrow * nlay + j * nlay + k, and each cell holds a block of values:
+ *    corners[24 * ic ...]     as from grdcp3d_corners()
+ *    aabb[6 * ic ...]         xmin, xmax, ymin, ymax, zmin, zmax
+ *    centroids[3 * ic ...]    x, y, z as the mean of the 8 corners
+ *
+ *    This version is for xtgformat=2; see grd3d_geometry_cache.c for xtgformat=1.
+ *    Both gives the same layout.
+ *
+ * ARGUMENTS:
+ *    ncol,nrow,nlay   i     Grid dimensions nx ny nz
+ *    coordsv          i     Grid Z coord for input
+ *    zcornsv          i     Grid Z corners for input
+ *    corners          o     Corners, 24 * ncell
+ *    aabb             o     Bounding boxes, 6 * ncell
+ *    centroids        o     Centroids, 3 * ncell
+ *    nthreads         i     Number of threads (if built with OpenMP); 0 or negative
+ *                           means all available.
+ *
+ * RETURNS:
+ *    Function status, EXIT_SUCCESS or EXIT_FAILURE if wrong array lengths
+ *
+ * TODO/ISSUES/BUGS:
+ *    None known
+ *
+ * LICENCE:
+ *    cf. XTGeo License
+ ***************************************************************************************
+ */
+
+#include "libxtg.h"
+#include "libxtg_.h"
+#include "logger.h"
+
+int
+grdcp3d_geometry_cache(long ncol,
+                       long nrow,
+                       long nlay,
+                       double *coordsv,
+                       long ncoord,
+                       float *zcornsv,
+                       long nzcorn,
+                       double *corners,
+                       long ncorners,
+                       double *aabb,
+                       long naabb,
+                       double *centroids,
+                       long ncentroids,
+                       int nthreads)
+
+{
+    long ncell = ncol * nrow * nlay;
+
+    if (ncorners != 24 * ncell || naabb != 6 * ncell || ncentroids != 3 * ncell) {
+        logger_error(LI, FI, FU, "Wrong length of geometry cache arrays in %s", FU);
+        return EXIT_FAILURE;
+    }
+
+    nthreads = x_nthreads(nthreads);
+    logger_info(LI, FI, FU, "Cell geometry cache (threads: %d)...", nthreads);
+
+    long i, j;
+#pragma omp parallel for collapse(2) schedule(static) num_threads(nthreads)
+    for (i = 0; i < ncol; i++) {
+        for (j = 0; j < nrow; j++) {
+            long k;
+            for (k = 0; k < nlay; k++) {
+                long ic = i * nrow * nlay + j * nlay + k;
+
+                grdcp3d_corners(i, j, k, ncol, nrow, nlay, coordsv, ncoord, zcornsv,
+                                nzcorn, &corners[24 * ic]);
+                x_corners_aabb_centroid(&corners[24 * ic], &aabb[6 * ic],
+                                        &centroids[3 * ic]);
+            }
+        }
+    }
+
+    logger_info(LI, FI, FU, "Cell geometry cache... done");
+    return EXIT_SUCCESS;
+}
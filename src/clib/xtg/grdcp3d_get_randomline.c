@@ -0,0 +1,220 @@
+/*
+ ***************************************************************************************
+ *
+ * NAME:
+ *    grdcp3d_get_randomline.c
+ *
+ *
+ * DESCRIPTION:
+ *    Given X Y Z vectors, return a a randomline array from a 3D grid property.
+ *    This is the xtgformat=2 version of grd3d_get_randomline(), with the same
+ *    search: candidate columns from the cell index, a test of the full column
+ *    (top of first layer to base of last layer, hence no onelayer grid is
+ *    needed), and then the layers in the column, starting around the last hit.
+ *
+ * ARGUMENTS:
+ *    xvec, yvec          i     Arrays coords XY
+ *    zmin, zmax          i     Vertical range
+ *    nzsam               i     Vertical sampling numbering
+ *    ncol, nrow, nlay    i     Grid dimensions
+ *    coordsv             i     Grid COORD, xtgformat=2
+ *    zcornsv             i     Grid ZCORN, xtgformat=2
+ *    actnumsv            i     Grid ACTNUM, xtgformat=2
+ *    propv               i     3D Grid values, C order
+ *    colbox              i     Cell index; bounding box per column
+ *    binstart, bincells  i     Cell index; columns per bin
+ *    xmin..nby           i     Cell index; bin layout (cf. grd3d_cellindex.c)
+ *    values              o     Randomline array
+ *
+ * RETURNS:
+ *    EXIT_SUCCESS, or EXIT_FAILURE if memory allocation fails
+ *
+ * TODO/ISSUES/BUGS:
+ *
+ * LICENCE:
+ *    cf. XTGeo LICENSE
+ ***************************************************************************************
+ */
+
+#include "libxtg.h"
+#include "libxtg_.h"
+#include "logger.h"
+
+/*
+****************************************************************************************
+* private functions
+****************************************************************************************
+*/
+
+static int
+_point_in_column(long ic,
+                 long jc,
+                 double xc,
+                 double yc,
+                 double zc,
+                 long ncol,
+                 long nrow,
+                 long nlay,
+                 double *coordsv,
+                 float *zcornsv)
+{
+    /* the full column as one cell, from top of first to base of last layer */
+
+    double corners[24], base[24];
+    grdcp3d_corners(ic, jc, 0, ncol, nrow, nlay, coordsv, 0, zcornsv, 0, corners);
+    grdcp3d_corners(ic, jc, nlay - 1, ncol, nrow, nlay, coordsv, 0, zcornsv, 0, base);
+
+    int n;
+    for (n = 12; n < 24; n++)
+        corners[n] = base[n];
+
+    return x_chk_point_in_cell(xc, yc, zc, corners, 1);
+}
+
+static long
+_find_k(long ic,
+        long jc,
+        long k1,
+        long k2,
+        double xc,
+        double yc,
+        double zc,
+        long ncol,
+        long nrow,
+        long nlay,
+        double *coordsv,
+        float *zcornsv)
+{
+    /* first layer in k1..k2 (base 0) holding the point, or -1 */
+
+    long k;
+    for (k = k1; k <= k2; k++) {
+        double corners[24];
+        grdcp3d_corners(ic, jc, k, ncol, nrow, nlay, coordsv, 0, zcornsv, 0, corners);
+        if (x_chk_point_in_cell(xc, yc, zc, corners, 1) > 0)
+            return k;
+    }
+    return -1;
+}
+
+/*
+****************************************************************************************
+* public function
+****************************************************************************************
+*/
+
+int
+grdcp3d_get_randomline(double *xvec,
+                       long nxvec,
+                       double *yvec,
+                       long nyvec,
+
+                       double zmin,
+                       double zmax,
+                       int nzsam,
+
+                       long ncol,
+                       long nrow,
+                       long nlay,
+
+                       double *coordsv,
+                       long ncoord,
+                       float *zcornsv,
+                       long nzcorn,
+                       int *actnumsv,
+                       long nact,
+
+                       double *propv,
+                       long nprop,
+
+                       double *colbox,
+                       long ncolbox,
+                       int *binstart,
+                       long nbinstart,
+                       int *bincells,
+                       long nbincells,
+                       double xmin,
+                       double ymin,
+                       double xbin,
+                       double ybin,
+                       int nbx,
+                       int nby,
+
+                       double *values,
+                       long nvalues)
+{
+    logger_info(LI, FI, FU, "Entering routine %s", FU);
+
+    double zsam = (zmax - zmin) / (nzsam - 1);
+
+    if (nxvec != nyvec) {
+        logger_warn(LI, FI, FU,
+                    "There seems to be issues in %s: NXVEC = %ld, NYVEC = %ld", FU,
+                    nxvec, nyvec);
+    }
+
+    /* candidate columns buffer, sized for the largest bin */
+    int maxcols = grd3d_cellindex_maxcols(nbx, nby, binstart);
+    int *cols = malloc(maxcols * sizeof(int));
+    if (cols == NULL) {
+        logger_error(LI, FI, FU, "Cannot allocate column buffer in %s", FU);
+        return EXIT_FAILURE;
+    }
+
+    /* layer of the last hit, as start point for the next search */
+    long klast = 0;
+
+    long ib = 0;
+    long ic;
+    for (ic = 0; ic < nxvec; ic++) {
+        double xc = xvec[ic];
+        double yc = yvec[ic];
+
+        /* candidate columns from the cell index, in XY only */
+        int ncols = grd3d_cellindex_lookup(xc, yc, UNDEF, colbox, xmin, ymin, xbin,
+                                           ybin, nbx, nby, binstart, bincells, cols,
+                                           maxcols);
+
+        int izc;
+        for (izc = 0; izc < nzsam; izc++) {
+
+            double zc = zmin + izc * zsam;
+
+            values[ib] = UNDEF;
+
+            int nc;
+            for (nc = 0; nc < ncols; nc++) {
+                long ii = cols[nc] % ncol;
+                long jj = cols[nc] / ncol;
+
+                if (_point_in_column(ii, jj, xc, yc, zc, ncol, nrow, nlay, coordsv,
+                                     zcornsv) <= 0)
+                    continue;
+
+                /* first around the last hit, then the full column */
+                long k1 = klast > 0 ? klast - 1 : 0;
+                long k2 = klast < nlay - 1 ? klast + 1 : nlay - 1;
+                long kc = _find_k(ii, jj, k1, k2, xc, yc, zc, ncol, nrow, nlay, coordsv,
+                                  zcornsv);
+                if (kc < 0)
+                    kc = _find_k(ii, jj, 0, nlay - 1, xc, yc, zc, ncol, nrow, nlay,
+                                 coordsv, zcornsv);
+
+                if (kc >= 0) {
+                    long icell = ii * nrow * nlay + jj * nlay + kc;
+                    if (actnumsv[icell] == 1)
+                        values[ib] = propv[icell];
+                    klast = kc;
+                    break;
+                }
+            }
+            ib++;
+        }
+    }
+
+    free(cols);
+
+    logger_info(LI, FI, FU, "Exit from routine %s", FU);
+
+    return EXIT_SUCCESS;
+}
@@ -48,73 +48,34 @@ grdcp3d_imp_roffbin_coordsv(FILE *fc,
 {
     /* Imports a ROFF binary array, update pointer */
 
-    float afloat;
-    double top[3] = { 0.0 }, base[3] = { 0.0 };
-    size_t i, j, n;
-
     logger_info(LI, FI, FU, "Reading COORDSV from byte position %ld with swap %d",
                 bytepos, swap);
 
-    fseek(fc, bytepos, SEEK_SET);
-
-    if (swap == 0) {
-        // just a global swap to read without swap eval for every item to improve speed
-        for (i = 0; i < nncol; i++) {
-            for (j = 0; j < nnrow; j++) {
-                for (n = 0; n < 6; n++) {
-                    if (fread(&afloat, 4, 1, fc) != 1)
-                        return EXIT_FAILURE;
-                    if (n == 0) {
-                        base[0] = (afloat + xoffset) * xscale;
-                    } else if (n == 1) {
-                        base[1] = (afloat + yoffset) * yscale;
-                    } else if (n == 2) {
-                        base[2] = (afloat + zoffset) * zscale;
-                    } else if (n == 3) {
-                        top[0] = (afloat + xoffset) * xscale;
-                    } else if (n == 4) {
-                        top[1] = (afloat + yoffset) * yscale;
-                    } else if (n == 5) {
-                        top[2] = (afloat + zoffset) * zscale;
-                    }
-                }
-                for (n = 0; n < 3; n++)
-                    coordsv[(i * nnrow + j) * 6 + n] = top[n];
-                for (n = 3; n < 6; n++)
-                    coordsv[(i * nnrow + j) * 6 + n] = base[n - 3];
-            }
-        }
-    } else {
-        for (i = 0; i < nncol; i++) {
-            for (j = 0; j < nnrow; j++) {
-                for (n = 0; n < 6; n++) {
-                    if (fread(&afloat, 4, 1, fc) != 1)
-                        return EXIT_FAILURE;
-
-                    SWAP_FLOAT(afloat);
+    /* read all pillars in one block; per pillar base xyz, then top xyz */
+    size_t nvalues = 6 * nncol * nnrow;
+    float *buf = malloc(nvalues * sizeof(float));
+    if (buf == NULL) {
+        logger_error(LI, FI, FU, "Cannot allocate buffer in %s", FU);
+        return EXIT_FAILURE;
+    }
+    if (x_roffbin_read_block(fc, bytepos, swap, 4, nvalues, buf) != EXIT_SUCCESS) {
+        free(buf);
+        return EXIT_FAILURE;
+    }
 
-                    if (n == 0) {
-                        base[0] = (afloat + xoffset) * xscale;
-                    } else if (n == 1) {
-                        base[1] = (afloat + yoffset) * yscale;
-                    } else if (n == 2) {
-                        base[2] = (afloat + zoffset) * zscale;
-                    } else if (n == 3) {
-                        top[0] = (afloat + xoffset) * xscale;
-                    } else if (n == 4) {
-                        top[1] = (afloat + yoffset) * yscale;
-                    } else if (n == 5) {
-                        top[2] = (afloat + zoffset) * zscale;
-                    }
-                }
-                for (n = 0; n < 3; n++)
-                    coordsv[(i * nnrow + j) * 6 + n] = top[n];
-                for (n = 3; n < 6; n++)
-                    coordsv[(i * nnrow + j) * 6 + n] = base[n - 3];
-            }
-        }
+    size_t ib;
+    for (ib = 0; ib < nvalues; ib += 6) {
+        float *pil = &buf[ib];
+        coordsv[ib + 0] = (pil[3] + xoffset) * xscale;
+        coordsv[ib + 1] = (pil[4] + yoffset) * yscale;
+        coordsv[ib + 2] = (pil[5] + zoffset) * zscale;
+        coordsv[ib + 3] = (pil[0] + xoffset) * xscale;
+        coordsv[ib + 4] = (pil[1] + yoffset) * yscale;
+        coordsv[ib + 5] = (pil[2] + zoffset) * zscale;
     }
 
+    free(buf);
+
     logger_info(LI, FI, FU, "Reading COORDSV done");
 
     return EXIT_SUCCESS;
@@ -19,7 +19,8 @@
  *    nitems             i     Length of coordsv array (nncol * nncol * 6)
  *
  * RETURNS:
- *    EXIT_STATUS (0) if OK, updated float pointer *coordsv
+ *    EXIT_SUCCESS if OK, updated float pointer *zcornsv. EXIT_FAILURE if the
+ *    data cannot be read or the split array is invalid
  *
  * TODO/ISSUES/BUGS:
  *
@@ -52,101 +53,57 @@ grdcp3d_imp_roffbin_zcornsv(FILE *fc,
 {
     /* Imports a ROFF binary array, update pointer */
 
-    float afloat;
-    float **pillar = x_allocate_2d_float(nnlay, 4);
-
     logger_info(LI, FI, FU, "Reading ZCORNS...");
     logger_info(LI, FI, FU, "Reading from byte position %ld with swap %d", bytepos,
                 swap);
 
-    fseek(fc, bytepos, SEEK_SET);
-
-    if (swap == 0) {
-
-        // just a global swap to read without swap eval for every item to improve speed
-        long ic = 0;
-        long i, j;
-
-        for (i = 0; i < nncol; i++) {
-            for (j = 0; j < nnrow; j++) {
-                long k;
-                for (k = 0; k < nnlay; k++) {
-
-                    long nsplit = splitenz[i * nnrow * nnlay + j * nnlay + k];
-
-                    long n;
-                    if (nsplit == 4) {
-                        for (n = 0; n < 4; n++) {
-                            if (fread(&afloat, 4, 1, fc) != 1)
-                                return EXIT_FAILURE;
-                            pillar[k][n] = (afloat + zoffset) * zscale;
-                        }
-                    } else if (nsplit == 1) {
-                        if (fread(&afloat, 4, 1, fc) != 1)
-                            return EXIT_FAILURE;
-                        for (n = 0; n < 4; n++) {
-                            pillar[k][n] = (afloat + zoffset) * zscale;
-                        }
-                    } else {
-                        logger_critical(
-                          LI, FI, FU, "Probably a bug in %s, nsplit is %d for %d %d %d",
-                          FU, nsplit, i, j, k);
-                        exit(-989);
-                    }
-                }
-                for (k = (nnlay - 1); k >= 0; k--) {
-                    long n;
-                    for (n = 0; n < 4; n++) {
-                        zcornsv[ic++] = pillar[k][n];
-                    }
-                }
-            }
+    /* the number of stored values is given by the split per node, 1 or 4 */
+    size_t nvalues = 0;
+    long inode;
+    for (inode = 0; inode < nncol * nnrow * nnlay; inode++) {
+        int nsplit = splitenz[inode];
+        if (nsplit != 1 && nsplit != 4) {
+            logger_error(LI, FI, FU, "Probably a bug in %s, nsplit is %d at node %ld",
+                         FU, nsplit, inode);
+            return EXIT_FAILURE;
         }
-    } else {
-
-        long ic = 0;
-        long i, j;
-
-        for (i = 0; i < nncol; i++) {
-            for (j = 0; j < nnrow; j++) {
-                long k;
-                for (k = 0; k < nnlay; k++) {
+        nvalues += nsplit;
+    }
 
-                    long nsplit = splitenz[(i * nnrow + j) * nnrow + k];
+    float *buf = malloc(nvalues * sizeof(float));
+    if (buf == NULL) {
+        logger_error(LI, FI, FU, "Cannot allocate buffer in %s", FU);
+        return EXIT_FAILURE;
+    }
+    if (x_roffbin_read_block(fc, bytepos, swap, 4, nvalues, buf) != EXIT_SUCCESS) {
+        free(buf);
+        return EXIT_FAILURE;
+    }
 
-                    long n;
-                    if (nsplit == 4) {
-                        for (n = 0; n < 4; n++) {
-                            if (fread(&afloat, 4, 1, fc) != 1)
-                                return EXIT_FAILURE;
-                            SWAP_FLOAT(afloat);
-                            pillar[k][n] = (afloat + zoffset) * zscale;
-                        }
-                    } else if (nsplit == 1) {
-                        if (fread(&afloat, 4, 1, fc) != 1)
-                            return EXIT_FAILURE;
-                        SWAP_FLOAT(afloat);
-                        for (n = 0; n < 4; n++) {
-                            pillar[k][n] = (afloat + zoffset) * zscale;
-                        }
-                    } else {
-                        logger_critical(LI, FI, FU, "Probably a bug in %s", FU);
-                        exit(-989);
-                    }
-                }
-                for (k = (nnlay - 1); k >= 0; k--) {
-                    long n;
-                    for (n = 0; n < 4; n++) {
-                        zcornsv[ic++] = pillar[k][n];
-                    }
-                }
+    /* ROFF has k from base per pillar, while XTGeo has k from top */
+    float *val = buf;
+    long icol;
+    for (icol = 0; icol < nncol * nnrow; icol++) {
+        long k;
+        for (k = 0; k < nnlay; k++) {
+            float *zc = &zcornsv[4 * (icol * nnlay + nnlay - 1 - k)];
+            long n;
+            if (splitenz[icol * nnlay + k] == 4) {
+                for (n = 0; n < 4; n++)
+                    zc[n] = (val[n] + zoffset) * zscale;
+                val += 4;
+            } else {
+                float zval = (val[0] + zoffset) * zscale;
+                for (n = 0; n < 4; n++)
+                    zc[n] = zval;
+                val += 1;
             }
         }
     }
 
-    logger_info(LI, FI, FU, "Reading ZCORNSV done");
+    free(buf);
 
-    x_free_2d_float(pillar);
+    logger_info(LI, FI, FU, "Reading ZCORNSV done");
 
     return EXIT_SUCCESS;
 }
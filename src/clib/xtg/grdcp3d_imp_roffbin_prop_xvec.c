@@ -21,6 +21,7 @@
  * DESCRIPTION:
  *    Read from ROFF and maps pointer directlry to XTGeo layout, which is in
  *    xtgformat=2 C ordered but with K starting at top, not at base as in ROFF.
+ *    The data are read in blocks, cf. x_roffbin_read_prop().
  *
  * ARGUMENTS:
  *    fc              i     Filehandle (stream) to read from
@@ -52,43 +53,22 @@ grdcp3d_imp_roffbin_prop_ivec(FILE *fc,
 {
     /* Imports a ROFF binary array, update pointer */
 
-    size_t anint;
+    return x_roffbin_read_prop(fc, bytepos, swap, 1, ncol, nrow, nlay, NULL, pvec);
+}
 
-    fseek(fc, bytepos, SEEK_SET);
+int
+grdcp3d_imp_roffbin_prop_fvec(FILE *fc,
+                              int swap,
+                              long bytepos,
+                              long ncol,
+                              long nrow,
+                              long nlay,
+                              float *pvec,
+                              long nvec)
+{
+    /* Imports a ROFF binary float array, update pointer */
 
-    if (swap == 0) {
-        long i;
-        for (i = 0; i < ncol; i++) {
-            long j;
-            for (j = 0; j < nrow; j++) {
-                long k;
-                for (k = (nlay - 1); k >= 0; k--) {
-                    if (fread(&anint, 4, 1, fc) != 1)
-                        return EXIT_FAILURE;
-                    if (anint == -999.0)
-                        anint = UNDEF_INT;
-                    pvec[i * nrow * nlay + j * nlay + k] = anint;
-                }
-            }
-        }
-    } else {
-        long i;
-        for (i = 0; i < ncol; i++) {
-            long j;
-            for (j = 0; j < nrow; j++) {
-                long k;
-                for (k = (nlay - 1); k >= 0; k--) {
-                    if (fread(&anint, 4, 1, fc) != 1)
-                        return EXIT_FAILURE;
-                    SWAP_INT(anint);
-                    if (anint == -999.0)
-                        anint = UNDEF_INT;
-                    pvec[i * nrow * nlay + j * nlay + k] = anint;
-                }
-            }
-        }
-    }
-    return EXIT_SUCCESS;
+    return x_roffbin_read_prop(fc, bytepos, swap, 2, ncol, nrow, nlay, pvec, NULL);
 }
 
 int
@@ -103,25 +83,5 @@ grdcp3d_imp_roffbin_prop_bvec(FILE *fc,
 {
     // a byte vector does not need swap, and is converted to int array!
 
-    unsigned char abyte;
-    int anint;
-
-    fseek(fc, bytepos, SEEK_SET);
-
-    long i;
-    for (i = 0; i < ncol; i++) {
-        long j;
-        for (j = 0; j < nrow; j++) {
-            long k;
-            for (k = (nlay - 1); k >= 0; k--) {
-                if (fread(&abyte, 1, 1, fc) != 1)
-                    return EXIT_FAILURE;
-                anint = (int)abyte;
-                if (anint == 255)
-                    anint = UNDEF_INT;
-                pvec[i * nrow * nlay + j * nlay + k] = anint;
-            }
-        }
-    }
-    return EXIT_SUCCESS;
+    return x_roffbin_read_prop(fc, bytepos, 0, 6, ncol, nrow, nlay, NULL, pvec);
 }
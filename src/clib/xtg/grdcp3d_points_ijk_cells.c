@@ -0,0 +1,365 @@
+/*
+ ***************************************************************************************
+ *
+ * NAME:
+ *    grdcp3d_points_ijk_cells.c
+ *
+ *
+ * DESCRIPTION:
+ *    Given X Y Z vectors, return the corresponding I J K vectors for the cell indices.
+ *    This is the xtgformat=2 version of grd3d_points_ijk_cells(), using the same
+ *    search strategy:
+ *    > A spatial bin index of grid columns to find candidate columns
+ *      (cf. grd3d_cellindex.c and grdcp3d_cellindex_colbox.c)
+ *    > A onelayer test per candidate column, where the column cell is made from the
+ *      top of the first layer and the base of the last layer (hence no onelayer
+ *      grid is needed)
+ *    > A "last hit" warm start, as consecutive points often are in the same cell,
+ *      with precomputed face planes once the warm start cell is hit again
+ *      (cf. grd3d_points_ijk_cells.c)
+ *
+ *    The points may be processed in parallel (OpenMP), each thread having its own
+ *    warm start cell.
+ *
+ * ARGUMENTS:
+ *    xvec, yvec, zvec    i     Arrays coords XYZ
+ *    n*vec               i     length of input vectors (spesified for swig/numpy)
+ *    ncol, nrow, nlay    i     Grid dimensions
+ *    coordsv             i     Grid COORD, xtgformat=2
+ *    zcornsv             i     Grid ZCORN, xtgformat=2
+ *    actnumsv            i     Grid ACTNUM, xtgformat=2
+ *    cornerscache        i     Optional precomputed cell corners (24 per cell, C order)
+ *                              cf. grdcp3d_geometry_cache(); length 0 for no cache
+ *    colbox              i     Cell index; bounding box per column
+ *    binstart, bincells  i     Cell index; columns per bin
+ *    xmin..nby           i     Cell index; bin layout
+ *    actnumoption        i     if 1, then only report if cell is active
+ *    ivec, jvec, kvec    o     IJK arrays, base 1 (as grd3d_points_ijk_cells)
+ *    n*vec               i     array lengths (for swig/numpies)
+ *    nthreads            i     Number of threads; 0 or less for all available.
+ *                              Only in effect if compiled with OpenMP.
+ *
+ * RETURNS:
+ *    Update IJK pointers, UNDEF_INT where no cell is found
+ *
+ * TODO/ISSUES/BUGS:
+ *
+ * LICENCE:
+ *    cf. XTGeo LICENSE
+ ***************************************************************************************
+ */
+
+#include "libxtg.h"
+#include "libxtg_.h"
+#include "logger.h"
+
+#include <math.h>
+
+static struct
+{
+    long ncol;
+    long nrow;
+    long nlay;
+    double *coordsv;
+    long ncoord;
+    float *zcornsv;
+    long nzcorn;
+    double *cornerscache;
+} grid;
+
+/*
+****************************************************************************************
+* private functions
+****************************************************************************************
+*/
+
+static double *
+_cell_corners(long ic, long jc, long kc, double *cornersv)
+{
+    /* corners of cell (base 0), from the cache or computed into cornersv */
+
+    if (grid.cornerscache) {
+        long icell = ic * grid.nrow * grid.nlay + jc * grid.nlay + kc;
+        return &grid.cornerscache[24 * icell];
+    }
+    grdcp3d_corners(ic, jc, kc, grid.ncol, grid.nrow, grid.nlay, grid.coordsv,
+                    grid.ncoord, grid.zcornsv, grid.nzcorn, cornersv);
+    return cornersv;
+}
+
+static int
+_point_in_cell(long ic, long jc, long kc, double xc, double yc, double zc)
+{
+    /* score of point in cell (base 0), going from -1 to 100 */
+
+    double cornersv[24];
+    double *corners = _cell_corners(ic, jc, kc, cornersv);
+    return x_point_in_hexahedron(xc, yc, zc, corners, 24, 1);
+}
+
+static int
+_point_in_column(long ic, long jc, double xc, double yc, double zc)
+{
+    /* score of point in the full column, as one cell from top to base */
+
+    double corners[24], base[24];
+    grdcp3d_corners(ic, jc, 0, grid.ncol, grid.nrow, grid.nlay, grid.coordsv,
+                    grid.ncoord, grid.zcornsv, grid.nzcorn, corners);
+    grdcp3d_corners(ic, jc, grid.nlay - 1, grid.ncol, grid.nrow, grid.nlay,
+                    grid.coordsv, grid.ncoord, grid.zcornsv, grid.nzcorn, base);
+
+    int n;
+    for (n = 12; n < 24; n++)
+        corners[n] = base[n];
+
+    return x_point_in_hexahedron(xc, yc, zc, corners, 24, 1);
+}
+
+static int
+_point_val_ij(double xc, double yc, double zc, int *cols, int ncols, int colfound[])
+{
+    /*
+     * Search candidate columns (0 based index, from cell index) for the column
+     * holding the point. It may be that several columns are valid (on edges).
+     */
+
+    int ncn = 0;
+
+    int n;
+    for (n = 0; n < ncols; n++) {
+        long ii = cols[n] % grid.ncol;
+        long jj = cols[n] / grid.ncol;
+
+        int score = _point_in_column(ii, jj, xc, yc, zc);
+
+        if (score > 50) {
+            colfound[ncn++] = cols[n];
+            return ncn;
+        } else if (score == 50) {
+            colfound[ncn++] = cols[n];
+            if (ncn == 4)
+                return ncn;
+        }
+    }
+    return ncn;
+}
+
+static int
+_point_val_k(double xc,
+             double yc,
+             double zc,
+             int *actnumsv,
+             int actnumoption,
+             long iin,
+             long jin,
+             long *kchosen)
+{
+    /*
+     * Search the layers in column iin, jin for the K location of point XYZ. The
+     * result is the best scoring (active) layer; return the score or -1.
+     */
+
+    *kchosen = -1;
+    int hiscore = 0;
+    int nib = 0;
+
+    long k;
+    for (k = 0; k < grid.nlay; k++) {
+        int score = _point_in_cell(iin, jin, k, xc, yc, zc);
+
+        if (score >= 50) {
+            long icell = iin * grid.nrow * grid.nlay + jin * grid.nlay + k;
+            int active = (actnumoption == 0) ? 1 : actnumsv[icell];
+            if (score > hiscore && active == 1) {
+                hiscore = score;
+                *kchosen = k;
+            }
+            nib++;
+        } else if (score == 0 && nib > 0) {
+            break;
+        }
+    }
+
+    return (nib > 0) ? hiscore : -1;
+}
+
+/*
+****************************************************************************************
+* public function
+****************************************************************************************
+*/
+
+int
+grdcp3d_points_ijk_cells(double *xvec,
+                         long nxvec,
+                         double *yvec,
+                         long nyvec,
+                         double *zvec,
+                         long nzvec,
+
+                         long ncol,
+                         long nrow,
+                         long nlay,
+                         double *coordsv,
+                         long ncoord,
+                         float *zcornsv,
+                         long nzcorn,
+                         int *actnumsv,
+                         long nact,
+                         double *cornerscache,
+                         long ncornerscache,
+
+                         double *colbox,
+                         long ncolbox,
+                         int *binstart,
+                         long nbinstart,
+                         int *bincells,
+                         long nbincells,
+                         double xmin,
+                         double ymin,
+                         double xbin,
+                         double ybin,
+                         int nbx,
+                         int nby,
+
+                         int actnumoption,
+
+                         int *ivec,
+                         long nivec,
+                         int *jvec,
+                         long njvec,
+                         int *kvec,
+                         long nkvec,
+                         int nthreads)
+{
+    double xprof_t0 = x_prof_tic();
+
+    logger_info(LI, FI, FU, "Entering routine %s", FU);
+
+    if (nxvec != nyvec || nyvec != nzvec)
+        logger_critical(LI, FI, FU, "Input bug");
+    if (nivec != njvec || nivec != nkvec)
+        logger_critical(LI, FI, FU, "Input bug");
+
+    nthreads = x_nthreads(nthreads);
+    logger_info(LI, FI, FU, "Number of threads: %d", nthreads);
+
+    grid.ncol = ncol;
+    grid.nrow = nrow;
+    grid.nlay = nlay;
+    grid.coordsv = coordsv;
+    grid.ncoord = ncoord;
+    grid.zcornsv = zcornsv;
+    grid.nzcorn = nzcorn;
+
+    /* a cache of wrong length (or none) means corners are computed on the fly */
+    grid.cornerscache = NULL;
+    if (ncornerscache == 24 * ncol * nrow * nlay)
+        grid.cornerscache = cornerscache;
+
+    /* candidate columns buffer per thread, sized for the largest bin */
+    int maxcols = grd3d_cellindex_maxcols(nbx, nby, binstart);
+    int nomem = 0;
+
+#pragma omp parallel num_threads(nthreads)
+    {
+        /* warm start; the last cell found (per thread), -1 if none. When the
+           warm start cell holds the next point as well, it is prepared for
+           repeated tests, cf. x_hexahedron_prepare() */
+        long iclast = -1;
+        int lastprepared = 0;
+        double lastprep[HEXA_NPREP];
+
+        int *cols = malloc(maxcols * sizeof(int));
+        if (cols == NULL) {
+#pragma omp atomic write
+            nomem = 1;
+        }
+
+        long ip;
+#pragma omp for schedule(static)
+        for (ip = 0; ip < nxvec; ip++) {
+            double xc = xvec[ip];
+            double yc = yvec[ip];
+            double zc = zvec[ip];
+
+            ivec[ip] = UNDEF_INT;
+            jvec[ip] = UNDEF_INT;
+            kvec[ip] = UNDEF_INT;
+
+            if (cols == NULL)
+                continue;
+
+            /*
+             * first try the previous hit cell; accept only if point is fully inside
+             * (score 100), otherwise do the complete search below
+             */
+            if (iclast >= 0) {
+                long ires = iclast / (nrow * nlay);
+                long jres = (iclast / nlay) % nrow;
+                long kres = iclast % nlay;
+                int score;
+                if (lastprepared) {
+                    score = x_point_in_hexahedron_prepared(xc, yc, zc, lastprep);
+                } else {
+                    double cornersv[24];
+                    double *corners = _cell_corners(ires, jres, kres, cornersv);
+                    score = x_point_in_hexahedron(xc, yc, zc, corners, 24, 1);
+                    if (score == 100) {
+                        x_hexahedron_prepare(corners, lastprep);
+                        lastprepared = 1;
+                    }
+                }
+                if (score == 100) {
+                    ivec[ip] = ires + 1;
+                    jvec[ip] = jres + 1;
+                    kvec[ip] = kres + 1;
+                    continue;
+                }
+            }
+
+            /* candidate columns from the cell index */
+            int ncols =
+              grd3d_cellindex_lookup(xc, yc, zc, colbox, xmin, ymin, xbin, ybin, nbx,
+                                     nby, binstart, bincells, cols, maxcols);
+
+            if (ncols == 0)
+                continue;
+
+            /* pin the I J column, then find the K location */
+            int colfound[4];
+            int nfound = _point_val_ij(xc, yc, zc, cols, ncols, colfound);
+
+            int n;
+            for (n = 0; n < nfound; n++) {
+                long ires = colfound[n] % ncol;
+                long jres = colfound[n] / ncol;
+
+                long kres;
+                int nscore =
+                  _point_val_k(xc, yc, zc, actnumsv, actnumoption, ires, jres, &kres);
+
+                if (kres >= 0 && nscore > 0) {
+                    ivec[ip] = ires + 1;
+                    jvec[ip] = jres + 1;
+                    kvec[ip] = kres + 1;
+                    iclast = ires * nrow * nlay + jres * nlay + kres;
+                    lastprepared = 0;
+                    break;
+                }
+            }
+        }
+
+        free(cols);
+    }
+
+    if (nomem) {
+        logger_error(LI, FI, FU, "Cannot allocate column buffers in %s", FU);
+        return EXIT_FAILURE;
+    }
+
+    logger_info(LI, FI, FU, "Exit from routine %s", FU);
+
+    x_prof_toc(FU, xprof_t0, nxvec);
+    return EXIT_SUCCESS;
+}
@@ -26,10 +26,14 @@
  *    ncol,nrow,nlay   i     Grid dimensions nx ny nz
  *    coordsv          i     Grid Z coord for input
  *    zcornsv          i     Grid Z corners for input
- *    corners          o     Array, 24 length allocated at client.
+ *    actnumsv         i     Actnum array
+ *    fresults         o     Array with the quality measures, one block per measure
+ *    cornerscache     i     Optional precomputed cell corners (24 per cell, C order),
+ *                           cf. grdcp3d_geometry_cache(). Length 0 means computing
+ *                           corners on the fly.
  *
  * RETURNS:
- *    corners, _xtgformat=2
+ *    fresults, _xtgformat=2
  *
  * TODO/ISSUES/BUGS:
  *    None known
@@ -242,7 +246,9 @@ grdcp3d_quality_indicators(long ncol,
                            int *actnumsv,
                            long nact,
                            float *fresults,
-                           long nfresults)
+                           long nfresults,
+                           double *cornerscache,
+                           long ncornerscache)
 
 {
     /* each cell is defined by 4 pillars */
@@ -265,6 +271,8 @@ grdcp3d_quality_indicators(long ncol,
     data.corners = corners;
     data.ncount = data.ncol * data.nrow * data.nlay;
 
+    int usecache = (ncornerscache > 0 && ncornerscache == 24 * data.ncount);
+
     long i, j, k;
     for (i = 0; i < ncol; i++) {
         for (j = 0; j < nrow; j++) {
@@ -276,9 +284,14 @@ grdcp3d_quality_indicators(long ncol,
                 data.jrow = j;
                 data.klay = k;
                 data.icount = ic;
-                grdcp3d_corners(data.icol, data.jrow, data.klay, data.ncol, data.nrow,
-                                data.nlay, data.coordsv, data.ncoord, data.zcornsv,
-                                data.nzcorn, data.corners);
+                if (usecache) {
+                    data.corners = &cornerscache[24 * ic];
+                } else {
+                    data.corners = corners;
+                    grdcp3d_corners(data.icol, data.jrow, data.klay, data.ncol,
+                                    data.nrow, data.nlay, data.coordsv, data.ncoord,
+                                    data.zcornsv, data.nzcorn, data.corners);
+                }
                 _cellangles();
                 _collapsed();
                 _faulted();
@@ -0,0 +1,349 @@
+/*
+ ***************************************************************************************
+ *
+ * NAME:
+ *    grdcp3d_well_ijk.c
+ *
+ * DESCRIPTION:
+ *    Look along a well trajectory (X Y Z coords), and for each point find
+ *    which I J K it has. Return as 3 IJK 1D arrays.
+ *
+ *    This is the xtgformat=2 version of grd3d_well_ijk(), with the same search:
+ *    a growing radius around the previous hit, first in the grid envelope and
+ *    then in the full grid, and the cell index when the radius search fails.
+ *    There are two differences in the implementation:
+ *    > The grid envelope is made per column from the top of the first and the
+ *      base of the last layer, hence no onelayer grid is needed
+ *    > Instead of making the Z corners consistent in place (which edits the
+ *      grid), the corners of each cell are made consistent when used, i.e. a
+ *      base corner is at least ZSEP below the top corner
+ *
+ *    Note, the cell index is 1 based.
+ *
+ * ARGUMENTS:
+ *    ncol, nrow, nlay   i     Grid dimensions
+ *    coordsv            i     Grid coordinate lines, xtgformat=2
+ *    zcornsv            i     Grid Z corners, xtgformat=2
+ *    actnumsv           i     Grid ACTNUM parameter, xtgformat=2
+ *    colbox             i     Cell index; bounding box per column
+ *    binstart, bincells i     Cell index; columns per bin
+ *    xmin..nby          i     Cell index; bin layout (cf. grd3d_cellindex.c)
+ *    nval               i     Position of last point for well log
+ *    p_utme_v           i     East coordinate vector for well log
+ *    p_utmn_v           i     North coordinate vector for well log
+ *    p_tvds_v           i     TVD (SS) coordinate vector for well log
+ *    ivector            o     Returning I coordinates (0 if not in grid)
+ *    jvector            o     Returning J coordinates (0 if not in grid)
+ *    kvector            o     Returning K coordinates (0 if not in grid)
+ *    iflag              i     Options flag
+ *
+ * RETURNS:
+ *    The C macro EXIT_SUCCESS unless problems
+ *    Updated *vector variables
+ *
+ * TODO/ISSUES/BUGS:
+ *
+ * LICENCE:
+ *    cf. XTGeo LICENSE
+ ***************************************************************************************
+ */
+
+#include "libxtg.h"
+#include "libxtg_.h"
+#include "logger.h"
+
+#define ZSEP 0.000001
+
+static struct
+{
+    long ncol;
+    long nrow;
+    long nlay;
+    double *coordsv;
+    float *zcornsv;
+} grid;
+
+/*
+****************************************************************************************
+* private functions
+****************************************************************************************
+*/
+
+/* corners of cell (base 0), or of the full column if envelope is 1 */
+static void
+_corners(long i, long j, long k, int envelope, double corners[])
+{
+    if (envelope) {
+        double base[24];
+        grdcp3d_corners(i, j, 0, grid.ncol, grid.nrow, grid.nlay, grid.coordsv, 0,
+                        grid.zcornsv, 0, corners);
+        grdcp3d_corners(i, j, grid.nlay - 1, grid.ncol, grid.nrow, grid.nlay,
+                        grid.coordsv, 0, grid.zcornsv, 0, base);
+        int n;
+        for (n = 12; n < 24; n++)
+            corners[n] = base[n];
+    } else {
+        grdcp3d_corners(i, j, k, grid.ncol, grid.nrow, grid.nlay, grid.coordsv, 0,
+                        grid.zcornsv, 0, corners);
+    }
+
+    int n;
+    for (n = 0; n < 4; n++) {
+        if (corners[12 + 3 * n + 2] - corners[3 * n + 2] < ZSEP)
+            corners[12 + 3 * n + 2] = corners[3 * n + 2] + ZSEP;
+    }
+}
+
+/*
+ * Search in a growing radius around a start cell (as grd3d_point_in_cell with
+ * sflag 0), in the full grid or in the grid envelope (one layer). Return 0 and
+ * the cell (base 0) if found, else -1.
+ */
+static int
+_point_in_cell(long *start,
+               int envelope,
+               double x,
+               double y,
+               double z,
+               int maxrad,
+               long *found)
+{
+    long nlay = envelope ? 1 : grid.nlay;
+
+    long i1 = start[0], i2 = start[0];
+    long j1 = start[1], j2 = start[1];
+    long k1 = start[2], k2 = start[2];
+
+    int irad;
+    for (irad = 0; irad <= (maxrad + 1); irad++) {
+
+        if (irad > 0) {
+            i1 -= 1;
+            i2 += 1;
+            j1 -= 1;
+            j2 += 1;
+            k1 -= 1;
+            k2 += 1;
+        }
+
+        if (i1 < 0)
+            i1 = 0;
+        if (j1 < 0)
+            j1 = 0;
+        if (k1 < 0)
+            k1 = 0;
+        if (i2 > grid.ncol - 1)
+            i2 = grid.ncol - 1;
+        if (j2 > grid.nrow - 1)
+            j2 = grid.nrow - 1;
+        if (k2 > nlay - 1)
+            k2 = nlay - 1;
+
+        long i, j, k;
+        for (k = k1; k <= k2; k++) {
+            for (j = j1; j <= j2; j++) {
+                for (i = i1; i <= i2; i++) {
+                    double corners[24];
+                    _corners(i, j, k, envelope, corners);
+                    if (x_chk_point_in_cell(x, y, z, corners, 1) > 0) {
+                        found[0] = i;
+                        found[1] = j;
+                        found[2] = k;
+                        return 0;
+                    }
+                }
+            }
+        }
+
+        if (i1 == 0 && i2 == grid.ncol - 1 && j1 == 0 && j2 == grid.nrow - 1 &&
+            k1 == 0 && k2 == nlay - 1)
+            break;
+    }
+    return -1;
+}
+
+/*
+ * Find the cell for a point when the (local) search around the start cell
+ * failed, using the cell index to get candidate columns (into cols, which has
+ * room for maxcols). The columns are then tested as a whole first and then
+ * along K. Return 0 and the cell if found.
+ */
+static int
+_search_by_index(double xcor,
+                 double ycor,
+                 double zcor,
+                 double *colbox,
+                 int *binstart,
+                 int *bincells,
+                 double xmin,
+                 double ymin,
+                 double xbin,
+                 double ybin,
+                 int nbx,
+                 int nby,
+                 int *cols,
+                 int maxcols,
+                 long *found)
+{
+    int ncols = grd3d_cellindex_lookup(xcor, ycor, zcor, colbox, xmin, ymin, xbin, ybin,
+                                       nbx, nby, binstart, bincells, cols, maxcols);
+
+    int nc;
+    for (nc = 0; nc < ncols; nc++) {
+        long i = cols[nc] % grid.ncol;
+        long j = cols[nc] / grid.ncol;
+        double corners[24];
+
+        _corners(i, j, 0, 1, corners);
+        if (x_chk_point_in_cell(xcor, ycor, zcor, corners, 1) <= 0)
+            continue;
+
+        long k;
+        for (k = 0; k < grid.nlay; k++) {
+            _corners(i, j, k, 0, corners);
+            if (x_chk_point_in_cell(xcor, ycor, zcor, corners, 1) > 0) {
+                found[0] = i;
+                found[1] = j;
+                found[2] = k;
+                return 0;
+            }
+        }
+    }
+    return -1;
+}
+
+/*
+****************************************************************************************
+* public function
+****************************************************************************************
+*/
+
+int
+grdcp3d_well_ijk(long ncol,
+                 long nrow,
+                 long nlay,
+
+                 double *coordsv,
+                 long ncoord,
+                 float *zcornsv,
+                 long nzcorn,
+                 int *actnumsv,
+                 long nact,
+
+                 double *colbox,
+                 long ncolbox,
+                 int *binstart,
+                 long nbinstart,
+                 int *bincells,
+                 long nbincells,
+                 double xmin,
+                 double ymin,
+                 double xbin,
+                 double ybin,
+                 int nbx,
+                 int nby,
+
+                 int nval,
+                 double *p_utme_v,
+                 double *p_utmn_v,
+                 double *p_tvds_v,
+                 int *ivector,
+                 int *jvector,
+                 int *kvector,
+                 int iflag)
+
+{
+
+    logger_info(LI, FI, FU, "Entering %s", FU);
+
+    grid.ncol = ncol;
+    grid.nrow = nrow;
+    grid.nlay = nlay;
+    grid.coordsv = coordsv;
+    grid.zcornsv = zcornsv;
+
+    /* find a smart global startcell; middle of IJ and K=1 */
+    long start0[3] = { ncol / 2 - 1, nrow / 2 - 1, 0 };
+    if (start0[0] < 0)
+        start0[0] = 0;
+    if (start0[1] < 0)
+        start0[1] = 0;
+
+    /* start cells in the full grid and in the grid envelope */
+    long start[3] = { start0[0], start0[1], start0[2] };
+    long start2[3] = { start0[0], start0[1], 0 };
+
+    /* initial search options, as in grd3d_well_ijk */
+    int maxradsearch = 5;
+
+    /* candidate columns buffer for the cell index, sized for the largest bin */
+    int maxcols = grd3d_cellindex_maxcols(nbx, nby, binstart);
+    int *cols = malloc(maxcols * sizeof(int));
+    if (cols == NULL) {
+        logger_error(LI, FI, FU, "Cannot allocate column buffer in %s", FU);
+        return EXIT_FAILURE;
+    }
+
+    int mnum;
+    for (mnum = 0; mnum < nval; mnum++) {
+        double xcor = p_utme_v[mnum];
+        double ycor = p_utmn_v[mnum];
+        double zcor = p_tvds_v[mnum];
+
+        ivector[mnum] = 0;
+        jvector[mnum] = 0;
+        kvector[mnum] = 0;
+
+        /* first check that the point is inside the grid envelope, to avoid
+           unneccasary searching */
+        long cell[3];
+        int ier2 = -1;
+        int outside = -999;
+        if (_point_in_cell(start2, 1, xcor, ycor, zcor, maxradsearch, cell) == 0) {
+            outside = 0;
+            start2[0] = cell[0];
+            start2[1] = cell[1];
+        } else {
+            /* not near the previous point; use the cell index */
+            ier2 = _search_by_index(xcor, ycor, zcor, colbox, binstart, bincells, xmin,
+                                    ymin, xbin, ybin, nbx, nby, cols, maxcols, cell);
+            outside = -777;
+            if (ier2 == 0) {
+                outside = 0;
+                start2[0] = cell[0];
+                start2[1] = cell[1];
+            }
+        }
+
+        if (outside != 0)
+            continue;
+
+        /* search the full grid, near the start cell, then by cell index */
+        if (ier2 != 0)
+            ier2 = _point_in_cell(start, 0, xcor, ycor, zcor, maxradsearch, cell);
+        if (ier2 != 0)
+            ier2 = _search_by_index(xcor, ycor, zcor, colbox, binstart, bincells, xmin,
+                                    ymin, xbin, ybin, nbx, nby, cols, maxcols, cell);
+
+        if (ier2 == 0) {
+            if (actnumsv[cell[0] * nrow * nlay + cell[1] * nlay + cell[2]] == 1) {
+                ivector[mnum] = cell[0] + 1;
+                jvector[mnum] = cell[1] + 1;
+                kvector[mnum] = cell[2] + 1;
+            }
+            start[0] = cell[0];
+            start[1] = cell[1];
+            start[2] = cell[2];
+        } else {
+            /* outside grid */
+            start[0] = start0[0];
+            start[1] = start0[1];
+            start[2] = start0[2];
+        }
+    }
+
+    free(cols);
+
+    logger_info(LI, FI, FU, "Exit from %s", FU);
+    return EXIT_SUCCESS;
+}
@@ -113,6 +113,18 @@ xtg_get_fbuffer(FILE *fhandle, char *swig_bytes, long swig_bytes_len);
  *======================================================================================
  */
 
+int
+x_nthreads(int nthreads);
+
+void
+x_prof_enable(int flag);
+
+void
+x_prof_reset(void);
+
+int
+x_prof_report(char *swig_bnd_char_1m);  // *report
+
 double
 x_interp_map_nodes(double *x_v,
                    double *y_v,
@@ -501,6 +513,69 @@ surf_get_zv_from_xyv(double *swig_np_dbl_in_v1,  // *xv
                      double *swig_np_dbl_in_v3,  // *p_map_v,
                      long n_swig_np_dbl_in_v3);
 
+int
+surf_gridding_add(double *swig_np_dbl_in_v1,  // *xv
+                  long n_swig_np_dbl_in_v1,
+                  double *swig_np_dbl_in_v2,  // *yv
+                  long n_swig_np_dbl_in_v2,
+                  double *swig_np_dbl_in_v3,  // *zv
+                  long n_swig_np_dbl_in_v3,
+                  int nx,
+                  int ny,
+                  double xori,
+                  double yori,
+                  double xinc,
+                  double yinc,
+                  int yflip,
+                  double rot_deg,
+                  int method,
+                  double radius,
+                  double power,
+                  double *swig_np_dbl_inplaceflat_v1,  // *accsum
+                  long n_swig_np_dbl_inplaceflat_v1,
+                  double *swig_np_dbl_inplaceflat_v2,  // *accw
+                  long n_swig_np_dbl_inplaceflat_v2,
+                  double *swig_np_dbl_inplaceflat_v3,  // *accd2
+                  long n_swig_np_dbl_inplaceflat_v3,
+                  int nthreads);
+
+int
+surf_gridding_result(double *swig_np_dbl_in_v1,  // *accsum
+                     long n_swig_np_dbl_in_v1,
+                     double *swig_np_dbl_in_v2,  // *accw
+                     long n_swig_np_dbl_in_v2,
+                     double *swig_np_dbl_in_v3,  // *accd2
+                     long n_swig_np_dbl_in_v3,
+                     int nx,
+                     int ny,
+                     double xinc,
+                     double yinc,
+                     int method,
+                     int niter,
+                     double *swig_np_dbl_aout_v1,  // *result
+                     long n_swig_np_dbl_aout_v1,
+                     int nthreads);
+
+int
+surf_sample_xyv(double *swig_np_dbl_in_v1,  // *xv
+                long n_swig_np_dbl_in_v1,
+                double *swig_np_dbl_in_v2,  // *yv
+                long n_swig_np_dbl_in_v2,
+                double *swig_np_dbl_inplace_v1,  // *zv
+                long n_swig_np_dbl_inplace_v1,
+                int nx,
+                int ny,
+                double xori,
+                double yori,
+                double xinc,
+                double yinc,
+                int yflip,
+                double rot_deg,
+                double *swig_np_dbl_in_v3,  // *p_map_v,
+                long n_swig_np_dbl_in_v3,
+                int method,
+                int nthreads);
+
 int
 surf_xy_as_values(double xori,
                   double xinc,
@@ -542,6 +617,34 @@ surf_slice_grd3d(int mcol,
                  double *p_prop_v,
                  int buffer);
 
+int
+surf_slice_grdcp3d(int mcol,
+                   int mrow,
+                   double xori,
+                   double xinc,
+                   double yori,
+                   double yinc,
+                   double rotation,
+                   int yflip,
+                   double *swig_np_dbl_in_v1,  // *p_zslice_v
+                   long n_swig_np_dbl_in_v1,
+                   double *swig_np_dbl_aout_v1,  // *p_map_v to update argout
+                   long n_swig_np_dbl_aout_v1,
+                   long ncol,
+                   long nrow,
+                   long nlay,
+
+                   double *swig_np_dbl_inplaceflat_v1,  // coordsv
+                   long n_swig_np_dbl_inplaceflat_v1,   // ncoord
+                   float *swig_np_flt_inplaceflat_v1,   // zcornsv
+                   long n_swig_np_flt_inplaceflat_v1,   // nzcorn
+                   int *swig_np_int_inplaceflat_v1,     // actnumsv
+                   long n_swig_np_int_inplaceflat_v1,   // nact
+
+                   double *swig_np_dbl_in_v2,  // *p_prop_v, C order
+                   long n_swig_np_dbl_in_v2,
+                   int buffer);
+
 int
 surf_resample(int nx1,
               int ny1,
@@ -563,7 +666,8 @@ surf_resample(int nx1,
               double rota2,
               double *swig_np_dbl_inplaceflat_v2,
               long n_swig_np_dbl_inplaceflat_v2,
-              int option);
+              int option,
+              int nthreads);
 
 int
 surf_get_dist_values(double xori,
@@ -594,6 +698,7 @@ surf_slice_cube(int ncx,
                 int yflip,
                 float *swig_np_flt_in_v1,  // *p_cubeval_v
                 long n_swig_np_flt_in_v1,
+                int bcache,
                 int mx,
                 int my,
                 double xori,
@@ -634,6 +739,7 @@ surf_slice_cube_v3(int ncol,
                    double czinc,
                    float *swig_np_flt_inplaceflat_v1,
                    long n_swig_np_flt_inplaceflat_v1,
+                   int bcache,
                    double *swig_np_dbl_inplaceflat_v1,
                    long n_swig_np_dbl_inplaceflat_v1,
                    double *swig_np_dbl_inplaceflat_v2,
@@ -651,6 +757,7 @@ surf_stack_slice_cube(int ncol,
                       double czori,
                       double czinc,
                       float *cubevalsv,
+                      int bcache,
                       double **stack,
                       mbool **rmask,
                       int optnearest,
@@ -670,6 +777,7 @@ surf_slice_cube_window(int ncx,
                        int yflip,
                        float *swig_np_flt_in_v1,  // *p_cubeval_v
                        long n_swig_np_flt_in_v1,  // ncube
+                       int bcache,
                        int mx,
                        int my,
                        double xori,
@@ -697,6 +805,7 @@ surf_cube_attr_intv(int ncol,
                     double czinc,
                     float *swig_np_flt_inplaceflat_v1,
                     long n_swig_np_flt_inplaceflat_v1,
+                    int bcache,
                     double *swig_np_dbl_inplaceflat_v1,
                     long n_swig_np_dbl_inplaceflat_v1,
                     double *swig_np_dbl_inplaceflat_v2,
@@ -714,7 +823,48 @@ surf_cube_attr_intv(int ncol,
                     int optmask,
                     int optprogress,
                     double maskthreshold,
-                    int optsum);
+                    int optsum,
+                    int nthreads);
+
+int
+surf_stats_add(double *swig_np_dbl_in_v1,             // *values
+               long n_swig_np_dbl_in_v1,              // nnode
+               int *swig_np_int_inplaceflat_v1,       // *count
+               long n_swig_np_int_inplaceflat_v1,     // ncount
+               double *swig_np_dbl_inplaceflat_v1,    // *mean
+               long n_swig_np_dbl_inplaceflat_v1,     // nmean
+               double *swig_np_dbl_inplaceflat_v2,    // *m2
+               long n_swig_np_dbl_inplaceflat_v2,     // nm2
+               double *swig_np_dbl_in_v2,             // *probs
+               long n_swig_np_dbl_in_v2,              // nprobs
+               double *swig_np_dbl_inplaceflat_v3,    // *heights
+               long n_swig_np_dbl_inplaceflat_v3,     // nheights
+               int *swig_np_int_inplaceflat_v2,       // *positions
+               long n_swig_np_int_inplaceflat_v2,     // npositions
+               int nthreads);
+
+int
+surf_stats_sketch_result(int *swig_np_int_in_v1,     // *count
+                         long n_swig_np_int_in_v1,    // nnode
+                         double *swig_np_dbl_in_v1,   // *probs
+                         long n_swig_np_dbl_in_v1,    // nprobs
+                         double *swig_np_dbl_in_v2,   // *heights
+                         long n_swig_np_dbl_in_v2,    // nheights
+                         double *swig_np_dbl_in_v3,   // *percentiles
+                         long n_swig_np_dbl_in_v3,    // npct
+                         double *swig_np_dbl_aout_v1,  // *result
+                         long n_swig_np_dbl_aout_v1,   // nresult
+                         int nthreads);
+
+int
+surf_stats_percentiles(double *swig_np_dbl_in_v1,    // *stack
+                       long n_swig_np_dbl_in_v1,     // nstack
+                       long nreal,
+                       double *swig_np_dbl_in_v2,    // *percentiles
+                       long n_swig_np_dbl_in_v2,     // npct
+                       double *swig_np_dbl_aout_v1,  // *result
+                       long n_swig_np_dbl_aout_v1,   // nresult
+                       int nthreads);
 
 void
 surf_sample_grd3d_lay(int nx,
@@ -832,7 +982,26 @@ sucu_ij_from_xy(int *i,
                 double rot_azi_deg,
                 int flag);
 
-void
+int
+sucu_ij_from_xyv(double *swig_np_dbl_in_v1,  // *xv
+                 long n_swig_np_dbl_in_v1,
+                 double *swig_np_dbl_in_v2,  // *yv
+                 long n_swig_np_dbl_in_v2,
+                 int *swig_np_int_aout_v1,  // *iv
+                 long n_swig_np_int_aout_v1,
+                 int *swig_np_int_aout_v2,  // *jv
+                 long n_swig_np_int_aout_v2,
+                 double xori,
+                 double xinc,
+                 double yori,
+                 double yinc,
+                 int nx,
+                 int ny,
+                 int yflip,
+                 double rot_deg,
+                 int flag);
+
+int
 cube_scan_segy_hdr(char *file,
                    int *gn_bitsheader,
                    int *gn_formatcode,
@@ -852,7 +1021,7 @@ cube_import_storm(int nx,
                   long n_swig_np_flt_aout_v1,  // nxyz
                   int option);
 
-void
+int
 cube_import_segy(char *file,
                  int hbitoffset,
                  int formatcode,
@@ -877,6 +1046,117 @@ cube_import_segy(char *file,
                  int option,
                  char *outfile);
 
+int
+x_ibm_to_ieee_array(int *swig_np_int_in_v1,       // *ibmv, raw file bytes
+                    long n_swig_np_int_in_v1,     // nibm
+                    float *swig_np_flt_aout_v1,   // *ieeev
+                    long n_swig_np_flt_aout_v1,   // nieee
+                    double *swig_dbl_out_p1,      // *minval
+                    double *swig_dbl_out_p2);     // *maxval
+
+int
+x_ieee_to_ibm_array(float *swig_np_flt_in_v1,    // *ieeev
+                    long n_swig_np_flt_in_v1,    // nieee
+                    int *swig_np_int_aout_v1,    // *ibmv, raw file bytes
+                    long n_swig_np_int_aout_v1);  // nibm
+
+int
+cube_segy_trace_index(char *file,
+                      long offset,
+                      long tracebytes,
+                      long ntraces,
+                      int *swig_np_int_aout_v1,     // *ilines
+                      long n_swig_np_int_aout_v1,   // nilines
+                      int *swig_np_int_aout_v2,     // *xlines
+                      long n_swig_np_int_aout_v2,   // nxlines
+                      int *swig_np_int_aout_v3,     // *traceidcodes
+                      long n_swig_np_int_aout_v3,   // ntraceidcodes
+                      double *swig_np_dbl_aout_v1,  // *cdpx
+                      long n_swig_np_dbl_aout_v1,   // ncdpx
+                      double *swig_np_dbl_aout_v2,  // *cdpy
+                      long n_swig_np_dbl_aout_v2,   // ncdpy
+                      int nthreads);
+
+int
+cube_import_segy_traces(char *file,
+                        long offset,
+                        long tracebytes,
+                        int formatcode,
+                        int nsamples,
+                        int *swig_np_int_in_v1,         // *traceno
+                        long n_swig_np_int_in_v1,       // ntraceno
+                        float *swig_np_flt_inplace_v1,  // *values
+                        long n_swig_np_flt_inplace_v1,  // nvalues
+                        int nthreads);
+
+int
+cube_bcache_open_segy(char *file,
+                      long offset,
+                      long tracebytes,
+                      int formatcode,
+                      int ncol,
+                      int nrow,
+                      int nlay,
+                      int *swig_np_int_in_v1,   // *traceno
+                      long n_swig_np_int_in_v1,  // ntraceno
+                      int bcol,
+                      int brow,
+                      int blay,
+                      long maxbytes);
+
+int
+cube_bcache_close(int bcache);
+
+int
+cube_bcache_stats(int bcache,
+                  long *swig_lon_out_p1,   // *nhits
+                  long *swig_lon_out_p2,   // *nmisses
+                  long *swig_lon_out_p3);  // *nbytes
+
+int
+cube_bcache_deadtraces(int bcache,
+                       int *swig_np_int_in_v1,   // *traceidcodes
+                       long n_swig_np_int_in_v1,  // ntraceidcodes
+                       float deadvalue,
+                       int option);
+
+int
+cube_bcache_read(int bcache,
+                 int i1,
+                 int i2,
+                 int j1,
+                 int j2,
+                 int k1,
+                 int k2,
+                 float *swig_np_flt_aout_v1,   // *values
+                 long n_swig_np_flt_aout_v1);  // nvalues
+
+int
+cube_bcache_open_xtgbrick(char *file, long maxbytes);
+
+int
+cube_export_xtgbrick(char *file,
+                     int ncol,
+                     int nrow,
+                     int nlay,
+                     float *swig_np_flt_in_v1,   // *values
+                     long n_swig_np_flt_in_v1,  // nvalues
+                     int bcol,
+                     int brow,
+                     int blay,
+                     int compression,
+                     double tolerance,
+                     int nthreads);
+
+int
+cube_import_xtgbrick(char *file,
+                     int ncol,
+                     int nrow,
+                     int nlay,
+                     float *swig_np_flt_aout_v1,   // *values
+                     long n_swig_np_flt_aout_v1,  // nvalues
+                     int nthreads);
+
 void
 cube_import_rmsregular(int iline,
                        int *ndef,
@@ -956,6 +1236,7 @@ cube_coord_val_ijk(int i,
                    double rot_deg,
                    int yflip,
                    float *p_val_v,
+                   int bcache,
                    double *x,
                    double *y,
                    double *z,
@@ -1008,6 +1289,7 @@ cube_value_ijk(int i,
                int ny,
                int nz,
                float *p_val_v,
+               int bcache,
                float *value);
 
 int
@@ -1026,6 +1308,7 @@ cube_value_xyz_cell(double x,
                     int ny,
                     int nz,
                     float *p_val_v,
+                    int bcache,
                     float *value,
                     int option);
 
@@ -1045,6 +1328,7 @@ cube_value_xyz_interp(double x,
                       int ny,
                       int nz,
                       float *p_val_v,
+                      int bcache,
                       float *value,
                       int option);
 
@@ -1084,6 +1368,7 @@ cube_resample_cube(int ncx1,
                    int yflip2,
                    float *swig_np_flt_in_v1,  // *p_cubeval2_v,
                    long n_swig_np_flt_in_v1,  // ncube2,
+                   int bcache2,
                    int option1,
                    int option2,
                    float ovalue);
@@ -1109,6 +1394,7 @@ cube_get_randomline(double *swig_np_dbl_in_v1,  // *xvec,
                     int nz,
                     float *swig_np_flt_in_v1,     // *p_val_v
                     long n_swig_np_flt_in_v1,     // ncube
+                    int bcache,
                     double *swig_np_dbl_aout_v1,  // *values
                     long n_swig_np_dbl_aout_v1,   // nvalues
                     int option);
@@ -1318,6 +1604,16 @@ grd3d_scan_eclbinary(FILE *fc,
                      long *recstarts,
                      long maxkw);
 
+long
+grd3d_scan_eclbinary_from(FILE *fc,
+                          long startpos,
+                          char *swig_bnd_char_1m,  // *keywords,
+                          int *rectype,
+                          long *reclengths,
+                          long *recstarts,
+                          long maxkw,
+                          long *swig_lon_out_p1);  // *endpos
+
 int
 grd3d_read_eclrecord(FILE *fc,
                      long recstart,
@@ -1329,6 +1625,13 @@ grd3d_read_eclrecord(FILE *fc,
                      double *swig_np_dbl_inplace_v1,
                      long n_swig_np_dbl_inplace_v1);
 
+int
+grd3d_read_eclrecord_dbl(FILE *fc,
+                         long recstart,
+                         int rectype,
+                         double *swig_np_dbl_inplace_v1,
+                         long n_swig_np_dbl_inplace_v1);
+
 int
 grd3d_roff2xtgeo_coord(int nx,
                        int ny,
@@ -1417,7 +1720,13 @@ grd3d_imp_ecl_egrid(FILE *fc,
                     long *nact,
                     int option);
 
-void
+int
+grd3d_grdecl_specgrid(FILE *fc,
+                      int *swig_int_out_p1,   // *nx
+                      int *swig_int_out_p2,   // *ny
+                      int *swig_int_out_p3);  // *nz
+
+int
 grd3d_import_grdecl(FILE *fc,
                     int nx,
                     int ny,
@@ -1706,6 +2015,47 @@ grd3d_point_in_cell(long ibstart,
                     int *nradsearch,
                     int option);
 
+int
+grd3d_cellindex_colbox(int nx,
+                       int ny,
+                       int nz,
+                       double *swig_np_dbl_in_v1,    // *coordsv
+                       long n_swig_np_dbl_in_v1,     // ncoordin
+                       double *swig_np_dbl_in_v2,    // *zcornsv
+                       long n_swig_np_dbl_in_v2,     // nzcornin
+                       double *swig_np_dbl_aout_v1,  // *colbox
+                       long n_swig_np_dbl_aout_v1);  // ncolbox
+
+int
+grd3d_cellindex_count(int nx,
+                      int ny,
+                      double *swig_np_dbl_in_v1,  // *colbox
+                      long n_swig_np_dbl_in_v1,   // ncolbox
+                      double xmin,
+                      double ymin,
+                      double xbin,
+                      double ybin,
+                      int nbx,
+                      int nby,
+                      int *swig_np_int_aout_v1,     // *counts
+                      long n_swig_np_int_aout_v1);  // ncounts
+
+int
+grd3d_cellindex_fill(int nx,
+                     int ny,
+                     double *swig_np_dbl_in_v1,  // *colbox
+                     long n_swig_np_dbl_in_v1,   // ncolbox
+                     double xmin,
+                     double ymin,
+                     double xbin,
+                     double ybin,
+                     int nbx,
+                     int nby,
+                     int *swig_np_int_in_v1,       // *binstart
+                     long n_swig_np_int_in_v1,     // nbinstart
+                     int *swig_np_int_aout_v1,     // *bincells
+                     long n_swig_np_int_aout_v1);  // nbincells
+
 int
 grd3d_points_ijk_cells(double *swig_np_dbl_in_v1,  // *xvec
                        long n_swig_np_dbl_in_v1,   // nxvec
@@ -1714,19 +2064,6 @@ grd3d_points_ijk_cells(double *swig_np_dbl_in_v1,  // *xvec
                        double *swig_np_dbl_in_v3,  // *zvec
                        long n_swig_np_dbl_in_v3,   // nzvec
 
-                       int mcol,
-                       int mrow,
-                       double xori,
-                       double yori,
-                       double xinc,
-                       double yinc,
-                       double rotation,
-                       int yflip,
-                       double *maptopi,
-                       double *maptopj,
-                       double *mapbasi,
-                       double *mapbasj,
-
                        int nx,
                        int ny,
                        int nz,
@@ -1739,15 +2076,31 @@ grd3d_points_ijk_cells(double *swig_np_dbl_in_v1,  // *xvec
 
                        double *swig_np_dbl_in_v6,  // *p_zcoordone_v
                        long n_swig_np_dbl_in_v6,   // nzcornonein
+                       double *swig_np_dbl_in_v8,  // *corners cache
+                       long n_swig_np_dbl_in_v8,   // ncorners, 0 if no cache
+
+                       double *swig_np_dbl_in_v7,  // *colbox
+                       long n_swig_np_dbl_in_v7,   // ncolbox
+                       int *swig_np_int_in_v2,     // *binstart
+                       long n_swig_np_int_in_v2,   // nbinstart
+                       int *swig_np_int_in_v3,     // *bincells
+                       long n_swig_np_int_in_v3,   // nbincells
+                       double xmin,
+                       double ymin,
+                       double xbin,
+                       double ybin,
+                       int nbx,
+                       int nby,
 
                        int actnumoption,
 
-                       int *swig_np_int_aout_v1,     // *ivec
-                       long n_swig_np_int_aout_v1,   // nivec
-                       int *swig_np_int_aout_v2,     // *jvec
-                       long n_swig_np_int_aout_v2,   // njvec
-                       int *swig_np_int_aout_v3,     // *kvec
-                       long n_swig_np_int_aout_v3);  // nkvec
+                       int *swig_np_int_aout_v1,    // *ivec
+                       long n_swig_np_int_aout_v1,  // nivec
+                       int *swig_np_int_aout_v2,    // *jvec
+                       long n_swig_np_int_aout_v2,  // njvec
+                       int *swig_np_int_aout_v3,    // *kvec
+                       long n_swig_np_int_aout_v3,  // nkvec
+                       int nthreads);
 
 int
 grd3d_get_randomline(double *swig_np_dbl_in_v1,  // *xvec,
@@ -1758,19 +2111,6 @@ grd3d_get_randomline(double *swig_np_dbl_in_v1,  // *xvec,
                      double zmax,
                      int nzsam,
 
-                     int mcol,
-                     int mrow,
-                     double xori,
-                     double yori,
-                     double xinc,
-                     double yinc,
-                     double rotation,
-                     int yflip,
-                     double *maptopi,
-                     double *maptopj,
-                     double *mapbasi,
-                     double *mapbasj,
-
                      int nx,
                      int ny,
                      int nz,
@@ -1789,6 +2129,19 @@ grd3d_get_randomline(double *swig_np_dbl_in_v1,  // *xvec,
                      int *swig_np_int_in_v2,     // *p_actnumone_v
                      long n_swig_np_int_in_v2,   // nactonein
 
+                     double *swig_np_dbl_in_v6,  // *colbox
+                     long n_swig_np_dbl_in_v6,   // ncolbox
+                     int *swig_np_int_in_v3,     // *binstart
+                     long n_swig_np_int_in_v3,   // nbinstart
+                     int *swig_np_int_in_v4,     // *bincells
+                     long n_swig_np_int_in_v4,   // nbincells
+                     double xmin,
+                     double ymin,
+                     double xbin,
+                     double ybin,
+                     int nbx,
+                     int nby,
+
                      double *swig_np_dbl_aout_v1,  // *values
                      long n_swig_np_dbl_aout_v1);  // nvalues
 
@@ -1940,6 +2293,22 @@ grd3d_corners(int i,
 
               double corners[]);
 
+int
+grd3d_geometry_cache(int nx,
+                     int ny,
+                     int nz,
+                     double *swig_np_dbl_in_v1,           // coordsv
+                     long n_swig_np_dbl_in_v1,            // ncoord
+                     double *swig_np_dbl_in_v2,           // zcornsv
+                     long n_swig_np_dbl_in_v2,            // nzcorn
+                     double *swig_np_dbl_inplaceflat_v1,  // corners
+                     long n_swig_np_dbl_inplaceflat_v1,   // ncorners
+                     double *swig_np_dbl_inplaceflat_v2,  // aabb
+                     long n_swig_np_dbl_inplaceflat_v2,   // naabb
+                     double *swig_np_dbl_inplaceflat_v3,  // centroids
+                     long n_swig_np_dbl_inplaceflat_v3,   // ncentroids
+                     int nthreads);
+
 double
 grd3d_zminmax(int i, int j, int k, int nx, int ny, int nz, double *zcornsv, int option);
 
@@ -1998,6 +2367,19 @@ grd3d_well_ijk(int nx,
                int *swig_np_int_in_v2,     // *p_actnum_onelay_v
                long n_swig_np_int_in_v2,   // nactonein
 
+               double *swig_np_dbl_in_v4,  // *colbox
+               long n_swig_np_dbl_in_v4,   // ncolbox
+               int *swig_np_int_in_v3,     // *binstart
+               long n_swig_np_int_in_v3,   // nbinstart
+               int *swig_np_int_in_v4,     // *bincells
+               long n_swig_np_int_in_v4,   // nbincells
+               double xmin,
+               double ymin,
+               double xbin,
+               double ybin,
+               int nbx,
+               int nby,
+
                int nval,
                double *p_utme_v,
                double *p_utmn_v,
@@ -2173,6 +2555,16 @@ grdcp3d_imp_roffbin_prop_ivec(FILE *fc,
                               int *swig_np_int_inplaceflat_v1,  // actnumsv1
                               long n_swig_np_int_inplaceflat_v1);
 
+int
+grdcp3d_imp_roffbin_prop_fvec(FILE *fc,
+                              int swap,
+                              long bytepos,
+                              long ncol,
+                              long nrow,
+                              long nlay,
+                              float *swig_np_flt_inplaceflat_v1,  // pvec
+                              long n_swig_np_flt_inplaceflat_v1);
+
 int
 grdcp3d_imp_roffbin_prop_bvec(FILE *fc,
                               int swap,
@@ -2213,6 +2605,150 @@ grdcp3d_conv_grid_roxapi(long ncol,
                          double *swig_np_dbl_aout_v3,  // zcornsv
                          long n_swig_np_dbl_aout_v3);  // nzcorners
 
+int
+grdcp3d_cellindex_colbox(long ncol,
+                         long nrow,
+                         long nlay,
+                         double *swig_np_dbl_inplaceflat_v1,  // coordsv
+                         long n_swig_np_dbl_inplaceflat_v1,   // ncoord
+                         float *swig_np_flt_inplaceflat_v1,   // zcornsv
+                         long n_swig_np_flt_inplaceflat_v1,   // nzcorn
+                         double *swig_np_dbl_aout_v1,         // colbox
+                         long n_swig_np_dbl_aout_v1);         // ncolbox
+
+int
+grdcp3d_points_ijk_cells(double *swig_np_dbl_in_v1,  // *xvec
+                         long n_swig_np_dbl_in_v1,   // nxvec
+                         double *swig_np_dbl_in_v2,  // *yvec
+                         long n_swig_np_dbl_in_v2,   // nyvec
+                         double *swig_np_dbl_in_v3,  // *zvec
+                         long n_swig_np_dbl_in_v3,   // nzvec
+
+                         long ncol,
+                         long nrow,
+                         long nlay,
+                         double *swig_np_dbl_inplaceflat_v1,  // coordsv
+                         long n_swig_np_dbl_inplaceflat_v1,   // ncoord
+                         float *swig_np_flt_inplaceflat_v1,   // zcornsv
+                         long n_swig_np_flt_inplaceflat_v1,   // nzcorn
+                         int *swig_np_int_inplaceflat_v1,     // actnumsv
+                         long n_swig_np_int_inplaceflat_v1,   // nact
+                         double *swig_np_dbl_inplaceflat_v2,  // corners cache
+                         long n_swig_np_dbl_inplaceflat_v2,   // 0 if no cache
+
+                         double *swig_np_dbl_in_v4,  // *colbox
+                         long n_swig_np_dbl_in_v4,   // ncolbox
+                         int *swig_np_int_in_v1,     // *binstart
+                         long n_swig_np_int_in_v1,   // nbinstart
+                         int *swig_np_int_in_v2,     // *bincells
+                         long n_swig_np_int_in_v2,   // nbincells
+                         double xmin,
+                         double ymin,
+                         double xbin,
+                         double ybin,
+                         int nbx,
+                         int nby,
+
+                         int actnumoption,
+
+                         int *swig_np_int_aout_v1,    // *ivec
+                         long n_swig_np_int_aout_v1,  // nivec
+                         int *swig_np_int_aout_v2,    // *jvec
+                         long n_swig_np_int_aout_v2,  // njvec
+                         int *swig_np_int_aout_v3,    // *kvec
+                         long n_swig_np_int_aout_v3,  // nkvec
+                         int nthreads);
+
+int
+grdcp3d_well_ijk(long ncol,
+                 long nrow,
+                 long nlay,
+
+                 double *swig_np_dbl_inplaceflat_v1,  // coordsv
+                 long n_swig_np_dbl_inplaceflat_v1,   // ncoord
+                 float *swig_np_flt_inplaceflat_v1,   // zcornsv
+                 long n_swig_np_flt_inplaceflat_v1,   // nzcorn
+                 int *swig_np_int_inplaceflat_v1,     // actnumsv
+                 long n_swig_np_int_inplaceflat_v1,   // nact
+
+                 double *swig_np_dbl_in_v1,  // *colbox
+                 long n_swig_np_dbl_in_v1,   // ncolbox
+                 int *swig_np_int_in_v1,     // *binstart
+                 long n_swig_np_int_in_v1,   // nbinstart
+                 int *swig_np_int_in_v2,     // *bincells
+                 long n_swig_np_int_in_v2,   // nbincells
+                 double xmin,
+                 double ymin,
+                 double xbin,
+                 double ybin,
+                 int nbx,
+                 int nby,
+
+                 int nval,
+                 double *p_utme_v,
+                 double *p_utmn_v,
+                 double *p_tvds_v,
+                 int *ivector,
+                 int *jvector,
+                 int *kvector,
+                 int iflag);
+
+int
+grdcp3d_get_randomline(double *swig_np_dbl_in_v1,  // *xvec,
+                       long n_swig_np_dbl_in_v1,   // nxvec,
+                       double *swig_np_dbl_in_v2,  // *yvec,
+                       long n_swig_np_dbl_in_v2,   // nyvec,
+                       double zmin,
+                       double zmax,
+                       int nzsam,
+
+                       long ncol,
+                       long nrow,
+                       long nlay,
+
+                       double *swig_np_dbl_inplaceflat_v1,  // coordsv
+                       long n_swig_np_dbl_inplaceflat_v1,   // ncoord
+                       float *swig_np_flt_inplaceflat_v1,   // zcornsv
+                       long n_swig_np_flt_inplaceflat_v1,   // nzcorn
+                       int *swig_np_int_inplaceflat_v1,     // actnumsv
+                       long n_swig_np_int_inplaceflat_v1,   // nact
+
+                       double *swig_np_dbl_in_v3,  // *propv, C order
+                       long n_swig_np_dbl_in_v3,   // nprop
+
+                       double *swig_np_dbl_in_v4,  // *colbox
+                       long n_swig_np_dbl_in_v4,   // ncolbox
+                       int *swig_np_int_in_v1,     // *binstart
+                       long n_swig_np_int_in_v1,   // nbinstart
+                       int *swig_np_int_in_v2,     // *bincells
+                       long n_swig_np_int_in_v2,   // nbincells
+                       double xmin,
+                       double ymin,
+                       double xbin,
+                       double ybin,
+                       int nbx,
+                       int nby,
+
+                       double *swig_np_dbl_aout_v1,  // *values
+                       long n_swig_np_dbl_aout_v1);  // nvalues
+
+int
+grdcp3d_calc_dxdy(long ncol,
+                  long nrow,
+                  long nlay,
+                  double *swig_np_dbl_inplaceflat_v1,  // coordsv
+                  long n_swig_np_dbl_inplaceflat_v1,   // ncoord
+                  float *swig_np_flt_inplaceflat_v1,   // zcornsv
+                  long n_swig_np_flt_inplaceflat_v1,   // nzcorn
+                  int *swig_np_int_inplaceflat_v1,     // actnumsv
+                  long n_swig_np_int_inplaceflat_v1,   // nact
+                  double *swig_np_dbl_inplace_v1,      // *dx,
+                  long n_swig_np_dbl_inplace_v1,       // ntot,
+                  double *swig_np_dbl_inplace_v2,      // *dy,
+                  long n_swig_np_dbl_inplace_v2,       // ntot,
+                  int option1,
+                  int option2);
+
 void
 grdcp3d_quality_indicators(long ncol,
                            long nrow,
@@ -2224,7 +2760,9 @@ grdcp3d_quality_indicators(long ncol,
                            int *swig_np_int_inplaceflat_v1,     // actnumsv,
                            long n_swig_np_int_inplaceflat_v1,   // nactnum
                            float *swig_np_flt_inplaceflat_v2,   // fresults
-                           long n_swig_np_flt_inplaceflat_v2);  // nactnum
+                           long n_swig_np_flt_inplaceflat_v2,   // nactnum
+                           double *swig_np_dbl_inplaceflat_v2,  // corners cache
+                           long n_swig_np_dbl_inplaceflat_v2);  // 0 if no cache
 void
 grdcp3d_cellvol(long ncol,
                 long nrow,
@@ -2237,8 +2775,27 @@ grdcp3d_cellvol(long ncol,
                 long n_swig_np_int_inplaceflat_v1,   // nactnum
                 double *swig_np_dbl_inplaceflat_v2,  // cellvolsv
                 long n_swig_np_dbl_inplaceflat_v2,   // ncell
+                double *swig_np_dbl_inplaceflat_v3,  // corners cache
+                long n_swig_np_dbl_inplaceflat_v3,   // ncorners, 0 if no cache
                 int precision,
-                int option);
+                int option,
+                int nthreads);
+
+int
+grdcp3d_geometry_cache(long ncol,
+                       long nrow,
+                       long nlay,
+                       double *swig_np_dbl_inplaceflat_v1,  // coordsv
+                       long n_swig_np_dbl_inplaceflat_v1,   // ncoord
+                       float *swig_np_flt_inplaceflat_v1,   // zcornsv
+                       long n_swig_np_flt_inplaceflat_v1,   // nzcorn
+                       double *swig_np_dbl_inplaceflat_v2,  // corners
+                       long n_swig_np_dbl_inplaceflat_v2,   // ncorners
+                       double *swig_np_dbl_inplaceflat_v3,  // aabb
+                       long n_swig_np_dbl_inplaceflat_v3,   // naabb
+                       double *swig_np_dbl_inplaceflat_v4,  // centroids
+                       long n_swig_np_dbl_inplaceflat_v4,   // ncentroids
+                       int nthreads);
 
 /*
  *======================================================================================
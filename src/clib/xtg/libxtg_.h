@@ -80,6 +80,18 @@ x_chk_point_in_cell(double x, double y, double z, double coor[], int imethod);
 int
 x_chk_point_in_hexahedron(double x, double y, double z, double *coor, int flip);
 
+void
+x_corners_aabb_centroid(double *corners, double *aabb, double *centroid);
+
+/* length of a prepared cell for x_point_in_hexahedron_prepared() */
+#define HEXA_NPREP 180
+
+void
+x_hexahedron_prepare(double *corners, double *prep);
+
+int
+x_point_in_hexahedron_prepared(double x0, double y0, double z0, double *prep);
+
 void
 x_2d_rect_corners(double x,
                   double y,
@@ -216,21 +228,184 @@ float
 x_roffgetfloatvalue(char *name, FILE *fc);
 int
 x_roffgetintvalue(char *name, FILE *fc);
-void
+int
 x_roffgetfloatarray(float *array, int num, FILE *fc);
-void
+int
 x_roffgetbytearray(unsigned char *array, int num, FILE *fc);
-void
+int
 x_roffgetintarray(int *array, int num, FILE *fc);
 void
 x_roffgetchararray(char *array, int num, FILE *fc);
 
+void
+x_swap_block(void *buf, size_t size, size_t nitems);
+int
+x_roffbin_read_block(FILE *fc,
+                     long bytepos,
+                     int swap,
+                     size_t size,
+                     size_t nitems,
+                     void *buf);
+int
+x_roffbin_read_prop(FILE *fc,
+                    long bytepos,
+                    int swap,
+                    int dtype,
+                    long ncol,
+                    long nrow,
+                    long nlay,
+                    float *fvec,
+                    int *ivec);
+
+/* in-process profiling of C routines, cf. x_prof.c */
+extern int XTG_PROFILING;
+
+double
+x_prof_tic(void);
+
+void
+x_prof_toc(const char *name, double t0, long nitems);
+
+/* rotated regular lattice with precomputed affine transform, cf. x_lattice.c */
+struct xtg_lattice
+{
+    double xori, yori;
+    double xinc, yinc; /* yinc is signed with yflip */
+    double cosa, sina;
+    double xlen, ylen; /* extent along each axis, inc * (n - 1) */
+    double xlen_inv, ylen_inv;
+    int nx, ny;
+};
+
+void
+x_lattice_init(struct xtg_lattice *lat,
+               double xori,
+               double xinc,
+               double yori,
+               double yinc,
+               int nx,
+               int ny,
+               int yflip,
+               double rot_deg);
+
+int
+x_lattice_ij_from_xy(const struct xtg_lattice *lat,
+                     double x,
+                     double y,
+                     int flag,
+                     int *i,
+                     int *j,
+                     double *rx,
+                     double *ry);
+
+void
+x_lattice_xy_from_ij(const struct xtg_lattice *lat, int i, int j, double *x, double *y);
+
+double
+surf_get_z_from_lattice(const struct xtg_lattice *lat,
+                        double x,
+                        double y,
+                        double *p_map_v);
+
+int
+cube_ijk_from_xyz_lattice(const struct xtg_lattice *lat,
+                          int *i,
+                          int *j,
+                          int *k,
+                          double *rx,
+                          double *ry,
+                          double *rz,
+                          double x,
+                          double y,
+                          double z,
+                          double zori,
+                          double zinc,
+                          int nz,
+                          int flag);
+
+int
+cube_value_xyz_cell_lattice(const struct xtg_lattice *lat,
+                            double x,
+                            double y,
+                            double z,
+                            double zori,
+                            double zinc,
+                            int nz,
+                            float *p_val_v,
+                            int bcache,
+                            float *value);
+
+int
+cube_value_xyz_interp_lattice(const struct xtg_lattice *lat,
+                              double x,
+                              double y,
+                              double z,
+                              double zori,
+                              double zinc,
+                              int nz,
+                              float *p_val_v,
+                              int bcache,
+                              float *value,
+                              int option);
+
+/* streaming reader for Eclipse ASCII (GRDECL) files, cf. x_grdecl_reader.c */
+struct grdecl_reader
+{
+    FILE *fc;
+    char *buf;
+    size_t nbuf;
+    size_t pos;
+    int eof;
+    long nrepeat;    /* remaining values of a N*value repeat */
+    double repvalue; /* the value to repeat */
+};
+
+int
+x_grdecl_open(struct grdecl_reader *rd, FILE *fc);
+
+void
+x_grdecl_close(struct grdecl_reader *rd);
+
+int
+x_grdecl_token(struct grdecl_reader *rd, char *token, int maxlen);
+
+int
+x_grdecl_find_keyword(struct grdecl_reader *rd, const char *keyword);
+
+long
+x_grdecl_read_doubles(struct grdecl_reader *rd,
+                      double *values,
+                      long nvalues,
+                      double defval);
+
+double
+x_strtod_fast(const char *str, char **endptr);
+
 /*
  *--------------------------------------------------------------------------------------
  * No-public grd3d routines for other issues
  *--------------------------------------------------------------------------------------
  */
 
+int
+grd3d_cellindex_maxcols(int nbx, int nby, int *binstart);
+
+int
+grd3d_cellindex_lookup(double x,
+                       double y,
+                       double z,
+                       double *colbox,
+                       double xmin,
+                       double ymin,
+                       double xbin,
+                       double ybin,
+                       int nbx,
+                       int nby,
+                       int *binstart,
+                       int *bincells,
+                       int *cols,
+                       int ncols);
+
 int
 u_read_segy_bitem(int nc,
                   int ic,
@@ -246,3 +421,40 @@ u_read_segy_bitem(int nc,
 
 void
 u_ibm_to_float(int *from, int *to, int n, int endian, int swap);
+
+void
+x_ibm_to_ieee(const void *src, float *dst, long n, float *minval, float *maxval);
+void
+x_ieee_be_to_float(const void *src, float *dst, long n, float *minval, float *maxval);
+void
+x_ieee_to_ibm(const float *src, void *dst, long n);
+void
+x_float_to_ieee_be(const float *src, void *dst, long n);
+
+/* SEGY sample decoding, cf. cube_import_segy_traces.c */
+int
+x_segy_sample_bytes(int formatcode);
+void
+x_segy_decode_samples(const unsigned char *data, int formatcode, long n, float *values);
+
+/* bricked cube format, cf. cube_xtgbrick.c */
+int
+x_xtgbrick_header(FILE *fc, int *dims, int64_t **offsets, long *nbricks);
+int
+x_xtgbrick_decode(const unsigned char *blob,
+                  long nblob,
+                  long ntrace,
+                  int nk,
+                  float *values,
+                  unsigned char *work);
+
+/* brick cache for windowed cubes, cf. cube_bcache.c */
+float
+cube_bcache_value(int bcache, long ic);
+int
+cube_bcache_trace(int bcache, long icol, int klo, int khi, float *trace);
+
+/* cube value at C order index ic, from the array or, for windowed cubes
+   (bcache >= 0), from the brick cache */
+#define CUBE_VALUE(p_val_v, bcache, ic)                                                \
+    ((bcache) < 0 ? (p_val_v)[ic] : cube_bcache_value((bcache), (ic)))
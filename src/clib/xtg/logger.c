@@ -14,6 +14,7 @@ int DEBUG = 0;
 static int XTG_LOGGING_SET = 0;
 
 static int XTG_LOGGING_LEVEL = 30;
+int XTG_LOGGING_ACTIVE = -1; /* as XTG_LOGGING_LEVEL, but -1 before init */
 static int XTG_LOGGING_FORMAT = 1;
 static double XTG_START_TIME = 0.0;
 
@@ -44,11 +45,12 @@ _logger_init()
 
     XTG_LOGGING_SET = 1;
     XTG_START_TIME = monotonic_seconds();
+    XTG_LOGGING_ACTIVE = XTG_LOGGING_LEVEL;
 
     llevel = getenv("XTG_LOGGING_LEVEL");
 
     if (llevel == NULL) {
-        return -1;
+        return 0;
     }
 
     if (strcmp(llevel, "INFO") == 0)
@@ -65,6 +67,7 @@ _logger_init()
         llev = 50;
 
     XTG_LOGGING_LEVEL = llev;
+    XTG_LOGGING_ACTIVE = llev;
 
     lfmt = getenv("XTG_LOGGING_FORMAT");
     if (lfmt != NULL) {
@@ -85,119 +88,77 @@ _logger_init()
 
 static void
 _logger_tell(int line,
-             const char *filename,
+             char *file,
              const char *func,
-             const char *message,
+             const char *fmt,
+             va_list ap,
              const char *ltype,
              int level)
 {
+    char message[550];
+
+    _logger_init();
+
+    /* the level may be unknown when checked in the calling macro */
+    if (level < XTG_LOGGING_LEVEL)
+        return;
+
+    vsnprintf(message, sizeof(message), fmt, ap);
 
     double dtime = monotonic_seconds() - XTG_START_TIME;
 
-    if (level >= XTG_LOGGING_LEVEL) {
-        if (XTG_LOGGING_FORMAT == 1) {
-            printf("%8s: (%7.3fs) \t%s <c>\n", ltype, dtime, message);
-        } else if (XTG_LOGGING_FORMAT >= 2) {
-            printf("%8s (%7.3lfs) %44s [%42s] %4d >> \t%s \n", ltype, dtime, filename,
-                   func, line, message);
-        }
+    if (XTG_LOGGING_FORMAT == 1) {
+        printf("%8s: (%7.3fs) \t%s <c>\n", ltype, dtime, message);
+    } else if (XTG_LOGGING_FORMAT >= 2) {
+        printf("%8s (%7.3lfs) %44s [%42s] %4d >> \t%s \n", ltype, dtime,
+               _basename(file), func, line, message);
     }
     XTG_START_TIME = monotonic_seconds();
 }
 
 void
-logger_debug(int line, char *file, const char *func, const char *fmt, ...)
+_logger_debug(int line, char *file, const char *func, const char *fmt, ...)
 {
-
-    if (_logger_init() == -1)
-        return;
-
     va_list ap;
-    char message[550], msg[547];
-
-    const char *filename = _basename(file);
-
     va_start(ap, fmt);
-    vsprintf(msg, fmt, ap);
+    _logger_tell(line, file, func, fmt, ap, "DEBUG", 10);
     va_end(ap);
-    sprintf(message, "%s", msg);
-    _logger_tell(line, filename, func, message, "DEBUG", 10);
 }
 
 void
-logger_info(int line, char *file, const char *func, const char *fmt, ...)
+_logger_info(int line, char *file, const char *func, const char *fmt, ...)
 {
-
-    if (_logger_init() == -1)
-        return;
-
     va_list ap;
-    char message[550], msg[547];
-
-    const char *filename = _basename(file);
-
     va_start(ap, fmt);
-    vsprintf(msg, fmt, ap);
+    _logger_tell(line, file, func, fmt, ap, "INFO", 20);
     va_end(ap);
-    sprintf(message, "%s", msg);
-    _logger_tell(line, filename, func, message, "INFO", 20);
 }
 
 void
-logger_warn(int line, char *file, const char *func, const char *fmt, ...)
+_logger_warn(int line, char *file, const char *func, const char *fmt, ...)
 {
-
-    if (_logger_init() == -1)
-        return;
-
     va_list ap;
-    char message[550], msg[547];
-
-    const char *filename = _basename(file);
-
     va_start(ap, fmt);
-    vsprintf(msg, fmt, ap);
+    _logger_tell(line, file, func, fmt, ap, "WARNING", 30);
     va_end(ap);
-    sprintf(message, "%s", msg);
-    _logger_tell(line, filename, func, message, "WARNING", 30);
 }
 
 void
-logger_error(int line, char *file, const char *func, const char *fmt, ...)
+_logger_error(int line, char *file, const char *func, const char *fmt, ...)
 {
-
-    if (_logger_init() == -1)
-        return;
-
     va_list ap;
-    char message[550], msg[547];
-
-    const char *filename = _basename(file);
-
     va_start(ap, fmt);
-    vsprintf(msg, fmt, ap);
+    _logger_tell(line, file, func, fmt, ap, "ERROR", 40);
     va_end(ap);
-    sprintf(message, "%s", msg);
-    _logger_tell(line, filename, func, message, "ERROR", 40);
 }
 
 void
-logger_critical(int line, char *file, const char *func, const char *fmt, ...)
+_logger_critical(int line, char *file, const char *func, const char *fmt, ...)
 {
-
-    if (_logger_init() == -1)
-        return;
-
     va_list ap;
-    char message[550], msg[547];
-
-    const char *filename = _basename(file);
-
     va_start(ap, fmt);
-    vsprintf(msg, fmt, ap);
+    _logger_tell(line, file, func, fmt, ap, "CRITICAL", 50);
     va_end(ap);
-    sprintf(message, "%s", msg);
-    _logger_tell(line, filename, func, message, "CRITICAL", 50);
     exit(666);
 }
 
@@ -8,11 +8,39 @@
 #define FI __FILE__
 #define FU __FUNCTION__
 
-void logger_info(int line, char *file, const char *func, const char *fmt, ...);
-void logger_debug(int line, char *file, const char *func, const char *fmt, ...);
-void logger_warn(int line, char *file, const char *func, const char *fmt, ...);
-void logger_error(int line, char *file, const char *func, const char *fmt, ...);
-void logger_critical(int line, char *file, const char *func, const char *fmt, ...);
+/* Logging levels are as in Python: DEBUG 10, INFO 20, WARNING 30, ERROR 40,
+   CRITICAL 50. The level is read from the XTG_LOGGING_LEVEL environment
+   variable at first use; until then XTG_LOGGING_ACTIVE is -1 (i.e. unknown) */
+extern int XTG_LOGGING_ACTIVE;
+
+void _logger_info(int line, char *file, const char *func, const char *fmt, ...);
+void _logger_debug(int line, char *file, const char *func, const char *fmt, ...);
+void _logger_warn(int line, char *file, const char *func, const char *fmt, ...);
+void _logger_error(int line, char *file, const char *func, const char *fmt, ...);
+void _logger_critical(int line, char *file, const char *func, const char *fmt, ...);
+
+/* The level check is done here, so a disabled level costs one comparison, with
+   no formatting of the message. Build with XTG_STRIP_DEBUG_LOGGING to remove
+   debug logging completely (arguments are still type checked) */
+#define _LOGGER_IF(level, fn, ...)                                               \
+    do {                                                                         \
+        if (XTG_LOGGING_ACTIVE <= (level))                                       \
+            fn(__VA_ARGS__);                                                     \
+    } while (0)
+
+#ifdef XTG_STRIP_DEBUG_LOGGING
+#define logger_debug(...)                                                        \
+    do {                                                                         \
+        if (0)                                                                   \
+            _logger_debug(__VA_ARGS__);                                          \
+    } while (0)
+#else
+#define logger_debug(...) _LOGGER_IF(10, _logger_debug, __VA_ARGS__)
+#endif
+#define logger_info(...) _LOGGER_IF(20, _logger_info, __VA_ARGS__)
+#define logger_warn(...) _LOGGER_IF(30, _logger_warn, __VA_ARGS__)
+#define logger_error(...) _LOGGER_IF(40, _logger_error, __VA_ARGS__)
+#define logger_critical(...) _logger_critical(__VA_ARGS__)
 
 
 /* A cross platform monotonic timer. Copyright 2013 Alex Reece. */
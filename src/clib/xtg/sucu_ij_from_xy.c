@@ -28,10 +28,16 @@
 *     her (yet). A numerical presision is however taken into account along
 *     the border.
 *
+*     sucu_ij_from_xyv is the vector version, for arrays of points, where the
+*     lattice geometry (rotation etc.) is computed once. Points outside get
+*     I and J equal to 0.
+*
 * ARGUMENTS:
 *    i, j           o     col/row to update
 *    rx, ry         o     relative coords of input point (useful in interpol)
 *    x, y           i     Input point
+*    xv, yv         i     Input points as arrays (sucu_ij_from_xyv, with length)
+*    iv, jv         o     Result col/row arrays (sucu_ij_from_xyv, with length)
 *    xori           i     X origin coordinate
 *    xinc           i     X increment
 *    yori           i     Y origin coordinate
@@ -46,6 +52,7 @@
 *
 * RETURNS:
 *    Function: 0: upon success. If problems or outside <> 0:. Update pointers
+*    The vector version returns -4 if array lengths differ.
 *
 * TODO/ISSUES/BUGS:
 *    yflip handling?
@@ -75,85 +82,50 @@ sucu_ij_from_xy(int *i,
                 double rot_deg,
                 int flag)
 {
-    /* locals */
-    int ierx = 0, iery = 0;
-    double angle, x1, x2, x3, y1, y2, y3, px, py, relx, rely, zin = 0.0;
-    double x0, y0, z0;
-    int ipos, jpos, option2;
-
-    angle = rot_deg * PI / 180.0;
-
-    yinc = yinc * yflip;
-
-    /* find the RELATIVE corners of the map or cube */
-
-    /*
-     *   3               4
-     *   |---------------|
-     *   |               |
-     *   |         P     |
-     *   |               |
-     *   |---------------|
-     *   1               2
-     */
-
-    /* first: actual corners (do not need corner 4): */
-
-    x1 = 0.0;
-    y1 = 0.0;
-
-    x2 = xinc * (nx - 1) * cos(angle);
-    y2 = xinc * (nx - 1) * sin(angle);
-
-    x3 = yinc * (ny - 1) * cos(angle + PI / 2.0);
-    y3 = yinc * (ny - 1) * sin(angle + PI / 2.0);
-
-    /* xin = xin - xori + 0.5 * FLOATEPS;  // Workaround: To avoid numerical trouble */
-    /* y = y - yori + 0.5 * FLOATEPS;  // when points are exact overlapping... */
-    xin = xin - xori;
-    yin = yin - yori;
-
-    /* determine _relative_ coordinate of point x y on X axis: */
-    option2 = 2; /* allow for numerical precision error for border */
+    struct xtg_lattice lat;
 
-    ierx = x_point_line_pos(x1, y1, 0.0, x2, y2, 0.0, xin, yin, zin, &x0, &y0, &z0,
-                            &relx, option2);
+    /* for many points, init the lattice once and use x_lattice_ij_from_xy */
+    x_lattice_init(&lat, xori, xinc, yori, yinc, nx, ny, yflip, rot_deg);
 
-    /* determine _relative_ coordinate of point x y on Y axis: */
-    iery = x_point_line_pos(x1, y1, 0.0, x3, y3, 0.0, xin, yin, zin, &x0, &y0, &z0,
-                            &rely, option2);
-
-    if (ierx == -1 || iery == -1) {
-        return -1;
-    }
-    /* now use the new coordinates */
-
-    px = relx * xinc * (nx - 1);
-    py = rely * yinc * (ny - 1);
-
-    if (flag == 0) {
-        /* ~find cell index */
-        ipos = (int)((px + 0.5 * xinc) / xinc) + 1;
-        jpos = (int)((py + 0.5 * yinc) / yinc) + 1;
-        *i = ipos;
-        *j = jpos;
-    } else {
-        /* ~find nodes; which is the lower left index position: */
-        ipos = (int)((px) / xinc) + 1;
-        jpos = (int)((py) / yinc) + 1;
-
-        /* if (ipos >= nx) ipos = nx - 1; */
-        /* if (jpos >= nx) jpos = ny - 1; */
-
-        /* if (ipos < 1) ipos = 1; */
-        /* if (jpos < 1) jpos = 1; */
+    return x_lattice_ij_from_xy(&lat, xin, yin, flag, i, j, rx, ry);
+}
 
-        *i = ipos;
-        *j = jpos;
+int
+sucu_ij_from_xyv(double *xv,
+                 long nxv,
+                 double *yv,
+                 long nyv,
+                 int *iv,
+                 long niv,
+                 int *jv,
+                 long njv,
+                 double xori,
+                 double xinc,
+                 double yori,
+                 double yinc,
+                 int nx,
+                 int ny,
+                 int yflip,
+                 double rot_deg,
+                 int flag)
+{
+    struct xtg_lattice lat;
+    long n;
+    int ier;
+    double rx, ry;
+
+    if (nyv != nxv || niv != nxv || njv != nxv)
+        return -4;
+
+    x_lattice_init(&lat, xori, xinc, yori, yinc, nx, ny, yflip, rot_deg);
+
+    for (n = 0; n < nxv; n++) {
+        ier = x_lattice_ij_from_xy(&lat, xv[n], yv[n], flag, &iv[n], &jv[n], &rx, &ry);
+        if (ier != 0) {
+            iv[n] = 0;
+            jv[n] = 0;
+        }
     }
 
-    *rx = px;
-    *ry = py;
-
     return EXIT_SUCCESS;
 }
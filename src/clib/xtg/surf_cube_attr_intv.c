@@ -11,10 +11,18 @@
  *
  *    New from May 2020, replaces surf_slice_cube_window*
  *
+ *    Each map node is processed independently: the cube is sampled along the
+ *    column and the values are streamed into a single pass accumulator (Welford
+ *    for mean and variance), so no stack of sampled values is stored. Map nodes
+ *    are processed in parallel if nthreads allows. For a windowed cube, the
+ *    part of the column trace within the interval is copied from the brick cache
+ *    once per map node, so only the copying is serialised.
+ *
  * ARGUMENTS:
  *    ncol, nrow...  i     cube dimensions and relevant increments
  *    czori, czinc   i     Cube zori and zinc
  *    cubevalsv      i     Cube array with lengths for swig
+ *    bcache         i     Brick cache handle for windowed cube, or -1
  *    surfsv*        i     Surface 1 2 array swith lengths
  *    maskv*         i     Mask 1 2 array swith lengths
  *    sliczinc       i     slice increments
@@ -25,9 +33,10 @@
  *    optprogress    i     If show progress print
  *    masktreshold   i     Intervals thinner than maskthreshold will be masked (undef)
  *    optsum         i     If 1, at least one sum attribute is needed (optimise speed)
+ *    nthreads       i     Number of threads, 0 or negative means all available
  *
  * RETURNS:
- *    Function: 0: upon success
+ *    Function: 0: upon success, -1 if trace buffers cannot be allocated
  *
  * TODO/ISSUES/BUGS:
  *
@@ -43,195 +52,143 @@
 
 #define NATTR 14
 
-static void
-pillar_attrs(double *pillar, int np, double *pattr)
+/* single pass accumulator for the attributes along one column */
+struct _attracc
 {
-    /* private routine that computes all possible attributes along on pillar/column*/
+    long np;
+    long nppos;
+    long npneg;
+    double min;
+    double max;
+    double mean; /* running mean and sum of squared deviations, Welford */
+    double m2;
+    double sumsq;
+    double maxpos;
+    double maxneg;
+    double maxabs;
+    double sumpos;
+    double sumneg;
+    double sumabs;
+};
 
-    int n;
-    for (n = 0; n < NATTR; n++)
-        pattr[n] = UNDEF;
-
-    if (np < 1)
-        return;
-
-    int k;
-    double val;
-
-    double max = VERYLARGENEGATIVE;
-    double min = VERYLARGEPOSITIVE;
-    double sum = 0.0;
-    double rms = 0.0;
-    double maxpos = VERYLARGENEGATIVE;
-    double maxneg = VERYLARGEPOSITIVE;
-    double maxabs = VERYLARGENEGATIVE;
-    double sumpos = 0.0;
-    double sumneg = 0.0;
-    double sumabs = 0.0;
-
-    int nppos = 0;
-    int npneg = 0;
-
-    for (k = 0; k < np; k++) {
-
-        val = pillar[k];
-
-        if (val >= max)
-            max = val;
-        if (val < min)
-            min = val;
-        if (val >= 0.0 && val >= maxpos)
-            maxpos = val;
-        if (val < 0.0 && val < maxneg)
-            maxneg = val;
-        if (fabs(val) > maxabs)
-            maxabs = fabs(val);
-
-        sum = sum + val;
-        rms = rms + val * val;
-
-        if (val >= 0.0) {
-            sumpos = sumpos + val;
-            nppos++;
-        }
-        if (val < 0.0) {
-            sumneg = sumneg + val;
-            npneg++;
-        }
-        sumabs = sumabs + fabs(val);
-    }
-
-    double mean = sum / (double)np;
-
-    double meanabs = sumabs / (double)np;
-
-    if (maxpos <= VERYLARGENEGATIVE)
-        maxpos = UNDEF;
-    if (maxneg >= VERYLARGEPOSITIVE)
-        maxneg = UNDEF;
-
-    double meanpos = UNDEF;
-    double meanneg = UNDEF;
-    if (nppos > 0) {
-        meanpos = sumpos / (double)nppos;
-    }
-    if (npneg > 0) {
-        meanneg = sumneg / (double)npneg;
-    }
-
-    rms = sqrt(rms / (double)np);
+static void
+_attracc_init(struct _attracc *acc)
+{
+    acc->np = acc->nppos = acc->npneg = 0;
+    acc->min = VERYLARGEPOSITIVE;
+    acc->max = VERYLARGENEGATIVE;
+    acc->mean = acc->m2 = acc->sumsq = 0.0;
+    acc->maxpos = VERYLARGENEGATIVE;
+    acc->maxneg = VERYLARGEPOSITIVE;
+    acc->maxabs = VERYLARGENEGATIVE;
+    acc->sumpos = acc->sumneg = acc->sumabs = 0.0;
+}
 
-    sum = 0.0;
-    for (k = 0; k < np; k++) {
-        val = pillar[k];
-        sum = sum + pow(val - mean, 2.0);
+static void
+_attracc_add(struct _attracc *acc, double val)
+{
+    acc->np++;
+
+    double delta = val - acc->mean;
+    acc->mean += delta / (double)acc->np;
+    acc->m2 += delta * (val - acc->mean);
+    acc->sumsq += val * val;
+
+    if (val >= acc->max)
+        acc->max = val;
+    if (val < acc->min)
+        acc->min = val;
+    if (fabs(val) > acc->maxabs)
+        acc->maxabs = fabs(val);
+    acc->sumabs += fabs(val);
+
+    if (val >= 0.0) {
+        if (val >= acc->maxpos)
+            acc->maxpos = val;
+        acc->sumpos += val;
+        acc->nppos++;
+    } else {
+        if (val < acc->maxneg)
+            acc->maxneg = val;
+        acc->sumneg += val;
+        acc->npneg++;
     }
-
-    double var = sum / (double)np;  // sample variance
-
-    pattr[0] = min;
-    pattr[1] = max;
-    pattr[2] = mean;
-    pattr[3] = var;
-    pattr[4] = rms;
-    pattr[5] = maxpos;
-    pattr[6] = maxneg;
-    pattr[7] = maxabs;
-    pattr[8] = meanabs;
-    pattr[9] = meanpos;
-    pattr[10] = meanneg;
 }
 
+/* store attributes 0..10, or the sum attributes 11..13 if cflag is 1 */
 static void
-pillar_attrs_sums(double *pillar, int np, double *pattr)
+_attracc_result(struct _attracc *acc, long inode, long nsurf, double *sres, int cflag)
 {
-    /* SUM attributes are only menaingful on a discrete level*/
-
+    double pattr[NATTR];
     int n;
-    for (n = 11; n <= 13; n++)
+    for (n = 0; n < NATTR; n++)
         pattr[n] = UNDEF;
 
-    if (np < 1)
-        return;
-
-    int k;
-
-    double sumpos = 0.0;
-    double sumneg = 0.0;
-    double sumabs = 0.0;
-
-    int nppos = 0;
-    int npneg = 0;
-
-    for (k = 0; k < np; k++) {
-
-        double val = pillar[k];
-
-        if (val >= 0.0) {
-            sumpos = sumpos + val;
-            nppos++;
-        }
-        if (val < 0.0) {
-            sumneg = sumneg + val;
-            npneg++;
-        }
-        sumabs = sumabs + fabs(val);
+    double np = (double)acc->np;
+
+    if (acc->np > 0 && cflag == 0) {
+        pattr[0] = acc->min;
+        pattr[1] = acc->max;
+        pattr[2] = acc->mean;
+        pattr[3] = acc->m2 / np;  // population variance
+        pattr[4] = sqrt(acc->sumsq / np);
+        if (acc->nppos > 0)
+            pattr[5] = acc->maxpos;
+        if (acc->npneg > 0)
+            pattr[6] = acc->maxneg;
+        pattr[7] = acc->maxabs;
+        pattr[8] = acc->sumabs / np;
+        if (acc->nppos > 0)
+            pattr[9] = acc->sumpos / (double)acc->nppos;
+        if (acc->npneg > 0)
+            pattr[10] = acc->sumneg / (double)acc->npneg;
+    } else if (acc->np > 0) {
+        if (acc->nppos > 0)
+            pattr[11] = acc->sumpos;
+        if (acc->npneg > 0)
+            pattr[12] = acc->sumneg;
+        pattr[13] = acc->sumabs;
     }
 
-    if (nppos <= 0) {
-        sumpos = UNDEF;
-    }
-
-    if (npneg <= 0) {
-        sumneg = UNDEF;
-    }
-
-    pattr[11] = sumpos;
-    pattr[12] = sumneg;
-    pattr[13] = sumabs;
+    int n1 = cflag == 0 ? 0 : 11;
+    int n2 = cflag == 0 ? 10 : 13;
+    for (n = n1; n <= n2; n++)
+        sres[inode + nsurf * n] = pattr[n];
 }
 
-static void
-compute_attributes(double **stack, long nsurf, int ndiv, double *sres, int cflag)
+/* cube value at depth zval in a column trace (nlay values), as in
+   surf_stack_slice_cube */
+static double
+_sample_column(const float *trace,
+               double zval,
+               int nlay,
+               double czori,
+               double czinc,
+               int optnearest)
 {
-    /* private */
+    double zd[2];
+    double czvals[2];
 
-    double *pattr;
+    // find vertical index of node right above
+    int k1 = (int)((zval - czori) / czinc);
 
-    pattr = calloc(NATTR, sizeof(double));
+    if (k1 < 0 || k1 > (nlay - 1))
+        return UNDEF;
 
-    int i;
-    for (i = 0; i < nsurf; i++) {
+    int k2 = k1 + 1;
 
-        // look along each pillar:
-        int k;
-        double *pillar = calloc(ndiv, sizeof(double));
-        int np = 0;
-        for (k = 0; k < ndiv; k++) {
+    // end cases
+    if (k1 == 0 && zval < czori)
+        k2 = k1;
+    if (k1 == nlay - 1)
+        k2 = k1;
 
-            double val = stack[i][k];
-            if (val < UNDEF_LIMIT) {
-                pillar[np++] = val;
-            }
-        }
-        int nat;
-        if (cflag == 0) {
-            pillar_attrs(pillar, np, pattr);
-            for (nat = 0; nat <= 10; nat++) {
-                long ic = i + nsurf * nat;
-                sres[ic] = pattr[nat];
-            }
-        } else {
-            pillar_attrs_sums(pillar, np, pattr);
-            for (nat = 11; nat <= 13; nat++) {
-                long ic = i + nsurf * nat;
-                sres[ic] = pattr[nat];
-            }
-        }
+    czvals[0] = trace[k1];
+    czvals[1] = trace[k2];
+    zd[0] = czori + k1 * czinc;
+    zd[1] = czori + k2 * czinc;
 
-        free(pillar);
-    }
-    free(pattr);
+    return x_vector_linint1d(zval, zd, czvals, 2, optnearest);
 }
 
 int
@@ -242,6 +199,7 @@ surf_cube_attr_intv(int ncol,
                     double czinc,
                     float *cubevalsv,
                     long ncube,
+                    int bcache,
                     double *surfsv1,
                     long nsurf1,
                     double *surfsv2,
@@ -259,99 +217,106 @@ surf_cube_attr_intv(int ncol,
                     int optmask,
                     int optprogress,
                     double maskthreshold,
-                    int optsum)
+                    int optsum,
+                    int nthreads)
 
 {
+    double xprof_t0 = x_prof_tic();
 
     logger_info(LI, FI, FU, "Enter %s", FU);
 
-    double **stack = x_allocate_2d_double(nsurf1, ndiv + 1);
-    mbool **rmask = x_allocate_2d_mbool(nsurf1, ndiv + 1);
+    nthreads = x_nthreads(nthreads);
 
     if (optprogress)
-        printf("progress: initialising for attributes...\n");
-
-    logger_info(LI, FI, FU, "Initialise");
-
-    int i, ic;
-    for (i = 0; i < nsurf1; i++) {
-        for (ic = 0; ic <= ndiv; ic++) {
-            double vadd = surfsv1[i] + ic * slicezinc;
-            if (maskv1[i] == 0 && maskv2[i] == 0 && vadd <= surfsv2[i]) {
-                stack[i][ic] = vadd;
-                rmask[i][ic] = 0;
-            } else {
-                stack[i][ic] = UNDEF;
-                rmask[i][ic] = 1;
-            }
+        printf("progress: compute mean, variance, etc attributes...\n");
 
-            if (surfsv2[i] < (surfsv1[i] + maskthreshold)) {
-                stack[i][ic] = UNDEF;
-                rmask[i][ic] = 1;
+    int nomem = 0;
+    int readerr = 0;
+
+#pragma omp parallel num_threads(nthreads)
+    {
+        /* trace copy per thread for windowed cubes */
+        float *tracebuf = NULL;
+        if (bcache >= 0) {
+            tracebuf = malloc(nlay * sizeof(float));
+            if (tracebuf == NULL) {
+#pragma omp atomic write
+                nomem = 1;
             }
         }
-    }
-
-    logger_info(LI, FI, FU, "Surf slice...");
-
-    // get surfs from cube and stack them
-    surf_stack_slice_cube(ncol, nrow, nlay, ndiv + 1, czori, czinc, cubevalsv, stack,
-                          rmask, optnearest, optmask);
-
-    logger_info(LI, FI, FU, "Init... dode", FU);
 
-    if (optprogress)
-        printf("progress: compute mean, variance, etc attributes...\n");
-
-    logger_info(LI, FI, FU, "Attributes...");
-    compute_attributes(stack, nsurf1, ndiv + 1, sresult, 0);
-
-    x_free_2d_double(stack);
-    x_free_2d_mbool(rmask);
-
-    logger_info(LI, FI, FU, "Done");
-
-    if (optsum == 0)
-        return EXIT_SUCCESS;  // don't compute sum attribute unless they are asked for
-
-    /*
-     * Special treatment of sum attributes, as they are not trivial to deduce
-     * if cells are interpolated; hence use only a discrete scheme here:
-     */
+        long i;
+#pragma omp for schedule(dynamic, 256)
+        for (i = 0; i < nsurf1; i++) {
+            struct _attracc acc, dacc;
+            _attracc_init(&acc);
+            _attracc_init(&dacc);
+
+            int active = (maskv1[i] == 0 && maskv2[i] == 0 &&
+                          surfsv2[i] >= (surfsv1[i] + maskthreshold));
+
+            if (bcache >= 0 && tracebuf == NULL)
+                active = 0;
+
+            const float *trace = bcache < 0 ? cubevalsv + i * nlay : tracebuf;
+            if (active && bcache >= 0) {
+                /* copy only the layers that can be sampled in the interval */
+                double zmax = surfsv2[i];
+                if (optsum && surfsv1[i] + ndivdisc * czinc > zmax)
+                    zmax = surfsv1[i] + ndivdisc * czinc;
+                int klo = (int)((surfsv1[i] - czori) / czinc);
+                int khi = (int)((zmax - czori) / czinc) + 1;
+                klo = klo < 0 ? 0 : (klo > nlay - 1 ? nlay - 1 : klo);
+                khi = khi < klo ? klo : (khi > nlay - 1 ? nlay - 1 : khi);
+                if (cube_bcache_trace(bcache, i, klo, khi, tracebuf + klo) !=
+                    EXIT_SUCCESS) {
+#pragma omp atomic write
+                    readerr = 1;
+                }
+            }
 
-    double **dstack = x_allocate_2d_double(nsurf1, ndivdisc + 1);
-    mbool **drmask = x_allocate_2d_mbool(nsurf1, ndivdisc + 1);
+            int ic;
+            for (ic = 0; active && ic <= ndiv; ic++) {
+                double zval = surfsv1[i] + ic * slicezinc;
+                if (zval > surfsv2[i])
+                    break;
 
-    if (optprogress)
-        printf("progress: initialising for sum attributes...\n");
-
-    for (i = 0; i < nsurf1; i++) {
-        for (ic = 0; ic <= ndivdisc; ic++) {
-            if (maskv1[i] == 0 && maskv2[i] == 0) {
-                dstack[i][ic] = surfsv1[i] + ic * czinc;
-                drmask[i][ic] = 0;
-            } else {
-                dstack[i][ic] = UNDEF;
-                drmask[i][ic] = 1;
+                double val =
+                  _sample_column(trace, zval, nlay, czori, czinc, optnearest);
+                if (val < UNDEF_LIMIT)
+                    _attracc_add(&acc, val);
             }
-
-            if (surfsv2[i] < (surfsv1[i] + maskthreshold)) {
-                dstack[i][ic] = UNDEF;
-                drmask[i][ic] = 1;
+            _attracc_result(&acc, i, nsurf1, sresult, 0);
+
+            if (optsum == 0)
+                continue;  // don't compute sum attribute unless they are asked for
+
+            /*
+             * Special treatment of sum attributes, as they are not trivial to deduce
+             * if cells are interpolated; hence use only a discrete scheme here:
+             */
+            for (ic = 0; active && ic <= ndivdisc; ic++) {
+                double zval = surfsv1[i] + ic * czinc;
+                double val =
+                  _sample_column(trace, zval, nlay, czori, czinc, optnearest);
+                if (val < UNDEF_LIMIT)
+                    _attracc_add(&dacc, val);
             }
+            _attracc_result(&dacc, i, nsurf1, sresult, 1);
         }
-    }
-    // get surfs from cube and stack them
-    surf_stack_slice_cube(ncol, nrow, nlay, ndivdisc + 1, czori, czinc, cubevalsv,
-                          dstack, drmask, optnearest, optmask);
 
-    if (optprogress)
-        printf("progress: compute sum attributes...\n");
+        free(tracebuf);
+    }
 
-    compute_attributes(dstack, nsurf1, ndivdisc + 1, sresult, 1);
+    if (nomem) {
+        logger_error(LI, FI, FU, "Cannot allocate trace buffers in %s", FU);
+        return -1;
+    }
+    if (readerr)
+        logger_warn(LI, FI, FU, "Cube bricks could not be read; UNDEF values used");
 
-    x_free_2d_double(dstack);
-    x_free_2d_mbool(drmask);
+    logger_info(LI, FI, FU, "Done");
 
+    x_prof_toc(FU, xprof_t0, nsurf1);
     return EXIT_SUCCESS;
 }
@@ -21,6 +21,9 @@
  *                        |
  *     0       1          |___E
  *
+ * The lattice version (surf_get_z_from_lattice) takes the map geometry as a
+ * precomputed struct, which is much faster when sampling many points.
+ *
  * ARGUMENTS:
  *    x, y          i      Coordinates
  *    nx, ny        i      Dimensions
@@ -29,6 +32,7 @@
  *    rot_deg       i      Rotation
  *    p_map_v       i      Pointer to map values to update
  *    flag          i      Flag for options
+ *    lat           i      Map geometry (surf_get_z_from_lattice)
  *
  * RETURNS:
  *    Z value at point
@@ -59,69 +63,51 @@ surf_get_z_from_xy(double x,
                    double *p_map_v,
                    long nn)
 {
-    int ib = -9, ier, iex[4], i = 0, j = 0;
-    double x_v[4], y_v[4], z_v[4];
-    double xx, yy, zz, z, rx, ry;
-    int userelative = 1;
+    struct xtg_lattice lat;
 
     if (nx * ny != nn)
         logger_error(LI, FI, FU, "Fatal error in %s", FU);
 
-    ib = -1;
+    x_lattice_init(&lat, xori, xinc, yori, yinc, nx, ny, yflip, rot_deg);
 
-    /* get i and j for lower left corner, given a point X Y*/
+    return surf_get_z_from_lattice(&lat, x, y, p_map_v);
+}
 
-    ier = sucu_ij_from_xy(&i, &j, &rx, &ry, x, y, xori, xinc, yori, yinc, nx, ny, yflip,
-                          rot_deg, 1);
+double
+surf_get_z_from_lattice(const struct xtg_lattice *lat,
+                        double x,
+                        double y,
+                        double *p_map_v)
+{
+    int i = 0, j = 0;
+    double rx, ry;
 
-    /* outside map, returning UNDEF value */
-    if (ier < 0) {
+    /* get i and j for lower left corner, given a point X Y*/
+    if (x_lattice_ij_from_xy(lat, x, y, 1, &i, &j, &rx, &ry) < 0) {
+        /* outside map, returning UNDEF value */
         return UNDEF;
     }
 
-    /* two approaches here; the 'userelative' is more clean and safe? */
-
-    if (userelative == 1) {
-        /* map origin rleative is 0.0 */
-        z = surf_get_z_from_ij(i, j, rx, ry, nx, ny, xinc, yinc * yflip, 0.0, 0.0,
-                               p_map_v);
-    } else {
+    /* bilinear interpolation, as surf_get_z_from_ij with map origin 0.0 */
+    double x0 = (i - 1) * lat->xinc, x1 = i * lat->xinc;
+    double y0 = (j - 1) * lat->yinc, y1 = j * lat->yinc;
 
-        /* find the x,y,z values of the four nodes */
-        iex[0] = surf_xyz_from_ij(i, j, &xx, &yy, &zz, xori, xinc, yori, yinc, nx, ny,
-                                  yflip, rot_deg, p_map_v, nn, 0);
-        x_v[0] = xx;
-        y_v[0] = yy;
-        z_v[0] = zz;
-
-        iex[1] = surf_xyz_from_ij(i + 1, j, &xx, &yy, &zz, xori, xinc, yori, yinc, nx,
-                                  ny, yflip, rot_deg, p_map_v, nn, 0);
-        x_v[1] = xx;
-        y_v[1] = yy;
-        z_v[1] = zz;
-
-        iex[2] = surf_xyz_from_ij(i, j + 1, &xx, &yy, &zz, xori, xinc, yori, yinc, nx,
-                                  ny, yflip, rot_deg, p_map_v, nn, 0);
-        x_v[2] = xx;
-        y_v[2] = yy;
-        z_v[2] = zz;
-
-        iex[3] = surf_xyz_from_ij(i + 1, j + 1, &xx, &yy, &zz, xori, xinc, yori, yinc,
-                                  nx, ny, yflip, rot_deg, p_map_v, nn, 0);
-        x_v[3] = xx;
-        y_v[3] = yy;
-        z_v[3] = zz;
+    if (rx < fmin(x0, x1) || rx > fmax(x0, x1) || ry < fmin(y0, y1) ||
+        ry > fmax(y0, y1))
+        return UNDEF;
 
-        for (i = 0; i < 4; i++) {
-            if (iex[i] != 0) {
-                return UNDEF;
-            }
-        }
+    long ib = (long)(i - 1) * lat->ny + (j - 1); /* C order */
+    double z0 = p_map_v[ib];
+    double z1 = p_map_v[ib + lat->ny];
+    double z2 = p_map_v[ib + 1];
+    double z3 = p_map_v[ib + lat->ny + 1];
 
-        // now find the Z value, using interpolation method 3 (bilinear w/rot.)
+    if (z0 > UNDEF_MAP_LIMIT || z1 > UNDEF_MAP_LIMIT || z2 > UNDEF_MAP_LIMIT ||
+        z3 > UNDEF_MAP_LIMIT)
+        return UNDEF;
 
-        z = x_interp_map_nodes(x_v, y_v, z_v, x, y, 3);
-    }
+    double a = (rx - x0) / (x1 - x0);
+    double b = (ry - y0) / (y1 - y0);
 
-    return z;
+    return z0 + a * (z1 - z0) + b * (z2 - z0) + a * b * (z3 + z0 - z2 - z1);
 }
@@ -5,7 +5,8 @@
 *    surf_get_zv_from_xyv.c
 *
 * DESCRIPTION:
-*    Vector version of surf_get_z_from_xy.c
+*    Vector version of surf_get_z_from_xy.c, cf. surf_sample_xyv for other
+*    sampling methods and threads.
 *
 * ARGUMENTS:
 *    xv, yv        i      XY Coordinates as arrays (vectors)
@@ -21,7 +22,7 @@
 *    flag          i      Flag for options
 *
 * RETURNS:
-*    Z value at point
+*    EXIT_SUCCESS, or -4 for inconsistent array lengths
 *
 * TODO/ISSUES/BUGS:
 *    - checking the handling of undef nodes; shall return UNDEF
@@ -51,14 +52,7 @@ surf_get_zv_from_xyv(double *xv,
                      double *p_map_v,
                      long nn)
 {
-    int i;
-
-    nn = nx * ny;
-
-    for (i = 0; i < nxv; i++) {
-        zv[i] = surf_get_z_from_xy(xv[i], yv[i], nx, ny, xori, yori, xinc, yinc, yflip,
-                                   rot_deg, p_map_v, nn);
-    }
-
-    return (0);
+    /* bilinear, serial */
+    return surf_sample_xyv(xv, nxv, yv, nyv, zv, nzv, nx, ny, xori, yori, xinc, yinc,
+                           yflip, rot_deg, p_map_v, nn, 1, 1);
 }
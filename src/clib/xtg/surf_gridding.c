@@ -0,0 +1,545 @@
+/*
+ ***************************************************************************************
+ *
+ * NAME:
+ *    surf_gridding.c (file name)
+ *    surf_gridding_add
+ *    surf_gridding_result
+ *
+ * DESCRIPTION:
+ *    Gridding of scattered points to a (rotated) regular map, where points can be
+ *    given in chunks (streaming) and the state is kept in three arrays per map
+ *    node, owned by the caller:
+ *
+ *    accsum, accw   Weighted sum and sum of weights of points
+ *    accd2          Squared distance to the nearest point within the search radius,
+ *                   UNDEF initially and if no points are within radius
+ *
+ *    Methods (all are limited to points within the search radius of a node):
+ *    0: nearest       Value of the nearest point (accsum is value, accw not used)
+ *    1: idw           Inverse distance weighting, weights 1 / distance^power
+ *    2: average       Moving average
+ *    3: mincurv       Minimum curvature. The points are averaged per nearest node
+ *                     (data nodes), and the biharmonic equation is solved for the
+ *                     other nodes with Gauss-Seidel iterations, coarse to fine
+ *                     grid levels. The values are extrapolated linearly across
+ *                     the map border (natural boundary conditions), hence a
+ *                     plane is reproduced. Nodes without points within radius
+ *                     are masked (accd2 is then not the distance to the nearest,
+ *                     only below UNDEF_LIMIT if any point is within radius).
+ *
+ *    surf_gridding_add:
+ *    Add a chunk of points. The points are binned on nearest node (a counting
+ *    sort), and then each map node collects the points in the bins within the
+ *    search radius. This is parallel over map nodes.
+ *
+ *    surf_gridding_result:
+ *    Compute the result map from the accumulators.
+ *
+ * ARGUMENTS:
+ *    xv, yv, zv     i     Point coordinates and values, chunk (with length)
+ *    nx, ny         i     Map dimensions
+ *    xori, yori     i     Map origin
+ *    xinc, yinc     i     Map increments
+ *    yflip          i     YFLIP 1 or -1
+ *    rot_deg        i     Map rotation, degrees
+ *    method         i     0: nearest, 1: idw, 2: average, 3: mincurv
+ *    radius         i     Search radius, in map units
+ *    power          i     Power in inverse distance weighting
+ *    accsum        i/o    Accumulator, sum of weighted values (with length)
+ *    accw          i/o    Accumulator, sum of weights (with length)
+ *    accd2         i/o    Accumulator, squared distance to nearest (with length)
+ *    niter          i     Max number of iterations per grid level (mincurv)
+ *    result         o     Result map, UNDEF if undefined (with length)
+ *    nthreads       i     Number of threads, 0 or negative means all available
+ *
+ * RETURNS:
+ *    EXIT_SUCCESS, or -4 for inconsistent array lengths, -5 for invalid options,
+ *    -6 if memory allocation fails.
+ *
+ * TODO/ISSUES/BUGS:
+ *
+ * LICENCE:
+ *    cf. XTGeo LICENSE
+ ***************************************************************************************
+ */
+
+#include "libxtg.h"
+#include "libxtg_.h"
+#include "logger.h"
+
+/* relative tolerance (versus range of data) for max change in mincurv iterations */
+#define MINCURV_TOLERANCE 1.0E-5
+
+int
+surf_gridding_add(double *xv,
+                  long nxv,
+                  double *yv,
+                  long nyv,
+                  double *zv,
+                  long nzv,
+                  int nx,
+                  int ny,
+                  double xori,
+                  double yori,
+                  double xinc,
+                  double yinc,
+                  int yflip,
+                  double rot_deg,
+                  int method,
+                  double radius,
+                  double power,
+                  double *accsum,
+                  long nsum,
+                  double *accw,
+                  long nw,
+                  double *accd2,
+                  long nd2,
+                  int nthreads)
+{
+    double xprof_t0 = x_prof_tic();
+
+    long nnode = (long)nx * ny;
+
+    if (nyv != nxv || nzv != nxv || nsum != nnode || nw != nnode || nd2 != nnode) {
+        logger_error(LI, FI, FU, "Inconsistent array lengths in %s", FU);
+        return -4;
+    }
+    if (method < 0 || method > 3 || radius <= 0.0) {
+        logger_error(LI, FI, FU, "Invalid method or radius in %s", FU);
+        return -5;
+    }
+
+    struct xtg_lattice lat;
+    x_lattice_init(&lat, xori, xinc, yori, yinc, nx, ny, yflip, rot_deg);
+
+    double ayinc = fabs(lat.yinc);
+    double r2 = radius * radius;
+    double eps2 = 1.0E-12 * xinc * ayinc; /* avoid division by 0 in idw */
+
+    /* bins are map nodes, extended with the search window */
+    int mx = (int)ceil(radius / xinc);
+    int my = (int)ceil(radius / ayinc);
+    long ex = nx + 2 * mx;
+    long ey = ny + 2 * my;
+    long nbin = ex * ey;
+
+    double *fi = malloc(nxv * sizeof(double));
+    double *fj = malloc(nxv * sizeof(double));
+    long *pbin = malloc(nxv * sizeof(long));
+    long *bstart = calloc(nbin + 1, sizeof(long));
+
+    /* points sorted on bins, for memory locality */
+    double *sfi = malloc(nxv * sizeof(double));
+    double *sfj = malloc(nxv * sizeof(double));
+    double *sz = malloc(nxv * sizeof(double));
+
+    if (fi == NULL || fj == NULL || pbin == NULL || bstart == NULL || sfi == NULL ||
+        sfj == NULL || sz == NULL) {
+        x_free(7, fi, fj, pbin, bstart, sfi, sfj, sz);
+        logger_error(LI, FI, FU, "Cannot allocate memory in %s", FU);
+        return -6;
+    }
+
+    nthreads = x_nthreads(nthreads);
+
+    /* points in the rotated map system, as (fractional) node indices */
+    long n;
+#pragma omp parallel for schedule(static) num_threads(nthreads)
+    for (n = 0; n < nxv; n++) {
+        double dx = xv[n] - lat.xori;
+        double dy = yv[n] - lat.yori;
+        fi[n] = (dx * lat.cosa + dy * lat.sina) / lat.xinc;
+        fj[n] = (dy * lat.cosa - dx * lat.sina) / lat.yinc;
+
+        double bi = floor(fi[n] + 0.5) + mx;
+        double bj = floor(fj[n] + 0.5) + my;
+        pbin[n] = -1;
+        if (bi >= 0 && bi < ex && bj >= 0 && bj < ey)
+            pbin[n] = (long)bi * ey + (long)bj;
+    }
+
+    /* counting sort of points on bins */
+    for (n = 0; n < nxv; n++) {
+        if (pbin[n] >= 0)
+            bstart[pbin[n] + 1]++;
+    }
+    long ib;
+    for (ib = 0; ib < nbin; ib++)
+        bstart[ib + 1] += bstart[ib];
+    for (n = 0; n < nxv; n++) {
+        if (pbin[n] >= 0) {
+            long k = bstart[pbin[n]]++;
+            sfi[k] = fi[n];
+            sfj[k] = fj[n];
+            sz[k] = zv[n];
+        }
+    }
+    /* bstart is now the end of each bin; shift back */
+    for (ib = nbin; ib > 0; ib--)
+        bstart[ib] = bstart[ib - 1];
+    bstart[0] = 0;
+
+    int i;
+#pragma omp parallel for schedule(dynamic, 4) num_threads(nthreads)
+    for (i = 0; i < nx; i++) {
+        int j, bi, bj;
+        long k;
+        for (j = 0; j < ny; j++) {
+            long inode = (long)i * ny + j;
+
+            if (method == 3) {
+                /* data: the points in own bin, i.e. with this as nearest node */
+                long bin = (long)(i + mx) * ey + (j + my);
+                for (k = bstart[bin]; k < bstart[bin + 1]; k++) {
+                    accsum[inode] += sz[k];
+                    accw[inode] += 1.0;
+                }
+                /* else only need to know if any point is within radius */
+                if (accd2[inode] < UNDEF_LIMIT)
+                    continue;
+            }
+
+            for (bi = i - mx; bi <= i + mx; bi++) {
+                for (bj = j - my; bj <= j + my; bj++) {
+                    long bin = (long)(bi + mx) * ey + (bj + my);
+                    for (k = bstart[bin]; k < bstart[bin + 1]; k++) {
+                        double dxl = (sfi[k] - i) * xinc;
+                        double dyl = (sfj[k] - j) * ayinc;
+                        double d2 = dxl * dxl + dyl * dyl;
+
+                        if (d2 > r2)
+                            continue;
+
+                        if (method == 0) {
+                            if (d2 < accd2[inode])
+                                accsum[inode] = sz[k];
+                        } else if (method == 1) {
+                            double w = 1.0 / pow(d2 > eps2 ? d2 : eps2, 0.5 * power);
+                            accsum[inode] += w * sz[k];
+                            accw[inode] += w;
+                        } else if (method == 2) {
+                            accsum[inode] += sz[k];
+                            accw[inode] += 1.0;
+                        }
+                        if (d2 < accd2[inode])
+                            accd2[inode] = d2;
+                    }
+                    if (method == 3 && accd2[inode] < UNDEF_LIMIT)
+                        break;
+                }
+                if (method == 3 && accd2[inode] < UNDEF_LIMIT)
+                    break;
+            }
+        }
+    }
+
+    x_free(7, fi, fj, pbin, bstart, sfi, sfj, sz);
+
+    x_prof_toc(FU, xprof_t0, nxv);
+    return EXIT_SUCCESS;
+}
+
+/* linear extrapolation across the grid border, which is the natural boundary
+   condition of minimum curvature (a plane is kept): the value at index i, at most
+   two nodes outside, is w * z[i0] + (1 - w) * z[i1] */
+static void
+_extrap(int i, int n, int *i0, int *i1, double *w)
+{
+    if (n == 1) {
+        *i0 = *i1 = 0;
+        *w = 1.0;
+    } else if (i < 0) {
+        *i0 = 0;
+        *i1 = 1;
+        *w = 1.0 - i;
+    } else if (i > n - 1) {
+        *i0 = n - 1;
+        *i1 = n - 2;
+        *w = 1.0 + i - (n - 1);
+    } else {
+        *i0 = *i1 = i;
+        *w = 1.0;
+    }
+}
+
+/* new value of a node within two nodes of the border, where the stencil terms
+   outside the grid are extrapolated; terms that fall back on the node itself are
+   moved to the diagonal. The value is kept if the node is not determined, e.g. in
+   a 2 x 2 grid */
+static double
+_mincurv_border(const double *z, int i, int j, int nx, int ny, double a, double b,
+                double c)
+{
+    static const int off[12][2] = { { -1, 0 },  { 1, 0 },  { 0, -1 }, { 0, 1 },
+                                    { -2, 0 },  { 2, 0 },  { 0, -2 }, { 0, 2 },
+                                    { -1, -1 }, { -1, 1 }, { 1, -1 }, { 1, 1 } };
+    double wt[12] = { -4 * a - 4 * c, -4 * a - 4 * c, -4 * b - 4 * c, -4 * b - 4 * c,
+                      a,              a,              b,              b,
+                      2 * c,          2 * c,          2 * c,          2 * c };
+
+    long ic = (long)i * ny + j;
+    double coef = 6.0 * a + 6.0 * b + 8.0 * c;
+    double diag = coef;
+    double res = coef * z[ic];
+
+    int t;
+    for (t = 0; t < 12; t++) {
+        int ii[2], jj[2];
+        double wi[2], wj[2];
+        _extrap(i + off[t][0], nx, &ii[0], &ii[1], &wi[0]);
+        _extrap(j + off[t][1], ny, &jj[0], &jj[1], &wj[0]);
+        wi[1] = 1.0 - wi[0];
+        wj[1] = 1.0 - wj[0];
+
+        int p, q;
+        for (p = 0; p < 2; p++) {
+            for (q = 0; q < 2; q++) {
+                double w = wt[t] * wi[p] * wj[q];
+                if (w == 0.0)
+                    continue;
+                res += w * z[(long)ii[p] * ny + jj[q]];
+                if (ii[p] == i && jj[q] == j)
+                    diag += w;
+            }
+        }
+    }
+    if (diag < 0.01 * coef)
+        return z[ic];
+    return z[ic] - res / diag;
+}
+
+/* Gauss-Seidel iterations for the biharmonic equation, data nodes are fixed */
+static void
+_mincurv_iterate(double *z,
+                 const int *fixed,
+                 int nx,
+                 int ny,
+                 double hx,
+                 double hy,
+                 int niter,
+                 double tolerance,
+                 int nthreads)
+{
+    double a = 1.0 / (hx * hx * hx * hx);
+    double b = 1.0 / (hy * hy * hy * hy);
+    double c = 1.0 / (hx * hx * hy * hy);
+    double coef = 6.0 * a + 6.0 * b + 8.0 * c;
+
+    int iter;
+    for (iter = 0; iter < niter; iter++) {
+        double maxchange = 0.0;
+        int color;
+
+        /* nodes with same (i % 3, j % 3) do not depend on each other */
+        for (color = 0; color < 9; color++) {
+            int i;
+#pragma omp parallel for schedule(static) num_threads(nthreads)
+            for (i = color / 3; i < nx; i += 3) {
+                double rowchange = 0.0;
+                int j;
+                int iborder = i < 2 || i > nx - 3;
+
+                for (j = color % 3; j < ny; j += 3) {
+                    long ic = (long)i * ny + j;
+                    if (fixed[ic])
+                        continue;
+
+                    double znew;
+                    if (iborder || j < 2 || j > ny - 3) {
+                        znew = _mincurv_border(z, i, j, nx, ny, a, b, c);
+                    } else {
+                        double zxe = z[ic - ny] + z[ic + ny];
+                        double zxf = z[ic - 2 * ny] + z[ic + 2 * ny];
+                        double zye = z[ic - 1] + z[ic + 1];
+                        double zyf = z[ic - 2] + z[ic + 2];
+                        double zdg = z[ic - ny - 1] + z[ic - ny + 1] +
+                                     z[ic + ny - 1] + z[ic + ny + 1];
+
+                        double rest = a * (zxf - 4.0 * zxe) + b * (zyf - 4.0 * zye) +
+                                      2.0 * c * (zdg - 2.0 * (zxe + zye));
+                        znew = -rest / coef;
+                    }
+
+                    double change = fabs(znew - z[ic]);
+                    if (change > rowchange)
+                        rowchange = change;
+                    z[ic] = znew;
+                }
+#pragma omp critical(surf_gridding)
+                {
+                    if (rowchange > maxchange)
+                        maxchange = rowchange;
+                }
+            }
+        }
+        if (maxchange < tolerance)
+            break;
+    }
+}
+
+static int
+_mincurv(const double *accsum,
+         const double *accw,
+         int nx,
+         int ny,
+         double xinc,
+         double yinc,
+         int niter,
+         double *result,
+         int nthreads)
+{
+    long nnode = (long)nx * ny;
+    long in;
+    double zmin = UNDEF, zmax = -UNDEF, zsum = 0.0;
+    long ndata = 0;
+
+    for (in = 0; in < nnode; in++) {
+        if (accw[in] > 0.0) {
+            double z = accsum[in] / accw[in];
+            zmin = z < zmin ? z : zmin;
+            zmax = z > zmax ? z : zmax;
+            zsum += z;
+            ndata++;
+        }
+    }
+    if (ndata == 0) {
+        for (in = 0; in < nnode; in++)
+            result[in] = UNDEF;
+        return EXIT_SUCCESS;
+    }
+
+    double tolerance = MINCURV_TOLERANCE * (zmax > zmin ? zmax - zmin : 1.0);
+
+    /* coarsest level, as power of 2, where the grid still has some nodes */
+    int f = 1;
+    while ((nx - 1) / (2 * f) >= 4 && (ny - 1) / (2 * f) >= 4)
+        f *= 2;
+
+    double *zprev = NULL;
+    int nxp = 0, nyp = 0;
+
+    for (; f >= 1; f /= 2) {
+        int nxl = (nx - 1 + f - 1) / f + 1;
+        int nyl = (ny - 1 + f - 1) / f + 1;
+        long nl = (long)nxl * nyl;
+
+        double *z = f == 1 ? result : malloc(nl * sizeof(double));
+        double *dsum = calloc(nl, sizeof(double));
+        double *dw = calloc(nl, sizeof(double));
+        int *fixed = calloc(nl, sizeof(int));
+
+        if (z == NULL || dsum == NULL || dw == NULL || fixed == NULL) {
+            if (z != result)
+                free(z);
+            x_free(4, zprev, dsum, dw, fixed);
+            return -6;
+        }
+
+        /* data nodes at this level: data averaged on nearest node */
+        int i, j;
+        for (i = 0; i < nx; i++) {
+            for (j = 0; j < ny; j++) {
+                long ic = (long)i * ny + j;
+                if (accw[ic] > 0.0) {
+                    long il = (long)((i + f / 2) / f) * nyl + (j + f / 2) / f;
+                    dsum[il] += accsum[ic];
+                    dw[il] += accw[ic];
+                }
+            }
+        }
+
+        /* start values, bilinear from previous (coarser) level */
+        for (i = 0; i < nxl; i++) {
+            for (j = 0; j < nyl; j++) {
+                long il = (long)i * nyl + j;
+                if (dw[il] > 0.0) {
+                    z[il] = dsum[il] / dw[il];
+                    fixed[il] = 1;
+                } else if (zprev == NULL) {
+                    z[il] = zsum / ndata;
+                } else {
+                    int i0 = i / 2 < nxp - 1 ? i / 2 : nxp - 1;
+                    int j0 = j / 2 < nyp - 1 ? j / 2 : nyp - 1;
+                    int i1 = i0 + 1 < nxp ? i0 + 1 : i0;
+                    int j1 = j0 + 1 < nyp ? j0 + 1 : j0;
+                    double ti = 0.5 * i - i0, tj = 0.5 * j - j0;
+                    ti = ti > 1.0 ? 1.0 : ti;
+                    tj = tj > 1.0 ? 1.0 : tj;
+                    z[il] = (1 - ti) * (1 - tj) * zprev[(long)i0 * nyp + j0] +
+                            ti * (1 - tj) * zprev[(long)i1 * nyp + j0] +
+                            (1 - ti) * tj * zprev[(long)i0 * nyp + j1] +
+                            ti * tj * zprev[(long)i1 * nyp + j1];
+                }
+            }
+        }
+
+        _mincurv_iterate(z, fixed, nxl, nyl, xinc * f, yinc * f, niter, tolerance,
+                         nthreads);
+
+        x_free(3, dsum, dw, fixed);
+        free(zprev);
+        zprev = f == 1 ? NULL : z;
+        nxp = nxl;
+        nyp = nyl;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+int
+surf_gridding_result(double *accsum,
+                     long nsum,
+                     double *accw,
+                     long nw,
+                     double *accd2,
+                     long nd2,
+                     int nx,
+                     int ny,
+                     double xinc,
+                     double yinc,
+                     int method,
+                     int niter,
+                     double *result,
+                     long nresult,
+                     int nthreads)
+{
+    double xprof_t0 = x_prof_tic();
+
+    long nnode = (long)nx * ny;
+
+    if (nsum != nnode || nw != nnode || nd2 != nnode || nresult != nnode) {
+        logger_error(LI, FI, FU, "Inconsistent array lengths in %s", FU);
+        return -4;
+    }
+    if (method < 0 || method > 3) {
+        logger_error(LI, FI, FU, "Invalid method in %s", FU);
+        return -5;
+    }
+
+    nthreads = x_nthreads(nthreads);
+
+    if (method == 3) {
+        int ier = _mincurv(accsum, accw, nx, ny, xinc, fabs(yinc), niter, result,
+                           nthreads);
+        if (ier != EXIT_SUCCESS) {
+            logger_error(LI, FI, FU, "Cannot allocate memory in %s", FU);
+            return ier;
+        }
+    }
+
+    long in;
+#pragma omp parallel for schedule(static) num_threads(nthreads)
+    for (in = 0; in < nnode; in++) {
+        if (accd2[in] > UNDEF_LIMIT) {
+            result[in] = UNDEF;
+        } else if (method == 0) {
+            result[in] = accsum[in];
+        } else if (method == 1 || method == 2) {
+            result[in] = accw[in] > 0.0 ? accsum[in] / accw[in] : UNDEF;
+        }
+    }
+
+    x_prof_toc(FU, xprof_t0, nnode);
+    return EXIT_SUCCESS;
+}
@@ -7,6 +7,15 @@
 * DESCRIPTION:
 *    Resample from one grid to another via bilinear interpolation
 *
+*    If the two grids share rotation (the common case), the position of a result
+*    node in the origin grid is separable: the origin column and weight only
+*    depend on the result column, and the origin row and weight only depend on
+*    the result row. These are then precomputed once as tables, and each node is
+*    a table lookup and a bilinear formula. Otherwise each result node is looked
+*    up in the origin grid via its (precomputed) lattice geometry.
+*
+*    Both paths are parallel over result columns.
+*
 * ARGUMENTS:
 *    nx1,ny1        i     Dimensions of first grid (origin)
 *    xori1,xinc1    i     Maps X settings origin grid
@@ -19,12 +28,12 @@
 *    rot2           i     Rotation of result
 *    mapv2         i/o    Result grid
 *    option         i     If 1 then outside nodes will be UNDEF (masked)
+*    nthreads       i     Number of threads, 0 or negative means all available
 *
 * RETURNS:
-*    Int + Changed pointer to result map
+*    Int + Changed pointer to result map. -6 if memory allocation fails.
 *
 * TODO:
-*    YFLIP handling?
 *
 * LICENCE:
 *    cf. XTGeo LICENSE
@@ -35,6 +44,134 @@
 #include "libxtg_.h"
 #include "logger.h"
 
+/*
+ * Origin node (1 based, lower left) and bilinear weight along one axis, for
+ * coordinate p relative to the origin grid, as in x_lattice_ij_from_xy and
+ * x_interp_map_nodes. Returns -1 if outside.
+ */
+static int
+_axis_weight(double p, double inc, double len, double len_inv, int *node, double *w)
+{
+    double u = p * len_inv;
+
+    if (len == 0.0 || u < (0.0 - FLOATEPS) || u > (1.0 + FLOATEPS))
+        return -1;
+    if (u < 0.0)
+        u = 0.0 + FLOATEPS;
+    if (u > 1.0)
+        u = 1.0 - FLOATEPS;
+
+    p = u * len;
+    *node = (int)(p / inc) + 1;
+
+    double p0 = (*node - 1) * inc;
+    double p1 = (*node) * inc;
+
+    /* check as in x_interp_map_nodes */
+    if (p < (p0 < p1 ? p0 : p1) || p > (p0 < p1 ? p1 : p0))
+        return -1;
+
+    *w = (p - p0) / (p1 - p0);
+    return 0;
+}
+
+/* bilinear value from 4 nodes, with lower left (i, j), 1 based, and weights */
+static double
+_bilinear(const double *mapv, int ny, int i, int j, double a, double b)
+{
+    long ib = (long)(i - 1) * ny + (j - 1);
+
+    double z0 = mapv[ib];
+    double z1 = mapv[ib + ny];
+    double z2 = mapv[ib + 1];
+    double z3 = mapv[ib + ny + 1];
+
+    if (z0 > UNDEF_MAP_LIMIT || z1 > UNDEF_MAP_LIMIT || z2 > UNDEF_MAP_LIMIT ||
+        z3 > UNDEF_MAP_LIMIT)
+        return UNDEF_MAP;
+
+    return z0 + a * (z1 - z0) + b * (z2 - z0) + a * b * (z3 + z0 - z2 - z1);
+}
+
+static int
+_resample_separable(const struct xtg_lattice *lat1,
+                    const double *mapv1,
+                    const struct xtg_lattice *lat2,
+                    double *mapv2,
+                    int nthreads)
+{
+    int nx2 = lat2->nx, ny2 = lat2->ny;
+
+    int *inode = malloc(nx2 * sizeof(int));
+    int *jnode = malloc(ny2 * sizeof(int));
+    double *aw = malloc(nx2 * sizeof(double));
+    double *bw = malloc(ny2 * sizeof(double));
+
+    if (inode == NULL || jnode == NULL || aw == NULL || bw == NULL) {
+        x_free(4, inode, jnode, aw, bw);
+        return -6;
+    }
+
+    /* result origin in the rotated system of the origin grid */
+    double dx = lat2->xori - lat1->xori;
+    double dy = lat2->yori - lat1->yori;
+    double ox = dx * lat1->cosa + dy * lat1->sina;
+    double oy = dy * lat1->cosa - dx * lat1->sina;
+
+    int i2, j2;
+    for (i2 = 0; i2 < nx2; i2++) {
+        if (_axis_weight(ox + i2 * lat2->xinc, lat1->xinc, lat1->xlen, lat1->xlen_inv,
+                         &inode[i2], &aw[i2]) != 0)
+            inode[i2] = 0;
+    }
+    for (j2 = 0; j2 < ny2; j2++) {
+        if (_axis_weight(oy + j2 * lat2->yinc, lat1->yinc, lat1->ylen, lat1->ylen_inv,
+                         &jnode[j2], &bw[j2]) != 0)
+            jnode[j2] = 0;
+    }
+
+#pragma omp parallel for schedule(static) private(j2) num_threads(nthreads)
+    for (i2 = 0; i2 < nx2; i2++) {
+        double *row = mapv2 + (long)i2 * ny2;
+        for (j2 = 0; j2 < ny2; j2++) {
+            if (inode[i2] == 0 || jnode[j2] == 0) {
+                row[j2] = UNDEF;
+            } else {
+                row[j2] =
+                  _bilinear(mapv1, lat1->ny, inode[i2], jnode[j2], aw[i2], bw[j2]);
+            }
+        }
+    }
+
+    x_free(4, inode, jnode, aw, bw);
+    return EXIT_SUCCESS;
+}
+
+static void
+_resample_general(const struct xtg_lattice *lat1,
+                  double *mapv1,
+                  const struct xtg_lattice *lat2,
+                  double *mapv2,
+                  int nthreads)
+{
+    int nx2 = lat2->nx, ny2 = lat2->ny;
+    int i2, j2;
+
+#pragma omp parallel for schedule(static) private(j2) num_threads(nthreads)
+    for (i2 = 1; i2 <= nx2; i2++) {
+        for (j2 = 1; j2 <= ny2; j2++) {
+            double xc2, yc2;
+            long ib2 = x_ijk2ic(i2, j2, 1, nx2, ny2, 1, 0); /* C order */
+
+            /* get the x y location in the result: */
+            x_lattice_xy_from_ij(lat2, i2, j2, &xc2, &yc2);
+
+            /* based on this X Y, need to find Z value from original: */
+            mapv2[ib2] = surf_get_z_from_lattice(lat1, xc2, yc2, mapv1);
+        }
+    }
+}
+
 int
 surf_resample(int nx1,
               int ny1,
@@ -56,39 +193,30 @@ surf_resample(int nx1,
               double rota2,
               double *mapv2,
               long nn2,
-              int optmask)
+              int optmask,
+              int nthreads)
 
 {
-    /* locals */
-    int i2, j2, ier2, ib2;
-    double xc2, yc2, zc2, zc;
+    double xprof_t0 = x_prof_tic();
+    int ier = EXIT_SUCCESS;
+    struct xtg_lattice lat1, lat2;
 
     logger_info(LI, FI, FU, "Resampling surface...");
 
-    for (i2 = 1; i2 <= nx2; i2++) {
-        for (j2 = 1; j2 <= ny2; j2++) {
-
-            ib2 = x_ijk2ic(i2, j2, 1, nx2, ny2, 1, 0); /* C order */
-
-            if (optmask == 1)
-                mapv2[ib2] = UNDEF;
-
-            /* get the x y location in the result: */
-            ier2 = surf_xyz_from_ij(i2, j2, &xc2, &yc2, &zc2, xori2, xinc2, yori2,
-                                    yinc2, nx2, ny2, yflip2, rota2, mapv2, nn2, 1);
+    /* geometry of both maps is set up once, not for every node */
+    x_lattice_init(&lat1, xori1, xinc1, yori1, yinc1, nx1, ny1, yflip1, rota1);
+    x_lattice_init(&lat2, xori2, xinc2, yori2, yinc2, nx2, ny2, yflip2, rota2);
 
-            /* based on this X Y, need to find Z value from original: */
-            if (ier2 == 0) {
-                zc = surf_get_z_from_xy(xc2, yc2, nx1, ny1, xori1, yori1, xinc1, yinc1,
-                                        yflip1, rota1, mapv1, nn1);
-                mapv2[ib2] = zc;
+    nthreads = x_nthreads(nthreads);
 
-            } else {
-                logger_info(LI, FI, FU, "Something went wrong: ier2 = %d", ier2);
-                return ier2;
-            }
-        }
+    if (lat1.cosa == lat2.cosa && lat1.sina == lat2.sina) {
+        logger_info(LI, FI, FU, "Same rotation, separable resampling");
+        ier = _resample_separable(&lat1, mapv1, &lat2, mapv2, nthreads);
+    } else {
+        _resample_general(&lat1, mapv1, &lat2, mapv2, nthreads);
     }
+
+    x_prof_toc(FU, xprof_t0, nn2);
     logger_info(LI, FI, FU, "Resampling surface... done!");
-    return 0;
+    return ier;
 }
@@ -0,0 +1,162 @@
+/*
+****************************************************************************************
+*
+* NAME:
+*    surf_sample_xyv.c
+*
+* DESCRIPTION:
+*    Sample a (rotated) map at arrays of X Y points, with nearest node, bilinear or
+*    bicubic interpolation. The map geometry is set up once, and the loop over
+*    points is parallel.
+*
+*    Points outside the map or at undefined nodes get UNDEF:
+*    - nearest: if the nearest node is undefined
+*    - bilinear: if any of the 4 surrounding nodes is undefined (as
+*      surf_get_z_from_xy)
+*    - bicubic: Catmull-Rom cubic convolution on the 4 x 4 surrounding nodes. If
+*      any of these are undefined or outside the map (i.e. along the map border),
+*      the result is the bilinear value.
+*
+* ARGUMENTS:
+*    xv, yv        i      XY Coordinates as arrays (with length)
+*    zv            o      Result array (with length)
+*    nx, ny        i      Surf dimensions
+*    xori, yori    i      Map origins
+*    xinc, yinc    i      Map increments
+*    yflip         i      YFLIP 1 or -1
+*    rot_deg       i      Rotation
+*    p_map_v       i      Map values (with length)
+*    method        i      0: nearest node, 1: bilinear, 2: bicubic
+*    nthreads      i      Number of threads, 0 or negative means all available
+*
+* RETURNS:
+*    EXIT_SUCCESS, or -4 for inconsistent array lengths, -5 for invalid method
+*
+* TODO/ISSUES/BUGS:
+*
+* LICENCE:
+*    cf. XTGeo LICENSE
+***************************************************************************************
+*/
+
+#include "libxtg.h"
+#include "libxtg_.h"
+#include "logger.h"
+
+/* Catmull-Rom weights for nodes -1, 0, 1, 2 at fraction t in [0, 1] */
+static void
+_cubic_weights(double t, double *w)
+{
+    double t2 = t * t;
+    double t3 = t2 * t;
+
+    w[0] = -0.5 * t3 + t2 - 0.5 * t;
+    w[1] = 1.5 * t3 - 2.5 * t2 + 1.0;
+    w[2] = -1.5 * t3 + 2.0 * t2 + 0.5 * t;
+    w[3] = 0.5 * t3 - 0.5 * t2;
+}
+
+static double
+_sample_nearest(const struct xtg_lattice *lat, double x, double y, double *p_map_v)
+{
+    int i, j;
+    double rx, ry;
+
+    if (x_lattice_ij_from_xy(lat, x, y, 0, &i, &j, &rx, &ry) != 0)
+        return UNDEF;
+    if (i < 1 || i > lat->nx || j < 1 || j > lat->ny)
+        return UNDEF;
+
+    double z = p_map_v[x_ijk2ic(i, j, 1, lat->nx, lat->ny, 1, 0)];
+    return z > UNDEF_MAP_LIMIT ? UNDEF : z;
+}
+
+static double
+_sample_bicubic(const struct xtg_lattice *lat, double x, double y, double *p_map_v)
+{
+    int i, j, m, n;
+    double rx, ry;
+
+    if (x_lattice_ij_from_xy(lat, x, y, 1, &i, &j, &rx, &ry) != 0)
+        return UNDEF;
+
+    int nx = lat->nx, ny = lat->ny;
+
+    /* the 4 x 4 nodes must be inside */
+    if (i < 2 || i + 2 > nx || j < 2 || j + 2 > ny)
+        return surf_get_z_from_lattice(lat, x, y, p_map_v);
+
+    double a = (rx - (i - 1) * lat->xinc) / lat->xinc;
+    double b = (ry - (j - 1) * lat->yinc) / lat->yinc;
+    a = a < 0.0 ? 0.0 : (a > 1.0 ? 1.0 : a);
+    b = b < 0.0 ? 0.0 : (b > 1.0 ? 1.0 : b);
+
+    double wa[4], wb[4];
+    _cubic_weights(a, wa);
+    _cubic_weights(b, wb);
+
+    double z = 0.0;
+    for (m = 0; m < 4; m++) {
+        const double *col = p_map_v + (long)(i - 2 + m) * ny + (j - 2);
+        double zcol = 0.0;
+        for (n = 0; n < 4; n++) {
+            if (col[n] > UNDEF_MAP_LIMIT)
+                return surf_get_z_from_lattice(lat, x, y, p_map_v);
+            zcol += wb[n] * col[n];
+        }
+        z += wa[m] * zcol;
+    }
+    return z;
+}
+
+int
+surf_sample_xyv(double *xv,
+                long nxv,
+                double *yv,
+                long nyv,
+                double *zv,
+                long nzv,
+                int nx,
+                int ny,
+                double xori,
+                double yori,
+                double xinc,
+                double yinc,
+                int yflip,
+                double rot_deg,
+                double *p_map_v,
+                long nn,
+                int method,
+                int nthreads)
+{
+    double xprof_t0 = x_prof_tic();
+    struct xtg_lattice lat;
+
+    if (nyv != nxv || nzv != nxv || nn != (long)nx * ny) {
+        logger_error(LI, FI, FU, "Inconsistent array lengths in %s", FU);
+        return -4;
+    }
+    if (method < 0 || method > 2) {
+        logger_error(LI, FI, FU, "Invalid sampling method %d in %s", method, FU);
+        return -5;
+    }
+
+    x_lattice_init(&lat, xori, xinc, yori, yinc, nx, ny, yflip, rot_deg);
+
+    nthreads = x_nthreads(nthreads);
+
+    long i;
+#pragma omp parallel for schedule(static) num_threads(nthreads)
+    for (i = 0; i < nxv; i++) {
+        if (method == 0) {
+            zv[i] = _sample_nearest(&lat, xv[i], yv[i], p_map_v);
+        } else if (method == 1) {
+            zv[i] = surf_get_z_from_lattice(&lat, xv[i], yv[i], p_map_v);
+        } else {
+            zv[i] = _sample_bicubic(&lat, xv[i], yv[i], p_map_v);
+        }
+    }
+
+    x_prof_toc(FU, xprof_t0, nxv);
+    return EXIT_SUCCESS;
+}
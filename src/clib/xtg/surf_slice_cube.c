@@ -15,6 +15,8 @@
  *    yflip          i     Cube YFLIP index
  *    p_cubeval_v    i     1D Array of cube values of ncx*ncy*ncz size
  *    ncube          i     Length of cube array
+ *    bcache         i     Brick cache handle for windowed cube (cube array is
+ *                         then empty), or -1
  *    mx, my         i     Map dimensions
  *    xori...        i     Map origin, incs, rotation
  *    p_zslice_v     i     map array with Z values
@@ -48,9 +50,9 @@
  *      * if the value is not UNDEF:
  *
  *        @ if nearest node:
- *          <cube_value_xyz_cell>, input X Y Z, return updated value from cube
- *            <cube_ijk_from_xyz>, find cube IJK from map XYZ
- *               <sucu_ij_from_xy>, find IJ from XY, nearest cell mode.
+ *          <cube_value_xyz_cell_lattice>, input X Y Z, return updated value from cube
+ *            <cube_ijk_from_xyz_lattice>, find cube IJK from map XYZ
+ *               <x_lattice_ij_from_xy>, find IJ from XY, nearest cell mode.
  *                                  and also provide relative coordinates
  *                  <x_point_line_pos>. finds if point is inside cube XY
  *                                      both for X and Y;
@@ -58,9 +60,9 @@
  *            return this value!
  *
  *        @ if trilinar node:
- *          <cube_value_xyz_interp>, input X Y Z, return updated value from cube
- *            <cube_ijk_from_xyz>, find cube IJK from map XYZ
- *               <sucu_ij_from_xy>, find IJ from XY, nearest cell mode.
+ *          <cube_value_xyz_interp_lattice>, input X Y Z, return updated value from cube
+ *            <cube_ijk_from_xyz_lattice>, find cube IJK from map XYZ
+ *               <x_lattice_ij_from_xy>, find IJ from XY, lower left mode.
  *                                  and also provide relative coordinates
  *                  <x_point_line_pos>. finds if point is inside cube XY
  *                                      both for X and Y;
@@ -89,6 +91,7 @@ surf_slice_cube(int ncx,
                 int yflip,
                 float *p_cubeval_v,
                 long ncube,
+                int bcache,
                 int mx,
                 int my,
                 double xori,
@@ -111,40 +114,43 @@ surf_slice_cube(int ncx,
     double x, y, z;
     float value;
     int nm = 0, option1a = 0;
+    struct xtg_lattice cubelat, maplat;
 
     if (nmap != nslice) {
         logger_error(LI, FI, FU, "Something is plain wrong in %s (nmap vs nslice)", FU);
     }
 
+    /* the map and cube XY geometries are set up once, not per node */
+    x_lattice_init(&cubelat, cxori, cxinc, cyori, cyinc, ncx, ncy, yflip, crotation);
+    x_lattice_init(&maplat, xori, xinc, yori, yinc, mx, my, mapflip, mrotation);
+
     /* work with every map node */
     for (im = 1; im <= mx; im++) {
 
         for (jm = 1; jm <= my; jm++) {
 
             /* get the surface x, y, value (z) from IJ location */
-            ier = surf_xyz_from_ij(im, jm, &x, &y, &z, xori, xinc, yori, yinc, mx, my,
-                                   mapflip, mrotation, p_zslice_v, nslice, 0);
+            ibm = x_ijk2ic(im, jm, 1, mx, my, 1, 0);
+            x_lattice_xy_from_ij(&maplat, im, jm, &x, &y);
+            z = p_zslice_v[ibm];
 
             ier = 99;
 
-            ibm = x_ijk2ic(im, jm, 1, mx, my, 1, 0);
-
             if (z < UNDEF_MAP_LIMIT) {
 
                 if (option1 == 0) {
 
-                    ier = cube_value_xyz_cell(x, y, z, cxori, cxinc, cyori, cyinc,
-                                              czori, czinc, crotation, yflip, ncx, ncy,
-                                              ncz, p_cubeval_v, &value, 0);
+                    ier = cube_value_xyz_cell_lattice(&cubelat, x, y, z, czori, czinc,
+                                                      ncz, p_cubeval_v, bcache, &value);
                 } else if (option1 == 1 || option1 == 2) {
 
                     option1a = 0;
                     if (option1 == 2)
                         option1a = 1;  // snap to closest XY
 
-                    ier = cube_value_xyz_interp(
-                      x, y, z, cxori, cxinc, cyori, cyinc, czori, czinc, crotation,
-                      yflip, ncx, ncy, ncz, p_cubeval_v, &value, option1a);
+                    ier = cube_value_xyz_interp_lattice(&cubelat, x, y, z, czori,
+                                                        czinc, ncz, p_cubeval_v, bcache,
+                                                        &value, option1a);
 
                 } else {
                     logger_error(LI, FI, FU, "Invalid option1 (%d) to %s", option1, FU);
@@ -16,6 +16,7 @@
  *    ncol, nrow...  i     cube dimensions and relevant increments
  *    p_cubeval_v    i     1D Array of cube values of ncx*ncy*ncz size
  *    ncube          i     Length of cube array
+ *    bcache         i     Brick cache handle for windowed cube, or -1
  *    zslicev        i     map array with Z values
  *    nslice         i     Length of slice array
  *    surfsv        i/o    map to update
@@ -49,6 +50,7 @@ surf_slice_cube_v3(int ncol,
                    double czinc,
                    float *cubevalsv,
                    long ncube,
+                   int bcache,
                    double *zslicev,
                    long nslice,
                    double *surfsv,
@@ -59,6 +61,7 @@ surf_slice_cube_v3(int ncol,
                    int optmask)
 
 {
+    double xprof_t0 = x_prof_tic();
 
     double zd[2];
     double czvals[2];
@@ -97,8 +100,8 @@ surf_slice_cube_v3(int ncol,
             icc1 = x_ijk2ic(icol, jrow, k1 + 1, ncol, nrow, nlay, 0);
             icc2 = x_ijk2ic(icol, jrow, k2 + 1, ncol, nrow, nlay, 0);
 
-            czvals[0] = cubevalsv[icc1];
-            czvals[1] = cubevalsv[icc2];
+            czvals[0] = CUBE_VALUE(cubevalsv, bcache, icc1);
+            czvals[1] = CUBE_VALUE(cubevalsv, bcache, icc2);
             zd[0] = czori + k1 * czinc;
             zd[1] = czori + k2 * czinc;
 
@@ -111,5 +114,6 @@ surf_slice_cube_v3(int ncol,
     }
     logger_info(LI, FI, FU, "Exit from %s", FU);
 
+    x_prof_toc(FU, xprof_t0, (long)ncol * nrow);
     return EXIT_SUCCESS;
 }
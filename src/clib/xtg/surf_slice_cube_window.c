@@ -17,6 +17,7 @@
  *    yflip          i     Cube YFLIP index
  *    p_cubeval_v    i     1D Array of cube values of ncx*ncy*ncz size
  *    ncube          i     Length of cube array
+ *    bcache         i     Brick cache handle for windowed cube, or -1
  *    mx, my         i     Map dimensions
  *    xori...        i     Map origin, incs, rotation
  *    p_map_v        i     Input map array with Z values
@@ -115,6 +116,7 @@ surf_slice_cube_window(int ncx,
                        int yflip,
                        float *p_cubeval_v,
                        long ncube,
+                       int bcache,
                        int mx,
                        int my,
                        double xori,
@@ -141,18 +143,25 @@ surf_slice_cube_window(int ncx,
     double *tmpzval;
     double *zattr;
     int option1a = 0;
+    struct xtg_lattice cubelat, maplat;
 
     tmpzval = calloc(nzincr, sizeof(double));
     zattr = calloc(nattr, sizeof(double));
 
+    /* the map and cube XY geometries are set up once, not per node */
+    x_lattice_init(&cubelat, cxori, cxinc, cyori, cyinc, ncx, ncy, yflip, crotation);
+    x_lattice_init(&maplat, xori, xinc, yori, yinc, mx, my, mapflip, mrotation);
+
     /* work with every map node */
     for (im = 1; im <= mx; im++) {
 
         for (jm = 1; jm <= my; jm++) {
 
             /* get the surface x, y, value (z) from IJ location */
-            ier = surf_xyz_from_ij(im, jm, &xcor, &ycor, &zcor, xori, xinc, yori, yinc,
-                                   mx, my, mapflip, mrotation, p_map_v, nmap, 0);
+            x_lattice_xy_from_ij(&maplat, im, jm, &xcor, &ycor);
+            zcor = p_map_v[x_ijk2ic(im, jm, 1, mx, my, 1, 0)];
+
+            ier = 99;
 
             if (zcor < UNDEF_LIMIT) {
 
@@ -162,23 +171,20 @@ surf_slice_cube_window(int ncx,
 
                     if (option1 == 0) {
 
-                        ier = cube_value_xyz_cell(
-                          xcor, ycor, zval, cxori, cxinc, cyori, cyinc, czori, czinc,
-                          crotation, yflip, ncx, ncy, ncz, p_cubeval_v, &value, 0);
+                        ier = cube_value_xyz_cell_lattice(&cubelat, xcor, ycor, zval,
+                                                          czori, czinc, ncz,
+                                                          p_cubeval_v, bcache, &value);
 
                     } else if (option1 == 1 || option1 == 2) {
 
                         option1a = 0;
                         if (option1 == 2)
                             option1a = 1;  // snap to closest XY
-                        if (knum > 0)
-                            option1a += 10;  // Skip IJ calculation
-
-                        /* TIDSTYV! */
-                        ier = cube_value_xyz_interp(xcor, ycor, zval, cxori, cxinc,
-                                                    cyori, cyinc, czori, czinc,
-                                                    crotation, yflip, ncx, ncy, ncz,
-                                                    p_cubeval_v, &value, option1a);
+
+                        ier = cube_value_xyz_interp_lattice(&cubelat, xcor, ycor, zval,
+                                                            czori, czinc, ncz,
+                                                            p_cubeval_v, bcache, &value,
+                                                            option1a);
 
                     } else {
                         logger_error(LI, FI, FU, "Invalid option1 (%d) to %s", option1,
@@ -60,6 +60,7 @@ surf_slice_grd3d(int mcol,
                  double *p_prop_v,
                  int buffer)
 {
+    double xprof_t0 = x_prof_tic();
 
     int j, k, kc1, kc2, kstep = 0, ier, ier3, ios, ix;
     int imm, im, jm, im1, im2, jm1, jm2;
@@ -68,6 +69,9 @@ surf_slice_grd3d(int mcol,
     double zmapmin, zmapmax;
     double xc[8], yc[8];
     long ib, ic, nactive = 0;
+    struct xtg_lattice lat;
+
+    x_lattice_init(&lat, xori, xinc, yori, yinc, mcol, mrow, yflip, rotation);
 
     /* determine Z window for map (could speed up if flat OWC contact) */
     ier = surf_zminmax(mcol, mrow, p_slice_v, &zmapmin, &zmapmax);
@@ -146,8 +150,7 @@ surf_slice_grd3d(int mcol,
             jm2 = 1;
 
             for (ix = 0; ix < 8; ix++) {
-                ier = sucu_ij_from_xy(&im, &jm, &rx, &ry, xc[ix], yc[ix], xori, xinc,
-                                      yori, yinc, mcol, mrow, yflip, rotation, 0);
+                ier = x_lattice_ij_from_xy(&lat, xc[ix], yc[ix], 0, &im, &jm, &rx, &ry);
                 if (ier == 0) {
                     if (im < im1)
                         im1 = im;
@@ -207,5 +210,6 @@ surf_slice_grd3d(int mcol,
         }
     }
 
+    x_prof_toc(FU, xprof_t0, (long)mcol * mrow);
     return EXIT_SUCCESS;
 }
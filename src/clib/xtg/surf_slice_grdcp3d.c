@@ -0,0 +1,234 @@
+/*
+ ******************************************************************************
+ *
+ * NAME:
+ *    surf_slice_grdcp3d.c
+ *
+ *
+ * DESCRIPTION:
+ *    Sample values from grd3d based on map values. This is the xtgformat=2
+ *    version of surf_slice_grd3d()
+ *
+ * ARGUMENTS:
+ *    mcol, mrow     i     map dimens
+ *    xori ... yinc  i     Various map settings
+ *    p_slice_v      i     map array, e.g a FWL
+ *    p_map_v        o     map array, to update to output
+ *    ncol, .. nlay  i     Grid dimensions I J K
+ *    coordsv        i     Grid COORD, xtgformat=2
+ *    zcornsv        i     Grid Z corners for input, xtgformat=2
+ *    actnumsv       i     Grid ACTNUM parameter input, xtgformat=2
+ *    p_prop_v       i     Grid property to extract values for, C order
+ *    buffer         i     A buffer number of nodes to extend sampling
+ *
+ * RETURNS:
+ *    The C macro EXIT_SUCCESS unless problems + changed pointers
+ *
+ * TODO/ISSUES/BUGS:
+ *
+ * LICENCE:
+ *    cf. XTGeo LICENSE
+ ******************************************************************************
+ */
+
+#include "libxtg.h"
+#include "libxtg_.h"
+#include "logger.h"
+
+/* min of cell top corners (option 0) or max of cell base corners (option 1), as
+   grd3d_zminmax(); i, j, k base 0 */
+static double
+_zminmax(long i,
+         long j,
+         long k,
+         long nrow,
+         long nlay,
+         float *zcornsv,
+         int option)
+{
+    long nnrow = nrow + 1;
+    long nnlay = nlay + 1;
+    long kk = (option == 0) ? k : k + 1;
+
+    double zc[4];
+    zc[0] = zcornsv[((i + 0) * nnrow * nnlay + (j + 0) * nnlay + kk) * 4 + 3];
+    zc[1] = zcornsv[((i + 1) * nnrow * nnlay + (j + 0) * nnlay + kk) * 4 + 2];
+    zc[2] = zcornsv[((i + 0) * nnrow * nnlay + (j + 1) * nnlay + kk) * 4 + 1];
+    zc[3] = zcornsv[((i + 1) * nnrow * nnlay + (j + 1) * nnlay + kk) * 4 + 0];
+
+    double zval = zc[0];
+    int ic;
+    for (ic = 1; ic < 4; ic++) {
+        if (option == 0 && zc[ic] < zval)
+            zval = zc[ic];
+        if (option == 1 && zc[ic] > zval)
+            zval = zc[ic];
+    }
+    return zval;
+}
+
+int
+surf_slice_grdcp3d(int mcol,
+                   int mrow,
+                   double xori,
+                   double xinc,
+                   double yori,
+                   double yinc,
+                   double rotation,
+                   int yflip,
+                   double *p_slice_v,  // input
+                   long mslice,
+                   double *p_map_v,  // output
+                   long mmap,
+                   long ncol,
+                   long nrow,
+                   long nlay,
+                   double *coordsv,
+                   long ncoord,
+                   float *zcornsv,
+                   long nzcorn,
+                   int *actnumsv,
+                   long nact,
+                   double *p_prop_v,
+                   long nprop,
+                   int buffer)
+{
+    double xprof_t0 = x_prof_tic();
+
+    int ier, ier3, ios, ix;
+    int im, jm, im1, im2, jm1, jm2;
+    double corners[24];
+    double rx, ry, xm, ym, zm;
+    double zmapmin, zmapmax;
+    double xc[8], yc[8];
+    long ic;
+    struct xtg_lattice lat;
+
+    x_lattice_init(&lat, xori, xinc, yori, yinc, mcol, mrow, yflip, rotation);
+
+    /* determine Z window for map (could speed up if flat OWC contact) */
+    ier = surf_zminmax(mcol, mrow, p_slice_v, &zmapmin, &zmapmax);
+
+    if (ier == -2)
+        logger_error(LI, FI, FU, "Only UNDEF in input map!");
+
+    for (ic = 0; ic < mcol * mrow; ic++)
+        p_map_v[ic] = UNDEF;
+
+    /* loop grid3d columns, and find approximate area for map to search */
+
+    long i, j, k;
+    for (j = 0; j < nrow; j++) {
+        for (i = 0; i < ncol; i++) {
+
+            /* if the whole column is outside zmap minmax, then skip */
+            if (_zminmax(i, j, nlay - 1, nrow, nlay, zcornsv, 1) < zmapmin)
+                continue;
+            if (_zminmax(i, j, 0, nrow, nlay, zcornsv, 0) > zmapmax)
+                continue;
+
+            long kc1 = 0;
+            long kc2 = -1;
+            long nactive = 0;
+            for (k = 0; k < nlay; k++) {
+                if (actnumsv[i * nrow * nlay + j * nlay + k] == 1)
+                    nactive++;
+
+                if (_zminmax(i, j, k, nrow, nlay, zcornsv, 1) < zmapmin)
+                    kc1 = k;
+                if (_zminmax(i, j, k, nrow, nlay, zcornsv, 0) > zmapmax) {
+                    kc2 = k;
+                    break;
+                }
+            }
+
+            if (nactive == 0)
+                continue;
+
+            if (kc1 > kc2)
+                kc2 = nlay - 1;
+
+            grdcp3d_corners(i, j, kc1, ncol, nrow, nlay, coordsv, ncoord, zcornsv,
+                            nzcorn, corners);
+            for (ix = 0; ix < 4; ix++) {
+                xc[ix] = corners[3 * ix];
+                yc[ix] = corners[3 * ix + 1];
+            }
+
+            grdcp3d_corners(i, j, kc2, ncol, nrow, nlay, coordsv, ncoord, zcornsv,
+                            nzcorn, corners);
+            for (ix = 4; ix < 8; ix++) {
+                xc[ix] = corners[3 * ix];
+                yc[ix] = corners[3 * ix + 1];
+            }
+
+            /* find widest range in map nodes to cover this cell column
+               which will be the upper and lower cell */
+            im1 = mcol;
+            im2 = 1;
+            jm1 = mrow;
+            jm2 = 1;
+
+            for (ix = 0; ix < 8; ix++) {
+                ier = x_lattice_ij_from_xy(&lat, xc[ix], yc[ix], 0, &im, &jm, &rx, &ry);
+                if (ier == 0) {
+                    if (im < im1)
+                        im1 = im;
+                    if (im > im2)
+                        im2 = im;
+                    if (jm < jm1)
+                        jm1 = jm;
+                    if (jm > jm2)
+                        jm2 = jm;
+                }
+            }
+
+            /* extend with buffer nodes to be certain */
+            im1 -= buffer;
+            im2 += buffer;
+            jm1 -= buffer;
+            jm2 += buffer;
+            if (im1 < 1)
+                im1 = 1;
+            if (im2 > mcol)
+                im2 = mcol;
+            if (jm1 < 1)
+                jm1 = 1;
+            if (jm2 > mrow)
+                jm2 = mrow;
+
+            for (k = kc1; k <= kc2; k++) {
+                long icell = i * nrow * nlay + j * nlay + k;
+                if (actnumsv[icell] != 1)
+                    continue;
+
+                double cellvalue = p_prop_v[icell];
+
+                /* get map cell corners: */
+                grdcp3d_corners(i, j, k, ncol, nrow, nlay, coordsv, ncoord, zcornsv,
+                                nzcorn, corners);
+
+                for (im = im1; im <= im2; im++) {
+                    for (jm = jm1; jm <= jm2; jm++) {
+                        ier3 = surf_xyz_from_ij(im, jm, &xm, &ym, &zm, xori, xinc, yori,
+                                                yinc, mcol, mrow, yflip, rotation,
+                                                p_slice_v, mslice, 0);
+
+                        if (ier3 == 0 && zm < UNDEF_LIMIT) {
+
+                            ios = x_chk_point_in_cell(xm, ym, zm, corners, 0);
+
+                            if (ios > 0) {
+                                long imm = x_ijk2ic(im, jm, 1, mcol, mrow, 1, 0);
+                                p_map_v[imm] = cellvalue;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    x_prof_toc(FU, xprof_t0, (long)mcol * mrow);
+    return EXIT_SUCCESS;
+}
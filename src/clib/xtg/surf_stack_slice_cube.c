@@ -14,6 +14,7 @@
  *    ncol, nrow...  i     Cube dimensions and relevant increments
  *    czori, czinc   i     Cube settings
  *    cubevalsv      i     Cube values
+ *    bcache         i     Brick cache handle for windowed cube, or -1
  *    stack         i/o    stacked map array stack with Z values
  *    rmask          i     stacked map array stack with masks
  *    optnearest     i     If 1 use nerest node, else do interpolation aka trilinear
@@ -43,6 +44,7 @@ surf_stack_slice_cube(int ncol,
                       double czori,
                       double czinc,
                       float *cubevalsv,
+                      int bcache,
                       double **stack,
                       mbool **rmask,
                       int optnearest,
@@ -89,8 +91,8 @@ surf_stack_slice_cube(int ncol,
                 long icc1, icc2;
                 icc1 = x_ijk2ic(icol, jcol, k1 + 1, ncol, nrow, nlay, 0);  // yes k+1
                 icc2 = x_ijk2ic(icol, jcol, k2 + 1, ncol, nrow, nlay, 0);
-                czvals[0] = cubevalsv[icc1];
-                czvals[1] = cubevalsv[icc2];
+                czvals[0] = CUBE_VALUE(cubevalsv, bcache, icc1);
+                czvals[1] = CUBE_VALUE(cubevalsv, bcache, icc2);
                 zd[0] = czori + k1 * czinc;
                 zd[1] = czori + k2 * czinc;
 
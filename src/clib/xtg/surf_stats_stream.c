@@ -0,0 +1,328 @@
+/*
+ ***************************************************************************************
+ *
+ * NAME:
+ *    surf_stats_stream.c (file name)
+ *    surf_stats_add
+ *    surf_stats_sketch_result
+ *    surf_stats_percentiles
+ *
+ * DESCRIPTION:
+ *    Streaming statistics per map node for a collection of surfaces, e.g.
+ *    realisations, where surfaces are added one at a time and never stacked.
+ *
+ *    The state is kept in arrays owned by the caller, one entry per node:
+ *    count, mean and sum of squared deviations (m2) are updated with Welford's
+ *    single pass algorithm, so that variance = m2 / (count - 1).
+ *
+ *    Approximate percentiles are estimated with the extended P-square algorithm
+ *    (Jain and Chlamtac 1985, Raatikainen 1987), which keeps m = 2 * nprobs + 3
+ *    markers per node: heights and (1 based) positions of markers at the
+ *    probabilities 0, p1/2, p1, (p1+p2)/2, p2, ..., pn, (pn+1)/2, 1. The markers
+ *    at 0 and 1 are the exact minimum and maximum. The first m values are kept
+ *    sorted, hence the result is exact for up to m values.
+ *
+ *    surf_stats_add:
+ *    Add a surface (UNDEF for undefined nodes) to the accumulators. The markers
+ *    are updated only if heights are given (nheights > 0).
+ *
+ *    surf_stats_sketch_result:
+ *    Percentiles from the markers, interpolated linearly between marker
+ *    probabilities (i.e. p1, p2 ... are marker heights).
+ *
+ *    surf_stats_percentiles:
+ *    Exact percentiles per node of a stack of surfaces (nreal x nnode, C order),
+ *    with linear interpolation as numpy.nanpercentile.
+ *
+ *    All functions are parallel over map nodes. Nodes without values get UNDEF.
+ *
+ * ARGUMENTS:
+ *    values         i     Surface values, UNDEF if undefined (with length nnode)
+ *    count         i/o    Number of values per node (with length)
+ *    mean          i/o    Running mean per node (with length)
+ *    m2            i/o    Running sum of squared deviations per node (with length)
+ *    probs          i     Marker probabilities in (0, 1), sorted (with length)
+ *    heights       i/o    Marker heights, m per node (with length, may be 0)
+ *    positions     i/o    Marker positions, m per node (with length, may be 0)
+ *    stack          i     Stack of surface values, UNDEF if undefined (with length)
+ *    nreal          i     Number of surfaces in stack
+ *    percentiles    i     Percentiles to compute, 0 - 100 (with length)
+ *    result         o     Percentile surfaces, npct x nnode, C order (with length)
+ *    nthreads       i     Number of threads, 0 or negative means all available
+ *
+ * RETURNS:
+ *    EXIT_SUCCESS, or -4 for inconsistent array lengths, -6 if memory allocation
+ *    fails.
+ *
+ * TODO/ISSUES/BUGS:
+ *
+ * LICENCE:
+ *    cf. XTGeo LICENSE
+ ***************************************************************************************
+ */
+
+#include "libxtg.h"
+#include "libxtg_.h"
+#include "logger.h"
+
+/* marker probabilities 0, p1/2, p1, (p1+p2)/2, ..., pn, (pn+1)/2, 1 (allocated) */
+static double *
+_marker_probs(double *probs, long nprobs)
+{
+    long m = 2 * nprobs + 3;
+    double *dp = malloc(m * sizeof(double));
+    if (dp == NULL)
+        return NULL;
+
+    long i;
+    double prev = 0.0;
+    for (i = 0; i < nprobs; i++) {
+        dp[2 * i + 1] = 0.5 * (prev + probs[i]);
+        dp[2 * i + 2] = probs[i];
+        prev = probs[i];
+    }
+    dp[0] = 0.0;
+    dp[m - 2] = 0.5 * (prev + 1.0);
+    dp[m - 1] = 1.0;
+    return dp;
+}
+
+/* P-square update of markers with value x, where count is before adding x */
+static void
+_psquare_add(double *q, int *n, const double *dp, int m, long count, double x)
+{
+    int i, k;
+
+    if (count < m) {
+        /* initial phase; keep values sorted (insertion) */
+        for (i = (int)count; i > 0 && q[i - 1] > x; i--)
+            q[i] = q[i - 1];
+        q[i] = x;
+        n[count] = (int)count + 1;
+        return;
+    }
+
+    if (x < q[0]) {
+        q[0] = x;
+        k = 0;
+    } else if (x >= q[m - 1]) {
+        q[m - 1] = x;
+        k = m - 2;
+    } else {
+        for (k = 0; k < m - 2 && x >= q[k + 1]; k++)
+            ;
+    }
+
+    for (i = k + 1; i < m; i++)
+        n[i]++;
+
+    /* adjust inner markers towards desired positions 1 + count * dp */
+    for (i = 1; i < m - 1; i++) {
+        double d = 1.0 + count * dp[i] - n[i];
+
+        if ((d >= 1.0 && n[i + 1] - n[i] > 1) || (d <= -1.0 && n[i - 1] - n[i] < -1)) {
+            int s = d > 0.0 ? 1 : -1;
+
+            /* piecewise parabolic prediction, else linear */
+            double qp =
+              q[i] + (double)s / (n[i + 1] - n[i - 1]) *
+                       ((n[i] - n[i - 1] + s) * (q[i + 1] - q[i]) / (n[i + 1] - n[i]) +
+                        (n[i + 1] - n[i] - s) * (q[i] - q[i - 1]) / (n[i] - n[i - 1]));
+
+            if (q[i - 1] < qp && qp < q[i + 1]) {
+                q[i] = qp;
+            } else {
+                q[i] = q[i] + s * (q[i + s] - q[i]) / (n[i + s] - n[i]);
+            }
+            n[i] += s;
+        }
+    }
+}
+
+/* percentile (0 - 100) of sorted values, with linear interpolation */
+static double
+_sorted_percentile(const double *v, long nv, double pct)
+{
+    double pos = pct / 100.0 * (nv - 1);
+    long lo = (long)floor(pos);
+    if (lo >= nv - 1)
+        return v[nv - 1];
+    if (lo < 0)
+        return v[0];
+    double frac = pos - lo;
+    return v[lo] + frac * (v[lo + 1] - v[lo]);
+}
+
+static int
+_cmp_double(const void *a, const void *b)
+{
+    double da = *(const double *)a;
+    double db = *(const double *)b;
+    return (da > db) - (da < db);
+}
+
+int
+surf_stats_add(double *values,
+               long nnode,
+               int *count,
+               long ncount,
+               double *mean,
+               long nmean,
+               double *m2,
+               long nm2,
+               double *probs,
+               long nprobs,
+               double *heights,
+               long nheights,
+               int *positions,
+               long npositions,
+               int nthreads)
+{
+    double xprof_t0 = x_prof_tic();
+
+    int m = (int)(2 * nprobs + 3);
+    int usesketch = nheights > 0;
+
+    if (ncount != nnode || nmean != nnode || nm2 != nnode ||
+        (usesketch && (nheights != m * nnode || npositions != m * nnode))) {
+        logger_error(LI, FI, FU, "Inconsistent array lengths in %s", FU);
+        return -4;
+    }
+
+    double *dp = _marker_probs(probs, nprobs);
+    if (dp == NULL)
+        return -6;
+
+    nthreads = x_nthreads(nthreads);
+
+    long i;
+#pragma omp parallel for schedule(static) num_threads(nthreads)
+    for (i = 0; i < nnode; i++) {
+        double x = values[i];
+        if (x > UNDEF_LIMIT)
+            continue;
+
+        if (usesketch)
+            _psquare_add(heights + i * m, positions + i * m, dp, m, count[i], x);
+
+        count[i]++;
+        double delta = x - mean[i];
+        mean[i] += delta / count[i];
+        m2[i] += delta * (x - mean[i]);
+    }
+    free(dp);
+
+    x_prof_toc(FU, xprof_t0, nnode);
+    return EXIT_SUCCESS;
+}
+
+int
+surf_stats_sketch_result(int *count,
+                         long nnode,
+                         double *probs,
+                         long nprobs,
+                         double *heights,
+                         long nheights,
+                         double *percentiles,
+                         long npct,
+                         double *result,
+                         long nresult,
+                         int nthreads)
+{
+    int m = (int)(2 * nprobs + 3);
+
+    if (nheights != m * nnode || nresult != npct * nnode) {
+        logger_error(LI, FI, FU, "Inconsistent array lengths in %s", FU);
+        return -4;
+    }
+
+    double *dp = _marker_probs(probs, nprobs);
+    if (dp == NULL)
+        return -6;
+
+    nthreads = x_nthreads(nthreads);
+
+    long i;
+#pragma omp parallel for schedule(static) num_threads(nthreads)
+    for (i = 0; i < nnode; i++) {
+        double *q = heights + i * m;
+        long ip;
+        for (ip = 0; ip < npct; ip++) {
+            double res = UNDEF;
+            if (count[i] > 0 && count[i] <= m) {
+                res = _sorted_percentile(q, count[i], percentiles[ip]);
+            } else if (count[i] > m) {
+                double p = percentiles[ip] / 100.0;
+                int k = 0;
+                while (k < m - 2 && p > dp[k + 1])
+                    k++;
+                double frac = (p - dp[k]) / (dp[k + 1] - dp[k]);
+                frac = frac < 0.0 ? 0.0 : (frac > 1.0 ? 1.0 : frac);
+                res = q[k] + frac * (q[k + 1] - q[k]);
+            }
+            result[ip * nnode + i] = res;
+        }
+    }
+    free(dp);
+    return EXIT_SUCCESS;
+}
+
+int
+surf_stats_percentiles(double *stack,
+                       long nstack,
+                       long nreal,
+                       double *percentiles,
+                       long npct,
+                       double *result,
+                       long nresult,
+                       int nthreads)
+{
+    double xprof_t0 = x_prof_tic();
+
+    if (nreal < 1 || nstack % nreal != 0 || nresult != npct * (nstack / nreal)) {
+        logger_error(LI, FI, FU, "Inconsistent array lengths in %s", FU);
+        return -4;
+    }
+    long nnode = nstack / nreal;
+
+    nthreads = x_nthreads(nthreads);
+
+    int ier = EXIT_SUCCESS;
+#pragma omp parallel num_threads(nthreads)
+    {
+        /* scratch buffer per thread */
+        double *column = malloc(nreal * sizeof(double));
+        if (column == NULL) {
+#pragma omp critical(surf_stats_stream)
+            ier = -6;
+        }
+
+        long i;
+#pragma omp for schedule(static)
+        for (i = 0; i < nnode; i++) {
+            if (column == NULL)
+                continue;
+
+            long ir, nv = 0;
+            for (ir = 0; ir < nreal; ir++) {
+                double x = stack[ir * nnode + i];
+                if (x < UNDEF_LIMIT)
+                    column[nv++] = x;
+            }
+            qsort(column, nv, sizeof(double), _cmp_double);
+
+            long ip;
+            for (ip = 0; ip < npct; ip++) {
+                result[ip * nnode + i] =
+                  nv > 0 ? _sorted_percentile(column, nv, percentiles[ip]) : UNDEF;
+            }
+        }
+        free(column);
+    }
+
+    if (ier != EXIT_SUCCESS)
+        logger_error(LI, FI, FU, "Cannot allocate memory in %s", FU);
+
+    x_prof_toc(FU, xprof_t0, nstack);
+    return ier;
+}
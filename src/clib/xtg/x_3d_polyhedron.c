@@ -112,6 +112,45 @@ _x_point_outside_hexahedron_simple(double px, double py, double pz, double *corn
     return 0;
 }
 
+static double
+_x_tetrahedron_vol6(double *p0, double *p1, double *p2, double *p3)
+{
+    // six times the (unsigned) volume of a tetrahedron, as a 3x3 determinant.
+    // Much cheaper than x_tetrahedron_volume(), and used where volumes are only
+    // compared, as in the point in tetrahedron tests
+
+    double ax = p1[0] - p0[0], ay = p1[1] - p0[1], az = p1[2] - p0[2];
+    double bx = p2[0] - p0[0], by = p2[1] - p0[1], bz = p2[2] - p0[2];
+    double cx = p3[0] - p0[0], cy = p3[1] - p0[1], cz = p3[2] - p0[2];
+
+    return fabs(ax * (by * cz - bz * cy) - ay * (bx * cz - bz * cx) +
+                az * (bx * cy - by * cx));
+}
+
+static double
+_x_point_in_tetrahedron_diff(double x0, double y0, double z0, double *pv)
+{
+    // the relative volume difference (sum of the 4 tetrahedrons where one vertex is
+    // replaced with the point, vs the true volume), which is 0.0 (within precision)
+    // if the point is inside. Returns VERYLARGEPOSITIVE if the tetrahedron is
+    // collapsed
+
+    double pt[3] = { x0, y0, z0 };
+    double *p0 = &pv[0], *p1 = &pv[3], *p2 = &pv[6], *p3 = &pv[9];
+
+    double truevol = _x_tetrahedron_vol6(p0, p1, p2, p3) / 6.0;
+
+    if (truevol < FLOATEPS)
+        return VERYLARGEPOSITIVE;
+
+    double sumvol =
+      (_x_tetrahedron_vol6(pt, p1, p2, p3) + _x_tetrahedron_vol6(p0, pt, p2, p3) +
+       _x_tetrahedron_vol6(p0, p1, pt, p3) + _x_tetrahedron_vol6(p0, p1, p2, pt)) /
+      6.0;
+
+    return (sumvol - truevol) / truevol;
+}
+
 /*
  ***************************************************************************************
  *
@@ -219,7 +258,8 @@ x_hexahedron_volume(double *corners, long ndim, int precision)
         return 0.0;
     }
 
-    double **crn = x_allocate_2d_double(8, 3);
+    // stack storage; this function is called per cell from threaded loops
+    double crn[8][3];
 
     int i, j;
     int ic = 0;
@@ -250,8 +290,6 @@ x_hexahedron_volume(double *corners, long ndim, int precision)
         vol = (vol * (ialt - 1) + altvol) / ialt;
     }
 
-    free(crn);
-
     return vol;
 }
 
@@ -291,85 +329,14 @@ x_hexahedron_volume(double *corners, long ndim, int precision)
 int
 x_point_in_tetrahedron(double x0, double y0, double z0, double *pv, long ndim)
 {
+    double reldiff = _x_point_in_tetrahedron_diff(x0, y0, z0, pv);
 
-    double truevol = x_tetrahedron_volume(pv, 12);
-
-    if (truevol < FLOATEPS)
-        return 0;
-
-    int i, nv;
-    double newpv[12];
-    double sumvol;
-
-    sumvol = 0.0;
-    for (nv = 0; nv < 4; nv++) {
-        for (i = 0; i < ndim; i++) {
-            newpv[i] = pv[i];
-        }
-        newpv[0 + 3 * nv] = x0;
-        newpv[1 + 3 * nv] = y0;
-        newpv[2 + 3 * nv] = z0;
-
-        double vol = x_tetrahedron_volume(newpv, ndim);
-
-        sumvol += vol;
-    }
-
-    double relerror = truevol * 0.001;
-    double diff = sumvol - truevol;
-
-    if (diff < -1 * relerror) {
-        logger_critical(LI, FI, FU, "Something is wrong in %s!", FU);
-        exit(323);
-    } else if (diff > relerror) {
-        // LATER: make algorithm more smart to tell "closeness" of point
-        // if (sumvol / truevol < 5 && sumvol > 0.0) {
-        //     int res = (int)100 * (truevol / sumvol);
-        //     // logger_debug(LI, FI, FU, "Sumvol TrueVol %lf %lf Return %d", sumvol,
-        //                  truevol, res);
-        //     return res;
-        // }
-        return 0;
-    } else {
-        return 100;
-    }
-}
-
-static int
-x_point_in_tetrahedron_v2(double x0, double y0, double z0, double *pv, long ndim)
-{
-    // Simpler version, return 0 if outside and 1 if 0 if inside
-
-    double truevol = x_tetrahedron_volume(pv, 12);
-
-    if (truevol < FLOATEPS)
-        return 0;
-
-    int i, nv;
-    double newpv[12];
-    double sumvol;
-
-    sumvol = 0.0;
-    for (nv = 0; nv < 4; nv++) {
-        for (i = 0; i < ndim; i++) {
-            newpv[i] = pv[i];
-        }
-        newpv[0 + 3 * nv] = x0;
-        newpv[1 + 3 * nv] = y0;
-        newpv[2 + 3 * nv] = z0;
-
-        double vol = x_tetrahedron_volume(newpv, ndim);
-
-        sumvol += vol;
-    }
-
-    double relerror = truevol * 0.001;
-    double diff = sumvol - truevol;
-
-    if (diff > relerror)
+    // LATER: make algorithm more smart to tell "closeness" of point, e.g. from
+    // the reldiff
+    if (reldiff > 0.001)
         return 0;
 
-    return 1;
+    return 100;
 }
 
 /*
@@ -397,6 +364,46 @@ x_point_in_tetrahedron_v2(double x0, double y0, double z0, double *pv, long ndim
  ***************************************************************************************
  */
 
+/* the hexahedron as 5 tetrahedrons, in two alternative arrangements (method 1) */
+static const int HEXA5TETRA[2][5][4] = { { { 0, 2, 3, 6 },
+                                           { 0, 1, 3, 5 },
+                                           { 0, 4, 5, 6 },
+                                           { 3, 6, 7, 5 },
+                                           { 0, 3, 5, 6 } },
+                                         { { 0, 1, 2, 4 },
+                                           { 1, 2, 3, 7 },
+                                           { 4, 5, 7, 1 },
+                                           { 6, 4, 7, 2 },
+                                           { 1, 2, 4, 7 } } };
+
+static int
+_x_point_in_tetrahedron_set(double x0,
+                            double y0,
+                            double z0,
+                            double *corners,
+                            const int *tetra,
+                            int ntetra)
+{
+    // return 1 if point is inside any of the ntetra tetrahedrons in the set, where
+    // tetra holds 4 corner indices per tetrahedron
+
+    double thd[12];
+
+    int icset, i;
+    for (icset = 0; icset < ntetra; icset++) {
+        for (i = 0; i < 4; i++) {
+            const double *crn = &corners[3 * tetra[4 * icset + i]];
+            thd[3 * i + 0] = crn[0];
+            thd[3 * i + 1] = crn[1];
+            thd[3 * i + 2] = crn[2];
+        }
+        double reldiff = _x_point_in_tetrahedron_diff(x0, y0, z0, thd);
+        if (reldiff <= 0.001)
+            return 1;
+    }
+    return 0;
+}
+
 /* private, method 1 */
 static int
 _x_point_in_hexahedron_v1(double x0, double y0, double z0, double *corners, long ndim)
@@ -412,131 +419,14 @@ _x_point_in_hexahedron_v1(double x0, double y0, double z0, double *corners, long
         return 0;
     }
 
-    double **crn = x_allocate_2d_double(8, 3);
-    int **cset = x_allocate_2d_int(4, 5);
-
-    int i, j;
-    int ic = 0;
-    for (i = 0; i < 8; i++) {
-        for (j = 0; j < 3; j++) {
-            crn[i][j] = corners[ic++];
-        }
-    }
-
-    // the hexahedron consists of 5 tetrahedrons
-
-    cset[0][0] = 0;
-    cset[1][0] = 2;
-    cset[2][0] = 3;
-    cset[3][0] = 6;
-
-    cset[0][1] = 0;
-    cset[1][1] = 1;
-    cset[2][1] = 3;
-    cset[3][1] = 5;
-
-    cset[0][2] = 0;
-    cset[1][2] = 4;
-    cset[2][2] = 5;
-    cset[3][2] = 6;
-
-    cset[0][3] = 3;
-    cset[1][3] = 6;
-    cset[2][3] = 7;
-    cset[3][3] = 5;
-
-    cset[0][4] = 0;
-    cset[1][4] = 3;
-    cset[2][4] = 5;
-    cset[3][4] = 6;
-
-    int icset;
-    double thd[12];
-
-    int status1 = 0;
-    int set1score = 0;
-    for (icset = 0; icset < 5; icset++) {
-        ic = 0;
-        for (i = 0; i < 4; i++) {
-            thd[ic + 0] = crn[cset[i][icset]][0];
-            thd[ic + 1] = crn[cset[i][icset]][1];
-            thd[ic + 2] = crn[cset[i][icset]][2];
-            ic += 3;
-        }
-        int score = x_point_in_tetrahedron(x0, y0, z0, thd, 12);
-
-        if (score == 100) {
-            status1 += 50;
-            set1score = 0;
-            break;
-        } else if (score > 0 && score > set1score) {
-            set1score += score;
-        }
-    }
-
-    if (set1score > 0) {
-        status1 = set1score / 2;
-    }
-
-    // alternative arrangment of tetrahedrons
-
-    cset[0][0] = 0;
-    cset[1][0] = 1;
-    cset[2][0] = 2;
-    cset[3][0] = 4;
-
-    cset[0][1] = 1;
-    cset[1][1] = 2;
-    cset[2][1] = 3;
-    cset[3][1] = 7;
-
-    cset[0][2] = 4;
-    cset[1][2] = 5;
-    cset[2][2] = 7;
-    cset[3][2] = 1;
-
-    cset[0][3] = 6;
-    cset[1][3] = 4;
-    cset[2][3] = 7;
-    cset[3][3] = 2;
-
-    cset[0][4] = 1;
-    cset[1][4] = 2;
-    cset[2][4] = 4;
-    cset[3][4] = 7;
-
-    int status2 = 0;
-    int set2score = 0;
-    for (icset = 0; icset < 5; icset++) {
-        ic = 0;
-        for (i = 0; i < 4; i++) {
-            thd[ic + 0] = crn[cset[i][icset]][0];
-            thd[ic + 1] = crn[cset[i][icset]][1];
-            thd[ic + 2] = crn[cset[i][icset]][2];
-
-            ic += 3;
-        }
-
-        int score = x_point_in_tetrahedron(x0, y0, z0, thd, 12);
-
-        if (score == 100) {
-            status2 += 50;
-            set2score = 0;
-            break;
-        } else if (score > 0 && score > set2score) {
-            set2score += score;
-        }
-    }
-
-    if (set2score > 0) {
-        status2 = set2score / 2;
+    // the hexahedron consists of 5 tetrahedrons; each arrangement gives 50 if inside
+    int status = 0;
+    int ialt;
+    for (ialt = 0; ialt < 2; ialt++) {
+        status += 50 * _x_point_in_tetrahedron_set(x0, y0, z0, corners,
+                                                   &HEXA5TETRA[ialt][0][0], 5);
     }
 
-    int status = status1 + status2;
-
-    x_free_2d_double(crn);
-    x_free_2d_int(cset);
-
     return status;
 }
 
@@ -555,40 +445,13 @@ _x_point_in_hexahedron_v2(double x0, double y0, double z0, double *corners, long
         return 0;
     }
 
-    double **crn = x_allocate_2d_double(8, 3);
-    int **cset = x_allocate_2d_int(4, 5);
-
-    int i, j;
-    int ic = 0;
-    for (i = 0; i < 8; i++) {
-        for (j = 0; j < 3; j++) {
-            crn[i][j] = corners[ic++];
-        }
-    }
-
-    double thd[12];
-
     int status = 0;
-    int icset, ialt;
-    for (ialt = 1; ialt <= 2; ialt++) {
-        for (icset = 0; icset < 6; icset++) {
-            ic = 0;
-            for (i = 0; i < 4; i++) {
-                thd[ic + 0] = crn[TETRACOMBS[ialt - 1][icset][i]][0];
-                thd[ic + 1] = crn[TETRACOMBS[ialt - 1][icset][i]][1];
-                thd[ic + 2] = crn[TETRACOMBS[ialt - 1][icset][i]][2];
-                ic += 3;
-            }
-            int score = x_point_in_tetrahedron_v2(x0, y0, z0, thd, 12);
-            if (score == 1) {
-                status += 1;
-                break;
-            }
-        }
+    int ialt;
+    for (ialt = 0; ialt < 2; ialt++) {
+        status +=
+          _x_point_in_tetrahedron_set(x0, y0, z0, corners, &TETRACOMBS[ialt][0][0], 6);
     }
 
-    free(crn);
-
     return status * 50;
 }
 
@@ -607,4 +470,186 @@ x_point_in_hexahedron(double x0,
     } else {
         return _x_point_in_hexahedron_v2(x0, y0, z0, corners, ndim);
     }
-}
\ No newline at end of file
+}
+/*
+ ***************************************************************************************
+ *
+ * NAME:
+ *    x_hexahedron_prepare, x_point_in_hexahedron_prepared
+ *
+ *
+ * DESCRIPTION:
+ *    As x_point_in_hexahedron() with method 1, but for a cell that is prepared once
+ *    and then tested against many points, e.g. the last hit cell in the grid IJK
+ *    searches. In a point in tetrahedron test, the volume of the tetrahedron where
+ *    one vertex is replaced with the point is an affine function of the point, given
+ *    by the plane of the opposite face. Hence the 4 face planes of each of the 10
+ *    tetrahedrons, and the true volumes, are computed once per cell, relative to
+ *    the first corner (for precision). A point test is then 40 plane evaluations
+ *    without branches, stored per coefficient so that the loop is vectorized
+ *    (SIMD) by the compiler.
+ *
+ * ARGUMENTS:
+ *    corners       i     a [24] array with X Y Z of 8 vertices, as usual for cells
+ *    prep          o/i   the prepared cell, a [HEXA_NPREP] array
+ *    x0, y0, z0    i     Point coords
+ *
+ * RETURNS:
+ *    x_point_in_hexahedron_prepared: as x_point_in_hexahedron(), method 1
+ *
+ * LICENCE:
+ *    cf. XTGeo LICENSE
+ ***************************************************************************************
+ */
+
+/* layout of the prepared cell; face planes are stored as [vertex][tetrahedron] */
+#define HXP_NTETRA 10
+#define HXP_FLAG 0
+#define HXP_AABB 1
+#define HXP_ORIG 7
+#define HXP_NX 10
+#define HXP_NY (HXP_NX + 4 * HXP_NTETRA)
+#define HXP_NZ (HXP_NY + 4 * HXP_NTETRA)
+#define HXP_C (HXP_NZ + 4 * HXP_NTETRA)
+#define HXP_VOL (HXP_C + 4 * HXP_NTETRA)
+
+void
+x_hexahedron_prepare(double *corners, double *prep)
+{
+    prep[HXP_FLAG] = (_x_hexahedron_dz(corners) < FLOATEPS) ? 1.0 : 0.0;
+
+    double centroid[3];
+    x_corners_aabb_centroid(corners, &prep[HXP_AABB], centroid);
+
+    double rel[8][3];
+    int i, n;
+    for (i = 0; i < 8; i++) {
+        for (n = 0; n < 3; n++)
+            rel[i][n] = corners[3 * i + n] - corners[n];
+    }
+    for (n = 0; n < 3; n++)
+        prep[HXP_ORIG + n] = corners[n];
+
+    int ialt, it;
+    for (ialt = 0; ialt < 2; ialt++) {
+        for (it = 0; it < 5; it++) {
+            const int *tetra = HEXA5TETRA[ialt][it];
+            int itt = 5 * ialt + it;
+
+            double vol6 = _x_tetrahedron_vol6(rel[tetra[0]], rel[tetra[1]],
+                                              rel[tetra[2]], rel[tetra[3]]);
+            /* a collapsed tetrahedron never holds the point */
+            prep[HXP_VOL + itt] = (vol6 / 6.0 < FLOATEPS) ? -1.0 : vol6;
+
+            /* vertex iv replaced with the point: by the opposite face o1, o2, o3 the
+               volume is +- (det[o1, o2, o3] - point . ((o2 - o1) x (o3 - o1))) */
+            int iv;
+            for (iv = 0; iv < 4; iv++) {
+                double *o[3];
+                int io = 0;
+                for (i = 0; i < 4; i++) {
+                    if (i != iv)
+                        o[io++] = rel[tetra[i]];
+                }
+                double ax = o[1][0] - o[0][0], ay = o[1][1] - o[0][1];
+                double az = o[1][2] - o[0][2];
+                double bx = o[2][0] - o[0][0], by = o[2][1] - o[0][1];
+                double bz = o[2][2] - o[0][2];
+
+                int ip = iv * HXP_NTETRA + itt;
+                prep[HXP_NX + ip] = ay * bz - az * by;
+                prep[HXP_NY + ip] = az * bx - ax * bz;
+                prep[HXP_NZ + ip] = ax * by - ay * bx;
+                prep[HXP_C + ip] =
+                  o[0][0] * (o[1][1] * o[2][2] - o[1][2] * o[2][1]) -
+                  o[0][1] * (o[1][0] * o[2][2] - o[1][2] * o[2][0]) +
+                  o[0][2] * (o[1][0] * o[2][1] - o[1][1] * o[2][0]);
+            }
+        }
+    }
+}
+
+int
+x_point_in_hexahedron_prepared(double x0, double y0, double z0, double *prep)
+{
+    if (prep[HXP_FLAG] > 0.0)
+        return 0;
+
+    double *aabb = &prep[HXP_AABB];
+    if (x0 < aabb[0] || x0 > aabb[1] || y0 < aabb[2] || y0 > aabb[3] ||
+        z0 < aabb[4] || z0 > aabb[5])
+        return 0;
+
+    double px = x0 - prep[HXP_ORIG];
+    double py = y0 - prep[HXP_ORIG + 1];
+    double pz = z0 - prep[HXP_ORIG + 2];
+
+    const double *nx = &prep[HXP_NX], *ny = &prep[HXP_NY], *nz = &prep[HXP_NZ];
+    const double *cc = &prep[HXP_C];
+
+    /* six times the sum of the 4 volumes, per tetrahedron */
+    double sumvol[HXP_NTETRA] = { 0.0 };
+    int iv, it;
+    for (iv = 0; iv < 4; iv++) {
+        int ip0 = iv * HXP_NTETRA;
+#pragma omp simd
+        for (it = 0; it < HXP_NTETRA; it++) {
+            int ip = ip0 + it;
+            sumvol[it] += fabs(cc[ip] - (nx[ip] * px + ny[ip] * py + nz[ip] * pz));
+        }
+    }
+
+    /* each arrangement of 5 tetrahedrons gives 50 if inside any of them */
+    const double *vol = &prep[HXP_VOL];
+    int inside[2] = { 0, 0 };
+    for (it = 0; it < HXP_NTETRA; it++) {
+        if (sumvol[it] - vol[it] <= 0.001 * vol[it])
+            inside[it / 5] = 1;
+    }
+    return 50 * (inside[0] + inside[1]);
+}
+
+/*
+ ***************************************************************************************
+ *
+ * NAME:
+ *    x_corners_aabb_centroid
+ *
+ *
+ * DESCRIPTION:
+ *    Bounding box (AABB) and centroid of a hexahedron (cell). The centroid is the
+ *    mean of the 8 corners, computed as in grd3d_midpoint().
+ *
+ * ARGUMENTS:
+ *   corners       i     a [24] array with X Y Z of 8 vertices, x1, y1, z1, x2, y2, ...
+ *   aabb          o     a [6] array; xmin, xmax, ymin, ymax, zmin, zmax
+ *   centroid      o     a [3] array; x, y, z
+ *
+ * LICENCE:
+ *    cf. XTGeo LICENSE
+ ***************************************************************************************
+ */
+
+void
+x_corners_aabb_centroid(double *corners, double *aabb, double *centroid)
+{
+    double *c = corners;
+
+    aabb[0] = aabb[2] = aabb[4] = VERYLARGEPOSITIVE;
+    aabb[1] = aabb[3] = aabb[5] = VERYLARGENEGATIVE;
+
+    int i, n;
+    for (i = 0; i < 8; i++) {
+        for (n = 0; n < 3; n++) {
+            double val = c[3 * i + n];
+            if (val < aabb[2 * n])
+                aabb[2 * n] = val;
+            if (val > aabb[2 * n + 1])
+                aabb[2 * n + 1] = val;
+        }
+    }
+
+    centroid[0] = 0.125 * (c[0] + c[3] + c[6] + c[9] + c[12] + c[15] + c[18] + c[21]);
+    centroid[1] = 0.125 * (c[1] + c[4] + c[7] + c[10] + c[13] + c[16] + c[19] + c[22]);
+    centroid[2] = 0.125 * (c[2] + c[5] + c[8] + c[11] + c[14] + c[17] + c[20] + c[23]);
+}
@@ -36,199 +36,138 @@
 #include "libxtg.h"
 #include "libxtg_.h"
 
-#define CBIG 1E32
+/*
+ * Each side face of a cell can be regarded as 2 plane triangles. However the way
+ * one divides it matters. The idea here is to compute the normal vector to
+ * each plane in such a way that it is pointing outwards. Hence, only of a point
+ * in on the negative side of all trangles, it is inside (Hence inside is given
+ * value 1). Since triangle division matters and this is non-unique we try all
+ * and that is why there are 4 normal vectors per side.
+ *
+ * Corners counts from 1 to 8; sides are top, base, front, back, left, right
+ */
+#define HEXPLANES_N 24
 
-static int
-_check_envelope(double x, double y, double z, double *coor)
-{
+static const int HEXPLANES[HEXPLANES_N][3] = {
+    { 1, 3, 2 }, { 4, 2, 3 }, { 2, 4, 1 }, { 3, 1, 4 }, { 5, 7, 6 }, { 8, 6, 7 },
+    { 6, 8, 5 }, { 7, 5, 8 }, { 1, 5, 2 }, { 6, 2, 5 }, { 5, 6, 1 }, { 2, 1, 6 },
+    { 3, 4, 7 }, { 8, 7, 4 }, { 4, 8, 3 }, { 7, 3, 8 }, { 1, 3, 5 }, { 7, 5, 3 },
+    { 5, 1, 7 }, { 3, 7, 1 }, { 6, 8, 2 }, { 4, 2, 8 }, { 2, 6, 4 }, { 8, 4, 6 }
+};
 
-    /*
-     * Check first if point is outside envelope which is a cube based on most extreme
-     * values
-     */
-
-    double vminx = CBIG;
-    double vmaxx = -CBIG;
-    double vminy = CBIG;
-    double vmaxy = -CBIG;
-    double vminz = CBIG;
-    double vmaxz = -CBIG;
+static void
+_envelope(double *coor, double *env)
+{
+    /* envelope, a cube based on most extreme values */
+    double vminx = VERYLARGEPOSITIVE;
+    double vmaxx = VERYLARGENEGATIVE;
+    double vminy = VERYLARGEPOSITIVE;
+    double vmaxy = VERYLARGENEGATIVE;
+    double vminz = VERYLARGEPOSITIVE;
+    double vmaxz = VERYLARGENEGATIVE;
 
     int i;
-    for (i = 1; i <= 8; i++) {
-        if (vminx > coor[3 * i - 3])
-            vminx = coor[3 * i - 3];
-        if (vmaxx < coor[3 * i - 3])
-            vmaxx = coor[3 * i - 3];
-        if (vminy > coor[3 * i - 2])
-            vminy = coor[3 * i - 2];
-        if (vmaxy < coor[3 * i - 2])
-            vmaxy = coor[3 * i - 2];
-        if (vminz > coor[3 * i - 1])
-            vminz = coor[3 * i - 1];
-        if (vmaxz < coor[3 * i - 1])
-            vmaxz = coor[3 * i - 1];
+    for (i = 0; i < 8; i++) {
+        double xv = coor[3 * i];
+        double yv = coor[3 * i + 1];
+        double zv = coor[3 * i + 2];
+        vminx = xv < vminx ? xv : vminx;
+        vmaxx = xv > vmaxx ? xv : vmaxx;
+        vminy = yv < vminy ? yv : vminy;
+        vmaxy = yv > vmaxy ? yv : vmaxy;
+        vminz = zv < vminz ? zv : vminz;
+        vmaxz = zv > vmaxz ? zv : vmaxz;
     }
-
-    if (x < vminx)
-        return -1;
-    if (x > vmaxx)
-        return -1;
-    if (y < vminy)
-        return -1;
-    if (y > vmaxy)
-        return -1;
-    if (z < vminz)
-        return -1;
-    if (z > vmaxz)
-        return -1;
-
-    return 0;
+    env[0] = vminx;
+    env[1] = vmaxx;
+    env[2] = vminy;
+    env[3] = vmaxy;
+    env[4] = vminz;
+    env[5] = vmaxz;
 }
 
 static int
-_inside_plane(int ic0,
-              int ic1,
-              int ic2,
-              double x,
-              double y,
-              double z,
-              double *coor,
-              int flip)
+_outside_envelope(double x, double y, double z, double *env)
 {
+    return (x < env[0] || x > env[1] || y < env[2] || y > env[3] || z < env[4] ||
+            z > env[5]);
+}
 
+static void
+_plane(double *coor, int flip, int iplane, double *abcdw)
+{
     /*
      * A plane consists of 3 corners, and the normal vector result is positive
      * upwards when a normal right handed system. So be careful when thinking base;
      * then turn head upside down!
-     * If flip, we have a left handed system instead. Corners counts from 1 to 8
+     * If flip, we have a left handed system instead.
+     *
+     * The normal vector is computed as in x_plane_normalvector(), inlined here
      */
-
-    double nvec[4], pt[9];
-    int ic;
-
-    ic = ic0; /*  cell corners, 1..8 */
-    pt[0] = coor[3 * ic - 3];
-    pt[1] = coor[3 * ic - 2];
-    pt[2] = coor[3 * ic - 1];
-
-    ic = ic1;
-    pt[3] = coor[3 * ic - 3];
-    pt[4] = coor[3 * ic - 2];
-    pt[5] = coor[3 * ic - 1];
-
-    ic = ic2;
-    pt[6] = coor[3 * ic - 3];
-    pt[7] = coor[3 * ic - 2];
-    pt[8] = coor[3 * ic - 1];
-
-    int ier = x_plane_normalvector(pt, nvec, 0);
-
-    if (ier != 0) {
-        /*  could not make normal vector... */
-        return 0;
+    double *p1 = &coor[3 * HEXPLANES[iplane][0] - 3];
+    double *p2 = &coor[3 * HEXPLANES[iplane][1] - 3];
+    double *p3 = &coor[3 * HEXPLANES[iplane][2] - 3];
+
+    double x1 = p1[0], y1 = p1[1], z1 = p1[2];
+    double x2 = p2[0], y2 = p2[1], z2 = p2[2];
+    double x3 = p3[0], y3 = p3[1], z3 = p3[2];
+
+    double a = y1 * (z2 - z3) + y2 * (z3 - z1) + y3 * (z1 - z2);
+    double b = z1 * (x2 - x3) + z2 * (x3 - x1) + z3 * (x1 - x2);
+    double c = x1 * (y2 - y3) + x2 * (y3 - y1) + x3 * (y1 - y2);
+    double d = -1 * (x1 * (y2 * z3 - y3 * z2) + x2 * (y3 * z1 - y1 * z3) +
+                     x3 * (y1 * z2 - y2 * z1));
+
+    if ((x1 == x2 && y1 == y2 && z1 == z2) || (x1 == x3 && y1 == y3 && z1 == z3) ||
+        (x3 == x2 && y3 == y2 && z3 == z2) || (a == 0.0 && b == 0.0 && c == 0.0)) {
+        /*  could not make normal vector; plane will not count */
+        abcdw[0] = abcdw[1] = abcdw[2] = abcdw[3] = abcdw[4] = 0.0;
+        return;
     }
 
-    double prod = (nvec[0] * x + nvec[1] * y + nvec[2] * z + nvec[3]) * flip;
-
-    if (prod <= 0.0)
-        return 1; /*  1 for "INSIDE" */
-    if (prod > 0.0)
-        return -1; /* for OUTSIDE */
+    abcdw[0] = a * flip;
+    abcdw[1] = b * flip;
+    abcdw[2] = c * flip;
+    abcdw[3] = d * flip;
+    abcdw[4] = 1.0;
+}
 
-    return 0;
+static double
+_inside_plane(double x, double y, double z, double *abcdw)
+{
+    /* 1 for "INSIDE" (on negative side), -1 for OUTSIDE, 0 if no plane */
+    double prod = abcdw[0] * x + abcdw[1] * y + abcdw[2] * z + abcdw[3];
+    return abcdw[4] * (prod <= 0.0 ? 1.0 : -1.0);
 }
 
 int
 x_chk_point_in_hexahedron(double x, double y, double z, double *coor, int flip)
 {
-
-    if (_check_envelope(x, y, z, coor) == -1)
-        return -1;
-
     /*
-     * Each side face of a cell can be regarded as 2 plane triangles. However the way
-     * one divides it matters. The idea here is to compute the normal vector to
-     * each plane in such a way that it is pointing outwards. Hence, only of a point
-     * in on the negative side of all trangles, it is inside (Hence inside is given
-     * value 1). Since triangle division matters and this is non-unique we try all
-     * and that is why there are 4 normal vectors per side
+     * Single test; planes are computed side by side here, as most points can be
+     * rejected after one or two sides
      */
-    int score = 0, i, ist[24];
-
-    for (i = 0; i < 24; i++)
-        ist[i] = -2;
-
-    /* top and base */
-    ist[0] = _inside_plane(1, 3, 2, x, y, z, coor, flip);
-    ist[1] = _inside_plane(4, 2, 3, x, y, z, coor, flip);
-    ist[2] = _inside_plane(2, 4, 1, x, y, z, coor, flip);
-    ist[3] = _inside_plane(3, 1, 4, x, y, z, coor, flip);
-    score = 0;
-    for (i = 0; i < 4; i++)
-        score += ist[i];
-    /* for (i = 0; i < 4; i++) printf("IST index %d is %d\n",i , ist[i]); */
-    if (score < 0)
-        return -1;
-
-    ist[4] = _inside_plane(5, 7, 6, x, y, z, coor, flip);
-    ist[5] = _inside_plane(8, 6, 7, x, y, z, coor, flip);
-    ist[6] = _inside_plane(6, 8, 5, x, y, z, coor, flip);
-    ist[7] = _inside_plane(7, 5, 8, x, y, z, coor, flip);
-    score = 0;
-    for (i = 4; i < 8; i++)
-        score += ist[i];
-    /* for (i = 4; i < 8; i++) printf("IST index %d is %d\n",i , ist[i]); */
-    if (score < 0)
-        return -1;
-
-    /* front  and back */
-    ist[8] = _inside_plane(1, 5, 2, x, y, z, coor, flip);
-    ist[9] = _inside_plane(6, 2, 5, x, y, z, coor, flip);
-    ist[10] = _inside_plane(5, 6, 1, x, y, z, coor, flip);
-    ist[11] = _inside_plane(2, 1, 6, x, y, z, coor, flip);
-    score = 0;
-    for (i = 8; i < 12; i++)
-        score += ist[i];
-    if (score < 0)
-        return -1;
+    double env[6];
 
-    ist[12] = _inside_plane(3, 4, 7, x, y, z, coor, flip);
-    ist[13] = _inside_plane(8, 7, 4, x, y, z, coor, flip);
-    ist[14] = _inside_plane(4, 8, 3, x, y, z, coor, flip);
-    ist[15] = _inside_plane(7, 3, 8, x, y, z, coor, flip);
-    score = 0;
-    for (i = 12; i < 16; i++)
-        score += ist[i];
-    if (score < 0)
+    _envelope(coor, env);
+    if (_outside_envelope(x, y, z, env))
         return -1;
 
-    /* left and right*/
-    ist[16] = _inside_plane(1, 3, 5, x, y, z, coor, flip);
-    ist[17] = _inside_plane(7, 5, 3, x, y, z, coor, flip);
-    ist[18] = _inside_plane(5, 1, 7, x, y, z, coor, flip);
-    ist[19] = _inside_plane(3, 7, 1, x, y, z, coor, flip);
-    score = 0;
-    for (i = 16; i < 20; i++)
-        score += ist[i];
-    if (score < 0)
-        return -1;
-
-    ist[20] = _inside_plane(6, 8, 2, x, y, z, coor, flip);
-    ist[21] = _inside_plane(4, 2, 8, x, y, z, coor, flip);
-    ist[22] = _inside_plane(2, 6, 4, x, y, z, coor, flip);
-    ist[23] = _inside_plane(8, 4, 6, x, y, z, coor, flip);
-    score = 0;
-    for (i = 20; i < 24; i++)
-        score += ist[i];
-    if (score < 0)
-        return -1;
-
-    /* cumulattive score */
-    score = 0;
-    for (i = 0; i < 24; i++) {
-        score += ist[i];
-        /* printf("SCORE %d  -->  %d\n", i, ist[i]); */
+    int score = 0;
+    int side;
+    for (side = 0; side < 6; side++) {
+        int sscore = 0;
+        int i;
+        for (i = 4 * side; i < 4 * side + 4; i++) {
+            double abcdw[5];
+            _plane(coor, flip, i, abcdw);
+            sscore += (int)_inside_plane(x, y, z, abcdw);
+        }
+        if (sscore < 0)
+            return -1;
+        score += sscore;
     }
+
+    /* cumulative score */
     return score;
 }
@@ -0,0 +1,320 @@
+/*
+ ***************************************************************************************
+ *
+ * NAME:
+ *    x_grdecl_reader.c (file name)
+ *    x_grdecl_open
+ *    x_grdecl_close
+ *    x_grdecl_token
+ *    x_grdecl_find_keyword
+ *    x_grdecl_read_doubles
+ *    x_strtod_fast
+ *
+ * DESCRIPTION:
+ *    Streaming tokenizer for Eclipse ASCII input (GRDECL) files. The file is read
+ *    in large chunks into a fixed size buffer, so memory use is bounded regardless
+ *    of file size, and no preprocessing (e.g. removing comments) is needed.
+ *
+ *    Tokens are separated by whitespace. In addition:
+ *    * '--' starts a comment which lasts to end of line
+ *    * '/' terminates a keyword record and is returned as a separate token
+ *    * Quoted strings ('...') are returned as one token, including quotes
+ *
+ *    Values are read with repeat counts expanded, i.e. 3*0.25 is three values of
+ *    0.25; a repeat count without value (3*) gives the default value. The repeat
+ *    state is kept in the reader, so values can be read in portions.
+ *
+ *    x_strtod_fast() parses decimal numbers exactly (correctly rounded) in the
+ *    common case of at most 19 significant digits and a small exponent, and
+ *    falls back to strtod() otherwise. Fortran exponent letters D and d are
+ *    accepted.
+ *
+ * ARGUMENTS:
+ *    rd             i/o    Reader instance
+ *    fc              i     Filehandle (stream) to read from, opened by caller
+ *    token           o     Token string (truncated to maxlen - 1 characters)
+ *    keyword         i     Keyword to search for
+ *    values          o     Array to fill
+ *    nvalues         i     Number of values to read
+ *    defval          i     Value to use for defaulted values (N*)
+ *
+ * RETURNS:
+ *    x_grdecl_token: length of token, 0 at end of file
+ *    x_grdecl_find_keyword: 1 if found, 0 if not
+ *    x_grdecl_read_doubles: Number of values read, which is less than nvalues if
+ *    the record terminates (/) or the file ends, or -1 if a value is invalid
+ *
+ * TODO/ISSUES/BUGS:
+ *
+ * LICENCE:
+ *    cf. XTGeo LICENSE
+ ***************************************************************************************
+ */
+
+#include "libxtg.h"
+#include "libxtg_.h"
+#include "logger.h"
+#include <ctype.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define GRDECL_BUFSIZE 1048576
+#define GRDECL_MAXTOKEN 256
+
+static const double pow10tab[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                   1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                   1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+/* next character, refilling the buffer as needed; EOF at end of file */
+static int
+_getc(struct grdecl_reader *rd)
+{
+    if (rd->pos >= rd->nbuf) {
+        if (rd->eof)
+            return EOF;
+        rd->nbuf = fread(rd->buf, 1, GRDECL_BUFSIZE, rd->fc);
+        rd->pos = 0;
+        if (rd->nbuf == 0) {
+            rd->eof = 1;
+            return EOF;
+        }
+    }
+    return (unsigned char)rd->buf[rd->pos++];
+}
+
+static int
+_peekc(struct grdecl_reader *rd)
+{
+    int ch = _getc(rd);
+    if (ch != EOF)
+        rd->pos--;
+    return ch;
+}
+
+int
+x_grdecl_open(struct grdecl_reader *rd, FILE *fc)
+{
+    rd->fc = fc;
+    rd->buf = malloc(GRDECL_BUFSIZE);
+    rd->nbuf = 0;
+    rd->pos = 0;
+    rd->eof = 0;
+    rd->nrepeat = 0;
+    rd->repvalue = 0.0;
+
+    if (rd->buf == NULL) {
+        logger_error(LI, FI, FU, "Cannot allocate read buffer");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+void
+x_grdecl_close(struct grdecl_reader *rd)
+{
+    free(rd->buf);
+    rd->buf = NULL;
+}
+
+int
+x_grdecl_token(struct grdecl_reader *rd, char *token, int maxlen)
+{
+    int ch, len = 0;
+
+    /* skip whitespace and comments */
+    while (1) {
+        ch = _getc(rd);
+        if (ch == EOF) {
+            token[0] = '\0';
+            return 0;
+        }
+        if (isspace(ch))
+            continue;
+        if (ch == '-' && _peekc(rd) == '-') {
+            while ((ch = _getc(rd)) != EOF && ch != '\n')
+                ;
+            continue;
+        }
+        break;
+    }
+
+    if (ch == '/') {
+        token[0] = '/';
+        token[1] = '\0';
+        return 1;
+    }
+
+    if (ch == '\'') {
+        do {
+            if (len < maxlen - 1)
+                token[len++] = (char)ch;
+            ch = _getc(rd);
+        } while (ch != EOF && ch != '\'');
+        if (ch == '\'' && len < maxlen - 1)
+            token[len++] = (char)ch;
+        token[len] = '\0';
+        return len;
+    }
+
+    while (ch != EOF && !isspace(ch) && ch != '/') {
+        if (len < maxlen - 1)
+            token[len++] = (char)ch;
+        ch = _getc(rd);
+    }
+    if (ch == '/')
+        rd->pos--; /* the '/' is next token */
+
+    token[len] = '\0';
+    return len;
+}
+
+int
+x_grdecl_find_keyword(struct grdecl_reader *rd, const char *keyword)
+{
+    char token[GRDECL_MAXTOKEN];
+
+    rd->nrepeat = 0;
+    while (x_grdecl_token(rd, token, GRDECL_MAXTOKEN) > 0) {
+        if (strcmp(token, keyword) == 0)
+            return 1;
+    }
+    return 0;
+}
+
+long
+x_grdecl_read_doubles(struct grdecl_reader *rd,
+                      double *values,
+                      long nvalues,
+                      double defval)
+{
+    char token[GRDECL_MAXTOKEN];
+    long nread = 0;
+
+    while (nread < nvalues) {
+        if (rd->nrepeat > 0) {
+            long nuse = rd->nrepeat;
+            if (nuse > nvalues - nread)
+                nuse = nvalues - nread;
+            long i;
+            for (i = 0; i < nuse; i++)
+                values[nread++] = rd->repvalue;
+            rd->nrepeat -= nuse;
+            continue;
+        }
+
+        if (x_grdecl_token(rd, token, GRDECL_MAXTOKEN) == 0 || token[0] == '/')
+            break;
+
+        char *end;
+        char *star = strchr(token, '*');
+        if (star != NULL) {
+            long nrep = strtol(token, &end, 10);
+            if (end != star || nrep < 1) {
+                logger_error(LI, FI, FU, "Invalid repeat count: %s", token);
+                return -1;
+            }
+            rd->nrepeat = nrep;
+            rd->repvalue = defval;
+            if (star[1] != '\0') {
+                rd->repvalue = x_strtod_fast(star + 1, &end);
+                if (*end != '\0') {
+                    logger_error(LI, FI, FU, "Invalid value: %s", token);
+                    return -1;
+                }
+            }
+            continue;
+        }
+
+        values[nread++] = x_strtod_fast(token, &end);
+        if (*end != '\0') {
+            logger_error(LI, FI, FU, "Invalid value: %s", token);
+            return -1;
+        }
+    }
+    return nread;
+}
+
+double
+x_strtod_fast(const char *str, char **endptr)
+{
+    const char *s = str;
+    int negative = 0, ndigits = 0, exp10 = 0, expsign = 1, expval = 0;
+    uint64_t mantissa = 0;
+
+    if (*s == '-' || *s == '+') {
+        negative = (*s == '-');
+        s++;
+    }
+
+    const char *digits = s;
+    while (*s >= '0' && *s <= '9') {
+        if (ndigits < 19) {
+            mantissa = mantissa * 10 + (uint64_t)(*s - '0');
+            if (mantissa > 0)
+                ndigits++;
+        } else {
+            exp10++;
+        }
+        s++;
+    }
+    if (*s == '.') {
+        s++;
+        while (*s >= '0' && *s <= '9') {
+            if (ndigits < 19) {
+                mantissa = mantissa * 10 + (uint64_t)(*s - '0');
+                if (mantissa > 0)
+                    ndigits++;
+                exp10--;
+            }
+            s++;
+        }
+    }
+    if (s == digits || (s == digits + 1 && *digits == '.'))
+        return strtod(str, endptr); /* not a plain number, e.g. nan or inf */
+
+    if (*s == 'e' || *s == 'E' || *s == 'd' || *s == 'D') {
+        const char *e = s + 1;
+        if (*e == '-' || *e == '+') {
+            expsign = (*e == '-') ? -1 : 1;
+            e++;
+        }
+        if (*e >= '0' && *e <= '9') {
+            while (*e >= '0' && *e <= '9') {
+                if (expval < 10000)
+                    expval = expval * 10 + (*e - '0');
+                e++;
+            }
+            s = e;
+        }
+    }
+    exp10 += expsign * expval;
+
+    /* digits beyond 19 or exponent beyond the exact powers of ten: use strtod() */
+    if (ndigits >= 19 || mantissa > (1ULL << 53) || exp10 < -22 || exp10 > 22) {
+        char tmp[GRDECL_MAXTOKEN];
+        size_t len = (size_t)(s - str);
+        if (len >= GRDECL_MAXTOKEN)
+            len = GRDECL_MAXTOKEN - 1;
+        memcpy(tmp, str, len);
+        tmp[len] = '\0';
+        char *p;
+        for (p = tmp; *p; p++) {
+            if (*p == 'd' || *p == 'D')
+                *p = 'e';
+        }
+        double value = strtod(tmp, NULL);
+        *endptr = (char *)s;
+        return value;
+    }
+
+    double value = (double)mantissa;
+    if (exp10 < 0)
+        value /= pow10tab[-exp10];
+    else
+        value *= pow10tab[exp10];
+
+    *endptr = (char *)s;
+    return negative ? -value : value;
+}
@@ -0,0 +1,636 @@
+/*
+ ***************************************************************************************
+ *
+ * NAME:
+ *    x_ibm_ieee.c (file name)
+ *    x_ibm_to_ieee
+ *    x_ieee_to_ibm
+ *    x_ieee_be_to_float
+ *    x_float_to_ieee_be
+ *    x_ibm_to_ieee_array
+ *    x_ieee_to_ibm_array
+ *
+ * DESCRIPTION:
+ *    Conversion of SEGY sample arrays between big endian 32 bit IBM float (SEGY
+ *    format 1) or big endian IEEE float (SEGY format 5), as stored in file, and
+ *    native float. Byte swapping is fused with the conversion, and the min and max
+ *    values are tracked in the same pass when reading.
+ *
+ *    The kernels are branch free and vectorized with SSE2 (baseline on x86-64), or
+ *    AVX2 when the CPU supports it (detected at run time, GCC/Clang only), and
+ *    have a portable scalar fallback for other platforms and the array tails.
+ *
+ *    IBM to IEEE is exact for normal numbers; IBM values above the IEEE range
+ *    become the largest float (with sign), and values below the normal IEEE range
+ *    become zero, as in the traditional (Brian Sumner, CWP) algorithm. IEEE to IBM
+ *    truncates the mantissa (up to 3 bits are lost); zero and denormal floats
+ *    become zero, and inf/nan become the largest IBM number.
+ *
+ *    x_ibm_to_ieee_array and x_ieee_to_ibm_array are SWIG wrappers on numpy arrays,
+ *    where IBM data are int32 arrays holding the raw (big endian) file bytes.
+ *
+ * ARGUMENTS:
+ *    src             i     Input array, n items (4 bytes each), may equal dst
+ *    dst             o     Output array, n items
+ *    n               i     Number of items
+ *    minval, maxval i/o    Updated with min and max value (ignored if NULL)
+ *
+ * RETURNS:
+ *    Void, or EXIT_SUCCESS/EXIT_FAILURE for the SWIG wrappers
+ *
+ * TODO/ISSUES/BUGS:
+ *
+ * LICENCE:
+ *    cf. XTGeo LICENSE
+ ***************************************************************************************
+ */
+
+#include "libxtg.h"
+#include "libxtg_.h"
+#include "logger.h"
+#include <float.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define XTG_IBM_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(XTG_IBM_SSE2) && (defined(__GNUC__) || defined(__clang__)) &&             \
+  (defined(__x86_64__) || defined(__i386__))
+#define XTG_IBM_AVX2 1
+#include <immintrin.h>
+#endif
+
+/*
+ * -------------------------------------------------------------------------------------
+ * Scalar kernels
+ * -------------------------------------------------------------------------------------
+ */
+
+static inline uint32_t
+_load_be32(const unsigned char *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) |
+           (uint32_t)p[3];
+}
+
+static inline void
+_store_be32(unsigned char *p, uint32_t w)
+{
+    p[0] = (unsigned char)(w >> 24);
+    p[1] = (unsigned char)(w >> 16);
+    p[2] = (unsigned char)(w >> 8);
+    p[3] = (unsigned char)w;
+}
+
+/*
+ * The IBM fraction (24 bit) is converted exactly to float, which normalizes it,
+ * and then the float exponent is adjusted with the IBM exponent: value is
+ * frac * 2^-24 * 16^(exp - 64), i.e. an adjustment of 4 * exp - 280
+ */
+static inline uint32_t
+_ibm2ieee(uint32_t w)
+{
+    uint32_t frac = w & 0x00ffffffu;
+    float ffrac = (float)frac;
+    uint32_t fb;
+    memcpy(&fb, &ffrac, 4);
+
+    int32_t adj = (int32_t)((w >> 22) & 0x1fc) - 280;
+    int32_t newexp = (int32_t)(fb >> 23) + adj;
+    uint32_t sign = w & 0x80000000u;
+
+    if (frac == 0 || newexp < 1)
+        return 0;
+    if (newexp > 254)
+        return sign | 0x7f7fffffu;
+    return sign | (fb + ((uint32_t)adj << 23));
+}
+
+/*
+ * IEEE value is m * 2^-24 * 2^x with m the 24 bit mantissa (with the hidden bit)
+ * and x = e - 126. IBM exponent is ceil(x / 4) + 64 = (e + 133) >> 2, and the
+ * mantissa is shifted right s = 4 * ceil(x / 4) - x bits (0..3)
+ */
+static inline uint32_t
+_ieee2ibm(uint32_t b)
+{
+    uint32_t sign = b & 0x80000000u;
+    uint32_t e = (b >> 23) & 0xff;
+    uint32_t m = (b & 0x007fffffu) | 0x00800000u;
+    uint32_t ibmexp = (e + 133) >> 2;
+    uint32_t shift = (ibmexp << 2) - e - 130;
+
+    if (e == 0)
+        return 0;
+    if (e == 255)
+        return sign | 0x7fffffffu;
+    return sign | (ibmexp << 24) | (m >> shift);
+}
+
+static void
+_ibm_to_ieee_scalar(const unsigned char *src,
+                    float *dst,
+                    long n,
+                    float *vmin,
+                    float *vmax)
+{
+    long i;
+    for (i = 0; i < n; i++) {
+        uint32_t w = _ibm2ieee(_load_be32(src + 4 * i));
+        float v;
+        memcpy(&v, &w, 4);
+        dst[i] = v;
+        if (v < *vmin)
+            *vmin = v;
+        if (v > *vmax)
+            *vmax = v;
+    }
+}
+
+static void
+_ieee_be_to_float_scalar(const unsigned char *src,
+                         float *dst,
+                         long n,
+                         float *vmin,
+                         float *vmax)
+{
+    long i;
+    for (i = 0; i < n; i++) {
+        uint32_t w = _load_be32(src + 4 * i);
+        float v;
+        memcpy(&v, &w, 4);
+        dst[i] = v;
+        if (v < *vmin)
+            *vmin = v;
+        if (v > *vmax)
+            *vmax = v;
+    }
+}
+
+static void
+_ieee_to_ibm_scalar(const float *src, unsigned char *dst, long n)
+{
+    long i;
+    for (i = 0; i < n; i++) {
+        uint32_t b;
+        memcpy(&b, src + i, 4);
+        _store_be32(dst + 4 * i, _ieee2ibm(b));
+    }
+}
+
+static void
+_float_to_ieee_be_scalar(const float *src, unsigned char *dst, long n)
+{
+    long i;
+    for (i = 0; i < n; i++) {
+        uint32_t b;
+        memcpy(&b, src + i, 4);
+        _store_be32(dst + 4 * i, b);
+    }
+}
+
+/*
+ * -------------------------------------------------------------------------------------
+ * SSE2 kernels (x86 is little endian, so loads/stores need a byte swap)
+ * -------------------------------------------------------------------------------------
+ */
+
+#ifdef XTG_IBM_SSE2
+
+static inline __m128i
+_bswap32_sse2(__m128i x)
+{
+    x = _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+    x = _mm_shufflelo_epi16(x, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm_shufflehi_epi16(x, _MM_SHUFFLE(2, 3, 0, 1));
+}
+
+static inline __m128i
+_ibm2ieee_sse2(__m128i w)
+{
+    const __m128i fracmask = _mm_set1_epi32(0x00ffffff);
+    const __m128i signmask = _mm_set1_epi32((int)0x80000000u);
+
+    __m128i frac = _mm_and_si128(w, fracmask);
+    __m128i fb = _mm_castps_si128(_mm_cvtepi32_ps(frac));
+    __m128i adj = _mm_and_si128(_mm_srli_epi32(w, 22), _mm_set1_epi32(0x1fc));
+    adj = _mm_sub_epi32(adj, _mm_set1_epi32(280));
+    __m128i newexp = _mm_add_epi32(_mm_srli_epi32(fb, 23), adj);
+    __m128i sign = _mm_and_si128(w, signmask);
+
+    __m128i res = _mm_or_si128(sign, _mm_add_epi32(fb, _mm_slli_epi32(adj, 23)));
+
+    __m128i over = _mm_cmpgt_epi32(newexp, _mm_set1_epi32(254));
+    __m128i largest = _mm_or_si128(sign, _mm_set1_epi32(0x7f7fffff));
+    res = _mm_or_si128(_mm_andnot_si128(over, res), _mm_and_si128(over, largest));
+
+    __m128i zero = _mm_or_si128(_mm_cmplt_epi32(newexp, _mm_set1_epi32(1)),
+                                _mm_cmpeq_epi32(frac, _mm_setzero_si128()));
+    return _mm_andnot_si128(zero, res);
+}
+
+static inline __m128i
+_ieee2ibm_sse2(__m128i b)
+{
+    const __m128i signmask = _mm_set1_epi32((int)0x80000000u);
+
+    __m128i sign = _mm_and_si128(b, signmask);
+    __m128i e = _mm_and_si128(_mm_srli_epi32(b, 23), _mm_set1_epi32(0xff));
+    __m128i m = _mm_or_si128(_mm_and_si128(b, _mm_set1_epi32(0x007fffff)),
+                             _mm_set1_epi32(0x00800000));
+    __m128i ibmexp = _mm_srli_epi32(_mm_add_epi32(e, _mm_set1_epi32(133)), 2);
+    __m128i shift = _mm_sub_epi32(_mm_slli_epi32(ibmexp, 2),
+                                  _mm_add_epi32(e, _mm_set1_epi32(130)));
+
+    /* no variable shift in SSE2; select among the 4 possible shifts */
+    __m128i s1 = _mm_cmpeq_epi32(shift, _mm_set1_epi32(1));
+    __m128i s2 = _mm_cmpeq_epi32(shift, _mm_set1_epi32(2));
+    __m128i s3 = _mm_cmpeq_epi32(shift, _mm_set1_epi32(3));
+    __m128i s0 = _mm_cmpeq_epi32(shift, _mm_setzero_si128());
+    __m128i frac = _mm_or_si128(
+      _mm_or_si128(_mm_and_si128(s0, m), _mm_and_si128(s1, _mm_srli_epi32(m, 1))),
+      _mm_or_si128(_mm_and_si128(s2, _mm_srli_epi32(m, 2)),
+                   _mm_and_si128(s3, _mm_srli_epi32(m, 3))));
+
+    __m128i res = _mm_or_si128(sign, _mm_or_si128(_mm_slli_epi32(ibmexp, 24), frac));
+
+    __m128i inf = _mm_cmpeq_epi32(e, _mm_set1_epi32(255));
+    __m128i largest = _mm_or_si128(sign, _mm_set1_epi32(0x7fffffff));
+    res = _mm_or_si128(_mm_andnot_si128(inf, res), _mm_and_si128(inf, largest));
+
+    __m128i zero = _mm_cmpeq_epi32(e, _mm_setzero_si128());
+    return _mm_andnot_si128(zero, res);
+}
+
+static long
+_ibm_to_ieee_sse2(const unsigned char *src,
+                  float *dst,
+                  long n,
+                  float *vmin,
+                  float *vmax)
+{
+    __m128 mn = _mm_set1_ps(*vmin), mx = _mm_set1_ps(*vmax);
+    long i;
+    for (i = 0; i + 4 <= n; i += 4) {
+        __m128i w = _bswap32_sse2(_mm_loadu_si128((const __m128i *)(src + 4 * i)));
+        __m128 v = _mm_castsi128_ps(_ibm2ieee_sse2(w));
+        _mm_storeu_ps(dst + i, v);
+        mn = _mm_min_ps(mn, v);
+        mx = _mm_max_ps(mx, v);
+    }
+    float tmp[4];
+    int k;
+    _mm_storeu_ps(tmp, mn);
+    for (k = 0; k < 4; k++)
+        *vmin = tmp[k] < *vmin ? tmp[k] : *vmin;
+    _mm_storeu_ps(tmp, mx);
+    for (k = 0; k < 4; k++)
+        *vmax = tmp[k] > *vmax ? tmp[k] : *vmax;
+    return i;
+}
+
+static long
+_ieee_be_to_float_sse2(const unsigned char *src,
+                       float *dst,
+                       long n,
+                       float *vmin,
+                       float *vmax)
+{
+    __m128 mn = _mm_set1_ps(*vmin), mx = _mm_set1_ps(*vmax);
+    long i;
+    for (i = 0; i + 4 <= n; i += 4) {
+        __m128i w = _bswap32_sse2(_mm_loadu_si128((const __m128i *)(src + 4 * i)));
+        __m128 v = _mm_castsi128_ps(w);
+        _mm_storeu_ps(dst + i, v);
+        mn = _mm_min_ps(mn, v);
+        mx = _mm_max_ps(mx, v);
+    }
+    float tmp[4];
+    int k;
+    _mm_storeu_ps(tmp, mn);
+    for (k = 0; k < 4; k++)
+        *vmin = tmp[k] < *vmin ? tmp[k] : *vmin;
+    _mm_storeu_ps(tmp, mx);
+    for (k = 0; k < 4; k++)
+        *vmax = tmp[k] > *vmax ? tmp[k] : *vmax;
+    return i;
+}
+
+static long
+_ieee_to_ibm_sse2(const float *src, unsigned char *dst, long n)
+{
+    long i;
+    for (i = 0; i + 4 <= n; i += 4) {
+        __m128i b = _mm_castps_si128(_mm_loadu_ps(src + i));
+        _mm_storeu_si128((__m128i *)(dst + 4 * i), _bswap32_sse2(_ieee2ibm_sse2(b)));
+    }
+    return i;
+}
+
+static long
+_float_to_ieee_be_sse2(const float *src, unsigned char *dst, long n)
+{
+    long i;
+    for (i = 0; i + 4 <= n; i += 4) {
+        __m128i b = _mm_castps_si128(_mm_loadu_ps(src + i));
+        _mm_storeu_si128((__m128i *)(dst + 4 * i), _bswap32_sse2(b));
+    }
+    return i;
+}
+
+#endif /* XTG_IBM_SSE2 */
+
+/*
+ * -------------------------------------------------------------------------------------
+ * AVX2 kernels, compiled for AVX2 regardless of build flags and used only if the
+ * CPU supports it
+ * -------------------------------------------------------------------------------------
+ */
+
+#ifdef XTG_IBM_AVX2
+
+#define AVX2_TARGET __attribute__((target("avx2")))
+
+AVX2_TARGET static inline __m256i
+_bswap32_avx2(__m256i x)
+{
+    const __m256i order = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14,
+                                           13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8,
+                                           15, 14, 13, 12);
+    return _mm256_shuffle_epi8(x, order);
+}
+
+AVX2_TARGET static inline __m256i
+_ibm2ieee_avx2(__m256i w)
+{
+    __m256i frac = _mm256_and_si256(w, _mm256_set1_epi32(0x00ffffff));
+    __m256i fb = _mm256_castps_si256(_mm256_cvtepi32_ps(frac));
+    __m256i adj = _mm256_sub_epi32(
+      _mm256_and_si256(_mm256_srli_epi32(w, 22), _mm256_set1_epi32(0x1fc)),
+      _mm256_set1_epi32(280));
+    __m256i newexp = _mm256_add_epi32(_mm256_srli_epi32(fb, 23), adj);
+    __m256i sign = _mm256_and_si256(w, _mm256_set1_epi32((int)0x80000000u));
+
+    __m256i res = _mm256_add_epi32(fb, _mm256_slli_epi32(adj, 23));
+    res = _mm256_or_si256(sign, res);
+
+    __m256i over = _mm256_cmpgt_epi32(newexp, _mm256_set1_epi32(254));
+    res = _mm256_blendv_epi8(res, _mm256_or_si256(sign, _mm256_set1_epi32(0x7f7fffff)),
+                             over);
+
+    __m256i zero = _mm256_or_si256(_mm256_cmpgt_epi32(_mm256_set1_epi32(1), newexp),
+                                   _mm256_cmpeq_epi32(frac, _mm256_setzero_si256()));
+    return _mm256_andnot_si256(zero, res);
+}
+
+AVX2_TARGET static inline __m256i
+_ieee2ibm_avx2(__m256i b)
+{
+    __m256i sign = _mm256_and_si256(b, _mm256_set1_epi32((int)0x80000000u));
+    __m256i e = _mm256_and_si256(_mm256_srli_epi32(b, 23), _mm256_set1_epi32(0xff));
+    __m256i m = _mm256_or_si256(_mm256_and_si256(b, _mm256_set1_epi32(0x007fffff)),
+                                _mm256_set1_epi32(0x00800000));
+    __m256i ibmexp = _mm256_srli_epi32(_mm256_add_epi32(e, _mm256_set1_epi32(133)), 2);
+    __m256i shift = _mm256_sub_epi32(_mm256_slli_epi32(ibmexp, 2),
+                                     _mm256_add_epi32(e, _mm256_set1_epi32(130)));
+
+    __m256i res = _mm256_or_si256(_mm256_slli_epi32(ibmexp, 24),
+                                  _mm256_srlv_epi32(m, shift));
+    res = _mm256_or_si256(sign, res);
+
+    __m256i inf = _mm256_cmpeq_epi32(e, _mm256_set1_epi32(255));
+    res = _mm256_blendv_epi8(res, _mm256_or_si256(sign, _mm256_set1_epi32(0x7fffffff)),
+                             inf);
+
+    __m256i zero = _mm256_cmpeq_epi32(e, _mm256_setzero_si256());
+    return _mm256_andnot_si256(zero, res);
+}
+
+AVX2_TARGET static void
+_reduce_minmax_avx2(__m256 mn, __m256 mx, float *vmin, float *vmax)
+{
+    float tmp[8];
+    int k;
+    _mm256_storeu_ps(tmp, mn);
+    for (k = 0; k < 8; k++)
+        *vmin = tmp[k] < *vmin ? tmp[k] : *vmin;
+    _mm256_storeu_ps(tmp, mx);
+    for (k = 0; k < 8; k++)
+        *vmax = tmp[k] > *vmax ? tmp[k] : *vmax;
+}
+
+AVX2_TARGET static long
+_ibm_to_ieee_avx2(const unsigned char *src,
+                  float *dst,
+                  long n,
+                  float *vmin,
+                  float *vmax)
+{
+    __m256 mn = _mm256_set1_ps(*vmin), mx = _mm256_set1_ps(*vmax);
+    long i;
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m256i w = _bswap32_avx2(_mm256_loadu_si256((const __m256i *)(src + 4 * i)));
+        __m256 v = _mm256_castsi256_ps(_ibm2ieee_avx2(w));
+        _mm256_storeu_ps(dst + i, v);
+        mn = _mm256_min_ps(mn, v);
+        mx = _mm256_max_ps(mx, v);
+    }
+    _reduce_minmax_avx2(mn, mx, vmin, vmax);
+    return i;
+}
+
+AVX2_TARGET static long
+_ieee_be_to_float_avx2(const unsigned char *src,
+                       float *dst,
+                       long n,
+                       float *vmin,
+                       float *vmax)
+{
+    __m256 mn = _mm256_set1_ps(*vmin), mx = _mm256_set1_ps(*vmax);
+    long i;
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m256i w = _bswap32_avx2(_mm256_loadu_si256((const __m256i *)(src + 4 * i)));
+        __m256 v = _mm256_castsi256_ps(w);
+        _mm256_storeu_ps(dst + i, v);
+        mn = _mm256_min_ps(mn, v);
+        mx = _mm256_max_ps(mx, v);
+    }
+    _reduce_minmax_avx2(mn, mx, vmin, vmax);
+    return i;
+}
+
+AVX2_TARGET static long
+_ieee_to_ibm_avx2(const float *src, unsigned char *dst, long n)
+{
+    long i;
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m256i b = _mm256_castps_si256(_mm256_loadu_ps(src + i));
+        _mm256_storeu_si256((__m256i *)(dst + 4 * i), _bswap32_avx2(_ieee2ibm_avx2(b)));
+    }
+    return i;
+}
+
+AVX2_TARGET static long
+_float_to_ieee_be_avx2(const float *src, unsigned char *dst, long n)
+{
+    long i;
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m256i b = _mm256_castps_si256(_mm256_loadu_ps(src + i));
+        _mm256_storeu_si256((__m256i *)(dst + 4 * i), _bswap32_avx2(b));
+    }
+    return i;
+}
+
+static int
+_has_avx2(void)
+{
+    static int hasavx2 = -1;
+    if (hasavx2 < 0) {
+        __builtin_cpu_init();
+        hasavx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+    }
+    return hasavx2;
+}
+
+#endif /* XTG_IBM_AVX2 */
+
+/*
+ * -------------------------------------------------------------------------------------
+ * Public functions; dispatch to the best kernel, and do the tail with scalar code
+ * -------------------------------------------------------------------------------------
+ */
+
+void
+x_ibm_to_ieee(const void *src, float *dst, long n, float *minval, float *maxval)
+{
+    const unsigned char *bsrc = src;
+    float vmin = minval ? *minval : 0.0f, vmax = maxval ? *maxval : 0.0f;
+    long i = 0;
+
+    if (n <= 0)
+        return;
+
+#if defined(XTG_IBM_AVX2)
+    if (_has_avx2())
+        i = _ibm_to_ieee_avx2(bsrc, dst, n, &vmin, &vmax);
+    else
+        i = _ibm_to_ieee_sse2(bsrc, dst, n, &vmin, &vmax);
+#elif defined(XTG_IBM_SSE2)
+    i = _ibm_to_ieee_sse2(bsrc, dst, n, &vmin, &vmax);
+#endif
+    _ibm_to_ieee_scalar(bsrc + 4 * i, dst + i, n - i, &vmin, &vmax);
+
+    if (minval)
+        *minval = vmin;
+    if (maxval)
+        *maxval = vmax;
+}
+
+void
+x_ieee_be_to_float(const void *src, float *dst, long n, float *minval, float *maxval)
+{
+    const unsigned char *bsrc = src;
+    float vmin = minval ? *minval : 0.0f, vmax = maxval ? *maxval : 0.0f;
+    long i = 0;
+
+    if (n <= 0)
+        return;
+
+#if defined(XTG_IBM_AVX2)
+    if (_has_avx2())
+        i = _ieee_be_to_float_avx2(bsrc, dst, n, &vmin, &vmax);
+    else
+        i = _ieee_be_to_float_sse2(bsrc, dst, n, &vmin, &vmax);
+#elif defined(XTG_IBM_SSE2)
+    i = _ieee_be_to_float_sse2(bsrc, dst, n, &vmin, &vmax);
+#endif
+    _ieee_be_to_float_scalar(bsrc + 4 * i, dst + i, n - i, &vmin, &vmax);
+
+    if (minval)
+        *minval = vmin;
+    if (maxval)
+        *maxval = vmax;
+}
+
+void
+x_ieee_to_ibm(const float *src, void *dst, long n)
+{
+    unsigned char *bdst = dst;
+    long i = 0;
+
+    if (n <= 0)
+        return;
+
+#if defined(XTG_IBM_AVX2)
+    if (_has_avx2())
+        i = _ieee_to_ibm_avx2(src, bdst, n);
+    else
+        i = _ieee_to_ibm_sse2(src, bdst, n);
+#elif defined(XTG_IBM_SSE2)
+    i = _ieee_to_ibm_sse2(src, bdst, n);
+#endif
+    _ieee_to_ibm_scalar(src + i, bdst + 4 * i, n - i);
+}
+
+void
+x_float_to_ieee_be(const float *src, void *dst, long n)
+{
+    unsigned char *bdst = dst;
+    long i = 0;
+
+    if (n <= 0)
+        return;
+
+#if defined(XTG_IBM_AVX2)
+    if (_has_avx2())
+        i = _float_to_ieee_be_avx2(src, bdst, n);
+    else
+        i = _float_to_ieee_be_sse2(src, bdst, n);
+#elif defined(XTG_IBM_SSE2)
+    i = _float_to_ieee_be_sse2(src, bdst, n);
+#endif
+    _float_to_ieee_be_scalar(src + i, bdst + 4 * i, n - i);
+}
+
+int
+x_ibm_to_ieee_array(int *ibmv,
+                    long nibm,
+                    float *ieeev,
+                    long nieee,
+                    double *minval,
+                    double *maxval)
+{
+    if (nibm != nieee) {
+        logger_error(LI, FI, FU, "Inconsistent array lengths in %s", FU);
+        return EXIT_FAILURE;
+    }
+
+    double xprof_t0 = x_prof_tic();
+
+    float vmin = FLT_MAX, vmax = -FLT_MAX;
+    x_ibm_to_ieee(ibmv, ieeev, nibm, &vmin, &vmax);
+    *minval = vmin;
+    *maxval = vmax;
+
+    x_prof_toc(FU, xprof_t0, nibm);
+    return EXIT_SUCCESS;
+}
+
+int
+x_ieee_to_ibm_array(float *ieeev, long nieee, int *ibmv, long nibm)
+{
+    if (nibm != nieee) {
+        logger_error(LI, FI, FU, "Inconsistent array lengths in %s", FU);
+        return EXIT_FAILURE;
+    }
+
+    double xprof_t0 = x_prof_tic();
+
+    x_ieee_to_ibm(ieeev, ibmv, nieee);
+
+    x_prof_toc(FU, xprof_t0, nieee);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,137 @@
+/*
+ ***************************************************************************************
+ *
+ * NAME:
+ *    x_lattice.c
+ *
+ * DESCRIPTION:
+ *    Geometry of a rotated regular 2D lattice (map or cube in XY) with the affine
+ *    transform precomputed, so that looking up many points only costs a few
+ *    multiply-adds per point instead of trigonometry per point.
+ *
+ *    x_lattice_init:
+ *    Fill the lattice struct, from the same settings as e.g. sucu_ij_from_xy.
+ *
+ *    x_lattice_ij_from_xy:
+ *    As sucu_ij_from_xy; find the I J (1 based) and the relative coordinates (rx,
+ *    ry) of a point. Points that are outside the nodes (with a tolerance of
+ *    FLOATEPS, relative to the lattice length, along the border) give -1.
+ *
+ *    x_lattice_xy_from_ij:
+ *    As surf_xyz_from_ij; find X Y of node I J (1 based, not checked).
+ *
+ * ARGUMENTS:
+ *    lat            i/o   Pointer to lattice struct
+ *    xori, yori     i     Origin
+ *    xinc, yinc     i     Increments
+ *    nx, ny         i     Dimensions
+ *    yflip          i     YFLIP (1 or -1)
+ *    rot_deg        i     Rotation (degrees, from X axis, anti-clock)
+ *    x, y           i/o   Point
+ *    flag           i     0: get node nearest to point, 1: get lower left node
+ *    i, j           i/o   Node (1 based)
+ *    rx, ry         o     Coordinates relative to the origin, in the lattice system
+ *
+ * RETURNS:
+ *    x_lattice_ij_from_xy: 0 if inside, -1 if outside
+ *
+ * TODO/ISSUES/BUGS:
+ *
+ * LICENCE:
+ *    cf. XTGeo LICENSE
+ ***************************************************************************************
+ */
+
+#include "libxtg.h"
+#include "libxtg_.h"
+#include <math.h>
+
+void
+x_lattice_init(struct xtg_lattice *lat,
+               double xori,
+               double xinc,
+               double yori,
+               double yinc,
+               int nx,
+               int ny,
+               int yflip,
+               double rot_deg)
+{
+    double angle = rot_deg * PI / 180.0;
+
+    lat->xori = xori;
+    lat->yori = yori;
+    lat->xinc = xinc;
+    lat->yinc = yinc * yflip;
+    lat->nx = nx;
+    lat->ny = ny;
+    lat->cosa = cos(angle);
+    lat->sina = sin(angle);
+
+    lat->xlen = lat->xinc * (nx - 1);
+    lat->ylen = lat->yinc * (ny - 1);
+
+    /* a lattice with one node in a direction has no extent; all points map to 0 */
+    lat->xlen_inv = lat->xlen != 0.0 ? 1.0 / lat->xlen : 0.0;
+    lat->ylen_inv = lat->ylen != 0.0 ? 1.0 / lat->ylen : 0.0;
+}
+
+/* relative position along an axis, 0..1, with a numerical tolerance at the border */
+static int
+_relpos(double *u)
+{
+    if (*u < (0.0 - FLOATEPS) || *u > (1.0 + FLOATEPS))
+        return -1;
+    if (*u < 0.0)
+        *u = 0.0 + FLOATEPS; /* making edge points being inside */
+    if (*u > 1.0)
+        *u = 1.0 - FLOATEPS;
+    return 0;
+}
+
+int
+x_lattice_ij_from_xy(const struct xtg_lattice *lat,
+                     double x,
+                     double y,
+                     int flag,
+                     int *i,
+                     int *j,
+                     double *rx,
+                     double *ry)
+{
+    double dx = x - lat->xori;
+    double dy = y - lat->yori;
+
+    /* rotate back and scale to relative (0..1) positions along each axis */
+    double u = (dx * lat->cosa + dy * lat->sina) * lat->xlen_inv;
+    double v = (dy * lat->cosa - dx * lat->sina) * lat->ylen_inv;
+
+    if (_relpos(&u) != 0 || _relpos(&v) != 0)
+        return -1;
+
+    double px = u * lat->xlen;
+    double py = v * lat->ylen;
+
+    if (flag == 0) {
+        *i = (int)((px + 0.5 * lat->xinc) / lat->xinc) + 1;
+        *j = (int)((py + 0.5 * lat->yinc) / lat->yinc) + 1;
+    } else {
+        *i = (int)(px / lat->xinc) + 1;
+        *j = (int)(py / lat->yinc) + 1;
+    }
+
+    *rx = px;
+    *ry = py;
+
+    return EXIT_SUCCESS;
+}
+
+void
+x_lattice_xy_from_ij(const struct xtg_lattice *lat, int i, int j, double *x, double *y)
+{
+    double xdist = lat->xinc * (i - 1);
+    double ydist = lat->yinc * (j - 1);
+
+    *x = lat->xori + xdist * lat->cosa - ydist * lat->sina;
+    *y = lat->yori + xdist * lat->sina + ydist * lat->cosa;
+}
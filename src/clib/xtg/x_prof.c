@@ -0,0 +1,166 @@
+/*
+ ***************************************************************************************
+ *
+ * NAME:
+ *    x_prof.c (file name)
+ *    x_prof_enable
+ *    x_prof_reset
+ *    x_prof_report
+ *    x_prof_tic
+ *    x_prof_toc
+ *
+ * DESCRIPTION:
+ *    Lightweight in-process profiling of C routines. A routine is instrumented as:
+ *
+ *        double t0 = x_prof_tic();
+ *        ...
+ *        x_prof_toc(FU, t0, nitems);
+ *
+ *    which aggregates number of calls, wall time (seconds) and a count of items
+ *    (e.g. values read or points processed) per name. Profiling is off by default,
+ *    and then x_prof_toc just returns.
+ *
+ *    Timing is wall time from a monotonic clock (clock_gettime with CLOCK_MONOTONIC,
+ *    or QueryPerformanceCounter on Windows); note that monotonic_seconds() in
+ *    logger.c is CPU time on Linux. Updates are thread safe (OpenMP
+ *    critical section). The number of names is limited to XPROF_MAXENTRIES;
+ *    further names are ignored.
+ *
+ *    x_prof_enable:  Turn profiling on (1) or off (0)
+ *    x_prof_reset:   Clear all collected data
+ *    x_prof_report:  Return collected data as text, one line per name on form
+ *                    name;ncalls;seconds;nitems
+ *
+ * ARGUMENTS:
+ *    flag            i     1 for on, 0 for off
+ *    report          o     Text report (swig bounded char)
+ *    name            i     Name of timer/counter, usually the routine name (FU)
+ *    t0              i     Start time from x_prof_tic
+ *    nitems          i     Number of items to add to counter
+ *
+ * RETURNS:
+ *    x_prof_report: Number of entries; x_prof_tic: start time
+ *
+ * TODO/ISSUES/BUGS:
+ *
+ * LICENCE:
+ *    cf. XTGeo LICENSE
+ ***************************************************************************************
+ */
+
+#include "libxtg.h"
+#include "libxtg_.h"
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#define XPROF_MAXENTRIES 256
+#define XPROF_MAXNAME 64
+#define XPROF_MAXREPORT 1000000
+
+int XTG_PROFILING = 0;
+
+static struct
+{
+    char name[XPROF_MAXNAME];
+    long ncalls;
+    double seconds;
+    long nitems;
+} _entries[XPROF_MAXENTRIES];
+
+static int _nentries = 0;
+
+static double
+_wall_seconds(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (double)count.QuadPart / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1.0e-9;
+#endif
+}
+
+void
+x_prof_enable(int flag)
+{
+    XTG_PROFILING = flag ? 1 : 0;
+}
+
+void
+x_prof_reset(void)
+{
+#pragma omp critical(xtg_profiling)
+    _nentries = 0;
+}
+
+int
+x_prof_report(char *report)
+{
+    int i, nentries;
+    size_t pos = 0;
+
+    report[0] = '\0';
+
+#pragma omp critical(xtg_profiling)
+    {
+        nentries = _nentries;
+        for (i = 0; i < _nentries; i++) {
+            int n = snprintf(report + pos, XPROF_MAXREPORT - pos, "%s;%ld;%.9f;%ld\n",
+                             _entries[i].name, _entries[i].ncalls,
+                             _entries[i].seconds, _entries[i].nitems);
+            if (n < 0 || pos + n >= XPROF_MAXREPORT) {
+                nentries = i;
+                break;
+            }
+            pos += n;
+        }
+    }
+    report[pos] = '\0';
+    return nentries;
+}
+
+double
+x_prof_tic(void)
+{
+    return _wall_seconds();
+}
+
+void
+x_prof_toc(const char *name, double t0, long nitems)
+{
+    if (!XTG_PROFILING)
+        return;
+
+    double dt = _wall_seconds() - t0;
+
+#pragma omp critical(xtg_profiling)
+    {
+        int i;
+        for (i = 0; i < _nentries; i++) {
+            if (strcmp(_entries[i].name, name) == 0)
+                break;
+        }
+        if (i == _nentries && _nentries < XPROF_MAXENTRIES) {
+            strncpy(_entries[i].name, name, XPROF_MAXNAME - 1);
+            _entries[i].name[XPROF_MAXNAME - 1] = '\0';
+            _entries[i].ncalls = 0;
+            _entries[i].seconds = 0.0;
+            _entries[i].nitems = 0;
+            _nentries++;
+        }
+        if (i < _nentries) {
+            _entries[i].ncalls++;
+            _entries[i].seconds += dt;
+            _entries[i].nitems += nitems;
+        }
+    }
+}
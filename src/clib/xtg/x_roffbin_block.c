@@ -0,0 +1,189 @@
+/*
+ ***************************************************************************************
+ *
+ * NAME:
+ *    x_roffbin_block.c (file name)
+ *    x_swap_block
+ *    x_roffbin_read_block
+ *    x_roffbin_read_prop
+ *
+ * DESCRIPTION:
+ *    Block reading of binary (ROFF) arrays. Instead of one fread() (and one
+ *    SwapEndian() call) per element, the data are read in large blocks with one
+ *    fread() per block, and then byte swapped, converted and reordered in tight
+ *    loops over the memory buffer.
+ *
+ *    x_swap_block:         Swap byte order of all items in a buffer (in place)
+ *    x_roffbin_read_block: Read nitems of size bytes from a file position into a
+ *                          buffer, with byte swapping if requested
+ *    x_roffbin_read_prop:  Read a ROFF 3D parameter array, which is stored with
+ *                          i, j, k (C order) but with k starting at base, into
+ *                          xtgformat=2 layout, i.e. C order with k from top.
+ *                          Undefined values (-999 for int/float, 255 for byte)
+ *                          are set to UNDEF_INT/UNDEF
+ *
+ * ARGUMENTS:
+ *    fc              i     Filehandle (stream) to read from
+ *    bytepos         i     The byte position to start at; -1 for current position
+ *    swap            i     SWAP status, 0 of False, 1 if True
+ *    dtype           i     ROFF data type; 1=int, 2=float, 3=double, 4=char,
+ *                          5=bool, 6=byte (char/bool/byte are 1 byte unsigned)
+ *    ncol,nrow,nlay  i     Dimensions
+ *    fvec           i/o    Float array to update (float data), or NULL
+ *    ivec           i/o    Int array to update (int and byte data), or NULL
+ *
+ * RETURNS:
+ *    EXIT_SUCCESS, or EXIT_FAILURE if the data cannot be read
+ *
+ * TODO/ISSUES/BUGS:
+ *
+ * LICENCE:
+ *    cf. XTGeo LICENSE
+ ***************************************************************************************
+ */
+
+#include "libxtg.h"
+#include "libxtg_.h"
+#include "logger.h"
+#include <stdint.h>
+#include <string.h>
+
+/* max number of items in the buffer when reading and reordering ROFF parameters */
+#define ROFFBLOCK_MAXITEMS 4194304
+
+void
+x_swap_block(void *buf, size_t size, size_t nitems)
+{
+    size_t i;
+    if (size == 2) {
+        uint16_t *v = buf;
+        for (i = 0; i < nitems; i++) {
+            v[i] = (uint16_t)((v[i] >> 8) | (v[i] << 8));
+        }
+    } else if (size == 4) {
+        uint32_t *v = buf;
+        for (i = 0; i < nitems; i++) {
+            uint32_t x = v[i];
+            v[i] = (x >> 24) | ((x >> 8) & 0x0000ff00u) | ((x << 8) & 0x00ff0000u) |
+                   (x << 24);
+        }
+    } else if (size == 8) {
+        uint64_t *v = buf;
+        for (i = 0; i < nitems; i++) {
+            const uint64_t m8 = 0x00ff00ff00ff00ffull;
+            const uint64_t m16 = 0x0000ffff0000ffffull;
+            uint64_t x = v[i];
+            x = ((x >> 8) & m8) | ((x & m8) << 8);
+            x = ((x >> 16) & m16) | ((x & m16) << 16);
+            v[i] = (x >> 32) | (x << 32);
+        }
+    }
+}
+
+int
+x_roffbin_read_block(FILE *fc, long bytepos, int swap, size_t size, size_t nitems,
+                     void *buf)
+{
+    if (bytepos >= 0 && fseek(fc, bytepos, SEEK_SET) != 0) {
+        logger_error(LI, FI, FU, "Cannot seek to position %ld", bytepos);
+        return EXIT_FAILURE;
+    }
+
+    size_t nread = fread(buf, size, nitems, fc);
+    if (nread != nitems) {
+        logger_error(LI, FI, FU, "Problem in fread: got %zu of %zu items", nread,
+                     nitems);
+        return EXIT_FAILURE;
+    }
+
+    if (swap == 1 && size > 1)
+        x_swap_block(buf, size, nitems);
+
+    return EXIT_SUCCESS;
+}
+
+int
+x_roffbin_read_prop(FILE *fc,
+                    long bytepos,
+                    int swap,
+                    int dtype,
+                    long ncol,
+                    long nrow,
+                    long nlay,
+                    float *fvec,
+                    int *ivec)
+{
+    double xprof_t0 = x_prof_tic();
+
+    size_t size = 4;
+    if (dtype == 3)
+        size = 8;
+    if (dtype >= 4)
+        size = 1;
+
+    if ((dtype == 2 || dtype == 3) ? fvec == NULL : ivec == NULL) {
+        logger_error(LI, FI, FU, "No array given for data type %d", dtype);
+        return EXIT_FAILURE;
+    }
+
+    if (fseek(fc, bytepos, SEEK_SET) != 0) {
+        logger_error(LI, FI, FU, "Cannot seek to position %ld", bytepos);
+        return EXIT_FAILURE;
+    }
+
+    /* read a number of whole columns (all layers) per block */
+    long ncolumns = ncol * nrow;
+    long nblockcols = ROFFBLOCK_MAXITEMS / (nlay > 0 ? nlay : 1);
+    if (nblockcols < 1)
+        nblockcols = 1;
+    if (nblockcols > ncolumns)
+        nblockcols = ncolumns;
+
+    unsigned char *buf = malloc(nblockcols * nlay * size);
+    if (buf == NULL) {
+        logger_error(LI, FI, FU, "Cannot allocate buffer in %s", FU);
+        return EXIT_FAILURE;
+    }
+
+    long col0;
+    for (col0 = 0; col0 < ncolumns; col0 += nblockcols) {
+        long ncols = ncolumns - col0 < nblockcols ? ncolumns - col0 : nblockcols;
+        if (x_roffbin_read_block(fc, -1, swap, size, ncols * nlay, buf) !=
+            EXIT_SUCCESS) {
+            free(buf);
+            return EXIT_FAILURE;
+        }
+
+        long c;
+        for (c = 0; c < ncols; c++) {
+            long kin = c * nlay;
+            long kout = (col0 + c) * nlay + nlay - 1;
+            long k;
+            if (dtype == 1) {
+                int32_t *v = (int32_t *)buf + kin;
+                for (k = 0; k < nlay; k++) {
+                    ivec[kout - k] = (v[k] == -999) ? UNDEF_INT : v[k];
+                }
+            } else if (dtype == 2) {
+                float *v = (float *)buf + kin;
+                for (k = 0; k < nlay; k++) {
+                    fvec[kout - k] = (v[k] == -999.0) ? UNDEF : v[k];
+                }
+            } else if (dtype == 3) {
+                double *v = (double *)buf + kin;
+                for (k = 0; k < nlay; k++) {
+                    fvec[kout - k] = (v[k] == -999.0) ? UNDEF : (float)v[k];
+                }
+            } else {
+                unsigned char *v = buf + kin;
+                for (k = 0; k < nlay; k++) {
+                    ivec[kout - k] = (v[k] == 255) ? UNDEF_INT : (int)v[k];
+                }
+            }
+        }
+    }
+
+    free(buf);
+    x_prof_toc(FU, xprof_t0, ncol * nrow * nlay);
+    return EXIT_SUCCESS;
+}
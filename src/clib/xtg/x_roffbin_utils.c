@@ -167,23 +167,15 @@ x_roffgetintvalue(char *name, FILE *fc)
 
 /*
  ***************************************************************************************
- * Reading a  float array
+ * Reading a  float array (one block read, cf. x_roffbin_block.c)
+ * Returns EXIT_SUCCESS, or EXIT_FAILURE if the file is short
  ***************************************************************************************
  */
-void
+int
 x_roffgetfloatarray(float *array, int num, FILE *fc)
 {
-    float afloat;
-    int i;
-
-    for (i = 0; i < num; i++) {
-        x_fread(&afloat, 4, 1, fc);
-        if (x_byteorder(-1) > 1)
-            SWAP_FLOAT(afloat);
-        array[i] = afloat;
-    }
-
-    /* PREVIOUS WAY: fread(array,4,num,fc); */
+    int swap = (x_byteorder(-1) > 1) ? 1 : 0;
+    return x_roffbin_read_block(fc, -1, swap, 4, num, array);
 }
 
 /*
@@ -191,37 +183,26 @@ x_roffgetfloatarray(float *array, int num, FILE *fc)
  * Reading a byte array, e.g:
  * array bool data 48 (this is not read here but by read int...)
  *   1   1   1   1   1 ...
+ * Returns EXIT_SUCCESS, or EXIT_FAILURE if the file is short
  ***************************************************************************************
  */
-void
+int
 x_roffgetbytearray(unsigned char *array, int num, FILE *fc)
 {
-    int i;
-    unsigned char abyte;
-
-    for (i = 0; i < num; i++) {
-        x_fread(&abyte, 1, 1, fc);
-        array[i] = abyte;
-    }
+    return x_roffbin_read_block(fc, -1, 0, 1, num, array);
 }
 
 /*
  ***************************************************************************************
  * Reading a int array
+ * Returns EXIT_SUCCESS, or EXIT_FAILURE if the file is short
  ***************************************************************************************
  */
-void
+int
 x_roffgetintarray(int *array, int num, FILE *fc)
 {
-    int i;
-    int aint;
-
-    for (i = 0; i < num; i++) {
-        x_fread(&aint, 4, 1, fc);
-        if (x_byteorder(-1) > 1)
-            SWAP_SHORT(aint); /* SHORT? */
-        array[i] = aint;
-    }
+    int swap = (x_byteorder(-1) > 1) ? 1 : 0;
+    return x_roffbin_read_block(fc, -1, swap, 4, num, array);
 }
 
 /*
@@ -0,0 +1,47 @@
+/*
+ ***************************************************************************************
+ *
+ * NAME:
+ *    x_threads.c
+ *
+ * DESCRIPTION:
+ *    Resolve the number of threads to use in routines that are parallelized with
+ *    OpenMP. OpenMP is opt-in at build time (cmake -DXTG_OPENMP=ON); without it,
+ *    all routines run serially and this function always returns 1.
+ *
+ * ARGUMENTS:
+ *    nthreads       i     Requested number of threads; 0 or negative means all
+ *                         available processors
+ *
+ * RETURNS:
+ *    Number of threads that will actually be applied (>= 1)
+ *
+ * TODO/ISSUES/BUGS:
+ *
+ * LICENCE:
+ *    CF XTGeo's LICENSE
+ ***************************************************************************************
+ */
+
+#include "libxtg.h"
+#include "libxtg_.h"
+#include "logger.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+int
+x_nthreads(int nthreads)
+{
+#ifdef _OPENMP
+    int nmax = omp_get_num_procs();
+
+    if (nthreads <= 0 || nthreads > nmax)
+        nthreads = nmax;
+
+    return nthreads;
+#else
+    return 1;
+#endif
+}
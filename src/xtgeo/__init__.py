@@ -95,6 +95,7 @@ from xtgeo.common.exceptions import BlockedWellsNotFoundError
 
 from xtgeo.common.xtgeo_dialog import XTGeoDialog
 from xtgeo.common.sys import _XTGeoFile
+from xtgeo.common import profiling
 
 _xprint("Import common... done")
 
@@ -167,6 +168,7 @@ from xtgeo.surface.regular_surface import surface_from_file
 from xtgeo.surface.regular_surface import surface_from_roxar
 from xtgeo.surface.regular_surface import surface_from_cube
 from xtgeo.surface.regular_surface import surface_from_grid3d
+from xtgeo.surface.surfaces import surfaces_statistics
 
 from xtgeo.grid3d.grid import grid_from_file
 from xtgeo.grid3d.grid import grid_from_roxar
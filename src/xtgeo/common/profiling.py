@@ -0,0 +1,91 @@
+# -*- coding: utf-8 -*-
+"""Profiling of the XTGeo C library.
+
+Time consuming routines in the C library (import/export of grids and properties,
+slicing, point in cell searches, cell volumes, ...) are instrumented with named
+timers and counters. When profiling is enabled, number of calls, wall time and
+number of items processed are aggregated per routine, in-process, and can be
+retrieved from Python::
+
+  import xtgeo
+
+  xtgeo.profiling.enable()
+  grd = xtgeo.grid_from_file("reek.roff")
+  ...
+  print(xtgeo.profiling.report(dataframe=True))
+  xtgeo.profiling.reset()
+
+Profiling is off by default, and may also be enabled by setting the environment
+variable ``XTG_PROFILING`` (to any value but 0), e.g.::
+
+  export XTG_PROFILING=1
+
+Note that the numbers are accumulated for the whole process, and that a routine
+running in several threads at the same time reports the sum of the wall times.
+
+.. versionadded:: 2.14
+"""
+import os
+
+import pandas as pd
+
+import xtgeo.cxtgeo._cxtgeo as _cxtgeo
+
+COLUMNS = ["NAME", "NCALLS", "SECONDS", "NITEMS"]
+
+
+def enable(flag=True):
+    """Enable (or disable with ``flag=False``) profiling of C routines."""
+    _cxtgeo.x_prof_enable(1 if flag else 0)
+
+
+def disable():
+    """Disable profiling of C routines. Collected data are kept."""
+    _cxtgeo.x_prof_enable(0)
+
+
+def reset():
+    """Clear all collected profiling data."""
+    _cxtgeo.x_prof_reset()
+
+
+def report(dataframe=False):
+    """Return collected profiling data.
+
+    Args:
+        dataframe (bool): If True, return a Pandas dataframe with columns NAME,
+            NCALLS, SECONDS and NITEMS, sorted on SECONDS (descending).
+
+    Returns:
+        A dictionary on form ``{name: {"ncalls": ..., "seconds": ..., "nitems":
+        ...}}``, or a Pandas dataframe if ``dataframe`` is True.
+
+    Example::
+
+        >>> rep = xtgeo.profiling.report()
+        >>> rep["grd3d_imp_ecl_egrid"]["seconds"]
+    """
+    _nentries, text = _cxtgeo.x_prof_report()
+
+    result = {}
+    for line in text.splitlines():
+        name, ncalls, seconds, nitems = line.split(";")
+        result[name] = {
+            "ncalls": int(ncalls),
+            "seconds": float(seconds),
+            "nitems": int(nitems),
+        }
+
+    if not dataframe:
+        return result
+
+    rows = [
+        (name, val["ncalls"], val["seconds"], val["nitems"])
+        for name, val in result.items()
+    ]
+    dfr = pd.DataFrame(rows, columns=COLUMNS)
+    return dfr.sort_values("SECONDS", ascending=False).reset_index(drop=True)
+
+
+if os.environ.get("XTG_PROFILING", "0") not in ("", "0"):
+    enable()
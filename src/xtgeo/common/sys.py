@@ -46,12 +46,18 @@ VALID_FILE_ALIASES = ["$fmu-v1", "$md5sum", "$random"]
 
 
 def npfromfile(fname, dtype=np.float32, count=1, offset=0, mmap=False):
-    """Wrapper round np.fromfile to be compatible with older np versions."""
+    """Wrapper round np.fromfile to be compatible with older np versions.
+
+    If mmap is True, the file is memory mapped copy-on-write instead of read, i.e.
+    the pages are shared with the page cache (and other processes) until modified,
+    and modifications are never written back to the file. The result is then a
+    plain numpy view of the mapping.
+    """
     try:
         if mmap:
             vals = np.memmap(
-                fname, dtype=dtype, shape=(count,), mode="r", offset=offset
-            )
+                fname, dtype=dtype, shape=(count,), mode="c", offset=offset
+            ).view(np.ndarray)
         else:
             vals = np.fromfile(fname, dtype=dtype, count=count, offset=offset)
     except TypeError as err:
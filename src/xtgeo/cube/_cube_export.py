@@ -220,3 +220,48 @@ def export_xtgregcube(self, mfile):
         fout.write(jmeta)
 
     logger.info("Export as xtgregcube... done")
+
+
+def export_xtgbrickcube(
+    self, mfile, compression=None, tolerance=None, bricksize=64, threads=1
+):
+    """Export to bricked (and optionally compressed) xtgbrickcube format.
+
+    The header, brick offset table and bricks are written by the C library, and
+    the metadata is appended as for the xtgregcube format.
+    """
+    logger.info("Export as xtgbrickcube...")
+
+    codes = {None: 0, "lossless": 1, "bounded": 2}
+    if compression not in codes:
+        raise ValueError("Invalid compression: {}".format(compression))
+    if compression == "bounded" and not (tolerance and tolerance > 0):
+        raise ValueError("A tolerance > 0 is required for bounded compression")
+
+    if isinstance(bricksize, int):
+        bricksize = (bricksize, bricksize, bricksize)
+
+    self.metadata.required = self
+    jmeta = json.dumps(self.metadata.get_metadata()).encode()
+
+    values = np.ascontiguousarray(self.values, dtype=np.float32).reshape(-1)
+
+    ier = _cxtgeo.cube_export_xtgbrick(
+        mfile,
+        self.ncol,
+        self.nrow,
+        self.nlay,
+        values,
+        *bricksize,
+        codes[compression],
+        float(tolerance or 0.0),
+        threads,
+    )
+    if ier != 0:
+        raise RuntimeError("Error code {} when exporting to xtgbrickcube".format(ier))
+
+    with open(mfile, "ab") as fout:
+        fout.write("\nXTGMETA.v01\n".encode())
+        fout.write(jmeta)
+
+    logger.info("Export as xtgbrickcube... done")
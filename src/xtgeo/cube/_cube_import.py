@@ -1,6 +1,7 @@
 """Import Cube data via SegyIO library or XTGeo CLIB."""
 from struct import unpack
 import json
+import os
 from collections import OrderedDict
 
 import numpy as np
@@ -11,18 +12,28 @@ import xtgeo.cxtgeo._cxtgeo as _cxtgeo
 import xtgeo.common.calc as xcalc
 import xtgeo.common.sys as xsys
 from xtgeo.common import XTGeoDialog
+from xtgeo.cube import _cube_window
 
 xtg = XTGeoDialog()
 logger = xtg.functionlogger(__name__)
 
+# number of bytes per sample for supported SEGY sample format codes
+SEGY_SAMPLEBYTES = {1: 4, 2: 4, 3: 2, 5: 4, 8: 1}
 
-def import_segy(self, sfile, engine="segyio"):
+
+def import_segy(
+    self, sfile, engine="segyio", threads=1, windowed=False, cachesize=1024
+):
     """Import SEGY."""
-    if engine == "segyio":
+    if windowed:
+        # values are kept in file, which requires the xtgeo reader
+        _import_segy_cxtgeo(self, sfile, threads=threads, cachesize=cachesize)
+    elif engine == "segyio":
         _import_segy_io(self, sfile)
+    elif engine == "xtgeo":
+        _import_segy_cxtgeo(self, sfile, threads=threads)
     else:
-        pass
-        # _import_segy_xtgeo()
+        raise ValueError("Invalid engine for SEGY import: {}".format(engine))
 
 
 def _import_segy_io(self, sfile):
@@ -143,6 +154,144 @@ def _import_segy_io(self, sfile):
     self._traceidcodes = traceidcodes
 
 
+def _import_segy_cxtgeo(self, sfile, threads=1, cachesize=None):
+    """Import SEGY via XTGeo's C library, reading a memory mapped file.
+
+    All trace headers are read once to build an inline/xline index, then the traces
+    are decoded (in parallel if threads > 1) directly into the cube array. Only
+    post-stack SEGY with fixed trace length is supported. Missing traces are set to
+    zero and flagged as dead (trace identification code 2).
+
+    If cachesize is given, the values are not read; instead the cube is made
+    windowed, with a brick cache on the file with this memory budget.
+
+    Args:
+        self (Cube): Cube object
+        sfile (str): File name of SEGY file
+        threads (int): Number of threads, where 0 means all available.
+        cachesize (int): Memory budget (MB) for a windowed cube, or None.
+    """
+    # pylint: disable=too-many-locals
+
+    with open(sfile, "rb") as fhandle:
+        fhandle.seek(3200)
+        binheader = fhandle.read(400)
+
+    if len(binheader) < 400:
+        raise ValueError("File is too short for a SEGY file: {}".format(sfile))
+
+    dtus, nsamples = unpack(">HH", binheader[16:18] + binheader[20:22])
+    (fcode,) = unpack(">h", binheader[24:26])
+    (nextheaders,) = unpack(">h", binheader[304:306])
+
+    if fcode not in SEGY_SAMPLEBYTES:
+        raise ValueError("Unsupported SEGY sample format code: {}".format(fcode))
+    if nextheaders < 0:
+        raise ValueError("Variable number of extended headers is not supported")
+
+    offset = 3600 + 3200 * nextheaders
+    tracebytes = 240 + nsamples * SEGY_SAMPLEBYTES[fcode]
+    ntraces, rest = divmod(os.path.getsize(sfile) - offset, tracebytes)
+    if ntraces < 1 or rest != 0:
+        raise ValueError(
+            "SEGY file has no traces, or traces have variable length: {}".format(sfile)
+        )
+
+    logger.info("SEGY format %s, %s traces of %s samples", fcode, ntraces, nsamples)
+    ier, ilines, xlines, tcodes, cdpx, cdpy = _cxtgeo.cube_segy_trace_index(
+        sfile,
+        offset,
+        tracebytes,
+        ntraces,
+        ntraces,
+        ntraces,
+        ntraces,
+        ntraces,
+        ntraces,
+        threads,
+    )
+    if ier != 0:
+        raise RuntimeError("Error code {} from cube_segy_trace_index".format(ier))
+
+    # inline/xline to cube column/row index
+    ilines_u = np.unique(ilines)
+    xlines_u = np.unique(xlines)
+    ncol = len(ilines_u)
+    nrow = len(xlines_u)
+    icol = np.searchsorted(ilines_u, ilines)
+    jrow = np.searchsorted(xlines_u, xlines)
+    ijpos = icol * nrow + jrow
+
+    if len(np.unique(ijpos)) != ntraces:
+        raise ValueError("SEGY file has several traces per inline/xline (prestack?)")
+
+    traceno = np.full(ncol * nrow, -1, dtype=np.int32)
+    traceno[ijpos] = np.arange(ntraces, dtype=np.int32)
+
+    if cachesize is None:
+        values = np.empty(ncol * nrow * nsamples, dtype=np.float32)
+        ier = _cxtgeo.cube_import_segy_traces(
+            sfile, offset, tracebytes, fcode, nsamples, traceno, values, threads
+        )
+        if ier != 0:
+            raise RuntimeError(
+                "Error code {} from cube_import_segy_traces".format(ier)
+            )
+
+        if np.isnan(np.sum(values)):
+            raise ValueError("The input contains NaN values which is trouble!")
+    else:
+        bcache = _cube_window.BrickCache(
+            sfile,
+            offset,
+            tracebytes,
+            fcode,
+            (ncol, nrow, nsamples),
+            traceno,
+            cachesize=cachesize,
+        )
+
+    traceidcodes = np.full(ncol * nrow, 2, dtype=np.int32)
+    traceidcodes[ijpos] = tcodes
+
+    # geometry from a least squares fit of CDP X Y versus column and row, which is
+    # robust for missing corner traces
+    amat = np.column_stack((np.ones(ntraces), icol, jrow))
+    (xori, xcol, xrow), _, _, _ = np.linalg.lstsq(amat, cdpx, rcond=None)
+    (yori, ycol, yrow), _, _, _ = np.linalg.lstsq(amat, cdpy, rcond=None)
+
+    xinc, _, rotation = xcalc.vectorinfo2(0.0, xcol, 0.0, ycol)
+    yinc, _, _ = xcalc.vectorinfo2(0.0, xrow, 0.0, yrow)
+    yflip = xcalc.find_flip((xcol, ycol, 0), (xrow, yrow, 0))
+
+    # vertical start and increment from first trace header, if present
+    with open(sfile, "rb") as fhandle:
+        fhandle.seek(offset)
+        theader = fhandle.read(240)
+    delrt, tdtus = unpack(">hH", theader[108:110] + theader[116:118])
+
+    self._ilines = ilines_u.astype(np.int32)
+    self._xlines = xlines_u.astype(np.int32)
+    self._ncol = ncol
+    self._nrow = nrow
+    self._nlay = nsamples
+    self._xori = xori
+    self._xinc = xinc if ncol > 1 else 1.0
+    self._yori = yori
+    self._yinc = yinc if nrow > 1 else 1.0
+    self._zori = float(delrt)
+    self._zinc = (tdtus if tdtus > 0 else dtus) / 1000.0
+    self._rotation = rotation if ncol > 1 else 0.0
+    if cachesize is None:
+        self.values = values.reshape((ncol, nrow, nsamples))
+    else:
+        self._values = None
+        self._bcache = bcache
+    self._yflip = yflip
+    self._segyfile = sfile
+    self._traceidcodes = traceidcodes.reshape((ncol, nrow))
+
+
 def _import_segy_xtgeo(sfile, scanheadermode=False, scantracemode=False, outfile=None):
     """Import SEGY via XTGeo's C library. OLD NOT UPDATED!!
 
@@ -176,7 +325,7 @@ def _import_segy_xtgeo(sfile, scanheadermode=False, scantracemode=False, outfile
     if scanheadermode:
         option = 1
 
-    _cxtgeo.cube_scan_segy_hdr(
+    ier = _cxtgeo.cube_scan_segy_hdr(
         sfile,
         ptr_gn_bitsheader,
         ptr_gn_formatcode,
@@ -186,6 +335,8 @@ def _import_segy_xtgeo(sfile, scanheadermode=False, scantracemode=False, outfile
         option,
         outfile,
     )
+    if ier != 0:
+        raise RuntimeError("Error code {} from cube_scan_segy_hdr".format(ier))
 
     # get values
     gn_bitsheader = _cxtgeo.intpointer_value(ptr_gn_bitsheader)
@@ -222,7 +373,7 @@ def _import_segy_xtgeo(sfile, scanheadermode=False, scantracemode=False, outfile
         option = 1
 
     logger.debug("Scan via C wrapper...")
-    _cxtgeo.cube_import_segy(
+    ier = _cxtgeo.cube_import_segy(
         sfile,
         # input
         gn_bitsheader,
@@ -251,6 +402,9 @@ def _import_segy_xtgeo(sfile, scanheadermode=False, scantracemode=False, outfile
         outfile,
     )
 
+    if ier != 0:
+        raise RuntimeError("Error code {} from cube_import_segy".format(ier))
+
     logger.debug("Scan via C wrapper... done")
 
     ncol = _cxtgeo.intpointer_value(ptr_ncol)
@@ -268,7 +422,7 @@ def _import_segy_xtgeo(sfile, scanheadermode=False, scantracemode=False, outfile
     optscan = 0
 
     logger.debug("Import via C wrapper...")
-    _cxtgeo.cube_import_segy(
+    ier = _cxtgeo.cube_import_segy(
         sfile,
         # input
         gn_bitsheader,
@@ -297,6 +451,9 @@ def _import_segy_xtgeo(sfile, scanheadermode=False, scantracemode=False, outfile
         outfile,
     )
 
+    if ier != 0:
+        raise RuntimeError("Error code {} from cube_import_segy".format(ier))
+
     logger.debug("Import via C wrapper...")
 
     sdata["ncol"] = ncol
@@ -476,3 +633,52 @@ def import_xtgregcube(self, mfile, values=True):
 
     self._metadata.required = self
     logger.info("Importing cube on xtgregcube format... done.")
+
+
+def import_xtgbrickcube(self, mfile, threads=1, windowed=False, cachesize=1024):
+    """Import bricked cube, xtgbrickcube format, as ordinary or windowed cube."""
+    logger.info("Importing cube on xtgbrickcube format...")
+
+    offset = 68
+    with open(mfile.file, "rb") as fhandle:
+        buf = fhandle.read(offset)
+
+        swap, magic, nfloat, ncol, nrow, nlay = unpack("= i i i q q q", buf[:36])
+        if swap != 1 or magic != 1202 or nfloat != 4:
+            raise ValueError("Invalid file format (wrong swap id or magic number).")
+
+        # the last entry in the offset table is the position of the metadata
+        (nbricks,) = unpack("= q", buf[60:68])
+        fhandle.seek(offset + 8 * nbricks)
+        (pos,) = unpack("= q", fhandle.read(8))
+
+        fhandle.seek(pos + 13)
+        jmeta = fhandle.read().decode()
+
+    meta = json.loads(jmeta, object_pairs_hook=OrderedDict)
+    req = meta["_required_"]
+
+    reqattrs = xtgeo.MetaDataRegularCube.REQUIRED
+
+    for myattr in reqattrs:
+        setattr(self, "_" + myattr, req[myattr])
+
+    self._traceidcodes = np.ones((ncol, nrow), dtype=np.int32)
+
+    if windowed:
+        self._values = None
+        self._bcache = _cube_window.BrickCache.from_xtgbrickcube(
+            mfile.name, (ncol, nrow, nlay), cachesize=cachesize
+        )
+    else:
+        ier, values = _cxtgeo.cube_import_xtgbrick(
+            mfile.name, ncol, nrow, nlay, ncol * nrow * nlay, threads
+        )
+        if ier != 0:
+            raise RuntimeError(
+                "Error code {} when importing xtgbrickcube {}".format(ier, mfile.name)
+            )
+        self.values = values.reshape(ncol, nrow, nlay)
+
+    self._metadata.required = self
+    logger.info("Importing cube on xtgbrickcube format... done.")
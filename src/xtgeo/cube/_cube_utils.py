@@ -7,6 +7,7 @@ import numpy as np
 import xtgeo
 import xtgeo.cxtgeo._cxtgeo as _cxtgeo
 from xtgeo.common import XTGeoDialog
+from xtgeo.cube import _cube_window
 
 xtg = XTGeoDialog()
 
@@ -192,7 +193,8 @@ def resample(self, other, sampling="nearest", outside_value=None):
     # TODO: traceidcodes
 
     values1a = self.values.reshape(-1)
-    values2a = other.values.reshape(-1)
+    # a windowed input cube is sampled through its brick cache, not loaded
+    values2a, bcache2 = _cube_window.values_and_cache(other)
 
     logger.info("Resampling, using %s...", sampling)
 
@@ -221,6 +223,7 @@ def resample(self, other, sampling="nearest", outside_value=None):
         other.rotation,
         other.yflip,
         values2a,
+        bcache2,
         1 if sampling == "trilinear" else 0,
         0 if outside_value is None else 1,
         0 if outside_value is None else outside_value,
@@ -324,6 +327,7 @@ def get_randomline(
     if sampling == "trilinear":
         option = 1
 
+    cubevalues, bcache = _cube_window.values_and_cache(self)
     _ier, values = _cxtgeo.cube_get_randomline(
         xcoords,
         ycoords,
@@ -341,7 +345,8 @@ def get_randomline(
         self._ncol,
         self._nrow,
         self._nlay,
-        self._values.reshape(-1),
+        cubevalues,
+        bcache,
         nsamples,
         option,
     )
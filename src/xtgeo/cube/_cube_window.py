@@ -0,0 +1,164 @@
+"""Windowed (out-of-core) Cube access, through a brick cache in the C library.
+
+A windowed cube keeps the values in file (SEGY or xtgbrickcube). Routines that
+sample the cube (slicing with surfaces, random lines, attributes between surfaces)
+fetch only the bricks they touch, and bricks are kept in a least recently used
+(LRU) cache with a fixed memory budget.
+"""
+import numpy as np
+
+import xtgeo.cxtgeo._cxtgeo as _cxtgeo
+from xtgeo.common import XTGeoDialog
+
+xtg = XTGeoDialog()
+logger = xtg.functionlogger(__name__)
+
+# default brick dimensions (ncol, nrow, nlay); 256 KB per brick
+BRICKSIZE = (32, 32, 64)
+
+
+class BrickCache:
+    """A brick cache on a SEGY file, as a handle to the C library.
+
+    Args:
+        sfile (str): Name of SEGY file
+        offset (int): Byte position of first trace header
+        tracebytes (int): Number of bytes per trace, including the trace header
+        fcode (int): SEGY sample format code
+        dimensions (tuple): Cube dimensions (ncol, nrow, nlay)
+        traceno (ndarray): File trace number per cube column (C order), where -1
+            means a missing trace
+        cachesize (int): Memory budget of the cache in MB
+        bricksize (tuple): Brick dimensions (ncol, nrow, nlay)
+    """
+
+    def __init__(
+        self,
+        sfile,
+        offset,
+        tracebytes,
+        fcode,
+        dimensions,
+        traceno,
+        cachesize=1024,
+        bricksize=BRICKSIZE,
+    ):
+        self._handle = -1
+        self._deadvalue = None
+
+        handle = _cxtgeo.cube_bcache_open_segy(
+            sfile,
+            offset,
+            tracebytes,
+            fcode,
+            *dimensions,
+            traceno.astype(np.int32),
+            *bricksize,
+            int(cachesize * 1024 * 1024),
+        )
+        self._set_handle(handle, dimensions, "cube_bcache_open_segy")
+
+    @classmethod
+    def from_xtgbrickcube(cls, mfile, dimensions, cachesize=1024):
+        """A brick cache on a xtgbrickcube file, using the bricks of the file.
+
+        Args:
+            mfile (str): Name of xtgbrickcube file
+            dimensions (tuple): Cube dimensions (ncol, nrow, nlay)
+            cachesize (int): Memory budget of the cache in MB
+        """
+        self = cls.__new__(cls)
+        self._handle = -1
+        self._deadvalue = None
+
+        handle = _cxtgeo.cube_bcache_open_xtgbrick(
+            mfile, int(cachesize * 1024 * 1024)
+        )
+        self._set_handle(handle, dimensions, "cube_bcache_open_xtgbrick")
+        return self
+
+    def _set_handle(self, handle, dimensions, routine):
+        if handle < 0:
+            raise RuntimeError("Error code {} from {}".format(handle, routine))
+        self._handle = handle
+        self._dimensions = tuple(dimensions)
+
+    def __del__(self):
+        self.close()
+
+    @property
+    def handle(self):
+        """The cache handle in the C library (read only)."""
+        return self._handle
+
+    @property
+    def deadvalue(self):
+        """The value for dead traces, or None if not set (read only)."""
+        return self._deadvalue
+
+    def close(self):
+        """Release the file and the memory of the cache."""
+        if self._handle >= 0:
+            _cxtgeo.cube_bcache_close(self._handle)
+            self._handle = -1
+
+    def info(self):
+        """Return cache statistics as a dictionary with hits, misses and memory.
+
+        A miss is a brick read from file, and memory is the memory in use (bytes).
+        """
+        _ier, nhits, nmisses, nbytes = _cxtgeo.cube_bcache_stats(self._handle)
+        return {"hits": nhits, "misses": nmisses, "memory": nbytes}
+
+    def deadtraces(self, traceidcodes, value):
+        """Set (or clear if value is None) the value for dead traces.
+
+        Returns the previous value, which is None if not set.
+        """
+        codes = np.ascontiguousarray(traceidcodes, dtype=np.int32).reshape(-1)
+        if value is None:
+            _cxtgeo.cube_bcache_deadtraces(self._handle, codes, 0.0, 0)
+        else:
+            _cxtgeo.cube_bcache_deadtraces(self._handle, codes, float(value), 1)
+
+        previous = self._deadvalue
+        self._deadvalue = value
+        return previous
+
+    def read(self, icols=None, jrows=None, klays=None):
+        """Read values in a sub cube, as a 3D numpy array.
+
+        The ranges are (first, last) index tuples, 1 based and inclusive, and
+        default to the full range. An OSError is raised if the values cannot be
+        read from file, e.g. if the file has been truncated.
+        """
+        ranges = []
+        for rng, nval in zip((icols, jrows, klays), self._dimensions):
+            ranges.append((1, nval) if rng is None else tuple(rng))
+
+        shape = tuple(last - first + 1 for first, last in ranges)
+        ier, values = _cxtgeo.cube_bcache_read(
+            self._handle,
+            *ranges[0],
+            *ranges[1],
+            *ranges[2],
+            int(np.prod(shape)),
+        )
+        if ier == -2:
+            raise OSError("Cannot read cube values from file, truncated or corrupt?")
+        if ier != 0:
+            raise ValueError("Invalid sub cube range: {}".format(ranges))
+
+        return values.reshape(shape)
+
+
+def values_and_cache(cube):
+    """Return cube values (1D) and brick cache handle for the C routines.
+
+    For a windowed cube the values array is empty, and the C routines will use the
+    brick cache, while the cache handle is -1 for an ordinary cube.
+    """
+    if cube.windowed:
+        return np.zeros(0, dtype=np.float32), cube._bcache.handle
+
+    return cube.values.reshape(-1), -1
@@ -40,6 +40,8 @@ logger = xtg.functionlogger(__name__)
 # _traceidcodes : 2D array with trace ID codes
 # _segyfile     : Name of SEGY file (not sure what the point of this is, TODO check)
 # _undef        : Undef value, defaulted to xtgeo.UNDEF
+# _bcache       : Brick cache (_cube_window.BrickCache) for a windowed cube, where
+#                 _values is None and values are read from file when needed
 #
 # See also Cube section in documentation: docs/datamodel.rst
 # ======================================================================================
@@ -124,6 +126,7 @@ class Cube:  # pylint: disable=too-many-public-methods
     ):
         """Initiate a Cube instance."""
         self._values = None
+        self._bcache = None
 
         self._filesrc = None
         self._xori = xori
@@ -153,7 +156,7 @@ class Cube:  # pylint: disable=too-many-public-methods
 
     def __repr__(self):
         """The __repr__ method."""
-        avg = self.values.mean()
+        avg = "(windowed)" if self.windowed else self.values.mean()
         dsc = (
             "{0.__class__} (ncol={0.ncol!r}, "
             "nrow={0.nrow!r}, nlay={0.nlay!r}, "
@@ -343,13 +346,46 @@ class Cube:  # pylint: disable=too-many-public-methods
 
     @property
     def values(self):
-        """The values, as a 3D numpy (ncol, nrow, nlay), 4 byte float."""
+        """The values, as a 3D numpy (ncol, nrow, nlay), 4 byte float.
+
+        For a windowed cube, the full cube is read into memory at first access,
+        and the cube is then no longer windowed. A value set for dead traces
+        (:meth:`values_dead_traces`) is kept in the values read.
+        """
+        if self._bcache is not None:
+            logger.info("Reading all values of windowed cube into memory")
+            self._bcache.deadtraces(self._traceidcodes, self._bcache.deadvalue)
+            self._values = self._bcache.read()
+            self._bcache = None
         return self._values
 
     @values.setter
     def values(self, values):
+        self._bcache = None
         self._ensure_correct_values(values)
 
+    @property
+    def windowed(self):
+        """True if the cube is windowed, i.e. values are kept in file (read only).
+
+        See :meth:`from_file`.
+
+        .. versionadded:: 2.14
+        """
+        return self._bcache is not None
+
+    def cache_info(self):
+        """Return brick cache statistics for a windowed cube, else None.
+
+        The statistics is a dictionary with number of cache ``hits``, number of
+        ``misses`` (bricks read from file) and ``memory`` in use (bytes).
+
+        .. versionadded:: 2.14
+        """
+        if self._bcache is None:
+            return None
+        return self._bcache.info()
+
     # =========================================================================
     # Describe
     # =========================================================================
@@ -405,17 +441,22 @@ class Cube:  # pylint: disable=too-many-public-methods
         dsc.txt("Inlines vector", self._ilines)
         dsc.txt("Xlines vector", self._xlines)
         dsc.txt("Time or depth slices vector", self.zslices)
-        dsc.txt("Values", self._values.reshape(-1), self._values.dtype)
-        np.set_printoptions(threshold=1000)
-        dsc.txt(
-            "Values, mean, stdev, minimum, maximum",
-            self.values.mean(),
-            self.values.std(),
-            self.values.min(),
-            self.values.max(),
-        )
+        if self.windowed:
+            dsc.txt("Values", "windowed, kept in file", self._segyfile)
+            np.set_printoptions(threshold=1000)
+            dsc.txt("Brick cache", self.cache_info())
+        else:
+            dsc.txt("Values", self._values.reshape(-1), self._values.dtype)
+            np.set_printoptions(threshold=1000)
+            dsc.txt(
+                "Values, mean, stdev, minimum, maximum",
+                self.values.mean(),
+                self.values.std(),
+                self.values.min(),
+                self.values.max(),
+            )
         dsc.txt("Trace ID codes", self._traceidcodes.reshape(-1))
-        msize = float(self.values.size * 4) / (1024 * 1024 * 1024)
+        msize = float(self.ncol * self.nrow * self.nlay * 4) / (1024 * 1024 * 1024)
         dsc.txt("Minimum memory usage of array (GB)", msize)
 
         if flush:
@@ -431,6 +472,9 @@ class Cube:  # pylint: disable=too-many-public-methods
     def copy(self):
         """Deep copy of a Cube() object to another instance.
 
+        Note that a windowed cube is read into memory (cf. :attr:`values`), for
+        both this instance and the copy.
+
         >>> mycube2 = mycube.copy()
 
         """
@@ -584,6 +628,13 @@ class Cube:  # pylint: disable=too-many-public-methods
         """
         logger.info("Set values for dead traces, if any")
 
+        if self.windowed:
+            # values in file are not changed; the brick cache substitutes values for
+            # dead traces, and the previous value (or None) is returned for reset
+            if 2 in self._traceidcodes:
+                return self._bcache.deadtraces(self._traceidcodes, newvalue)
+            return None
+
         if 2 in self._traceidcodes:
             minval = self._values[self._traceidcodes == 2].min()
             maxval = self._values[self._traceidcodes == 2].max()
@@ -695,18 +746,49 @@ class Cube:  # pylint: disable=too-many-public-methods
     # Import and export
     # =========================================================================
 
-    def from_file(self, sfile, fformat="guess", engine="segyio"):
+    def from_file(
+        self,
+        sfile,
+        fformat="guess",
+        engine="segyio",
+        threads=1,
+        windowed=False,
+        cachesize=1024,
+    ):
         """Import cube data from file.
 
         If fformat is not provided, the file type will be guessed based
         on file extension (e.g. segy og sgy for SEGY format)
 
+        A windowed cube (SEGY or xtgbrickcube) keeps the values in file, and is
+        meant for cubes that are too large for memory. Slicing with surfaces
+        (:meth:`~xtgeo.surface.RegularSurface.slice_cube`,
+        :meth:`~xtgeo.surface.RegularSurface.slice_cube_window`), and
+        :meth:`get_randomline` read only the parts of the cube they touch, in
+        bricks (32 x 32 x 64 samples for SEGY, while the xtgbrickcube format has
+        its own bricks), which are kept in a least recently used (LRU) cache with
+        a memory budget given by ``cachesize``. The same applies for the input
+        cube of :meth:`resample`. Accessing :attr:`values` reads the full cube
+        into memory, and so do all other operations that need the values, e.g.
+        :meth:`copy`, :meth:`swapaxes`, :meth:`do_thinning`, :meth:`do_cropping`,
+        :meth:`to_file` and :meth:`to_roxar`; the cube is then no longer windowed.
+
         Args:
             sfile (str): Filename (as string or pathlib.Path instance).
-            fformat (str): file format guess/segy/rms_regular/xtgregcube
-                where 'guess' is default. Regard 'xtgrecube' format as experimental.
+            fformat (str): file format guess/segy/rms_regular/xtgregcube/
+                xtgbrickcube where 'guess' is default. Regard 'xtgrecube' format as
+                experimental.
             engine (str): For the SEGY reader, 'xtgeo' is builtin
-                while 'segyio' uses the SEGYIO library (default).
+                while 'segyio' uses the SEGYIO library (default). The 'xtgeo'
+                engine memory maps the file and is fast for large post-stack
+                cubes, but requires fixed trace length.
+            threads (int): Number of threads for the 'xtgeo' SEGY reader and the
+                xtgbrickcube reader, where 0 means all available. Default is 1.
+            windowed (bool): If True, make a windowed cube where values are read
+                from file when needed (SEGY, using the 'xtgeo' engine, or
+                xtgbrickcube).
+            cachesize (int): Memory budget in MB for the brick cache of a windowed
+                cube. Default is 1024.
             deadtraces (float): Set 'dead' trace values to this value (SEGY
                 only). Default is UNDEF value (a very large number).
 
@@ -719,6 +801,9 @@ class Cube:  # pylint: disable=too-many-public-methods
             >>> zz = Cube()
             >>> zz.from_file('some.segy')
 
+        .. versionchanged:: 2.14 Added a fast ``engine="xtgeo"`` SEGY reader, the
+           ``threads`` key, windowed cubes (keys ``windowed`` and ``cachesize``)
+           and the bricked ``xtgbrickcube`` format
 
         """
         fobj = xtgeosys._XTGeoFile(sfile)
@@ -732,34 +817,75 @@ class Cube:  # pylint: disable=too-many-public-methods
 
             fformat = fext.lower()
 
+        if windowed and fformat not in ("segy", "sgy", "xtgbrickcube"):
+            raise ValueError(
+                "Windowed cubes are only supported for SEGY and xtgbrickcube files"
+            )
+
         if "rms" in fformat:
             _cube_import.import_rmsregular(self, fobj.name)
         elif fformat in ("segy", "sgy"):
-            _cube_import.import_segy(self, fobj.name, engine=engine)
+            _cube_import.import_segy(
+                self,
+                fobj.name,
+                engine=engine,
+                threads=threads,
+                windowed=windowed,
+                cachesize=cachesize,
+            )
         elif fformat == "storm":
             _cube_import.import_stormcube(self, fobj.name)
         elif fformat == "xtgregcube":
             # experimental format
             _cube_import.import_xtgregcube(self, fobj)
+        elif fformat == "xtgbrickcube":
+            _cube_import.import_xtgbrickcube(
+                self, fobj, threads=threads, windowed=windowed, cachesize=cachesize
+            )
         else:
             raise ValueError(f"File format fformat={fformat} is not supported")
 
         self._filesrc = fobj.name
         self._metadata.required = self
 
-    def to_file(self, sfile, fformat="segy", pristine=False, engine="xtgeo"):
+    def to_file(
+        self,
+        sfile,
+        fformat="segy",
+        pristine=False,
+        engine="xtgeo",
+        compression=None,
+        tolerance=None,
+        bricksize=64,
+        threads=1,
+    ):
         """Export cube data to file.
 
+        The 'xtgbrickcube' format stores the cube in bricks (default 64 x 64 x 64
+        samples) with an offset table, so that a windowed cube (see
+        :meth:`from_file`) reads only the bricks in use. Bricks can be
+        compressed, either lossless, or with a bounded error where values are
+        rounded to a multiple of 2 * ``tolerance``.
+
         Args:
             sfile (str): Filename
-            fformat (str, optional): file format 'segy' (default) or
-                'rms_regular'
+            fformat (str, optional): file format 'segy' (default),
+                'rms_regular', 'xtgregcube' or 'xtgbrickcube'
             pristine (bool): If True, make SEGY from scratch.
             engine (str): Which "engine" to use.
+            compression (str): For 'xtgbrickcube'; None (default), 'lossless'
+                or 'bounded'.
+            tolerance (float): Max absolute error for 'bounded' compression.
+            bricksize (int or tuple): Brick size for 'xtgbrickcube', as one
+                number or (ncol, nrow, nlay). Default is 64.
+            threads (int): Number of threads for compressing bricks, where 0
+                means all available. Default is 1.
 
         Example::
             >>> zz = Cube('some.segy')
             >>> zz.to_file('some.rmsreg')
+
+        .. versionchanged:: 2.14 Added the 'xtgbrickcube' format
         """
         fobj = xtgeosys._XTGeoFile(sfile, mode="wb")
 
@@ -771,6 +897,15 @@ class Cube:  # pylint: disable=too-many-public-methods
             _cube_export.export_rmsreg(self, fobj.name)
         elif fformat == "xtgregcube":
             _cube_export.export_xtgregcube(self, fobj.name)
+        elif fformat == "xtgbrickcube":
+            _cube_export.export_xtgbrickcube(
+                self,
+                fobj.name,
+                compression=compression,
+                tolerance=tolerance,
+                bricksize=bricksize,
+                threads=threads,
+            )
         else:
             raise ValueError(f"File format fformat={fformat} is not supported")
 
@@ -5,7 +5,6 @@ import numpy as np
 
 import xtgeo
 from xtgeo.grid3d import _gridprop_lowlevel as gl
-from xtgeo.surface import _regsurf_lowlevel as rl
 import xtgeo.cxtgeo._cxtgeo as _cxtgeo
 
 xtg = xtgeo.common.XTGeoDialog()
@@ -27,12 +26,8 @@ def get_randomline(
 
     This is a difficult task, in particular in terms of acceptable speed.
     """
-    self._xtgformat1()
-
     logger.info("Enter get_randomline from Grid...")
 
-    _update_tmpvars(self)
-
     if hincrement is None and isinstance(fencespec, xtgeo.Polygons):
         logger.info("Estimate hincrement from Polygons instance...")
         fencespec = _get_randomline_fence(self, fencespec, hincrement, atleast, nextend)
@@ -46,6 +41,8 @@ def get_randomline(
     ycoords = fencespec[:, 1]
     hcoords = fencespec[:, 3]
 
+    if zmin is None or zmax is None:
+        _update_tmpvars(self)
     if zmin is None:
         zmin = self._tmp["topd"].values.min()
     if zmax is None:
@@ -54,37 +51,69 @@ def get_randomline(
     nzsam = int((zmax - zmin) / float(zincrement)) + 1
     nsamples = xcoords.shape[0] * nzsam
 
+    # the fence estimate may change the xtgformat of the grid, so the cell index is
+    # made (or checked) for the final format just before use
+    _update_cellindex(self)
+    cindex = self._tmp["cellindex"]
+
     logger.info("Running C routine to get randomline...")
-    _ier, values = _cxtgeo.grd3d_get_randomline(
-        xcoords,
-        ycoords,
-        zmin,
-        zmax,
-        nzsam,
-        self._tmp["topd"].ncol,
-        self._tmp["topd"].nrow,
-        self._tmp["topd"].xori,
-        self._tmp["topd"].yori,
-        self._tmp["topd"].xinc,
-        self._tmp["topd"].yinc,
-        self._tmp["topd"].rotation,
-        self._tmp["topd"].yflip,
-        self._tmp["topi_carr"],
-        self._tmp["topj_carr"],
-        self._tmp["basi_carr"],
-        self._tmp["basj_carr"],
-        self.ncol,
-        self.nrow,
-        self.nlay,
-        self._coordsv,
-        self._zcornsv,
-        self._actnumsv,
-        gl.update_carray(prop, dtype=np.float64),
-        self._tmp["onegrid"]._zcornsv,
-        self._tmp["onegrid"]._actnumsv,
-        nsamples,
-    )
+    if self._xtgformat == 2:
+        ier, values = _cxtgeo.grdcp3d_get_randomline(
+            xcoords,
+            ycoords,
+            zmin,
+            zmax,
+            nzsam,
+            self.ncol,
+            self.nrow,
+            self.nlay,
+            self._coordsv,
+            self._zcornsv,
+            self._actnumsv,
+            np.ma.filled(prop.values, xtgeo.UNDEF).astype(np.float64).ravel(),
+            cindex["colbox"],
+            cindex["binstart"],
+            cindex["bincells"],
+            cindex["xmin"],
+            cindex["ymin"],
+            cindex["xbin"],
+            cindex["ybin"],
+            cindex["nbx"],
+            cindex["nby"],
+            nsamples,
+        )
+    else:
+        pcarr = gl.update_carray(prop, dtype=np.float64)
+        ier, values = _cxtgeo.grd3d_get_randomline(
+            xcoords,
+            ycoords,
+            zmin,
+            zmax,
+            nzsam,
+            self.ncol,
+            self.nrow,
+            self.nlay,
+            self._coordsv,
+            self._zcornsv,
+            self._actnumsv,
+            pcarr,
+            self._tmp["onegrid"]._zcornsv,
+            self._tmp["onegrid"]._actnumsv,
+            cindex["colbox"],
+            cindex["binstart"],
+            cindex["bincells"],
+            cindex["xmin"],
+            cindex["ymin"],
+            cindex["xbin"],
+            cindex["ybin"],
+            cindex["nbx"],
+            cindex["nby"],
+            nsamples,
+        )
+        gl.delete_carray(prop, pcarr)
 
+    if ier != 0:
+        raise RuntimeError("Error code {} from C routine for randomline".format(ier))
     logger.info("Running C routine to get randomline... DONE")
 
     values[values > xtgeo.UNDEF_LIMIT] = np.nan
@@ -95,40 +124,116 @@ def get_randomline(
 
 
 def _update_tmpvars(self, force=False):
-    """The self._tmp variables are needed to speed up calculations.
+    """Top and base depth surfaces of the grid, stored as self._tmp["topd"/"basd"].
 
-    If they are already created, the no need to recreate
+    These are used for the default vertical range of a randomline. If they are
+    already created, then no need to recreate.
     """
+    if "topd" not in self._tmp or force:
+        _update_onegrid(self, force=force)
+        one = self._tmp["onegrid"]
+        logger.info("Make a set of tmp surfaces for depth...")
+        self._tmp["topd"] = xtgeo.RegularSurface()
+        self._tmp["topd"].from_grid3d(one, where="top", rfactor=4)
+
+        self._tmp["basd"] = xtgeo.RegularSurface()
+        self._tmp["basd"].from_grid3d(one, where="base", rfactor=4)
+        logger.info("Make a set of tmp surfaces for depth... DONE")
+    else:
+        logger.info("Re-use existing onegrid and tmp surfaces for depth")
+
+
+def _update_onegrid(self, force=False):
+    """A onelayer version of the grid, stored as self._tmp["onegrid"]."""
     if "onegrid" not in self._tmp or force:
         logger.info("Make a tmp onegrid instance...")
         self._tmp["onegrid"] = self.copy()
         self._tmp["onegrid"].reduce_to_one_layer()
-        one = self._tmp["onegrid"]
         logger.info("Make a tmp onegrid instance... DONE")
-        logger.info("Make a set of tmp surfaces for I J locations + depth...")
-        self._tmp["topd"] = xtgeo.RegularSurface()
-        self._tmp["topi"], self._tmp["topj"] = self._tmp["topd"].from_grid3d(
-            one, where="top", rfactor=4
-        )
 
-        self._tmp["basd"] = xtgeo.RegularSurface()
-        self._tmp["basi"], self._tmp["basj"] = self._tmp["basd"].from_grid3d(
-            one, where="base", rfactor=4
-        )
 
-        self._tmp["topi"].fill()
-        self._tmp["topj"].fill()
-        self._tmp["basi"].fill()
-        self._tmp["basj"].fill()
+def _update_cellindex(self, force=False):
+    """A spatial index of grid columns for fast XYZ -> IJK lookups.
+
+    Each grid column gets a bounding box, and the XY extent of the grid is divided
+    into regular (unrotated) square bins holding the columns that overlap each bin,
+    cf. grd3d_cellindex.c. A lookup then only needs to evaluate a few columns, also
+    for rotated and faulted grids. The index is stored as self._tmp["cellindex"],
+    and is made only once per grid geometry.
+
+    The index is made for the current xtgformat of the grid (no conversion). The
+    xtgformat=1 routines also need a onelayer grid, which is then made as well.
+    """
+    if self._xtgformat == 1:
+        _update_onegrid(self, force=force)
+        # the onelayer grid may have been made while the grid was xtgformat 2
+        self._tmp["onegrid"]._xtgformat1()
 
-        self._tmp["topi_carr"] = rl.get_carr_double(self._tmp["topi"])
-        self._tmp["topj_carr"] = rl.get_carr_double(self._tmp["topj"])
-        self._tmp["basi_carr"] = rl.get_carr_double(self._tmp["basi"])
-        self._tmp["basj_carr"] = rl.get_carr_double(self._tmp["basj"])
+    cindex = self._tmp.get("cellindex")
+    if cindex is not None and cindex["xtgformat"] == self._xtgformat and not force:
+        logger.info("Re-use existing cell index")
+        return
 
-        logger.info("Make a set of tmp surfaces for I J locations + depth... DONE")
+    logger.info("Make a cell index...")
+
+    ncolumns = self.ncol * self.nrow
+
+    if self._xtgformat == 1:
+        _ier, colbox = _cxtgeo.grd3d_cellindex_colbox(
+            self.ncol, self.nrow, self.nlay, self._coordsv, self._zcornsv, 6 * ncolumns
+        )
     else:
-        logger.info("Re-use existing onegrid and tmp surfaces for I J")
+        _ier, colbox = _cxtgeo.grdcp3d_cellindex_colbox(
+            self.ncol, self.nrow, self.nlay, self._coordsv, self._zcornsv, 6 * ncolumns
+        )
+    boxes = colbox.reshape(ncolumns, 6)
+
+    xmin = boxes[:, 0].min()
+    ymin = boxes[:, 2].min()
+    xlen = max(boxes[:, 1].max() - xmin, 1.0)
+    ylen = max(boxes[:, 3].max() - ymin, 1.0)
+
+    # square bins, in average one column per bin
+    binsize = np.sqrt(xlen * ylen / ncolumns)
+    nbx = int(xlen / binsize) + 1
+    nby = int(ylen / binsize) + 1
+
+    _ier, counts = _cxtgeo.grd3d_cellindex_count(
+        self.ncol, self.nrow, colbox, xmin, ymin, binsize, binsize, nbx, nby, nbx * nby
+    )
+
+    binstart = np.zeros(nbx * nby + 1, dtype=np.int32)
+    binstart[1:] = np.cumsum(counts)
+
+    ier, bincells = _cxtgeo.grd3d_cellindex_fill(
+        self.ncol,
+        self.nrow,
+        colbox,
+        xmin,
+        ymin,
+        binsize,
+        binsize,
+        nbx,
+        nby,
+        binstart,
+        int(binstart[-1]),
+    )
+    if ier != 0:
+        raise RuntimeError("Error code {} from C routine making cell index".format(ier))
+
+    self._tmp["cellindex"] = {
+        "xtgformat": self._xtgformat,
+        "colbox": colbox,
+        "binstart": binstart,
+        "bincells": bincells,
+        "xmin": xmin,
+        "ymin": ymin,
+        "xbin": binsize,
+        "ybin": binsize,
+        "nbx": nbx,
+        "nby": nby,
+    }
+    logger.info("Make a cell index... DONE")
 
 
 def _get_randomline_fence(self, fencespec, hincrement, atleast, nextend):
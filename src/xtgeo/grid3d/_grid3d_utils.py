@@ -2,6 +2,9 @@
 
 """Some grid utilities, file scanning etc (methods with no class)"""
 
+import json
+import os
+import struct
 
 import pandas as pd
 
@@ -11,17 +14,47 @@ import xtgeo.cxtgeo._cxtgeo as _cxtgeo
 xtg = xtgeo.XTGeoDialog()
 logger = xtg.functionlogger(__name__)
 
-
-def scan_keywords(pfile, fformat="xecl", maxkeys=100000, dataframe=False, dates=False):
+# the scan index is a sidecar file (json) next to the Eclipse file
+SCANINDEX_SUFFIX = ".xtgidx"
+SCANINDEX_VERSION = 1
+
+# record types translation (cf: grd3d_scan_eclbinary.c in cxtgeo)
+ECL_RECTYPES = {
+    "1": "INTE",
+    "2": "REAL",
+    "3": "DOUB",
+    "4": "CHAR",
+    "5": "LOGI",
+    "6": "MESS",
+    "-1": "????",
+}
+
+
+def scan_keywords(
+    pfile,
+    fformat="xecl",
+    maxkeys=100000,
+    dataframe=False,
+    dates=False,
+    scanindex=None,
+):
     """Quick scan of keywords in Eclipse binary restart/init/... file,
     or ROFF binary files.
 
+    If scanindex is None, the environment variable XTG_ECL_SCANINDEX decides if
+    a scan index (sidecar file) shall be used for Eclipse files.
+
     Cf. grid_properties.py description
     """
 
     pfile.get_cfhandle()  # just to keep cfhanclecounter correct
 
-    if fformat == "xecl":
+    if fformat == "xecl" and _use_scanindex(pfile, scanindex):
+        data = _scan_ecl_keywords_indexed(
+            pfile, maxkeys=maxkeys, dataframe=dataframe, dates=dates
+        )
+
+    elif fformat == "xecl":
         if dates:
             data = _scan_ecl_keywords_w_dates(
                 pfile, maxkeys=maxkeys, dataframe=dataframe
@@ -98,16 +131,7 @@ def _scan_ecl_keywords(pfile, maxkeys=100000, dataframe=False):
     keywords = keywords.replace(" ", "")
     keywords = keywords.split("|")
 
-    # record types translation (cf: grd3d_scan_eclbinary.c in cxtgeo)
-    rct = {
-        "1": "INTE",
-        "2": "REAL",
-        "3": "DOUB",
-        "4": "CHAR",
-        "5": "LOGI",
-        "6": "MESS",
-        "-1": "????",
-    }
+    rct = ECL_RECTYPES
 
     rc = []
     rl = []
@@ -160,6 +184,200 @@ def _scan_ecl_keywords_w_dates(pfile, maxkeys=100000, dataframe=False):
     return result
 
 
+def _use_scanindex(pfile, scanindex):
+    """Return True if a scan index (sidecar file) shall be applied."""
+    if pfile.memstream:
+        return False
+
+    if scanindex is None:
+        envvalue = os.environ.get("XTG_ECL_SCANINDEX", "")
+        scanindex = envvalue.lower() not in ("", "0", "false", "no")
+
+    return bool(scanindex)
+
+
+def _scan_ecl_keywords_indexed(pfile, maxkeys=100000, dataframe=False, dates=False):
+    """Scan keywords with dates in Eclipse binary file, using a scan index.
+
+    The index is stored as a sidecar file <file>.xtgidx, and is valid as long as
+    the file size and modification time are unchanged. If the file has grown (e.g.
+    a restart file from a running simulation), only the new part is scanned, given
+    that the last record in the index is still in place.
+
+    An invalid record raises an error, and the index is then not written, as a
+    partial list of keywords shall not be cached.
+    """
+    fname = pfile.name
+    idxname = fname + SCANINDEX_SUFFIX
+    fstat = os.stat(fname)
+
+    index = _read_scanindex(idxname)
+
+    if index and (index["size"], index["mtime"]) == (fstat.st_size, fstat.st_mtime_ns):
+        logger.info("Reuse scan index %s", idxname)
+
+    else:
+        records = []
+        endpos = 0
+        if index and fstat.st_size > index["size"] and _scanindex_tail_ok(pfile, index):
+            logger.info("File is grown, update scan index %s", idxname)
+            records = index["records"]
+            endpos = index["endpos"]
+
+        nold = len(records)
+        newrecords, endpos = _scan_ecl_keywords_from(pfile, endpos, maxkeys)
+        records.extend(newrecords)
+        _scanindex_dates(pfile, records, nold)
+
+        index = {
+            "version": SCANINDEX_VERSION,
+            "file": fname,
+            "size": fstat.st_size,
+            "mtime": fstat.st_mtime_ns,
+            "endpos": endpos,
+            "records": records,
+        }
+        _write_scanindex(idxname, index)
+
+    if dates:
+        result = [tuple(rec) for rec in index["records"]]
+        cols = ["KEYWORD", "TYPE", "NITEMS", "BYTESTART", "DATE"]
+    else:
+        result = [tuple(rec[0:4]) for rec in index["records"]]
+        cols = ["KEYWORD", "TYPE", "NITEMS", "BYTESTART"]
+
+    if dataframe:
+        return pd.DataFrame.from_records(result, columns=cols)
+
+    return result
+
+
+def _scan_ecl_keywords_from(pfile, startpos, maxkeys):
+    """Scan keywords from a byte position, in chunks of maxkeys.
+
+    Returns a list of [keyword, type, nitems, bytestart, date] where date is
+    unset (0), and the byte position after the last complete record. An incomplete
+    last record (a file being written) is not included, while an invalid record is
+    an error.
+    """
+    ultramax = int(1000000 / 9)  # cf *swig_bnd_char_1m in cxtgeo.i
+    maxkeys = min(maxkeys, ultramax - 1)
+
+    rectypes = _cxtgeo.new_intarray(maxkeys)
+    reclens = _cxtgeo.new_longarray(maxkeys)
+    recstarts = _cxtgeo.new_longarray(maxkeys)
+
+    cfhandle = pfile.get_cfhandle()
+
+    records = []
+    endpos = startpos
+    nkeys = maxkeys
+    try:
+        while nkeys == maxkeys:
+            nkeys, keywords, endpos = _cxtgeo.grd3d_scan_eclbinary_from(
+                cfhandle, endpos, rectypes, reclens, recstarts, maxkeys
+            )
+            if nkeys < 0:
+                raise RuntimeError(
+                    "Invalid record at byte {} in file {}".format(endpos, pfile.name)
+                )
+            keywords = keywords.replace(" ", "").split("|")
+            for i in range(nkeys):
+                records.append(
+                    [
+                        keywords[i],
+                        ECL_RECTYPES[str(_cxtgeo.intarray_getitem(rectypes, i))],
+                        _cxtgeo.longarray_getitem(reclens, i),
+                        _cxtgeo.longarray_getitem(recstarts, i),
+                        0,
+                    ]
+                )
+    finally:
+        pfile.cfclose()
+
+        _cxtgeo.delete_intarray(rectypes)
+        _cxtgeo.delete_longarray(reclens)
+        _cxtgeo.delete_longarray(recstarts)
+
+    return records, endpos
+
+
+def _scanindex_dates(pfile, records, nold):
+    """Set dates in records (in place), from record no. nold and onwards.
+
+    As in scan_dates(), the date for a SEQNUM is found in the next INTEHEAD record
+    (items 65, 66, 67 counted from 1), and holds until next SEQNUM. Dates for the
+    records in the old part of the index are kept, except from the last SEQNUM,
+    where the INTEHEAD may have been missing at the time of previous scan.
+    """
+    start = nold
+    for inum in range(nold - 1, -1, -1):
+        if records[inum][0] == "SEQNUM":
+            start = inum
+            break
+
+    date = records[start - 1][4] if start > 0 else 0
+    seqpos = None
+    with open(pfile.name, "rb") as fhandle:
+        for inum in range(start, len(records)):
+            name, _, nitems, bytepos, _ = records[inum]
+            if name == "SEQNUM":
+                seqpos = inum
+            elif name == "INTEHEAD" and seqpos is not None and nitems > 66:
+                # [<16>'INTEHEAD' nitems 'INTE'<16>] <ftn> ...
+                fhandle.seek(bytepos + 24 + 4 + 64 * 4)
+                day, mon, year = struct.unpack(">3i", fhandle.read(12))
+                date = year * 10000 + mon * 100 + day
+                for jnum in range(seqpos, inum):
+                    records[jnum][4] = date
+                seqpos = None
+            records[inum][4] = date
+
+
+def _scanindex_tail_ok(pfile, index):
+    """Check that the last record in the index is unchanged in the file."""
+    if index["endpos"] > index["size"] or not index["records"]:
+        return False
+
+    name, _, nitems, bytepos, _ = index["records"][-1]
+    with open(pfile.name, "rb") as fhandle:
+        fhandle.seek(bytepos)
+        head = fhandle.read(24)
+    if len(head) != 24:
+        return False
+
+    fname = head[4:12].decode("ascii", errors="replace").replace(" ", "")
+    (fnitems,) = struct.unpack(">i", head[12:16])
+    return fname == name and fnitems == nitems
+
+
+def _read_scanindex(idxname):
+    """Read a scan index file, return None if missing or not valid."""
+    try:
+        with open(idxname, "r") as fhandle:
+            index = json.load(fhandle)
+    except (OSError, ValueError):
+        return None
+
+    if not isinstance(index, dict) or index.get("version") != SCANINDEX_VERSION:
+        return None
+
+    return index
+
+
+def _write_scanindex(idxname, index):
+    """Write scan index file; failure to do so (e.g. read-only folder) is not fatal."""
+    tmpname = idxname + ".tmp{}".format(os.getpid())
+    try:
+        with open(tmpname, "w") as fhandle:
+            json.dump(index, fhandle)
+        os.replace(tmpname, idxname)
+    except OSError as err:
+        logger.warning("Cannot write scan index %s: %s", idxname, err)
+        if os.path.exists(tmpname):
+            os.remove(tmpname)
+
+
 def _scan_roff_keywords(pfile, maxkeys=100000, dataframe=False):
 
     ultramax = int(1000000 / 9)  # cf *swig_bnd_char_1m in cxtgeo.i
@@ -9,8 +9,23 @@ xtg = xtgeo.common.XTGeoDialog()
 logger = xtg.functionlogger(__name__)
 
 
-def eclbin_record(gfile, kwname, kwlen, kwtype, kwbyte):
-    """Read ecl binary record."""
+def eclbin_record(gfile, kwname, kwlen, kwtype, kwbyte, todouble=False):
+    """Read ecl binary record.
+
+    If todouble is True, REAL records are returned as float64, widened directly
+    while reading.
+    """
+    if todouble and kwtype in ("REAL", "DOUB"):
+        kwntype = 2 if kwtype == "REAL" else 3
+        npdbl = np.zeros((kwlen), dtype=np.float64)
+        nread = _cxtgeo.grd3d_read_eclrecord_dbl(
+            gfile.get_cfhandle(), int(kwbyte), kwntype, npdbl
+        )
+        gfile.cfclose()
+        if nread != kwlen:
+            raise RuntimeError(f"Could not read record {kwname} (status {nread})")
+        return npdbl
+
     ilen = flen = dlen = 1
 
     if kwtype == "INTE":
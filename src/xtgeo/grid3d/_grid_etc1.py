@@ -1,8 +1,9 @@
 """Private module, Grid ETC 1 methods, info/modify/report."""
 
+import sys
 from copy import deepcopy
 from math import atan2, degrees
-from collections import OrderedDict
+from collections import Counter, OrderedDict
 
 import numpy as np
 import numpy.ma as ma
@@ -15,13 +16,18 @@ from xtgeo.common.calc import find_flip
 from xtgeo.xyz.polygons import Polygons
 from . import _gridprop_lowlevel
 from .grid_property import GridProperty
-from ._grid3d_fence import _update_tmpvars
+from ._grid3d_fence import _update_cellindex
+from . import _grid_geomcache
 
 xtg = XTGeoDialog()
 
 
 logger = xtg.functionlogger(__name__)
 
+# Number of xtgformat conversions, per direction and calling function. Each conversion
+# copies the full geometry, so these should be rare; see xtgformat_conversions()
+_XTGFORMAT_CONVERSIONS = Counter()
+
 
 # Note that "self" is the grid instance
 
@@ -166,8 +172,6 @@ def _create_box_v2(
 
 def get_dz(self, name="dZ", flip=True, asmasked=True):
     """Get dZ as property."""
-    self._xtgformat1()
-
     ntot = (self._ncol, self._nrow, self._nlay)
 
     dzv = GridProperty(
@@ -179,26 +183,29 @@ def get_dz(self, name="dZ", flip=True, asmasked=True):
         discrete=False,
     )
 
-    dz = np.zeros(self.ntotal, dtype=np.float64)
-
     nflip = 1
     if not flip:
         nflip = -1
 
-    option = 0
-    if asmasked:
-        option = 1
+    if self._xtgformat == 2:
+        dz = _get_dz_xtgformat2(self, nflip, asmasked)
+    else:
+        dz = np.zeros(self.ntotal, dtype=np.float64)
 
-    _cxtgeo.grd3d_calc_dz(
-        self._ncol,
-        self._nrow,
-        self._nlay,
-        self._zcornsv,
-        self._actnumsv,
-        dz,
-        nflip,
-        option,
-    )
+        option = 0
+        if asmasked:
+            option = 1
+
+        _cxtgeo.grd3d_calc_dz(
+            self._ncol,
+            self._nrow,
+            self._nlay,
+            self._zcornsv,
+            self._actnumsv,
+            dz,
+            nflip,
+            option,
+        )
 
     dzv.values = np.ma.masked_greater(dz, xtgeo.UNDEF_LIMIT)
     # return the property object
@@ -207,10 +214,28 @@ def get_dz(self, name="dZ", flip=True, asmasked=True):
     return dzv
 
 
+def _get_dz_xtgformat2(self, nflip, asmasked):
+    """Get dZ as a 1D numpy array in C order, directly from xtgformat=2 arrays.
+
+    Same as grd3d_calc_dz(), i.e. difference of the average cell top and base,
+    where the average is summed in the same order as in C, so the result is
+    identical to the xtgformat=1 version.
+    """
+    zc = self._zcornsv.astype(np.float64)
+
+    # the 4 corners of each cell; sw, se, nw, ne, cf. grdcp3d_corners()
+    zavg = 0.25 * (
+        zc[:-1, :-1, :, 3] + zc[1:, :-1, :, 2] + zc[:-1, 1:, :, 1] + zc[1:, 1:, :, 0]
+    )
+    dz = (nflip * (zavg[:, :, 1:] - zavg[:, :, :-1])).ravel()
+
+    if asmasked:
+        dz[self._actnumsv.ravel() == 0] = xtgeo.UNDEF
+    return dz
+
+
 def get_dxdy(self, names=("dX", "dY"), asmasked=False):
     """Get dX, dY as properties."""
-    self._xtgformat1()
-
     ntot = self._ncol * self._nrow * self._nlay
 
     dxval = np.zeros(ntot, dtype=np.float64)
@@ -237,7 +262,12 @@ def get_dxdy(self, names=("dX", "dY"), asmasked=False):
     if asmasked:
         option1 = 1
 
-    _cxtgeo.grd3d_calc_dxdy(
+    if self._xtgformat == 2:
+        calc_dxdy = _cxtgeo.grdcp3d_calc_dxdy
+    else:
+        calc_dxdy = _cxtgeo.grd3d_calc_dxdy
+
+    calc_dxdy(
         self._ncol,
         self._nrow,
         self._nlay,
@@ -257,7 +287,7 @@ def get_dxdy(self, names=("dX", "dY"), asmasked=False):
     return dx, dy
 
 
-def get_bulk_volume(self, name="bulkvol", asmasked=True, precision=2):
+def get_bulk_volume(self, name="bulkvol", asmasked=True, precision=2, threads=1):
     """Get cell bulk volume as a GridProperty() instance."""
     self._xtgformat2()
 
@@ -282,8 +312,10 @@ def get_bulk_volume(self, name="bulkvol", asmasked=True, precision=2):
         self._zcornsv,
         self._actnumsv,
         bval,
+        _grid_geomcache.get_corners_or_empty(self),
         precision,
         0 if asmasked else 1,
+        threads,
     )
 
     if asmasked:
@@ -355,102 +387,130 @@ def get_ijk_from_points(
     columnnames=("IX", "JY", "KZ"),
     fmt="int",
     undef=-1,
+    threads=1,
 ):
     """Get I J K indices as a list of tuples or a dataframe.
 
     It is here tried to get fast execution. This requires a preprosessing
-    of the grid to store a onlayer version, and maps with IJ positions
+    of the grid to store a onlayer version, and a spatial index of grid columns
+    (both are made once and reused)
     """
-    self._xtgformat1()
     logger.info("Getting IJK indices from Points...")
 
+    xvalues = points.dataframe[points.xname].values
+    yvalues = points.dataframe[points.yname].values
+    zvalues = points.dataframe[points.zname].values
+
+    iarr, jarr, karr = get_ijk_from_xyz(
+        self,
+        xvalues,
+        yvalues,
+        zvalues,
+        activeonly=activeonly,
+        zerobased=zerobased,
+        threads=threads,
+    )
+
+    ijkarrs = [iarr, jarr, karr]
+    undefmask = iarr == -1
+    if fmt == "float":
+        ijkarrs = [arr.astype("float") for arr in ijkarrs]
+
+    if undef != -1:
+        ijkarrs = [np.where(undefmask, undef, arr) for arr in ijkarrs]
+
+    proplist = OrderedDict()
+    if includepoints:
+        proplist["X_UTME"] = xvalues
+        proplist["Y_UTME"] = yvalues
+        proplist["Z_TVDSS"] = zvalues
+
+    for cname, arr in zip(columnnames, ijkarrs):
+        proplist[cname] = arr
+
+    mydataframe = pd.DataFrame.from_dict(proplist)
+
+    result = mydataframe
+    if not dataframe:
+        result = list(mydataframe.itertuples(index=False, name=None))
+
+    return result
+
+
+def get_ijk_from_xyz(
+    self, xvalues, yvalues, zvalues, activeonly=True, zerobased=False, threads=1
+):
+    """Get I J K indices as three numpy int arrays from X Y Z arrays.
+
+    Points outside the grid (or in inactive cells if activeonly) will get -1.
+    """
+    self._xtgformat2()
+
+    xvalues = np.ascontiguousarray(xvalues, dtype=np.float64)
+    yvalues = np.ascontiguousarray(yvalues, dtype=np.float64)
+    zvalues = np.ascontiguousarray(zvalues, dtype=np.float64)
+
+    if not xvalues.size == yvalues.size == zvalues.size:
+        raise ValueError("The X Y Z input arrays must have equal length")
+
     actnumoption = 1
     if not activeonly:
         actnumoption = 0
 
-    _update_tmpvars(self, force=True)
-
-    arrsize = points.dataframe[points.xname].values.size
-
-    useflip = 1
-    if self.ijk_handedness == "left":
-        useflip = -1
-
-    logger.info("Grid FLIP for C code is %s", useflip)
-
-    logger.info("Running C routine...")
-    _, iarr, jarr, karr = _cxtgeo.grd3d_points_ijk_cells(
-        points.dataframe[points.xname].values,
-        points.dataframe[points.yname].values,
-        points.dataframe[points.zname].values,
-        self._tmp["topd"].ncol,
-        self._tmp["topd"].nrow,
-        self._tmp["topd"].xori,
-        self._tmp["topd"].yori,
-        self._tmp["topd"].xinc,
-        self._tmp["topd"].yinc,
-        self._tmp["topd"].rotation,
-        self._tmp["topd"].yflip,
-        self._tmp["topi_carr"],
-        self._tmp["topj_carr"],
-        self._tmp["basi_carr"],
-        self._tmp["basj_carr"],
+    _update_cellindex(self)
+    cindex = self._tmp["cellindex"]
+
+    arrsize = xvalues.size
+
+    logger.info("Running C routine using %s thread(s)...", threads)
+    ier, iarr, jarr, karr = _cxtgeo.grdcp3d_points_ijk_cells(
+        xvalues,
+        yvalues,
+        zvalues,
         self.ncol,
         self.nrow,
         self.nlay,
         self._coordsv,
         self._zcornsv,
         self._actnumsv,
-        self._tmp["onegrid"]._zcornsv,
+        _grid_geomcache.get_corners_or_empty(self),
+        cindex["colbox"],
+        cindex["binstart"],
+        cindex["bincells"],
+        cindex["xmin"],
+        cindex["ymin"],
+        cindex["xbin"],
+        cindex["ybin"],
+        cindex["nbx"],
+        cindex["nby"],
         actnumoption,
         arrsize,
         arrsize,
         arrsize,
+        threads,
     )
+    if ier != 0:
+        raise RuntimeError("Error code {} from C routine getting IJK".format(ier))
     logger.info("Running C routine... DONE")
 
+    undefmask = iarr == xtgeo.UNDEF_INT
+
     if zerobased:
         # zero based cell indexing
         iarr -= 1
         jarr -= 1
         karr -= 1
 
-    proplist = OrderedDict()
-    if includepoints:
-        proplist["X_UTME"] = points.dataframe[points.xname].values
-        proplist["Y_UTME"] = points.dataframe[points.yname].values
-        proplist["Z_TVDSS"] = points.dataframe[points.zname].values
-
-    proplist[columnnames[0]] = iarr
-    proplist[columnnames[1]] = jarr
-    proplist[columnnames[2]] = karr
+    for arr in (iarr, jarr, karr):
+        arr[undefmask] = -1
 
-    mydataframe = pd.DataFrame.from_dict(proplist)
-    mydataframe.replace(xtgeo.UNDEF_INT, -1, inplace=True)
-
-    if fmt == "float":
-        mydataframe[columnnames[0]] = mydataframe[columnnames[0]].astype("float")
-        mydataframe[columnnames[1]] = mydataframe[columnnames[1]].astype("float")
-        mydataframe[columnnames[2]] = mydataframe[columnnames[2]].astype("float")
-
-    if undef != -1:
-        mydataframe[columnnames[0]].replace(-1, undef, inplace=True)
-        mydataframe[columnnames[1]].replace(-1, undef, inplace=True)
-        mydataframe[columnnames[2]].replace(-1, undef, inplace=True)
-
-    result = mydataframe
-    if not dataframe:
-        result = list(mydataframe.itertuples(index=False, name=None))
-
-    return result
+    return iarr, jarr, karr
 
 
 def get_xyz(self, names=("X_UTME", "Y_UTMN", "Z_TVDSS"), asmasked=True):
     """Get X Y Z as properties."""
     # TODO: May be issues with asmasked vs activeonly here?
 
-    self._xtgformat1()
-
     xv = np.zeros(self.ntotal, dtype=np.float64)
     yv = np.zeros(self.ntotal, dtype=np.float64)
     zv = np.zeros(self.ntotal, dtype=np.float64)
@@ -459,18 +519,36 @@ def get_xyz(self, names=("X_UTME", "Y_UTMN", "Z_TVDSS"), asmasked=True):
     if asmasked:
         option = 1
 
-    _cxtgeo.grd3d_calc_xyz(
-        self._ncol,
-        self._nrow,
-        self._nlay,
-        self._coordsv,
-        self._zcornsv,
-        self._actnumsv,
-        xv,
-        yv,
-        zv,
-        option,
-    )
+    # the cache is made for the current xtgformat, hence no conversion is needed
+    cache = _grid_geomcache.get_geometry_cache(self)
+    if cache is not None:
+        xv[:] = cache["centroids"][:, 0]
+        yv[:] = cache["centroids"][:, 1]
+        zv[:] = cache["centroids"][:, 2]
+        if asmasked:
+            # centroids are in C order, while actnum is in F order for xtgformat=1
+            actnum = self._actnumsv.ravel()
+            if self._xtgformat == 1:
+                actnum = self._actnumsv.reshape(self._nlay, self._nrow, self._ncol)
+                actnum = actnum.transpose(2, 1, 0).ravel()
+            inactive = actnum == 0
+            xv[inactive] = xtgeo.UNDEF
+            yv[inactive] = xtgeo.UNDEF
+            zv[inactive] = xtgeo.UNDEF
+    else:
+        self._xtgformat1()
+        _cxtgeo.grd3d_calc_xyz(
+            self._ncol,
+            self._nrow,
+            self._nlay,
+            self._coordsv,
+            self._zcornsv,
+            self._actnumsv,
+            xv,
+            yv,
+            zv,
+            option,
+        )
 
     xv = np.ma.masked_greater(xv, xtgeo.UNDEF_LIMIT)
     yv = np.ma.masked_greater(yv, xtgeo.UNDEF_LIMIT)
@@ -1004,6 +1082,7 @@ def copy(self):
         other._filesrc = self._filesrc
 
     other._xtgformat = self._xtgformat
+    other._geometry_cache = self._geometry_cache
 
     return other
 
@@ -1127,10 +1206,16 @@ def reduce_to_one_layer(self):
         1
 
     """
-    # need new pointers in C (not for coord)
-    # Note this could probably be done with pure numpy operations
-    self._xtgformat1()
+    if self._xtgformat == 2:
+        # the top of the first and the base of the last layer, all cells active
+        self._nlay = 1
+        self._zcornsv = self._zcornsv[:, :, [0, -1], :].copy()
+        self._actnumsv = np.ones((self._ncol, self._nrow, 1), dtype=np.int32)
+        self._props = None
+        self._subgrids = None
+        return
 
+    # need new pointers in C (not for coord)
     ptr_new_num_act = _cxtgeo.new_intpointer()
 
     nnum = (1 + 1) * 4
@@ -1336,12 +1421,45 @@ def estimate_flip(self):
     return flipvalue
 
 
+def _count_conversion(direction):
+    """Count (and log) a xtgformat conversion, with the function that requested it."""
+    frame = sys._getframe(1)  # pylint: disable=protected-access
+    while frame is not None and (
+        frame.f_code.co_name.startswith("_convert_xtgformat")
+        or frame.f_code.co_name in ("_xtgformat1", "_xtgformat2")
+    ):
+        frame = frame.f_back
+    caller = frame.f_code.co_name if frame is not None else "unknown"
+
+    _XTGFORMAT_CONVERSIONS[(direction, caller)] += 1
+    logger.info(
+        "Conversion of xtgformat %s requested by %s (%s times)",
+        direction,
+        caller,
+        _XTGFORMAT_CONVERSIONS[(direction, caller)],
+    )
+
+
+def xtgformat_conversions(reset=False):
+    """Return the number of xtgformat conversions as a dict, per direction and caller.
+
+    The result has the form {"1to2": {"get_bulk_volume": 2, ...}, "2to1": {...}}.
+    """
+    result = {"1to2": {}, "2to1": {}}
+    for (direction, caller), count in _XTGFORMAT_CONVERSIONS.items():
+        result[direction][caller] = count
+    if reset:
+        _XTGFORMAT_CONVERSIONS.clear()
+    return result
+
+
 def _convert_xtgformat2to1(self):
     """Convert arrays from new structure xtgformat=2 to legacy xtgformat=1."""
     if self._xtgformat == 1:
         logger.info("No conversion, format is already xtgformat == 1 or unset")
         return
 
+    _count_conversion("2to1")
     logger.info("Convert grid from new xtgformat to legacy format...")
 
     newcoordsv = np.zeros(((self._ncol + 1) * (self._nrow + 1) * 6), dtype=np.float64)
@@ -1376,6 +1494,7 @@ def _convert_xtgformat1to2(self):
         logger.info("No conversion, format is already xtgformat == 2 or unset")
         return
 
+    _count_conversion("1to2")
     logger.info("Convert grid from legacy xtgformat to new format...")
 
     newcoordsv = np.zeros((self._ncol + 1, self._nrow + 1, 6), dtype=np.float64)
@@ -1436,6 +1555,7 @@ def get_gridquality_properties(self):
         self._zcornsv,
         self._actnumsv,
         fresults,
+        _grid_geomcache.get_corners_or_empty(self),
     )
 
     grdprops = xtgeo.GridProperties()
@@ -0,0 +1,149 @@
+"""Private module, a per cell geometry cache for the Grid.
+
+The cache holds, per cell and in C order (i, j, k with k fastest):
+
+* corners: the 24 corner coordinates (8 corners * XYZ), as from grd3d_corners()
+  (xtgformat=1) or grdcp3d_corners() (xtgformat=2)
+* aabb: the axis aligned bounding box, as xmin, xmax, ymin, ymax, zmin, zmax
+* centroids: the cell midpoint X Y Z, as from grd3d_midpoint()
+
+Each cell block is contiguous, so the C routines can use a pointer into the corners
+array directly instead of deriving the corners from COORD and ZCORN for every query.
+
+The cache is stored as self._tmp["geomcache"], together with a signature of the
+geometry it was made for. As for the other self._tmp entries, the Grid methods
+that change the geometry reset self._tmp, which removes the cache. In addition,
+the signature holds the format, the dimensions, the identity of the geometry
+arrays and a checksum of a sample of their values, so that a change of format,
+replaced arrays and (most) in-place edits of the arrays are detected here, and the
+cache is rebuilt. The sample is small, so the check is cheap for each lookup.
+"""
+import numpy as np
+
+import xtgeo
+import xtgeo.cxtgeo._cxtgeo as _cxtgeo
+
+xtg = xtgeo.common.XTGeoDialog()
+logger = xtg.functionlogger(__name__)
+
+# number of float64 values per cell; corners, aabb and centroid
+NVALUES_PER_CELL = 24 + 6 + 3
+
+# in "auto" mode, the cache is only made if the memory use is below this limit
+AUTO_LIMIT_NBYTES = 100 * 1024 * 1024
+
+
+def estimate_nbytes(self):
+    """Estimated memory use of the geometry cache, in bytes."""
+    return self.ntotal * NVALUES_PER_CELL * 8
+
+
+# number of values per geometry array in the sample for the signature checksum
+SIGNATURE_NSAMPLE = 4096
+
+
+def _sample_checksum(arr):
+    """Checksum of evenly spaced values in an array (including the first and last)."""
+    flat = np.ravel(arr)
+    if flat.size == 0:
+        return 0
+    step = max(1, flat.size // SIGNATURE_NSAMPLE)
+    sample = np.append(flat[::step], flat[-1])
+    return hash(sample.tobytes())
+
+
+def _signature(self):
+    """The format, dimensions and a cheap identity of the geometry arrays."""
+    arrays = (self._coordsv, self._zcornsv, self._actnumsv)
+    return (
+        self._xtgformat,
+        self.dimensions,
+        tuple(id(arr) for arr in arrays),
+        tuple(_sample_checksum(arr) for arr in arrays),
+    )
+
+
+def is_enabled(self):
+    """Return True if the cache mode of the grid allows a geometry cache."""
+    mode = self._geometry_cache
+    if mode == "auto":
+        return estimate_nbytes(self) <= AUTO_LIMIT_NBYTES
+    return bool(mode)
+
+
+def get_geometry_cache(self):
+    """Return the geometry cache as a dict, or None if not enabled for this grid.
+
+    The cache is made for the current xtgformat of the grid, so the client must
+    convert the grid to the wanted format first.
+    """
+    if not is_enabled(self):
+        self._tmp.pop("geomcache", None)
+        return None
+
+    signature = _signature(self)
+    cache = self._tmp.get("geomcache")
+    if cache is not None and cache["signature"] == signature:
+        logger.info("Re-use existing geometry cache")
+        return cache
+
+    logger.info("Make a geometry cache, %s bytes...", estimate_nbytes(self))
+    ntotal = self.ntotal
+    corners = np.zeros(24 * ntotal, dtype=np.float64)
+    aabb = np.zeros(6 * ntotal, dtype=np.float64)
+    centroids = np.zeros(3 * ntotal, dtype=np.float64)
+
+    if self._xtgformat == 1:
+        ier = _cxtgeo.grd3d_geometry_cache(
+            self._ncol,
+            self._nrow,
+            self._nlay,
+            self._coordsv,
+            self._zcornsv,
+            corners,
+            aabb,
+            centroids,
+            0,
+        )
+    else:
+        ier = _cxtgeo.grdcp3d_geometry_cache(
+            self._ncol,
+            self._nrow,
+            self._nlay,
+            self._coordsv,
+            self._zcornsv,
+            corners,
+            aabb,
+            centroids,
+            0,
+        )
+    if ier != 0:
+        raise RuntimeError(
+            "Error code {} from C routine making geometry cache".format(ier)
+        )
+
+    cache = {
+        "signature": signature,
+        "corners": corners,
+        "aabb": aabb.reshape(ntotal, 6),
+        "centroids": centroids.reshape(ntotal, 3),
+    }
+    self._tmp["geomcache"] = cache
+    logger.info("Make a geometry cache... DONE")
+    return cache
+
+
+def get_corners_or_empty(self):
+    """Return the cached corners array, or an empty array (C computes on the fly)."""
+    cache = get_geometry_cache(self)
+    if cache is None:
+        return np.zeros(0, dtype=np.float64)
+    return cache["corners"]
+
+
+def get_nbytes(self):
+    """Return the memory in use by the geometry cache in bytes, 0 if none."""
+    cache = self._tmp.get("geomcache")
+    if cache is None:
+        return 0
+    return sum(cache[key].nbytes for key in ("corners", "aabb", "centroids"))
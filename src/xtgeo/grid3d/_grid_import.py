@@ -21,6 +21,7 @@ def from_file(
     initprops=None,
     restartprops=None,
     restartdates=None,
+    mmap=False,
 ):  # pylint: disable=too-many-branches
     """Import grid geometry from file, and makes an instance of this class."""
     if not isinstance(gfile, xtgeo._XTGeoFile):
@@ -41,6 +42,7 @@ def from_file(
             "eclipserun",
             "guess",
             "xtgf",
+            "xtgcpgeom",
         ]
     )
     if fformat not in fflist:
@@ -87,8 +89,8 @@ def from_file(
         _grid_import_ecl.import_ecl_grdecl(self, gfile)
     elif fformat == "bgrdecl":
         _grid_import_ecl.import_ecl_bgrdecl(self, gfile)
-    elif fformat == "xtgf":
-        self.from_xtgf(gfile)
+    elif fformat in ("xtgf", "xtgcpgeom"):
+        self.from_xtgf(gfile, mmap=mmap)
     else:
         raise ValueError("Invalid file format")
 
@@ -2,9 +2,6 @@
 
 """Grid import functions for Eclipse, new approach (i.e. version 2)."""
 
-import re
-import os
-from tempfile import mkstemp
 import numpy as np
 
 import xtgeo
@@ -149,40 +146,24 @@ def import_ecl_run(self, groot, initprops=None, restartprops=None, restartdates=
 
 # ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 # Import eclipse input .GRDECL
-# Uses a tmp file so not very efficient
+# Parsed directly from file in C, in one pass
 # ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 def import_ecl_grdecl(self, gfile):
-    """Import grdecl format."""
-    # make a temporary file
-    fds, tmpfile = mkstemp(prefix="tmpxtgeo")
-    os.close(fds)
+    """Import grdecl format.
 
-    with open(gfile.name) as oldfile, open(tmpfile, "w") as newfile:
-        for line in oldfile:
-            if not (re.search(r"^--", line) or re.search(r"^\s+$", line)):
-                newfile.write(line)
-
-    newfile.close()
-    oldfile.close()
+    The file is parsed in one pass in C (comments and repeat counts are handled
+    while reading), after SPECGRID is found for allocation.
+    """
+    cfhandle = gfile.get_cfhandle()
 
     # find ncol nrow nz
-    mylist = []
-    found = False
-    with open(tmpfile) as xfile:
-        for line in xfile:
-            if found:
-                logger.info(line)
-                mylist = line.split()
-                break
-            if re.search(r"^SPECGRID", line):
-                found = True
-
-    if not found:
+    ier, ncol, nrow, nlay = _cxtgeo.grd3d_grdecl_specgrid(cfhandle)
+    if ier != 0:
+        gfile.cfclose()
         logger.error("SPECGRID not found. Nothing imported!")
         return
-    xfile.close()
 
-    self._ncol, self._nrow, self._nlay = int(mylist[0]), int(mylist[1]), int(mylist[2])
+    self._ncol, self._nrow, self._nlay = ncol, nrow, nlay
 
     logger.info("NX NY NZ in grdecl file: %s %s %s", self._ncol, self._nrow, self._nlay)
 
@@ -196,9 +177,7 @@ def import_ecl_grdecl(self, gfile):
 
     ptr_num_act = _cxtgeo.new_intpointer()
 
-    cfhandle = gfile.get_cfhandle()
-
-    _cxtgeo.grd3d_import_grdecl(
+    ier = _cxtgeo.grd3d_import_grdecl(
         cfhandle,
         self._ncol,
         self._nrow,
@@ -209,9 +188,10 @@ def import_ecl_grdecl(self, gfile):
         ptr_num_act,
     )
 
-    # close and remove tmpfile
     gfile.cfclose()
-    os.remove(tmpfile)
+
+    if ier != 0:
+        raise RuntimeError("Error importing GRDECL file {}".format(gfile.name))
 
     nact = _cxtgeo.intpointer_value(ptr_num_act)
 
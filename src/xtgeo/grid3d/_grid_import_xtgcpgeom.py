@@ -19,7 +19,11 @@ logger = xtg.functionlogger(__name__)
 def import_xtgcpgeom(
     self, mfile, mmap
 ):  # pylint: disable=too-many-locals, too-many-statements
-    """Using pure python for experimental grid geometry import."""
+    """Using pure python for experimental grid geometry import.
+
+    If mmap is True, and the arrays in file have the native subformat (844), the
+    geometry arrays will be copy-on-write views over the file (zero copy).
+    """
     #
     offset = 36
     with open(mfile.file, "rb") as fhandle:
@@ -92,11 +96,16 @@ def import_xtgcpgeom(
             sca = opt["zscale"]
             coordsv[2::3] = np.where(shi != 0, coordsv[2::3] + shi, coordsv[2::3])
             coordsv[2::3] = np.where(sca != 1, coordsv[2::3] * sca, coordsv[2::3])
-            zcornsv = (zcornsv + shi) * sca
-
-    self._coordsv = coordsv.reshape((nncol, nnrow, 6)).astype(np.float64)
-    self._zcornsv = zcornsv.reshape((nncol, nnrow, nnlay, 4)).astype(np.float32)
-    self._actnumsv = actnumsv.reshape((ncol, nrow, nlay)).astype(np.int32)
+            if shi != 0 or sca != 1:
+                # keep zcornsv as is (e.g. memory mapped) if no actual change
+                zcornsv = (zcornsv + shi) * sca
+
+    # astype() with copy=False keeps the memory mapped views for native subformat
+    self._coordsv = coordsv.reshape((nncol, nnrow, 6)).astype(np.float64, copy=False)
+    self._zcornsv = zcornsv.reshape((nncol, nnrow, nnlay, 4)).astype(
+        np.float32, copy=False
+    )
+    self._actnumsv = actnumsv.reshape((ncol, nrow, nlay)).astype(np.int32, copy=False)
 
     reqattrs = xtgeo.MetaDataCPGeometry.REQUIRED
 
@@ -96,12 +96,15 @@ def _rarraykwquery(gfile, kws, name, swap, ncol, nrow, nlay):
     inumpy = np.zeros(ncol * nrow * nlay, dtype=np.int32)
     fnumpy = np.zeros(ncol * nrow * nlay, dtype=np.float32)
 
-    _cxtgeo.grd3d_imp_roffbin_arr(
+    status = _cxtgeo.grd3d_imp_roffbin_arr(
         gfile.get_cfhandle(), swap, ncol, nrow, nlay, bytepos, dtype, fnumpy, inumpy
     )
 
     gfile.cfclose()
 
+    if status != 0:
+        raise RuntimeError("Error reading <{}> from roff file".format(name))
+
     if dtype == 1:
         vals = inumpy
         vals = ma.masked_greater(vals, xtgeo.UNDEF_INT_LIMIT)
@@ -190,23 +193,27 @@ def _rkwxvec(gfile, kws, name, swap, strict=True):
 
     if dtype == 1:
         xvec = _cxtgeo.new_intarray(reclen)
-        _cxtgeo.grd3d_imp_roffbin_ivec(cfhandle, swap, bytepos, xvec, reclen)
+        status = _cxtgeo.grd3d_imp_roffbin_ivec(cfhandle, swap, bytepos, xvec, reclen)
 
     elif dtype == 2:
         xvec = _cxtgeo.new_floatarray(reclen)
-        _cxtgeo.grd3d_imp_roffbin_fvec(cfhandle, swap, bytepos, xvec, reclen)
+        status = _cxtgeo.grd3d_imp_roffbin_fvec(cfhandle, swap, bytepos, xvec, reclen)
 
     elif dtype >= 4:
         xvec = _cxtgeo.new_intarray(reclen)  # convert char/byte/bool to int
-        _cxtgeo.grd3d_imp_roffbin_bvec(cfhandle, swap, bytepos, xvec, reclen)
+        status = _cxtgeo.grd3d_imp_roffbin_bvec(cfhandle, swap, bytepos, xvec, reclen)
 
     else:
         gfile.cfclose()
         raise ValueError("Unhandled dtype: {}".format(dtype))
 
+    gfile.cfclose()
+
+    if status != 0:
+        raise RuntimeError("Error reading <{}> from roff file".format(name))
+
     logger.info("Reading %s from file done", name)
 
-    gfile.cfclose()
     return xvec
 
 
@@ -246,21 +253,30 @@ def _rkwxvec_prop(self, gfile, kws, name, swap, strict=True):
     proparr = None
     if dtype == 1:
         proparr = np.zeros((self._ncol, self._nrow, self._nlay), dtype=np.int32)
-        _cxtgeo.grdcp3d_imp_roffbin_prop_ivec(
+        status = _cxtgeo.grdcp3d_imp_roffbin_prop_ivec(
             cfhandle, swap, bytepos, self._ncol, self._nrow, self._nlay, proparr
         )
-    elif dtype in (4, 5):
+    elif dtype == 2:
+        proparr = np.zeros((self._ncol, self._nrow, self._nlay), dtype=np.float32)
+        status = _cxtgeo.grdcp3d_imp_roffbin_prop_fvec(
+            cfhandle, swap, bytepos, self._ncol, self._nrow, self._nlay, proparr
+        )
+    elif dtype in (4, 5, 6):
         proparr = np.zeros((self._ncol, self._nrow, self._nlay), dtype=np.int32)
-        _cxtgeo.grdcp3d_imp_roffbin_prop_bvec(
+        status = _cxtgeo.grdcp3d_imp_roffbin_prop_bvec(
             cfhandle, swap, bytepos, self._ncol, self._nrow, self._nlay, proparr
         )
     else:
         gfile.cfclose()
         raise ValueError("Unhandled dtype: {}".format(dtype))
 
+    gfile.cfclose()
+
+    if status != 0:
+        raise RuntimeError("Error reading <{}> from roff file".format(name))
+
     logger.info("Reading %s from file done", name)
 
-    gfile.cfclose()
     return proparr
 
 
@@ -100,6 +100,7 @@ def gridproperty_fromfile(self, pfile, **kwargs):
         gridlink=kwargs.get("gridlink"),
         date=self._date,
         fracture=self._fracture,
+        mmap=kwargs.get("mmap", False),
     )
 
 
@@ -24,6 +24,7 @@ def from_file(
     _roffapiv=1,
     ijrange=None,
     zerobased=False,
+    mmap=False,
 ):  # _roffapiv for devel.
     """Import grid property from file, and makes an instance of this."""
     # it may be that pfile already is an open file; hence a filehandle
@@ -70,7 +71,7 @@ def from_file(
         import_bgrdecl_prop(self, pfile, name=name, grid=grid)
 
     elif fformat.lower() == "xtgcpprop":
-        import_xtgcpprop(self, pfile, ijrange=ijrange, zerobased=zerobased)
+        import_xtgcpprop(self, pfile, ijrange=ijrange, zerobased=zerobased, mmap=mmap)
 
     else:
         logger.warning("Invalid file format")
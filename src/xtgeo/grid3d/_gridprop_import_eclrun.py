@@ -564,7 +564,8 @@ def _import_eclbinary_prop(
 ):
     """Import the actual record"""
 
-    values = _eclbin.eclbin_record(pfile, kwname, kwlen, kwtype, kwbyte)
+    # REAL arrays are read directly as float64
+    values = _eclbin.eclbin_record(pfile, kwname, kwlen, kwtype, kwbyte, todouble=True)
 
     self._isdiscrete = False
     use_undef = xtgeo.UNDEF
@@ -580,9 +581,6 @@ def _import_eclbinary_prop(
         codes = {key: str(val) for key, val in codes.items()}  # val: strings
         self.codes = codes
 
-    else:
-        values = values.astype(np.float64)  # cast REAL (float32) to float64
-
     # arrays from Eclipse INIT or UNRST are usually for inactive values only.
     # Use the ACTNUM index array for vectorized numpy remapping (need both C
     # and F order)
@@ -640,7 +638,7 @@ def _import_eclbinary_dualporo(
     # A lot of code duplication here, as this is under testing
     #
 
-    values = _eclbin.eclbin_record(pfile, kwname, kwlen, kwtype, kwbyte)
+    values = _eclbin.eclbin_record(pfile, kwname, kwlen, kwtype, kwbyte, todouble=True)
 
     # arrays from Eclipse INIT or UNRST are usually for inactive values only.
     # Use the ACTNUM index array for vectorized numpy remapping (need both C
@@ -671,9 +669,6 @@ def _import_eclbinary_dualporo(
         codes = {key: str(val) for key, val in codes.items()}  # val: strings
         self.codes = codes
 
-    else:
-        values = values.astype(np.float64)  # cast REAL (float32) to float64
-
     allvalues = (
         np.zeros((self._ncol * self._nrow * self._nlay), dtype=values.dtype)
         + self.undef
@@ -1,10 +1,5 @@
 """Importing grid props from GRDECL, ascii or binary"""
 
-
-import re
-import os
-from tempfile import mkstemp
-
 import numpy as np
 import numpy.ma as ma
 
@@ -96,20 +91,10 @@ def import_grdecl_prop(self, pfile, name="unknown", grid=None):
     self._filesrc = pfile
     actnumv = grid.get_actnum().values
 
-    # This requires that the Python part clean up comments
-    # etc, and make a tmp file.
-    fds, tmpfile = mkstemp(prefix="tmpxtgeo")
-    os.close(fds)
-
-    with open(pfile.name, "r") as oldfile, open(tmpfile, "w") as newfile:
-        for line in oldfile:
-            if not (re.search(r"^--", line) or re.search(r"^\s+$", line)):
-                newfile.write(line)
-
-    # now read the property
+    # comments, repeat counts etc are handled while reading in C
     nlen = self._ncol * self._nrow * self._nlay
     ier, values = _cxtgeo.grd3d_import_grdecl_prop(
-        tmpfile,
+        pfile.name,
         self._ncol,
         self._nrow,
         self._nlay,
@@ -118,8 +103,6 @@ def import_grdecl_prop(self, pfile, name="unknown", grid=None):
         0,
     )
 
-    os.remove(tmpfile)
-
     if ier != 0:
         raise xtgeo.KeywordNotFoundError(
             "Cannot import {}, not present in file {}?".format(name, pfile)
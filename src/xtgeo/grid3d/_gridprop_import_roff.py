@@ -66,6 +66,8 @@ def _import_roff_v1(self, pfile, name):
         msg = "Cannot find property name {}".format(name)
         logger.warning(msg)
         raise SystemExit("Error from ROFF import")
+    if ier == -2:
+        raise RuntimeError("Cannot read property {} from ROFF file".format(name))
 
     self._ncol = _cxtgeo.intpointer_value(ptr_ncol)
     self._nrow = _cxtgeo.intpointer_value(ptr_nrow)
@@ -118,6 +120,9 @@ def _import_roff_v1(self, pfile, name):
         0,
     )
 
+    if ier == -2:
+        raise RuntimeError("Cannot read property {} from ROFF file".format(name))
+
     if self._isdiscrete:
         _gridprop_lowlevel.update_values_from_carray(
             self, ptr_ival_v, np.int32, delete=True
@@ -14,7 +14,7 @@ xtg = xtgeo.common.XTGeoDialog()
 logger = xtg.functionlogger(__name__)
 
 
-def import_xtgcpprop(self, mfile, ijrange=None, zerobased=False):
+def import_xtgcpprop(self, mfile, ijrange=None, zerobased=False, mmap=False):
     """Using pure python for experimental xtgcpprop import.
 
     Args:
@@ -23,6 +23,8 @@ def import_xtgcpprop(self, mfile, ijrange=None, zerobased=False):
         ijrange (list-like): List or tuple with 4 members [i_from, i_to, j_from, j_to]
             where cell indices are zero based (starts with 0)
         zerobased (bool): If ijrange basis is zero or one.
+        mmap (bool): If True, and no ijrange, the values will be a copy-on-write
+            memory mapped view over the file (zero copy).
 
     """
     #
@@ -52,7 +54,9 @@ def import_xtgcpprop(self, mfile, ijrange=None, zerobased=False):
         )
 
     else:
-        vals = xsys.npfromfile(mfile.file, dtype=dtype, count=narr, offset=offset)
+        vals = xsys.npfromfile(
+            mfile.file, dtype=dtype, count=narr, offset=offset, mmap=mmap
+        )
 
     # read metadata which will be at position offet + nfloat*narr +13
     pos = offset + nbyte * narr + 13
@@ -76,8 +80,9 @@ def import_xtgcpprop(self, mfile, ijrange=None, zerobased=False):
         self._ncol = ncolnew
         self._nrow = nrownew
 
+    # copy=False so that a memory mapped array is kept as data for the masked array
     self._values = np.ma.masked_equal(
-        vals.reshape(self._ncol, self._nrow, self._nlay), self._undef
+        vals.reshape(self._ncol, self._nrow, self._nlay), self._undef, copy=False
     )
 
     self._metadata.required = self
@@ -2,12 +2,16 @@
 """Import/export of grid properties (cf GridProperties class)"""
 
 from copy import deepcopy
+from functools import partial
+
 import xtgeo
 
 from xtgeo.grid3d import _gridprop_import_eclrun
+from xtgeo.grid3d import _gridprop_import_roff
 
 from .grid_property import GridProperty
 from . import _grid3d_utils as utils
+from . import _grid_roff_lowlevel as grl
 
 xtg = xtgeo.XTGeoDialog()
 
@@ -25,10 +29,21 @@ logger = xtg.functionlogger(__name__)
 # raised
 #
 # Note that there are keyword and data checks also in _gridprop_import_eclrun
+#
+# On "lazy" keyword: If True, the properties are made with metadata only, and the
+# values are read first time they are needed, using the keyword list (with byte
+# positions) from the one scan of the file; cf. GridProperty.load_values()
 
 
 def import_ecl_output(
-    self, pfile, names=None, dates=None, grid=None, namestyle=0, strict=(True, False)
+    self,
+    pfile,
+    names=None,
+    dates=None,
+    grid=None,
+    namestyle=0,
+    strict=(True, False),
+    lazy=False,
 ):
 
     strictkeys, strictdates = strict
@@ -43,15 +58,15 @@ def import_ecl_output(
         raise ValueError("Name list cannot be empty (None)")
 
     if dates is None:
-        _import_ecl_output_v2_init(self, pfile, names, grid, strictkeys)
+        _import_ecl_output_v2_init(self, pfile, names, grid, strictkeys, lazy)
 
     else:
         _import_ecl_output_v2_rsta(
-            self, pfile, names, dates, grid, strictkeys, strictdates, namestyle
+            self, pfile, names, dates, grid, strictkeys, strictdates, namestyle, lazy
         )
 
 
-def _import_ecl_output_v2_init(self, pfile, names, grid, strict):
+def _import_ecl_output_v2_init(self, pfile, names, grid, strict, lazy):
     """Import INIT parameters"""
 
     # scan valid keywords
@@ -93,15 +108,18 @@ def _import_ecl_output_v2_init(self, pfile, names, grid, strict):
             continue
 
         prop = GridProperty()
-        # use a private GridProperty function, since filehandle
-        _gridprop_import_eclrun.import_eclbinary(
-            prop,
-            pfile,
-            name=name,
-            grid=grid,
-            etype=1,
-            _kwlist=kwlist,
-        )
+        if lazy:
+            _set_lazy_eclbinary(prop, pfile, name, grid, 1, None, kwlist)
+        else:
+            # use a private GridProperty function, since filehandle
+            _gridprop_import_eclrun.import_eclbinary(
+                prop,
+                pfile,
+                name=name,
+                grid=grid,
+                etype=1,
+                _kwlist=kwlist,
+            )
 
         self._names.append(name)
         self._props.append(prop)
@@ -112,7 +130,7 @@ def _import_ecl_output_v2_init(self, pfile, names, grid, strict):
 
 
 def _import_ecl_output_v2_rsta(
-    self, pfile, names, dates, grid, strictkeycomb, strictdate, namestyle
+    self, pfile, names, dates, grid, strictkeycomb, strictdate, namestyle, lazy
 ):
     """Import RESTART parameters"""
 
@@ -179,16 +197,19 @@ def _import_ecl_output_v2_rsta(
             sdate = str(date)
             usename = name + "--" + sdate[0:4] + "_" + sdate[4:6] + "_" + sdate[6:8]
 
-        # use a private GridProperty function, since filehandle
-        _gridprop_import_eclrun.import_eclbinary(
-            prop,
-            pfile,
-            name=name,
-            date=date,
-            grid=grid,
-            etype=5,
-            _kwlist=kwlist,
-        )
+        if lazy:
+            _set_lazy_eclbinary(prop, pfile, name, grid, 5, date, kwlist)
+        else:
+            # use a private GridProperty function, since filehandle
+            _gridprop_import_eclrun.import_eclbinary(
+                prop,
+                pfile,
+                name=name,
+                date=date,
+                grid=grid,
+                etype=5,
+                _kwlist=kwlist,
+            )
 
         self._names.append(usename)
         self._props.append(prop)
@@ -200,6 +221,88 @@ def _import_ecl_output_v2_rsta(
     self._nlay = grid.nlay
 
 
+def _set_lazy_eclbinary(prop, pfile, name, grid, etype, date, kwlist):
+    """Set metadata as import_eclbinary would do, and defer reading of values."""
+    prop._ncol = grid.ncol
+    prop._nrow = grid.nrow
+    prop._nlay = grid.nlay
+    prop._dualporo = grid.dualporo
+    prop._dualperm = grid.dualperm
+
+    # the name, cf. _import_eclbinary_prop and _import_eclbinary_dualporo
+    usename = name + "M" if grid.dualporo else name
+    if etype == 5:
+        usename += "_" + str(date)
+        prop._date = date
+    prop._name = usename
+
+    # INTE arrays are discrete; SOIL etc that may be derived are always continuous
+    usedate = str(date) if etype == 5 else None
+    for kwname, kwtype, _, _, kwdate in kwlist.itertuples(index=False, name=None):
+        if kwname == name and (usedate is None or str(kwdate) == usedate):
+            prop._isdiscrete = kwtype == "INTE"
+            break
+
+    prop._values = None
+    prop._loader = partial(
+        _gridprop_import_eclrun.import_eclbinary,
+        pfile=pfile,
+        name=name,
+        etype=etype,
+        date=date,
+        grid=grid,
+        _kwlist=kwlist,
+    )
+    prop._isloaded = False
+
+
+def import_roff_lazy(pfile, names):
+    """Return a list of lazy loaded properties from a ROFF binary file.
+
+    The file is scanned once for dimensions and data types, while the values are read
+    by the ordinary ROFF import when first needed.
+    """
+    kwords = utils.scan_keywords(pfile, fformat="roff")
+
+    byteswap = grl._rkwquery(pfile, kwords, "filedata!byteswaptest", -1)
+    ncol = grl._rkwquery(pfile, kwords, "dimensions!nX", byteswap)
+    nrow = grl._rkwquery(pfile, kwords, "dimensions!nY", byteswap)
+    nlay = grl._rkwquery(pfile, kwords, "dimensions!nZ", byteswap)
+
+    props = []
+    for name in names:
+        # the data type is given by the parameter!data entry following the name
+        dtype = None
+        namefound = False
+        for items in kwords:
+            if items[0] == "parameter!name!" + name:
+                namefound = True
+            elif namefound and items[0] == "parameter!data":
+                dtype = items[1]
+                break
+
+        if dtype is None:
+            raise xtgeo.KeywordNotFoundError(
+                "Cannot find property <{}> in file {}".format(name, pfile.name)
+            )
+
+        prop = GridProperty()
+        prop._ncol = ncol
+        prop._nrow = nrow
+        prop._nlay = nlay
+        prop._name = name
+        prop._isdiscrete = dtype != "float"
+        prop._filesrc = pfile.name
+        prop._values = None
+        prop._loader = partial(
+            _gridprop_import_roff.import_roff, pfile=pfile, name=name
+        )
+        prop._isloaded = False
+        props.append(prop)
+
+    return props
+
+
 def _process_valid_namesdates(kwlist, grid):
     """Return lists with valid pairs, dates scanned from RESTART"""
     validnamedatepairs = list()
@@ -24,6 +24,7 @@ from . import _grid_refine
 from . import _grid_etc1
 from . import _grid_wellzone
 from . import _grid3d_fence
+from . import _grid_geomcache
 from . import _grid_roxapi
 from . import _gridprop_lowlevel
 
@@ -48,7 +49,12 @@ logger = xtg.functionlogger(__name__)
 
 
 def grid_from_file(
-    gfile, fformat=None, initprops=None, restartprops=None, restartdates=None
+    gfile,
+    fformat=None,
+    initprops=None,
+    restartprops=None,
+    restartdates=None,
+    mmap=False,
 ):
     """Read a grid (cornerpoint) from file and an returns a Grid() instance.
 
@@ -68,6 +74,7 @@ def grid_from_file(
         restartprops=restartprops,
         restartdates=restartdates,
         fformat=fformat,
+        mmap=mmap,
     )
 
     return obj
@@ -161,6 +168,7 @@ class Grid(_Grid3D):
         restartdates: Optional[List[Union[int, str]]] = None,
         ijkrange: Optional[IJKRange] = None,
         zerobased: Optional[bool] = False,
+        mmap: Optional[bool] = False,
     ):
         """Instantating.
 
@@ -175,6 +183,8 @@ class Grid(_Grid3D):
             ijkrange: Tuple of 6 integers defining (imin, imax, jmin, jmax, kmin, kmax)
                 when import from ``hdf`` files. Ranges are implicit at both ends.
             zerobased: Whether `ijkrange` uses 1 (default) or 0 as base.
+            mmap: If True, memory map the geometry arrays when importing the native
+                ``xtgf`` (``xtgcpgeom``) format, see :meth:`from_file`.
 
         Example::
 
@@ -231,6 +241,10 @@ class Grid(_Grid3D):
         # See _grid3d_fence for instance; note! reset this if any kind of grid change!
         self._tmp = {}
 
+        # Mode for the per cell geometry cache ("auto", True or False), see
+        # _grid_geomcache; the cache itself is stored in self._tmp
+        self._geometry_cache = "auto"
+
         if gfile is not None:
             gfile = pathlib.Path(gfile)
             if gfile.suffix == "hdf":
@@ -241,6 +255,7 @@ class Grid(_Grid3D):
                 initprops=initprops,
                 restartprops=restartprops,
                 restartdates=restartdates,
+                mmap=mmap,
             )
         else:
             # make a simple empty box grid (from version 2.13)
@@ -449,6 +464,84 @@ class Grid(_Grid3D):
         """Returns the total number of cells (read only)."""
         return self._ncol * self._nrow * self._nlay
 
+    @property
+    def geometry_cache(self):
+        """Get or set the mode of the per cell geometry cache.
+
+        Some operations (e.g. bulk volume, grid quality and XYZ to IJK lookups)
+        need the corner coordinates of every cell. These may be computed once and
+        kept in a cache (24 corner coordinates, a bounding box and a midpoint per
+        cell, i.e. 264 bytes per cell). The cache is made when first needed, and is
+        rebuilt automatically if the grid geometry changes.
+
+        Valid modes are:
+
+        * ``"auto"`` (default): use a cache if it needs less than 100 MB
+        * ``True``: always use a cache, also for large grids
+        * ``False``: never use a cache; corners are computed on the fly
+
+        Example::
+
+            grd = xtgeo.grid_from_file("large.roff")
+            print(grd.geometry_cache_nbytes)  # estimated memory use
+            grd.geometry_cache = True
+
+        .. versionadded:: 2.14
+        """
+        return self._geometry_cache
+
+    @geometry_cache.setter
+    def geometry_cache(self, mode):
+        if mode not in ("auto", True, False):
+            raise ValueError(
+                "The geometry_cache mode must be 'auto', True or False, not {}".format(
+                    mode
+                )
+            )
+        self._geometry_cache = mode
+        if not _grid_geomcache.is_enabled(self):
+            self._tmp.pop("geomcache", None)
+
+    @property
+    def geometry_cache_nbytes(self):
+        """Memory in bytes needed for the per cell geometry cache (read only).
+
+        This is the estimated size regardless of whether the cache is made yet;
+        see :attr:`geometry_cache`.
+
+        .. versionadded:: 2.14
+        """
+        return _grid_geomcache.estimate_nbytes(self)
+
+    @staticmethod
+    def xtgformat_conversions(reset=False):
+        """Return how often the internal geometry layout has been converted.
+
+        Internally a grid may be stored in one of two array layouts (the legacy
+        and the current), and some operations still need the legacy layout. A
+        conversion copies the full grid geometry, so a workflow which alternates
+        between such operations may spend much time here. This reports the number
+        of conversions for all grids in the session, per direction and per the
+        function requesting it, which is useful for profiling. Details are also
+        logged (at info level).
+
+        Args:
+            reset (bool): If True, the counts are set to zero after reporting.
+
+        Returns:
+            A dict on the form ``{"1to2": {"get_bulk_volume": 2}, "2to1": {...}}``
+
+        Example::
+
+            grd = xtgeo.grid_from_file("reek.roff")
+            _ = grd.get_bulk_volume()
+            _ = grd.get_layer_slice(1)
+            print(xtgeo.Grid.xtgformat_conversions())
+
+        .. versionadded:: 2.14
+        """
+        return _grid_etc1.xtgformat_conversions(reset=reset)
+
     @property
     def dualporo(self):
         """Boolean flag for dual porosity scheme (read only)."""
@@ -720,7 +813,13 @@ class Grid(_Grid3D):
         )
 
     def from_file(
-        self, gfile, fformat=None, initprops=None, restartprops=None, restartdates=None
+        self,
+        gfile,
+        fformat=None,
+        initprops=None,
+        restartprops=None,
+        restartdates=None,
+        mmap=False,
     ):
         """Import grid geometry from file, and makes an instance of this class.
 
@@ -731,13 +830,19 @@ class Grid(_Grid3D):
         Arguments:
             gfile (str or Path): File name to be imported. If fformat="eclipse_run"
                 then a fileroot name shall be input here, see example below.
-            fformat (str): File format egrid/roff/grdecl/bgrdecl/eclipserun/xtgcpgeom
-                (None is default and means "guess")
+            fformat (str): File format egrid/roff/grdecl/bgrdecl/eclipserun/xtgf
+                (None is default and means "guess"). The native format "xtgf" may
+                also be given as "xtgcpgeom".
             initprops (str list): Optional, and only applicable for file format
                 "eclipserun". Provide a list the names of the properties here. A
                 special value "all" can be get all properties found in the INIT file
             restartprops (str list): Optional, see initprops
             restartdates (int list): Optional, required if restartprops
+            mmap (bool): Only applicable for the native "xtgf" format. If True, the
+                geometry arrays are memory mapped views over the file instead of
+                being read, which makes import of large grids almost instant and
+                shares the file pages between processes. The views are
+                copy-on-write; modifying the grid will never change the file.
 
         Example::
 
@@ -755,6 +860,8 @@ class Grid(_Grid3D):
 
         Raises:
             OSError: if file is not found etc
+
+        .. versionchanged:: 2.14 Added ``mmap`` key
         """
         gfile = xtgeo._XTGeoFile(gfile, mode="rb")
 
@@ -765,6 +872,7 @@ class Grid(_Grid3D):
             initprops=initprops,
             restartprops=restartprops,
             restartdates=restartdates,
+            mmap=mmap,
         )
         self._tmp = {}
         self._metadata.required = self
@@ -802,7 +910,8 @@ class Grid(_Grid3D):
 
         Args:
             gfile (str): Name of output file
-            mmap (bool): If true, reading with memory mapping is active
+            mmap (bool): If true, reading with memory mapping is active. The
+                geometry arrays will then be copy-on-write views over the file.
 
         Example::
 
@@ -1274,6 +1383,8 @@ class Grid(_Grid3D):
         else:
             self._actnumsv = np.ma.filled(actnum.values, fill_value=0).astype(np.int32)
 
+        self._tmp = {}
+
     def get_dz(self, name="dZ", flip=True, asmasked=True, mask=None):
         """Return the dZ as GridProperty object.
 
@@ -1358,7 +1469,7 @@ class Grid(_Grid3D):
 
         return vol
 
-    def get_bulk_volume(self, name="bulkvol", asmasked=True, precision=2):
+    def get_bulk_volume(self, name="bulkvol", asmasked=True, precision=2, threads=1):
         """Return the geometric cell volume for all cells as a GridProperty object.
 
         This method is currently *experimental*.
@@ -1378,15 +1489,20 @@ class Grid(_Grid3D):
             precision (int): An number indication precision level, where
                 a higher number means increased precision but also increased computing
                 time. Currently 1, 2 (default), 4 are supported.
+            threads (int): Number of threads to use. Default is 1; 0 or a negative
+                number means all available processors. This has only effect if
+                XTGeo is built with OpenMP, and the result is identical to a serial
+                run.
 
         Returns:
             XTGeo GridProperty object
 
         .. versionadded:: 2.13 (as experimental)
+        .. versionchanged:: 2.14 Added ``threads`` key
 
         """
         return _grid_etc1.get_bulk_volume(
-            self, name=name, asmasked=asmasked, precision=precision
+            self, name=name, asmasked=asmasked, precision=precision, threads=threads
         )
 
     def get_indices(self, names=("I", "J", "K")):
@@ -1439,6 +1555,7 @@ class Grid(_Grid3D):
         columnnames=("IX", "JY", "KZ"),
         fmt="int",
         undef=-1,
+        threads=1,
     ):
         """Returns a list/dataframe of cell indices based on a Points() instance.
 
@@ -1454,9 +1571,12 @@ class Grid(_Grid3D):
             columnnames (tuple): Name of columns if dataframe is returned
             fmt (str): Format of IJK arrays (int/float). Default is "int"
             undef (int or float): Value to assign to undefined (outside) entries.
+            threads (int): Number of threads to use, where 0 means all available.
+                Requires that xtgeo is built with OpenMP, otherwise ignored.
 
         .. versionadded:: 2.6
         .. versionchanged:: 2.8 Added keywords `columnnames`, `fmt`, `undef`
+        .. versionchanged:: 2.14 Added keyword `threads`
         """
         ijklist = _grid_etc1.get_ijk_from_points(
             self,
@@ -1468,11 +1588,50 @@ class Grid(_Grid3D):
             columnnames=columnnames,
             fmt=fmt,
             undef=undef,
+            threads=threads,
         )
 
         # return the dataframe or list of tuples
         return ijklist
 
+    def get_ijk_from_xyz(
+        self, xvalues, yvalues, zvalues, activeonly=True, zerobased=False, threads=1
+    ):
+        """Returns cell indices as numpy arrays for X Y Z coordinate arrays.
+
+        This is the fast batch version of :meth:`get_ijk_from_points`, intended for
+        large point sets (e.g. point clouds or many wells in one go). No dataframe
+        is made, and points outside the grid get -1 values.
+
+        Args:
+            xvalues (array-like): X coordinates
+            yvalues (array-like): Y coordinates
+            zvalues (array-like): Z coordinates
+            activeonly (bool): If True, points in inactive cells get -1
+            zerobased (bool): If True, counter start from 0, otherwise 1 (default=1).
+            threads (int): Number of threads to use, where 0 means all available.
+                Requires that xtgeo is built with OpenMP, otherwise ignored.
+
+        Returns:
+            A tuple of three int numpy arrays with I, J and K indices.
+
+        Example::
+
+            grd = xtgeo.Grid("mygrid.roff")
+            iarr, jarr, karr = grd.get_ijk_from_xyz(xarr, yarr, zarr, threads=0)
+
+        .. versionadded:: 2.14
+        """
+        return _grid_etc1.get_ijk_from_xyz(
+            self,
+            xvalues,
+            yvalues,
+            zvalues,
+            activeonly=activeonly,
+            zerobased=zerobased,
+            threads=threads,
+        )
+
     def get_xyz(self, names=("X_UTME", "Y_UTMN", "Z_TVDSS"), asmasked=True, mask=None):
         """Returns 3 xtgeo.grid3d.GridProperty objects for x, y, z coordinates.
 
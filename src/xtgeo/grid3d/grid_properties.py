@@ -357,6 +357,7 @@ class GridProperties(_Grid3D):
         grid=None,
         namestyle=0,
         strict=(True, False),
+        lazy=False,
     ):
         """Import grid properties from file in one go.
 
@@ -381,6 +382,11 @@ class GridProperties(_Grid3D):
                 means that that only valid entries are imported, more or less silently.
                 Saturations keywords SWAT/SOIL/SGAS are not evaluated as they may be
                 derived.
+            lazy (bool): If True, the file is scanned once and the properties will
+                only hold metadata, while values are read (using the scanned byte
+                positions) first time they are accessed. This is much faster if only a
+                few of many properties are used, e.g. from large restart files. Note
+                that errors in reading a keyword will then occur at first access.
 
         Example::
             >>> props = GridProperties()
@@ -394,6 +400,7 @@ class GridProperties(_Grid3D):
             KeywordFoundDateNotFoundError: The keyword but not date found
 
         .. versionadded:: 2.13 Added strict key
+        .. versionadded:: 2.14 Added lazy key
         """
         pfile = xtgeo._XTGeoFile(pfile, mode="rb")
 
@@ -418,9 +425,12 @@ class GridProperties(_Grid3D):
         pfile.check_file(raiseerror=OSError)
 
         if fformat.lower() == "roff":
-            lst = list()
-            for name in names:
-                lst.append(GridProperty(pfile, fformat="roff", name=name))
+            if lazy:
+                lst = _gridprops_io.import_roff_lazy(pfile, names)
+            else:
+                lst = list()
+                for name in names:
+                    lst.append(GridProperty(pfile, fformat="roff", name=name))
             self.append_props(lst)
 
         elif fformat.lower() in ("init", "unrst"):
@@ -432,6 +442,7 @@ class GridProperties(_Grid3D):
                 names=names,
                 namestyle=namestyle,
                 strict=strict,
+                lazy=lazy,
             )
         else:
             raise OSError("Invalid file format")
@@ -496,7 +507,12 @@ class GridProperties(_Grid3D):
 
     @staticmethod
     def scan_keywords(
-        pfile, fformat="xecl", maxkeys=100000, dataframe=False, dates=False
+        pfile,
+        fformat="xecl",
+        maxkeys=100000,
+        dataframe=False,
+        dates=False,
+        scanindex=None,
     ):
         """Quick scan of keywords in Eclipse binary files, or ROFF binary files.
 
@@ -521,10 +537,17 @@ class GridProperties(_Grid3D):
             dataframe (bool): If True, return a Pandas dataframe instead
             dates (bool): if True, the date is the last column (only
                 menaingful for restart files). Default is False.
+            scanindex (bool): For Eclipse files; if True, store the scan result
+                in a sidecar file (<pfile>.xtgidx) that is reused as long as the
+                file is unchanged, and updated incrementally if the file has
+                grown. Default is None, which means that the environment variable
+                XTG_ECL_SCANINDEX decides (off if not set).
 
         Return:
             A list of tuples or dataframe with keyword info
 
+        .. versionchanged:: 2.14 Added ``scanindex`` key
+
         Example::
             >>> props = GridProperties()
             >>> dlist = props.scan_keywords('ECL.UNRST')
@@ -533,7 +556,12 @@ class GridProperties(_Grid3D):
         pfile = xtgeo._XTGeoFile(pfile)
 
         dlist = utils.scan_keywords(
-            pfile, fformat=fformat, maxkeys=maxkeys, dataframe=dataframe, dates=dates
+            pfile,
+            fformat=fformat,
+            maxkeys=maxkeys,
+            dataframe=dataframe,
+            dates=dates,
+            scanindex=scanindex,
         )
 
         return dlist
@@ -212,6 +212,10 @@ class GridProperty(_Grid3D):
         self._roxorigin = False  # true if the object comes from the ROXAPI
         self._roxar_dtype = kwargs.get("roxar_dtype", np.float32)
 
+        # lazy loading: values are read by self._loader when first needed
+        self._isloaded = True  # assume True unless explicitly set
+        self._loader = None
+
         self._values = kwargs.get("values", None)
         self._undef = xtgeo.UNDEF
 
@@ -419,6 +423,8 @@ class GridProperty(_Grid3D):
     @property
     def codes(self):
         """The property codes as a dictionary."""
+        if self._isdiscrete and not self._isloaded:
+            self.load_values()  # codes are made from the values
         return self._codes
 
     @codes.setter
@@ -430,6 +436,28 @@ class GridProperty(_Grid3D):
         """Number of codes if discrete grid property (read only)."""
         return len(self._codes)
 
+    @property
+    def _values(self):
+        """The values array, loaded first time used if lazy (cf. load_values)."""
+        if not self._isloaded:
+            self.load_values()
+        return self._valuesarr
+
+    @_values.setter
+    def _values(self, values):
+        # any assignment replaces a pending lazy load
+        self._valuesarr = values
+        self._isloaded = True
+        self._loader = None
+
+    @property
+    def isloaded(self):
+        """bool: True if values are loaded, False if pending lazy load (read only).
+
+        .. versionadded:: 2.14
+        """
+        return self._isloaded
+
     @property
     def values(self):
         """ Return or set the grid property as a masked 3D numpy array"""
@@ -613,6 +641,7 @@ class GridProperty(_Grid3D):
         _roffapiv=1,
         ijrange=None,
         zerobased=False,
+        mmap=False,
     ):  # _roffapiv for devel.
         """
         Import grid property from file, and makes an instance of this class.
@@ -642,6 +671,9 @@ class GridProperty(_Grid3D):
                 of cells to read. Only applicable for xtgcpprop format.
             zerobased (bool): Input if cells counts are zero- or one-based in
                 ijrange. Only applicable for xtgcpprop format.
+            mmap (bool): If True, the values are a copy-on-write memory mapped view
+                over the file instead of being read. Only applicable for xtgcpprop
+                format when reading the full property (no ijrange).
 
         Examples::
 
@@ -657,6 +689,7 @@ class GridProperty(_Grid3D):
            True if success, otherwise False
 
         .. versionchanged:: 2.8 Added gridlink option, default is True
+        .. versionchanged:: 2.14 Added mmap option
         """
         pfile = xtgeo._XTGeoFile(pfile, mode="rb")
 
@@ -671,6 +704,7 @@ class GridProperty(_Grid3D):
             _roffapiv=_roffapiv,
             ijrange=ijrange,
             zerobased=zerobased,
+            mmap=mmap,
         )
 
         if grid and gridlink:
@@ -678,6 +712,43 @@ class GridProperty(_Grid3D):
 
         return obj
 
+    def load_values(self):
+        """Load values in cases where the property is lazy loaded.
+
+        A property made with ``lazy=True`` in :meth:`GridProperties.from_file` will
+        only hold metadata, and values are read from file (using the keyword byte
+        positions found when scanning the file) the first time they are needed.
+        This is done automatically, but can also be forced by this method.
+
+        Example::
+
+            props = GridProperties()
+            props.from_file("ECL.UNRST", fformat="unrst", names="all", dates="all",
+                            grid=grd, lazy=True)
+            pres = props.get_prop_by_name("PRESSURE_20010101")
+            pres.load_values()  # optional, as pres.values will also load
+
+        .. versionadded:: 2.14
+        """
+        if self._isloaded:
+            return
+
+        loader = self._loader
+        name = self._name
+        logger.info("Lazy load of values for %s", name)
+
+        # set as loaded during the actual load, in case the loader uses self._values
+        self._isloaded = True
+        try:
+            loader(self)
+        except Exception:
+            self._isloaded = False
+            self._loader = loader
+            raise
+
+        self._loader = None
+        self._name = name  # keep name, which may have been changed before loading
+
     def to_file(
         self, pfile, fformat="roff", name=None, append=False, dtype=None, fmt=None
     ):
@@ -2,11 +2,10 @@
 """Regular surface vs Cube"""
 
 
-import numpy as np
-
 import xtgeo
 import xtgeo.cxtgeo._cxtgeo as _cxtgeo
 from xtgeo.common import XTGeoDialog
+from xtgeo.cube import _cube_window
 
 xtg = XTGeoDialog()
 
@@ -83,7 +82,7 @@ def _slice_cube_v1(
         # set dead traces to cxtgeo UNDEF -> special treatment in the C code
         olddead = cube.values_dead_traces(xtgeo.UNDEF)
 
-    cubeval1d = np.ravel(cube.values, order="C")
+    cubeval1d, bcache = _cube_window.values_and_cache(cube)
 
     nsurf = self.ncol * self.nrow
 
@@ -107,6 +106,7 @@ def _slice_cube_v1(
         cube.rotation,
         cube.yflip,
         cubeval1d,
+        bcache,
         self.ncol,
         self.nrow,
         self.xori,
@@ -165,13 +165,15 @@ def _slice_cube_v2(
 
     # cube and surf shall share same topology, e.g. cube.col == surf.ncol etc
     # print(self.values.mask)
+    cubevalues, bcache = _cube_window.values_and_cache(cube)
     istat = _cxtgeo.surf_slice_cube_v3(
         cube.ncol,
         cube.nrow,
         cube.nlay,
         cube.zori,
         cube.zinc,
-        cube.values,
+        cubevalues,
+        bcache,
         other.values.data,
         self.values.data,
         self.values.mask,
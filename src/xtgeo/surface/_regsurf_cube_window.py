@@ -47,6 +47,7 @@ def slice_cube_window(
     showprogress=False,
     deadtraces=True,
     algorithm=1,
+    threads=1,
 ):
     if algorithm == 1:
 
@@ -86,6 +87,7 @@ def slice_cube_window(
             snapxy=snapxy,
             showprogress=showprogress,
             deadtraces=deadtraces,
+            threads=threads,
         )
     return attrs
 
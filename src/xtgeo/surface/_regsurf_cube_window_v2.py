@@ -6,6 +6,7 @@ import numpy as np
 import xtgeo
 import xtgeo.cxtgeo._cxtgeo as _cxtgeo
 from xtgeo.common import XTGeoDialog
+from xtgeo.cube import _cube_window
 
 xtg = XTGeoDialog()
 
@@ -45,6 +46,7 @@ def slice_cube_window(
     snapxy=False,
     showprogress=False,
     deadtraces=True,
+    threads=1,
 ):
 
     if not snapxy:
@@ -62,6 +64,7 @@ def slice_cube_window(
             maskthreshold,
             showprogress,
             deadtraces,
+            threads,
         )
 
     else:
@@ -80,6 +83,7 @@ def slice_cube_window(
             maskthreshold,
             showprogress,
             deadtraces,
+            threads,
         )
 
     # if attribute is str, self shall be updated and None returned, otherwise a dict
@@ -106,6 +110,7 @@ def _slice_cube_window(
     maskthreshold,
     showprogress,
     deadtraces,
+    threads,
 ):  # pylint: disable=too-many-branches, too-many-statements
 
     """Slice Cube between surfaces to find attributes
@@ -185,6 +190,7 @@ def _slice_cube_window(
         optprogress,
         maskthreshold,
         optsum,
+        threads,
     )
 
     if deadtraces:
@@ -213,6 +219,7 @@ def _attributes_betw_surfaces(
     optprogress,
     maskthreshold,
     optsum,
+    threads,
 ):
     """This is the actual lowlevel engine communicating with C code"""
 
@@ -224,13 +231,15 @@ def _attributes_betw_surfaces(
     if sampling in ["nearest", "cube"]:
         optnearest = 1
 
+    cubevalues, bcache = _cube_window.values_and_cache(cube)
     _cxtgeo.surf_cube_attr_intv(
         cube.ncol,
         cube.nrow,
         cube.nlay,
         cube.zori,
         cube.zinc,
-        cube.values,
+        cubevalues,
+        bcache,
         surf1.values.data,
         surf2.values.data,
         surf1.values.mask,
@@ -244,6 +253,7 @@ def _attributes_betw_surfaces(
         optprogress,
         maskthreshold,
         optsum,
+        threads,
     )
 
     logger.info("Results updated, with size %s", results.shape)
@@ -267,6 +277,7 @@ def _slice_cube_window_resample(
     maskthreshold,
     showprogress,
     deadtraces,
+    threads,
 ):
     """Makes a resample from original surfaces first to fit cube topology"""
 
@@ -274,17 +285,17 @@ def _slice_cube_window_resample(
 
     scube = xtgeo.surface_from_cube(cube, 0.0)
 
-    scube.resample(self)
+    scube.resample(self, threads=threads)
 
     szsurf = None
     if zsurf:
         szsurf = scube.copy()
-        szsurf.resample(zsurf)
+        szsurf.resample(zsurf, threads=threads)
 
     sother = None
     if other:
         sother = scube.copy()
-        sother.resample(other)
+        sother.resample(other, threads=threads)
 
     attrs = _slice_cube_window(
         scube,
@@ -300,12 +311,13 @@ def _slice_cube_window_resample(
         maskthreshold,
         showprogress,
         deadtraces,
+        threads,
     )
 
     # now resample attrs back to a copy of self
     zelf = self.copy()
     for key, _val in attrs.items():
-        zelf.resample(attrs[key])
+        zelf.resample(attrs[key], threads=threads)
         attrs[key] = zelf.copy()
 
     return attrs
@@ -23,7 +23,6 @@ logger = xtg.functionlogger(__name__)
 def slice_grid3d(self, grid, prop, zsurf=None, sbuffer=1):
     """Private function for the Grid3D slicing."""
 
-    grid._xtgformat1()
     if zsurf is not None:
         other = zsurf
     else:
@@ -36,28 +35,52 @@ def slice_grid3d(self, grid, prop, zsurf=None, sbuffer=1):
 
     nsurf = self.ncol * self.nrow
 
-    p_prop = _gridprop_lowlevel.update_carray(prop, discrete=False)
-
-    istat, updatedval = _cxtgeo.surf_slice_grd3d(
-        self.ncol,
-        self.nrow,
-        self.xori,
-        self.xinc,
-        self.yori,
-        self.yinc,
-        self.rotation,
-        self.yflip,
-        zslice.get_values1d(),
-        nsurf,
-        grid.ncol,
-        grid.nrow,
-        grid.nlay,
-        grid._coordsv,
-        grid._zcornsv,
-        grid._actnumsv,
-        p_prop,
-        sbuffer,
-    )
+    if grid._xtgformat == 2:
+        propv = np.ma.filled(prop.values, xtgeo.UNDEF).astype(np.float64).ravel()
+
+        istat, updatedval = _cxtgeo.surf_slice_grdcp3d(
+            self.ncol,
+            self.nrow,
+            self.xori,
+            self.xinc,
+            self.yori,
+            self.yinc,
+            self.rotation,
+            self.yflip,
+            zslice.get_values1d(),
+            nsurf,
+            grid.ncol,
+            grid.nrow,
+            grid.nlay,
+            grid._coordsv,
+            grid._zcornsv,
+            grid._actnumsv,
+            propv,
+            sbuffer,
+        )
+    else:
+        p_prop = _gridprop_lowlevel.update_carray(prop, discrete=False)
+
+        istat, updatedval = _cxtgeo.surf_slice_grd3d(
+            self.ncol,
+            self.nrow,
+            self.xori,
+            self.xinc,
+            self.yori,
+            self.yinc,
+            self.rotation,
+            self.yflip,
+            zslice.get_values1d(),
+            nsurf,
+            grid.ncol,
+            grid.nrow,
+            grid.nlay,
+            grid._coordsv,
+            grid._zcornsv,
+            grid._actnumsv,
+            p_prop,
+            sbuffer,
+        )
 
     if istat != 0:
         logger.warning("Problem, ISTAT = %s", istat)
@@ -93,6 +116,9 @@ def from_grid3d(self, grid, template=None, where="top", mode="depth", rfactor=1)
     if rfactor < 0.5:
         raise KeyError("Refinefactor rfactor is too small, should be >= 0.5")
 
+    # surf_sample_grd3d_lay is for xtgformat=1 only
+    grid._xtgformat1()
+
     _update_regsurf(self, template, grid, rfactor=float(rfactor))
 
     # call C function to make a map
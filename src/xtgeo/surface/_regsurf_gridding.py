@@ -10,6 +10,7 @@ import scipy.interpolate
 import scipy.ndimage
 
 import xtgeo
+import xtgeo.cxtgeo._cxtgeo as _cxtgeo
 
 xtg = xtgeo.common.XTGeoDialog()
 
@@ -19,10 +20,27 @@ logger = xtg.functionlogger(__name__)
 # pylint: disable=too-many-branches, too-many-statements, too-many-locals
 
 
-def points_gridding(self, points, method="linear", coarsen=1):
-    """Do gridding from a points data set."""
+# gridding methods in the C library, and their codes in surf_gridding_*
+NATIVE_METHODS = {
+    "nearest_radius": 0,
+    "idw": 1,
+    "moving_average": 2,
+    "min_curvature": 3,
+}
 
-    xiv, yiv = self.get_xy_values()
+
+def points_gridding(
+    self,
+    points,
+    method="linear",
+    coarsen=1,
+    radius=None,
+    power=2.0,
+    niter=100,
+    chunksize=1000000,
+    threads=1,
+):
+    """Do gridding from a points data set."""
 
     dfra = points.dataframe
 
@@ -35,13 +53,21 @@ def points_gridding(self, points, method="linear", coarsen=1):
         ycv = ycv[::coarsen]
         zcv = zcv[::coarsen]
 
-    validmethods = ["linear", "nearest", "cubic"]
+    if method in NATIVE_METHODS:
+        _points_gridding_native(
+            self, xcv, ycv, zcv, method, radius, power, niter, chunksize, threads
+        )
+        return
+
+    validmethods = ["linear", "nearest", "cubic"] + list(NATIVE_METHODS)
     if method not in set(validmethods):
         raise ValueError(
             "Invalid method for gridding: {}, valid "
             "options are {}".format(method, validmethods)
         )
 
+    xiv, yiv = self.get_xy_values()
+
     try:
         znew = scipy.interpolate.griddata(
             (xcv, ycv), zcv, (xiv, yiv), method=method, fill_value=np.nan
@@ -54,6 +80,83 @@ def points_gridding(self, points, method="linear", coarsen=1):
     self._ensure_correct_values(znew)
 
 
+def _points_gridding_native(
+    self, xcv, ycv, zcv, method, radius, power, niter, chunksize, threads
+):
+    """Gridding in the C library, with binned search and points in chunks.
+
+    Only per node accumulators are kept between chunks, so the points need not
+    be in memory at once as float64 copies.
+    """
+    code = NATIVE_METHODS[method]
+
+    if radius is None:
+        radius = 3.0 * max(self.xinc, self.yinc)
+    if radius <= 0.0:
+        raise ValueError("Search radius must be positive, got {}".format(radius))
+    if chunksize < 1:
+        raise ValueError("Chunksize must be at least 1, got {}".format(chunksize))
+
+    nnode = self.ncol * self.nrow
+    accsum = np.zeros(nnode, dtype=np.float64)
+    accw = np.zeros(nnode, dtype=np.float64)
+    accd2 = np.full(nnode, xtgeo.UNDEF, dtype=np.float64)
+
+    for start in range(0, len(zcv), chunksize):
+        xch = np.array(xcv[start : start + chunksize], dtype=np.float64)
+        ych = np.array(ycv[start : start + chunksize], dtype=np.float64)
+        zch = np.array(zcv[start : start + chunksize], dtype=np.float64)
+
+        valid = np.isfinite(xch) & np.isfinite(ych) & np.isfinite(zch)
+        valid &= zch < xtgeo.UNDEF_LIMIT
+        if not valid.all():
+            xch, ych, zch = xch[valid], ych[valid], zch[valid]
+
+        ier = _cxtgeo.surf_gridding_add(
+            xch,
+            ych,
+            zch,
+            self.ncol,
+            self.nrow,
+            self.xori,
+            self.yori,
+            self.xinc,
+            self.yinc,
+            self.yflip,
+            self.rotation,
+            code,
+            float(radius),
+            float(power),
+            accsum,
+            accw,
+            accd2,
+            threads,
+        )
+        if ier != 0:
+            raise RuntimeError("Error code {} from surf_gridding_add".format(ier))
+
+    ier, znew = _cxtgeo.surf_gridding_result(
+        accsum,
+        accw,
+        accd2,
+        self.ncol,
+        self.nrow,
+        self.xinc,
+        self.yinc,
+        code,
+        niter,
+        nnode,
+        threads,
+    )
+    if ier != 0:
+        raise RuntimeError("Error code {} from surf_gridding_result".format(ier))
+
+    logger.info("Gridding point (%s) ... DONE", method)
+
+    znew = ma.masked_greater(znew, xtgeo.UNDEF_LIMIT)
+    self._ensure_correct_values(znew.reshape(self.ncol, self.nrow))
+
+
 def avgsum_from_3dprops_gridding(
     self,
     summing=False,
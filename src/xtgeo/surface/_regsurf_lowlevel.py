@@ -1,5 +1,7 @@
 """RegularSurface utilities (low level)"""
 
+import numpy as np
+
 import xtgeo.cxtgeo._cxtgeo as _cxtgeo
 from xtgeo.common import XTGeoDialog
 
@@ -22,6 +24,41 @@ def get_carr_double(self):
     return carr
 
 
+SAMPLING = {"nearest": 0, "bilinear": 1, "bicubic": 2}
+
+
+def sample_xyv(self, xvalues, yvalues, zvalues, sampling="bilinear", threads=1):
+    """Sample surface at X Y arrays; zvalues (float64 array) is updated in place.
+
+    Points outside or at undefined nodes get UNDEF.
+    """
+    if sampling not in SAMPLING:
+        raise ValueError(
+            "Invalid sampling {}, must be one of {}".format(sampling, list(SAMPLING))
+        )
+
+    ier = _cxtgeo.surf_sample_xyv(
+        np.ascontiguousarray(xvalues, dtype=np.float64),
+        np.ascontiguousarray(yvalues, dtype=np.float64),
+        zvalues,
+        self.ncol,
+        self.nrow,
+        self.xori,
+        self.yori,
+        self.xinc,
+        self.yinc,
+        self.yflip,
+        self.rotation,
+        self.get_values1d(),
+        SAMPLING[sampling],
+        threads,
+    )
+    if ier != 0:
+        raise RuntimeError(
+            "Error code from C routine surf_sample_xyv is {}".format(ier)
+        )
+
+
 # ======================================================================================
 # METHODS BELOW SHALL BE DEPRECATED!!
 # Helper methods, for internal usage
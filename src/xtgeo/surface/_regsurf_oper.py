@@ -10,6 +10,7 @@ import xtgeo
 from xtgeo.xyz import Polygons
 import xtgeo.cxtgeo._cxtgeo as _cxtgeo
 from xtgeo.common import XTGeoDialog
+from xtgeo.surface import _regsurf_lowlevel
 
 xtg = XTGeoDialog()
 
@@ -82,7 +83,7 @@ def _check_other(self, other):
     return other
 
 
-def resample(self, other, mask=True):
+def resample(self, other, mask=True, threads=1):
     """Resample from other surface object to this surf."""
 
     logger.info("Resampling...")
@@ -116,6 +117,7 @@ def resample(self, other, mask=True):
         self._rotation,
         svalues,
         0 if not mask else 1,
+        threads,
     )
     self.values = np.ma.masked_greater(svalues, xtgeo.UNDEF_LIMIT)
 
@@ -323,31 +325,15 @@ def get_xy_values1d(self, order="C", activeonly=True):
     return xvals, yvals
 
 
-def get_fence(self, xyfence):
+def get_fence(self, xyfence, sampling="bilinear"):
     """Get surface values along fence."""
 
     cxarr = xyfence[:, 0]
     cyarr = xyfence[:, 1]
-    czarr = xyfence[:, 2].copy()
+    czarr = np.array(xyfence[:, 2], dtype=np.float64)
 
     # czarr will be updated "inplace":
-    istat = _cxtgeo.surf_get_zv_from_xyv(
-        cxarr,
-        cyarr,
-        czarr,
-        self.ncol,
-        self.nrow,
-        self.xori,
-        self.yori,
-        self.xinc,
-        self.yinc,
-        self.yflip,
-        self.rotation,
-        self.get_values1d(),
-    )
-
-    if istat != 0:
-        logger.warning("Seem to be rotten")
+    _regsurf_lowlevel.sample_xyv(self, cxarr, cyarr, czarr, sampling=sampling)
 
     xyfence[:, 2] = czarr
     xyfence = ma.masked_greater(xyfence, xtgeo.UNDEF_LIMIT)
@@ -356,7 +342,9 @@ def get_fence(self, xyfence):
     return xyfence
 
 
-def get_randomline(self, fencespec, hincrement=None, atleast=5, nextend=2):
+def get_randomline(
+    self, fencespec, hincrement=None, atleast=5, nextend=2, sampling="bilinear"
+):
     """Get surface values along fence."""
 
     if hincrement is None and isinstance(fencespec, xtgeo.Polygons):
@@ -369,27 +357,11 @@ def get_randomline(self, fencespec, hincrement=None, atleast=5, nextend=2):
 
     xcoords = fencespec[:, 0]
     ycoords = fencespec[:, 1]
-    zcoords = fencespec[:, 2].copy()
+    zcoords = np.array(fencespec[:, 2], dtype=np.float64)
     hcoords = fencespec[:, 3]
 
     # zcoords will be updated "inplace":
-    istat = _cxtgeo.surf_get_zv_from_xyv(
-        xcoords,
-        ycoords,
-        zcoords,
-        self.ncol,
-        self.nrow,
-        self.xori,
-        self.yori,
-        self.xinc,
-        self.yinc,
-        self.yflip,
-        self.rotation,
-        self.get_values1d(),
-    )
-
-    if istat != 0:
-        logger.warning("Seem to be rotten")
+    _regsurf_lowlevel.sample_xyv(self, xcoords, ycoords, zcoords, sampling=sampling)
 
     zcoords[zcoords > xtgeo.UNDEF_LIMIT] = np.nan
     arr = np.vstack([hcoords, zcoords]).T
@@ -0,0 +1,162 @@
+"""Streaming statistics for a collection of surfaces, via the C library.
+
+Surfaces are added one at a time, and only per node accumulators are kept: count,
+mean and sum of squared deviations (Welford), and for approximate percentiles a
+P-square sketch with 2 * npercentiles + 3 markers per node. Exact percentiles
+need all values, which are then kept in one float64 array (nsurfaces x nnodes),
+i.e. 8 * nsurfaces * nnodes bytes. When not given, exact percentiles are used only
+if this array is below EXACT_MAXBYTES, otherwise the sketch is used.
+"""
+import numpy as np
+
+import xtgeo
+import xtgeo.cxtgeo._cxtgeo as _cxtgeo
+from xtgeo.common import XTGeoDialog
+
+xtg = XTGeoDialog()
+logger = xtg.functionlogger(__name__)
+
+# max size (bytes) of the value stack when exact percentiles are chosen by default
+EXACT_MAXBYTES = 1024 ** 3
+
+
+class StreamingStatistics:
+    """Accumulate statistics per map node from surfaces with the same topology.
+
+    Args:
+        template (RegularSurface): Surface defining the topology
+        percentiles (list of float): Percentiles to evaluate, or None
+        exact (bool): If True, exact percentiles (requires nsurfaces), which keeps
+            all values in a float64 array of nsurfaces x nnodes. If False,
+            approximate percentiles from a sketch per node. If None (default),
+            exact if that array is at most EXACT_MAXBYTES, else approximate.
+        nsurfaces (int): Max number of surfaces, needed for exact percentiles
+        threads (int): Number of threads, where 0 means all available
+    """
+
+    def __init__(
+        self, template, percentiles=None, exact=None, nsurfaces=None, threads=1
+    ):
+        self._template = template.copy()
+        self._percentiles = None
+        self._threads = threads
+        self._nadded = 0
+
+        nnode = template.ncol * template.nrow
+        self._count = np.zeros(nnode, dtype=np.int32)
+        self._mean = np.zeros(nnode, dtype=np.float64)
+        self._m2 = np.zeros(nnode, dtype=np.float64)
+
+        # sketch markers; empty arrays if not in use
+        self._probs = np.zeros(0, dtype=np.float64)
+        self._heights = np.zeros(0, dtype=np.float64)
+        self._positions = np.zeros(0, dtype=np.int32)
+        self._stack = None
+
+        if percentiles is not None:
+            self._percentiles = list(percentiles)
+            pct = np.array(self._percentiles, dtype=np.float64)
+            if pct.min() < 0 or pct.max() > 100:
+                raise ValueError("Percentiles must be in range 0 - 100")
+
+            stackbytes = 8 * (nsurfaces or 0) * nnode
+            stackmb = stackbytes / 1024 ** 2
+            if exact is None:
+                exact = nsurfaces is not None and stackbytes <= EXACT_MAXBYTES
+                if not exact and nsurfaces is not None:
+                    logger.warning(
+                        "Approximate percentiles, as exact percentiles would need "
+                        "%.0f MB for %s surfaces; use exact=True to force",
+                        stackmb,
+                        nsurfaces,
+                    )
+            elif exact and stackbytes > EXACT_MAXBYTES:
+                logger.warning(
+                    "Exact percentiles for %s surfaces need %.0f MB", nsurfaces, stackmb
+                )
+
+            if exact:
+                if nsurfaces is None:
+                    raise ValueError("Number of surfaces is needed for exact mode")
+                self._stack = np.full((nsurfaces, nnode), xtgeo.UNDEF)
+            else:
+                probs = np.unique(pct[(pct > 0) & (pct < 100)]) / 100.0
+                nmark = 2 * probs.size + 3
+                self._probs = probs
+                self._heights = np.zeros(nmark * nnode, dtype=np.float64)
+                self._positions = np.zeros(nmark * nnode, dtype=np.int32)
+
+    def add(self, surf):
+        """Add a surface, which must have the same topology as the template."""
+        if not self._template.compare_topology(surf, strict=False):
+            raise ValueError("Cannot do statistics, surfaces differ in topology")
+
+        values = np.ma.filled(surf.values, fill_value=xtgeo.UNDEF)
+        values = np.array(values, dtype=np.float64).ravel()
+        values[np.isnan(values)] = xtgeo.UNDEF
+
+        if self._stack is not None:
+            if self._nadded >= self._stack.shape[0]:
+                raise ValueError("More surfaces than given for exact percentiles")
+            self._stack[self._nadded, :] = values
+
+        ier = _cxtgeo.surf_stats_add(
+            values,
+            self._count,
+            self._mean,
+            self._m2,
+            self._probs,
+            self._heights,
+            self._positions,
+            self._threads,
+        )
+        if ier != 0:
+            raise RuntimeError("Error code {} from surf_stats_add".format(ier))
+        self._nadded += 1
+
+    def _surface(self, values):
+        surf = self._template.copy()
+        surf.values = np.ma.masked_greater(values, xtgeo.UNDEF_LIMIT)
+        return surf
+
+    def result(self):
+        """Return a dictionary with mean, std and percentile surfaces."""
+        result = {}
+
+        mean = np.where(self._count > 0, self._mean, xtgeo.UNDEF)
+        result["mean"] = self._surface(mean)
+
+        with np.errstate(divide="ignore", invalid="ignore"):
+            std = np.sqrt(self._m2 / (self._count - 1))
+        result["std"] = self._surface(np.where(self._count > 1, std, xtgeo.UNDEF))
+
+        if self._percentiles is None:
+            return result
+
+        pct = np.array(self._percentiles, dtype=np.float64)
+        nnode = self._count.size
+
+        if self._stack is not None:
+            stack = self._stack[: self._nadded, :].ravel()
+            ier, res = _cxtgeo.surf_stats_percentiles(
+                stack, self._nadded, pct, pct.size * nnode, self._threads
+            )
+        else:
+            ier, res = _cxtgeo.surf_stats_sketch_result(
+                self._count,
+                self._probs,
+                self._heights,
+                pct,
+                pct.size * nnode,
+                self._threads,
+            )
+        if ier != 0:
+            raise RuntimeError("Error code {} when computing percentiles".format(ier))
+
+        res = res.reshape(pct.size, nnode)
+        for num, prc in enumerate(self._percentiles):
+            result["p" + str(prc)] = self._surface(res[num, :])
+            if prc == 50:
+                result["median"] = result["p50"]
+
+        return result
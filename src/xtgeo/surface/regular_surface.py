@@ -1946,14 +1946,49 @@ class RegularSurface:
     # Interacion with points
     # ==================================================================================
 
-    def gridding(self, points, method="linear", coarsen=1):
+    def gridding(
+        self,
+        points,
+        method="linear",
+        coarsen=1,
+        radius=None,
+        power=2.0,
+        niter=100,
+        chunksize=1000000,
+        threads=1,
+    ):
         """Grid a surface from points.
 
+        The methods linear / cubic / nearest use triangulation (scipy), while
+        nearest_radius / idw / moving_average / min_curvature are done in the
+        C library, where points are binned on map nodes and only points within
+        ``radius`` of a node are searched. Nodes without any points within the
+        radius are undefined. These methods need less memory and time for many
+        points, and the points are processed in chunks.
+
+        - nearest_radius: Value of nearest point
+        - idw: Inverse distance weighting, with weights 1 / distance^power
+        - moving_average: Average of points
+        - min_curvature: Minimum curvature, i.e. the smoothest surface through the
+          points averaged per nearest node. The radius here limits the extrapolation
+          distance from points.
+
         Args:
             points(Points): XTGeo Points instance.
-            method (str): Gridding method option: linear / cubic / nearest
+            method (str): Gridding method option: linear / cubic / nearest /
+                nearest_radius / idw / moving_average / min_curvature
             coarsen (int): Coarsen factor, to speed up gridding, but will
                 give poorer result.
+            radius (float): Search radius for the C library methods. Default is
+                3 times the largest map increment.
+            power (float): Power for method idw, default 2.0.
+            niter (int): Max number of iterations per grid level, min_curvature.
+            chunksize (int): Number of points per chunk, C library methods. For
+                idw and moving_average, the results may differ in the last digits
+                for different chunk sizes, as the sums are done in another order
+                (unless the points are ordered along the map columns).
+            threads (int): Number of threads to use, where 0 means all available.
+                Default is 1.
 
         Example::
 
@@ -1963,23 +1998,39 @@ class RegularSurface:
             # update the surface by gridding the points
             mysurf.gridding(mypoints)
 
+            # inverse distance, with points within 200 m
+            mysurf.gridding(mypoints, method="idw", radius=200, threads=0)
+
         Raises:
             RuntimeError: If not possible to grid for some reason
             ValueError: If invalid input
 
+        .. versionchanged:: 2.14
+           Added methods nearest_radius, idw, moving_average and min_curvature,
+           with keywords radius, power, niter, chunksize and threads.
         """
         if not isinstance(points, xtgeo.xyz.Points):
             raise ValueError("Argument not a Points instance")
 
         logger.info("Do gridding...")
 
-        _regsurf_gridding.points_gridding(self, points, coarsen=coarsen, method=method)
+        _regsurf_gridding.points_gridding(
+            self,
+            points,
+            coarsen=coarsen,
+            method=method,
+            radius=radius,
+            power=power,
+            niter=niter,
+            chunksize=chunksize,
+            threads=threads,
+        )
 
     # ==================================================================================
     # Interacion with other surface
     # ==================================================================================
 
-    def resample(self, other, mask=True):
+    def resample(self, other, mask=True, threads=1):
         """Resample an instance surface values from another surface instance.
 
         Note that there may be some 'loss' of nodes at the edges of the
@@ -1995,6 +2046,8 @@ class RegularSurface:
             other (RegularSurface): Surface to resample from.
             mask (bool): If True (default) nodes outside will be made undefined,
                 if False then values will be kept as original
+            threads (int): Number of threads to use, where 0 means all available.
+                Default is 1.
 
         Example::
 
@@ -2011,13 +2064,17 @@ class RegularSurface:
         .. versionchanged:: 2.9
            Added ``mask`` keyword, default is True for backward compatibility.
 
+        .. versionchanged:: 2.14
+           Added ``threads`` keyword. Surfaces with the same rotation are resampled
+           with a much faster separable algorithm.
+
         """
         if not isinstance(other, RegularSurface):
             raise ValueError("Argument not a RegularSurface " "instance")
 
         logger.info("Do resampling...")
 
-        _regsurf_oper.resample(self, other, mask=mask)
+        _regsurf_oper.resample(self, other, mask=mask, threads=threads)
 
     # ==================================================================================
     # Change a surface more fundamentally
@@ -2300,6 +2357,7 @@ class RegularSurface:
         showprogress=False,
         deadtraces=True,
         algorithm=2,
+        threads=1,
     ):
         """Slice the cube within a vertical window and get the statistical attrubutes.
 
@@ -2373,6 +2431,8 @@ class RegularSurface:
                 undefined, nad map will be undefined at dead trace location.
             algorithm (int): 1 for legacy method, 2 (default) for new faster
                 and more precise method available from xtgeo version 2.9.
+            threads (int): Number of threads for algorithm 2, where 0 means all
+                available. Default is 1.
 
         Example::
 
@@ -2399,6 +2459,8 @@ class RegularSurface:
 
         .. versionchanged:: 2.9 Added ``algorithm`` keyword, default is now 2,
                             while 1 is the legacy version
+
+        .. versionchanged:: 2.14 Added ``threads`` keyword
         """
         if other is None and zrange is None:
             zrange = 10
@@ -2419,6 +2481,7 @@ class RegularSurface:
             showprogress=showprogress,
             deadtraces=deadtraces,
             algorithm=algorithm,
+            threads=threads,
         )
 
         return asurfs
@@ -2427,7 +2490,7 @@ class RegularSurface:
     # Special methods
     # ==================================================================================
 
-    def get_fence(self, xyfence):
+    def get_fence(self, xyfence, sampling="bilinear"):
         """Sample the surface along X and Y positions (numpy arrays) and get Z.
 
         Note the result is a masked numpy (2D) with rows masked.
@@ -2435,15 +2498,23 @@ class RegularSurface:
         Args:
             xyfence (np): A 2D numpy array with shape (N, 3) where columns
                 are (X, Y, Z). The Z will be updated to the map.
+            sampling (str): Sampling method, "bilinear" (default), "nearest" or
+                "bicubic". Bicubic falls back to bilinear along the map border and
+                next to undefined nodes.
 
         Returns:
             ndarray: A numpy 2D array similar as input, but with updated
+
+        .. versionchanged:: 2.14
+           Added ``sampling`` keyword.
         """
-        xyfence = _regsurf_oper.get_fence(self, xyfence)
+        xyfence = _regsurf_oper.get_fence(self, xyfence, sampling=sampling)
 
         return xyfence
 
-    def get_randomline(self, fencespec, hincrement=None, atleast=5, nextend=2):
+    def get_randomline(
+        self, fencespec, hincrement=None, atleast=5, nextend=2, sampling="bilinear"
+    ):
         """Extract a line along a fencespec.
 
         Here, horizontal axis is "length" and vertical axis is sampled depth.
@@ -2470,6 +2541,8 @@ class RegularSurface:
                 fencespec is a Polygons instance and hincrement != False)
             nextend (int): Extend with nextend * hincrement in both ends (only if
                 fencespec is a Polygons instance and hincrement != False)
+            sampling (str): Sampling method, "bilinear" (default), "nearest" or
+                "bicubic".
 
         Returns:
             An array: ndarray2d (:, 2)
@@ -2489,13 +2562,21 @@ class RegularSurface:
 
         .. versionadded:: 2.1
 
+        .. versionchanged:: 2.14
+           Added ``sampling`` keyword.
+
         .. seealso::
            Class :class:`~xtgeo.xyz.polygons.Polygons`
               The method :meth:`~xtgeo.xyz.polygons.Polygons.get_fence()` which can be
               used to pregenerate `fencespec`
         """
         xyfence = _regsurf_oper.get_randomline(
-            self, fencespec, hincrement=hincrement, atleast=atleast, nextend=nextend
+            self,
+            fencespec,
+            hincrement=hincrement,
+            atleast=atleast,
+            nextend=nextend,
+            sampling=sampling,
         )
 
         return xyfence
@@ -7,11 +7,62 @@ import numpy as np
 
 import xtgeo
 from . import _surfs_import
+from . import _surfs_statistics
 
 xtg = xtgeo.common.XTGeoDialog()
 logger = xtg.functionlogger(__name__)
 
 
+def surfaces_statistics(sources, percentiles=None, exact=None, threads=1):
+    """Return statistical measures from surfaces, read and added one at a time.
+
+    This gives the same result as :meth:`Surfaces.statistics`, but surfaces given
+    as files are read one by one and are never held in memory together, which
+    is meant for large ensembles. Note that exact percentiles still keep all
+    values, see ``exact`` in :meth:`Surfaces.statistics`; by default the
+    approximate percentiles are then used for very large ensembles.
+
+    Args:
+        sources (list): RegularSurface instances and/or file names
+        percentiles (list of float): See :meth:`Surfaces.statistics`
+        exact (bool): See :meth:`Surfaces.statistics`
+        threads (int): See :meth:`Surfaces.statistics`
+
+    Returns:
+        dict: A dictionary of statistical measures
+
+    Raises:
+        ValueError: If surfaces differ in topology.
+
+    Example::
+
+        stats = xtgeo.surfaces_statistics(myfiles, percentiles=[10, 90], exact=False)
+
+    .. versionadded:: 2.14
+    """
+    stats = None
+    for item in sources:
+        if isinstance(item, xtgeo.RegularSurface):
+            surf = item
+        else:
+            surf = xtgeo.surface_from_file(item, fformat="guess")
+
+        if stats is None:
+            stats = _surfs_statistics.StreamingStatistics(
+                surf,
+                percentiles=percentiles,
+                exact=exact,
+                nsurfaces=len(sources),
+                threads=threads,
+            )
+        stats.add(surf)
+
+    if stats is None:
+        raise ValueError("No surfaces given")
+
+    return stats.result()
+
+
 class Surfaces(object):
     """Class for a collection of Surface objects, for operations that involves
     a number of surfaces, such as statistical numbers.
@@ -149,7 +200,7 @@ class Surfaces(object):
 
         return template
 
-    def statistics(self, percentiles=None):
+    def statistics(self, percentiles=None, exact=None, threads=1):
         """Return statistical measures from the surfaces.
 
         The statistics returned is:
@@ -160,9 +211,24 @@ class Surfaces(object):
         Currently this function expects that the surfaces all have the same
         shape/topology.
 
+        Statistics are computed by adding surfaces one at a time to accumulators
+        per map node, so the surfaces are not stacked, except for exact
+        percentiles. Exact percentiles keep all values in one float64 array, i.e.
+        8 * nsurfaces * ncol * nrow bytes (e.g. 1.6 GB for 200 surfaces of
+        1000 x 1000 nodes). With ``exact=False``, percentiles are estimated from a
+        small sketch per map node (the P-square algorithm), which is fast and uses
+        little memory, and is exact for up to 2 * len(percentiles) + 3 surfaces.
+        See also :func:`~xtgeo.surface.surfaces.surfaces_statistics` for
+        surfaces in files.
+
         Args:
             percentiles (list of float): If defined, a list of perecentiles to evaluate
                 e.g. [10, 50, 90] for p10, p50, p90
+            exact (bool): If True, exact percentiles, if False, approximate. If None
+                (default), exact unless the array of all values would exceed 1 GB,
+                where approximate percentiles are used and a warning is logged.
+            threads (int): Number of threads, where 0 means all available.
+                Default is 1.
 
         Returns:
             dict: A dictionary of statistical measures, see list above
@@ -178,36 +244,17 @@ class Surfaces(object):
             stats["mean"].to_file("mymean.gri")
 
         .. versionchanged:: 2.13 Added `percentile`
-        """
-        result = {}
-
-        template = self.surfaces[0].copy()
 
-        slist = []
+        .. versionchanged:: 2.14 Streaming computation, added `exact` and `threads`
+        """
+        stats = _surfs_statistics.StreamingStatistics(
+            self.surfaces[0],
+            percentiles=percentiles,
+            exact=exact,
+            nsurfaces=len(self.surfaces),
+            threads=threads,
+        )
         for surf in self.surfaces:
-            status = template.compare_topology(surf, strict=False)
-            if not status:
-                raise ValueError("Cannot do statistics, surfaces differ in topology")
-            slist.append(np.ma.filled(surf.values, fill_value=np.nan).ravel())
-
-        xlist = np.array(slist)
-
-        template.values = np.ma.masked_invalid(xlist).mean(axis=0)
-        result["mean"] = template.copy()
-        template.values = np.ma.masked_invalid(xlist).std(axis=0, ddof=1)
-        result["std"] = template.copy()
-
-        if percentiles is not None:
-
-            # nan on a axis tends to give warnings that are not a worry; suppress:
-            with warnings.catch_warnings():
-                warnings.filterwarnings("ignore", r"All-NaN (slice|axis) encountered")
-                res = np.nanpercentile(xlist, percentiles, axis=0)
-
-            for slice, prc in enumerate(percentiles):
-                template.values = res[slice, :]
-                result["p" + str(prc)] = template.copy()
-                if prc == 50:
-                    result["median"] = result["p50"]
+            stats.add(surf)
 
-        return result
+        return stats.result()
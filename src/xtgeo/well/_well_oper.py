@@ -181,14 +181,16 @@ def make_zone_qual_log(self, zqname):
     del dff
 
 
-def make_ijk_from_grid(self, grid, grid_id="", algorithm=1, activeonly=True):
+def make_ijk_from_grid(self, grid, grid_id="", algorithm=1, activeonly=True, threads=1):
     """Make an IJK log from grid indices."""
     logger.info("Using algorithm %s in %s", algorithm, __name__)
 
     if algorithm == 1:
         _make_ijk_from_grid_v1(self, grid, grid_id=grid_id)
     else:
-        _make_ijk_from_grid_v2(self, grid, grid_id=grid_id, activeonly=activeonly)
+        _make_ijk_from_grid_v2(
+            self, grid, grid_id=grid_id, activeonly=activeonly, threads=threads
+        )
 
     logger.info("Using algorithm %s in %s done", algorithm, __name__)
 
@@ -196,7 +198,8 @@ def make_ijk_from_grid(self, grid, grid_id="", algorithm=1, activeonly=True):
 def _make_ijk_from_grid_v1(self, grid, grid_id=""):
     """Getting IJK from a grid and make as well logs.
 
-    This is the first version, using _cxtgeo.grd3d_well_ijk from C
+    This is the first version, using _cxtgeo.grd3d_well_ijk from C, or
+    _cxtgeo.grdcp3d_well_ijk for xtgformat=2 grids
     """
     logger.info("Using algorithm 1 in %s", __name__)
 
@@ -209,28 +212,71 @@ def _make_ijk_from_grid_v1(self, grid, grid_id=""):
     wjvec = _cxtgeo.new_intarray(nlen)
     wkvec = _cxtgeo.new_intarray(nlen)
 
-    onelayergrid = grid.copy()
-    onelayergrid.reduce_to_one_layer()
-
-    cstatus = _cxtgeo.grd3d_well_ijk(
-        grid.ncol,
-        grid.nrow,
-        grid.nlay,
-        grid._coordsv,
-        grid._zcornsv,
-        grid._actnumsv,
-        onelayergrid._zcornsv,
-        onelayergrid._actnumsv,
-        self.nrow,
-        wxarr,
-        wyarr,
-        wzarr,
-        wivec,
-        wjvec,
-        wkvec,
-        0,
+    # the cell index (and the onelayer grid for xtgformat=1) are kept and reused in
+    # the grid instance
+    from xtgeo.grid3d._grid3d_fence import (  # pylint: disable=import-outside-toplevel
+        _update_cellindex,
     )
 
+    _update_cellindex(grid)
+    cindex = grid._tmp["cellindex"]
+
+    if grid._xtgformat == 2:
+        cstatus = _cxtgeo.grdcp3d_well_ijk(
+            grid.ncol,
+            grid.nrow,
+            grid.nlay,
+            grid._coordsv,
+            grid._zcornsv,
+            grid._actnumsv,
+            cindex["colbox"],
+            cindex["binstart"],
+            cindex["bincells"],
+            cindex["xmin"],
+            cindex["ymin"],
+            cindex["xbin"],
+            cindex["ybin"],
+            cindex["nbx"],
+            cindex["nby"],
+            self.nrow,
+            wxarr,
+            wyarr,
+            wzarr,
+            wivec,
+            wjvec,
+            wkvec,
+            0,
+        )
+    else:
+        onelayergrid = grid._tmp["onegrid"]
+        cstatus = _cxtgeo.grd3d_well_ijk(
+            grid.ncol,
+            grid.nrow,
+            grid.nlay,
+            grid._coordsv,
+            grid._zcornsv,
+            grid._actnumsv,
+            onelayergrid._zcornsv,
+            onelayergrid._actnumsv,
+            cindex["colbox"],
+            cindex["binstart"],
+            cindex["bincells"],
+            cindex["xmin"],
+            cindex["ymin"],
+            cindex["xbin"],
+            cindex["ybin"],
+            cindex["nbx"],
+            cindex["nby"],
+            self.nrow,
+            wxarr,
+            wyarr,
+            wzarr,
+            wivec,
+            wjvec,
+            wkvec,
+            0,
+        )
+
     if cstatus != 0:
         raise RuntimeError("Error from C routine, code is {}".format(cstatus))
 
@@ -264,45 +310,36 @@ def _make_ijk_from_grid_v1(self, grid, grid_id=""):
     _cxtgeo.delete_doublearray(wyarr)
     _cxtgeo.delete_doublearray(wzarr)
 
-    del onelayergrid
-
 
-def _make_ijk_from_grid_v2(self, grid, grid_id="", activeonly=True):
+def _make_ijk_from_grid_v2(self, grid, grid_id="", activeonly=True, threads=1):
     """Getting IJK from a grid and make as well logs.
 
-    This is a newer version, using grid.get_ijk_from_points which in turn
+    This is a newer version, using grid.get_ijk_from_xyz which in turn
     use the from C method x_chk_point_in_hexahedron, while v1 use the
     x_chk_point_in_cell. This one is believed to be more precise!
     """
-    # establish a Points instance and make points dataframe from well trajectory X Y Z
-    wpoints = xtgeo.Points()
-    wpdf = self.dataframe.loc[:, ["X_UTME", "Y_UTMN", "Z_TVDSS"]].copy()
-    wpoints.dataframe = wpdf
-    wpoints.dataframe.reset_index(inplace=True, drop=True)
-
-    # column names
-    cna = ("ICELL" + grid_id, "JCELL" + grid_id, "KCELL" + grid_id)
-
-    df = grid.get_ijk_from_points(
-        wpoints,
+    ijkarrs = grid.get_ijk_from_xyz(
+        self.dataframe["X_UTME"].values,
+        self.dataframe["Y_UTMN"].values,
+        self.dataframe["Z_TVDSS"].values,
         activeonly=activeonly,
         zerobased=False,
-        dataframe=True,
-        includepoints=False,
-        columnnames=cna,
-        fmt="float",
-        undef=np.nan,
+        threads=threads,
     )
+    set_ijk_logs(self, ijkarrs, grid_id=grid_id)
 
-    # The resulting df shall have same length as the well's dataframe,
-    # but the well index may not start from one. So first ignore index, then
-    # re-establish
-    wellindex = self.dataframe.index
 
-    newdf = pd.concat([self.dataframe.reset_index(drop=True), df], axis=1)
-    newdf.index = wellindex
+def set_ijk_logs(self, ijkarrs, grid_id=""):
+    """Set I J K arrays (with -1 as undefined) as ICELL, JCELL, KCELL logs.
 
-    self.dataframe = newdf
+    The logs are float with NaN for undefined, as other discrete logs.
+    """
+    cna = ("ICELL" + grid_id, "JCELL" + grid_id, "KCELL" + grid_id)
+
+    for cname, arr in zip(cna, ijkarrs):
+        self._df[cname] = np.where(arr == -1, np.nan, arr.astype("float"))
+
+    self._ensure_consistency()
 
 
 def get_gridproperties(self, gridprops, grid=("ICELL", "JCELL", "KCELL"), prop_id=""):
@@ -10,12 +10,40 @@ import shapely.geometry as sg
 from xtgeo.common import XTGeoDialog
 from xtgeo.common import XTGShowProgress
 
+from . import _well_oper
+
 logger = logging.getLogger(__name__)
 logger.addHandler(logging.NullHandler())
 
 xtg = XTGeoDialog()
 
 
+def make_ijk_from_grid(self, grid, grid_id="", activeonly=True, threads=1):
+    """Make IJK logs for all wells, using one batch call for all trajectories."""
+    if not self.wells:
+        return
+
+    xyz = [
+        [well.dataframe[cname].values for well in self.wells]
+        for cname in ("X_UTME", "Y_UTMN", "Z_TVDSS")
+    ]
+    ijkarrs = grid.get_ijk_from_xyz(
+        np.concatenate(xyz[0]),
+        np.concatenate(xyz[1]),
+        np.concatenate(xyz[2]),
+        activeonly=activeonly,
+        zerobased=False,
+        threads=threads,
+    )
+
+    # split the result back per well
+    splits = np.cumsum([well.nrow for well in self.wells])[:-1]
+    ijkarrs = [np.split(arr, splits) for arr in ijkarrs]
+
+    for iwell, well in enumerate(self.wells):
+        _well_oper.set_ijk_logs(well, [arr[iwell] for arr in ijkarrs], grid_id=grid_id)
+
+
 def wellintersections(
     self, wfilter=None, showprogress=False
 ):  # pylint: disable=too-many-locals, too-many-branches, too-many-statements
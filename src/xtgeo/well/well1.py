@@ -1527,7 +1527,9 @@ class Well:
         """
         return _wellmarkers.get_surface_picks(self, surf)
 
-    def make_ijk_from_grid(self, grid, grid_id="", algorithm=2, activeonly=True):
+    def make_ijk_from_grid(
+        self, grid, grid_id="", algorithm=2, activeonly=True, threads=1
+    ):
         """Look through a Grid and add grid I J K as discrete logs.
 
         Note that the the grid counting has base 1 (first row is 1 etc).
@@ -1541,14 +1543,22 @@ class Well:
             algorithm (int): Which interbal algorithm to use, default is 2 (expert
                 setting)
             activeonly (bool): If True, only active cells are applied (algorithm 2 only)
+            threads (int): Number of threads (algorithm 2 only), where 0 means all
+                available. Requires that xtgeo is built with OpenMP.
 
         Raises:
             RuntimeError: 'Error from C routine, code is ...'
 
         .. versionchanged:: 2.9 Added keys for and `activeonly`
+        .. versionchanged:: 2.14 Added key `threads`
         """
         _well_oper.make_ijk_from_grid(
-            self, grid, grid_id=grid_id, algorithm=algorithm, activeonly=activeonly
+            self,
+            grid,
+            grid_id=grid_id,
+            algorithm=algorithm,
+            activeonly=activeonly,
+            threads=threads,
         )
 
     def make_zone_qual_log(self, zqname):
@@ -263,6 +263,26 @@ class Wells(object):
         for well in self.wells:
             well.downsample(interval=interval, keeplast=keeplast)
 
+    def make_ijk_from_grid(self, grid, grid_id="", activeonly=True, threads=1):
+        """Look through a Grid and add grid I J K as discrete logs, for all wells.
+
+        This is the same as :meth:`Well.make_ijk_from_grid` (algorithm 2), but all
+        well trajectories are evaluated in one batch, which is much faster for a
+        large number of wells.
+
+        Args:
+            grid (Grid): A XTGeo Grid instance
+            grid_id (str): Add a tag (optional) to the current log name
+            activeonly (bool): If True, only active cells are applied
+            threads (int): Number of threads to use, where 0 means all available.
+                Requires that xtgeo is built with OpenMP, otherwise ignored.
+
+        .. versionadded:: 2.14
+        """
+        _wells_utils.make_ijk_from_grid(
+            self, grid, grid_id=grid_id, activeonly=activeonly, threads=threads
+        )
+
     def wellintersections(self, wfilter=None, showprogress=False):
         """Get intersections between wells, return as dataframe table.
 
@@ -306,7 +306,7 @@ def get_fence(
     return fence
 
 
-def snap_surface(self, surf, activeonly=True):
+def snap_surface(self, surf, activeonly=True, sampling="bilinear", threads=1):
     """Snap (or transfer) operation.
 
     Points that falls outside the surface will be UNDEF, and they will be removed
@@ -316,27 +316,21 @@ def snap_surface(self, surf, activeonly=True):
     if not isinstance(surf, xtgeo.RegularSurface):
         raise ValueError("Input object of wrong data type, must be RegularSurface")
 
-    zval = self._df[self.zname].values.copy()
+    from xtgeo.surface import (  # pylint: disable=import-outside-toplevel
+        _regsurf_lowlevel,
+    )
+
+    zval = np.array(self._df[self.zname].values, dtype=np.float64)
 
-    ier = _cxtgeo.surf_get_zv_from_xyv(
+    _regsurf_lowlevel.sample_xyv(
+        surf,
         self._df[self.xname].values,
         self._df[self.yname].values,
         zval,
-        surf.ncol,
-        surf.nrow,
-        surf.xori,
-        surf.yori,
-        surf.xinc,
-        surf.yinc,
-        surf.yflip,
-        surf.rotation,
-        surf.get_values1d(),
+        sampling=sampling,
+        threads=threads,
     )
 
-    if ier != 0:
-        raise RuntimeError(
-            "Error code from C routine surf_get_zv_from_xyv is {}".format(ier)
-        )
     if activeonly:
         self._df[self.zname] = zval
         self._df = self._df[self._df[self.zname] < xtgeo.UNDEF_LIMIT]
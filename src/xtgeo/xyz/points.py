@@ -657,25 +657,33 @@ class Points(XYZ):  # pylint: disable=too-many-public-methods
     # Operations vs surfaces and possibly other
     # ==================================================================================
 
-    def snap_surface(self, surf, activeonly=True):
+    def snap_surface(self, surf, activeonly=True, sampling="bilinear", threads=1):
         """Snap (transfer) the points Z values to a RegularSurface
 
         Args:
             surf (~xtgeo.surface.regular_surface.RegularSurface): Surface to snap to.
             activeonly (bool): If True (default), the points outside the defined surface
                 will be removed. If False, these points will keep the original values.
+            sampling (str): Sampling method, "bilinear" (default), "nearest" or
+                "bicubic".
+            threads (int): Number of threads, where 0 means all available.
 
         Returns:
             None (instance is updated inplace)
 
         Raises:
             ValueError: Input object of wrong data type, must be RegularSurface
-            RuntimeError: Error code from C routine surf_get_zv_from_xyv is ...
+            RuntimeError: Error code from C routine surf_sample_xyv is ...
 
         .. versionadded:: 2.1
 
+        .. versionchanged:: 2.14
+           Added ``sampling`` and ``threads`` keywords.
+
         """
-        _xyz_oper.snap_surface(self, surf, activeonly=activeonly)
+        _xyz_oper.snap_surface(
+            self, surf, activeonly=activeonly, sampling=sampling, threads=threads
+        )
 
     # ==================================================================================
     # Operations restricted to inside/outside polygons
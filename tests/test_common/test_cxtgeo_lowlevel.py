@@ -80,3 +80,45 @@ def test_well_mask_shoulder(depth, logseries, distance, expected):
     print(mask)
     assert res == 0
     assert (mask == expected).all()
+
+
+@pytest.mark.parametrize("yflip, rotation", [(1, 0.0), (1, 30.0), (-1, 210.0)])
+def test_sucu_ij_from_xyv(yflip, rotation):
+    """Test vectorized XY -> IJ lookup in a rotated lattice."""
+
+    ncol, nrow, xori, yori, xinc, yinc = 7, 5, 100.0, 200.0, 25.0, 20.0
+
+    ivals, jvals = np.meshgrid(np.arange(ncol), np.arange(nrow), indexing="ij")
+    ivals = ivals.ravel()
+    jvals = jvals.ravel()
+
+    angle = np.radians(rotation)
+    xdist = ivals * xinc
+    ydist = jvals * yinc * yflip
+    xvals = xori + xdist * np.cos(angle) - ydist * np.sin(angle)
+    yvals = yori + xdist * np.sin(angle) + ydist * np.cos(angle)
+
+    # add a point outside
+    xvals = np.append(xvals, xori - 1000.0)
+    yvals = np.append(yvals, yori)
+
+    ier, iout, jout = _cxtgeo.sucu_ij_from_xyv(
+        xvals,
+        yvals,
+        xvals.size,
+        yvals.size,
+        xori,
+        xinc,
+        yori,
+        yinc,
+        ncol,
+        nrow,
+        yflip,
+        rotation,
+        0,
+    )
+
+    assert ier == 0
+    np.testing.assert_array_equal(iout[:-1], ivals + 1)
+    np.testing.assert_array_equal(jout[:-1], jvals + 1)
+    assert iout[-1] == 0 and jout[-1] == 0
@@ -0,0 +1,39 @@
+# -*- coding: utf-8 -*-
+"""Testing profiling of C routines"""
+
+import xtgeo
+
+xtg = xtgeo.XTGeoDialog()
+logger = xtg.basiclogger(__name__)
+
+TPATH = xtg.testpathobj
+
+GFILE1 = TPATH / "3dgrids/reek/REEK.EGRID"
+
+
+def test_profiling_report():
+    """Enable profiling, import a grid, and inspect and reset the report."""
+    xtgeo.profiling.reset()
+    xtgeo.profiling.enable()
+    try:
+        grd = xtgeo.grid_from_file(GFILE1, fformat="egrid")
+        grd.from_file(GFILE1, fformat="egrid")
+    finally:
+        xtgeo.profiling.disable()
+
+    rep = xtgeo.profiling.report()
+    logger.info(rep)
+    assert rep["grd3d_imp_ecl_egrid"]["ncalls"] == 2
+    assert rep["grd3d_imp_ecl_egrid"]["nitems"] == 2 * grd.ntotal
+    assert rep["grd3d_imp_ecl_egrid"]["seconds"] > 0.0
+
+    dfr = xtgeo.profiling.report(dataframe=True)
+    assert list(dfr.columns) == ["NAME", "NCALLS", "SECONDS", "NITEMS"]
+    assert "grd3d_imp_ecl_egrid" in dfr["NAME"].values
+
+    # nothing is collected when disabled
+    xtgeo.grid_from_file(GFILE1, fformat="egrid")
+    assert xtgeo.profiling.report()["grd3d_imp_ecl_egrid"]["ncalls"] == 2
+
+    xtgeo.profiling.reset()
+    assert xtgeo.profiling.report() == {}
@@ -1,11 +1,13 @@
 # -*- coding: utf-8 -*-
 import os
+import shutil
 from os.path import join
 
 import pytest
 import numpy as np
 
 import xtgeo
+import xtgeo.cxtgeo._cxtgeo as _cxtgeo
 from xtgeo.cube import Cube
 from xtgeo.common import XTGeoDialog
 
@@ -121,6 +123,169 @@ def test_segyio_import(loadsfile1):
     assert xcu.values.max() == pytest.approx(7.42017, 0.001)
 
 
+def test_segy_import_xtgeo_engine(loadsfile1):
+    """Import SEGY (case 1 Reek) via the XTGeo C reader, compare with SEGYIO."""
+    xcu = loadsfile1
+
+    st1 = xtg.timer()
+    ycu = Cube()
+    ycu.from_file(SFILE1, engine="xtgeo", threads=0)
+    logger.info("Reading with XTGeo engine took %s", xtg.timer(st1))
+
+    assert ycu.dimensions == xcu.dimensions
+    np.testing.assert_array_equal(ycu.values, xcu.values)
+    np.testing.assert_array_equal(ycu.ilines, xcu.ilines)
+    np.testing.assert_array_equal(ycu.xlines, xcu.xlines)
+    np.testing.assert_array_equal(ycu.traceidcodes, xcu.traceidcodes)
+    for attr in ("xori", "yori", "zori", "xinc", "yinc", "zinc", "rotation"):
+        assert getattr(ycu, attr) == pytest.approx(getattr(xcu, attr), abs=0.01)
+    assert ycu.yflip == xcu.yflip
+
+
+def test_segy_import_xtgeo_engine_invalid():
+    """The XTGeo SEGY reader shall raise errors, not terminate."""
+    with open(SFILE1, "rb") as fhandle:
+        headers = bytearray(fhandle.read(3840))
+
+    # truncated file
+    sfile = join(TMD, "segy_truncated.segy")
+    with open(sfile, "wb") as fhandle:
+        fhandle.write(headers[:3000])
+    with pytest.raises(ValueError):
+        Cube().from_file(sfile, engine="xtgeo")
+
+    # unsupported sample format
+    headers[3224:3226] = (4).to_bytes(2, "big")
+    sfile = join(TMD, "segy_format4.segy")
+    with open(sfile, "wb") as fhandle:
+        fhandle.write(headers)
+    with pytest.raises(ValueError):
+        Cube().from_file(sfile, engine="xtgeo")
+
+
+def test_segy_ibm_ieee_conversion():
+    """Convert IEEE float to IBM float and back, and measure throughput."""
+    vals = np.array([1.0, -1.0, 0.15625, 0.0, -118.625, 7.42017], dtype=np.float32)
+    _ier, ibm = _cxtgeo.x_ieee_to_ibm_array(vals, vals.size)
+
+    # IBM numbers are given as raw (big endian) file bytes
+    assert list(ibm.view(">u4")[:5]) == [
+        0x41100000,
+        0xC1100000,
+        0x40280000,
+        0x00000000,
+        0xC276A000,
+    ]
+
+    _ier, back, minval, maxval = _cxtgeo.x_ibm_to_ieee_array(ibm, ibm.size)
+    np.testing.assert_array_equal(back, vals)
+    assert minval == pytest.approx(-118.625)
+    assert maxval == pytest.approx(7.42017, rel=1e-6)
+
+    nval = 10000000
+    vals = np.random.RandomState(42).normal(0.0, 1000.0, nval).astype(np.float32)
+
+    st1 = xtg.timer()
+    _ier, ibm = _cxtgeo.x_ieee_to_ibm_array(vals, nval)
+    elapsed = xtg.timer(st1)
+    logger.info("IEEE to IBM: %.2f GB/s", 4 * nval / elapsed / 1e9)
+
+    st1 = xtg.timer()
+    _ier, back, minval, maxval = _cxtgeo.x_ibm_to_ieee_array(ibm, nval)
+    elapsed = xtg.timer(st1)
+    logger.info("IBM to IEEE: %.2f GB/s", 4 * nval / elapsed / 1e9)
+
+    # IBM floats have hex normalization, so up to 3 mantissa bits are truncated
+    np.testing.assert_allclose(back, vals, rtol=2.0**-20)
+    assert minval == back.min()
+    assert maxval == back.max()
+    assert minval == pytest.approx(vals.min(), rel=2.0**-20)
+    assert maxval == pytest.approx(vals.max(), rel=2.0**-20)
+
+
+def test_segy_import_windowed(loadsfile1):
+    """Import SEGY (case 1 Reek) as a windowed cube, with values kept in file."""
+    xcu = loadsfile1
+
+    ycu = Cube()
+    ycu.from_file(SFILE1, windowed=True, cachesize=1)
+    assert ycu.windowed
+    assert ycu.dimensions == xcu.dimensions
+    assert ycu.cache_info() == {"hits": 0, "misses": 0, "memory": 0}
+    np.testing.assert_array_equal(ycu.traceidcodes, xcu.traceidcodes)
+
+    x1, y1 = xcu.get_xy_value_from_ij(10, 10)
+    x2, y2 = xcu.get_xy_value_from_ij(300, 200)
+    poly = xtgeo.Polygons()
+    poly.from_list([[x1, y1, xcu.zori, 1], [x2, y2, xcu.zori, 1]])
+    _, _, _, _, rnd1 = xcu.get_randomline(poly, sampling="trilinear")
+    _, _, _, _, rnd2 = ycu.get_randomline(poly, sampling="trilinear")
+    np.testing.assert_array_equal(rnd1, rnd2)
+
+    # budget of 1 MB is 4 bricks of 32 x 32 x 64 samples
+    assert ycu.cache_info()["memory"] <= 1024 * 1024
+    logger.info(ycu)
+
+    # accessing values reads the full cube
+    np.testing.assert_array_equal(ycu.values, xcu.values)
+    assert not ycu.windowed
+    assert ycu.cache_info() is None
+
+    with pytest.raises(ValueError):
+        Cube().from_file(SFILE3, fformat="storm", windowed=True)
+
+
+def test_segy_windowed_dead_traces(loadsfile1):
+    """Dead trace values set on a windowed cube are kept when values are read."""
+    xcu = loadsfile1.copy()
+    codes = xcu.traceidcodes.copy()
+    codes[5:9, 3:6] = 2
+    xcu.traceidcodes = codes
+    xcu.values_dead_traces(-999.0)
+
+    ycu = Cube()
+    ycu.from_file(SFILE1, windowed=True, cachesize=1)
+    ycu.traceidcodes = codes
+    ycu.values_dead_traces(-999.0)
+    assert ycu.windowed
+
+    np.testing.assert_array_equal(ycu.values, xcu.values)
+    assert (ycu.values[5:9, 3:6, :] == -999.0).all()
+
+
+def test_segy_import_windowed_truncated(loadsfile1):
+    """A windowed cube on a file truncated after import, where bricks cannot be
+    read, and the cache must still work for the bricks that can be read."""
+    xcu = loadsfile1
+
+    sfile = join(TMD, "segy_windowed_truncated.segy")
+    shutil.copyfile(SFILE1, sfile)
+
+    ycu = Cube()
+    ycu.from_file(sfile, windowed=True, cachesize=1)
+
+    first = ((1, 32), (1, 32), None)
+    np.testing.assert_array_equal(
+        ycu._bcache.read(*first), xcu.values[:32, :32, :]
+    )
+
+    os.truncate(sfile, os.path.getsize(sfile) // 2)
+
+    # the last bricks are missing, and failed bricks leave their cache slots free
+    with pytest.raises(OSError):
+        ycu._bcache.read()
+
+    for _ in range(3):
+        np.testing.assert_array_equal(
+            ycu._bcache.read(*first), xcu.values[:32, :32, :]
+        )
+        with pytest.raises(OSError):
+            ycu._bcache.read((xcu.ncol - 31, xcu.ncol), None, None)
+
+    assert ycu.cache_info()["memory"] <= 1024 * 1024
+    ycu._bcache.close()
+
+
 def test_segyio_import_export(loadsfile1):
     """Import and export SEGY (case 1 Reek) via SegIO library."""
 
@@ -229,6 +394,15 @@ def test_cube_resampling(loadsfile1):
     assert newcube.values.mean() == pytest.approx(5.3107, 0.0001)
     assert newcube.values[20, 20, 20] == pytest.approx(10.0, 0.0001)
 
+    # a windowed input cube is sampled through the brick cache, not read in full
+    wincube = Cube()
+    wincube.from_file(SFILE1, windowed=True, cachesize=1)
+    newcube2 = newcube.copy()
+    newcube2.values = 0.0
+    newcube2.resample(wincube, sampling="trilinear", outside_value=10.0)
+    assert wincube.windowed
+    np.testing.assert_array_equal(newcube2.values, newcube.values)
+
     # newcube.to_file(join(TMD, "cube_resmaple1.segy"))
 
 
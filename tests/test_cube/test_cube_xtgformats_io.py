@@ -2,6 +2,8 @@
 """Testing new xtg formats."""
 import pathlib
 import uuid
+
+import numpy as np
 import pytest
 
 import xtgeo
@@ -49,3 +51,50 @@ def test_cube_export_import_many():
     logger.info("Timing import %s cubes with %s: %s", nrange, fformat, xtg.timer(t1))
 
     assert cube1.values.mean() == pytest.approx(cube2.values.mean())
+
+
+@pytest.mark.parametrize(
+    "compression, tolerance", [(None, None), ("lossless", None), ("bounded", 0.01)]
+)
+def test_cube_xtgbrickcube(compression, tolerance):
+    """Test export and import of bricked cube, ordinary and windowed."""
+    cube1 = xtgeo.Cube(TESTSET1)
+    fname = pathlib.Path(TMPD) / (uuid.uuid4().hex + ".xtgbrickcube")
+
+    cube1.to_file(
+        fname,
+        fformat="xtgbrickcube",
+        compression=compression,
+        tolerance=tolerance,
+        bricksize=(64, 64, 32),
+        threads=2,
+    )
+
+    cube2 = xtgeo.Cube()
+    cube2.from_file(fname, threads=2)
+    assert cube2.dimensions == cube1.dimensions
+    assert cube2.xori == cube1.xori
+    assert cube2.rotation == cube1.rotation
+    if tolerance is None:
+        np.testing.assert_array_equal(cube2.values, cube1.values)
+    else:
+        assert np.abs(cube2.values - cube1.values).max() <= tolerance * 1.0001
+
+    # a windowed cube reads only the bricks along the line
+    cube3 = xtgeo.Cube()
+    cube3.from_file(fname, windowed=True, cachesize=8)
+    assert cube3.windowed
+
+    x1, y1 = cube1.get_xy_value_from_ij(10, 10)
+    x2, y2 = cube1.get_xy_value_from_ij(300, 20)
+    poly = xtgeo.Polygons()
+    poly.from_list([[x1, y1, cube1.zori, 1], [x2, y2, cube1.zori, 1]])
+    _, _, _, _, rnd2 = cube2.get_randomline(poly)
+    _, _, _, _, rnd3 = cube3.get_randomline(poly)
+    np.testing.assert_array_equal(rnd2, rnd3)
+
+    # the line crosses 5 x 1 x 3 bricks, which all fit in the cache
+    assert cube3.cache_info()["misses"] <= 15
+
+    np.testing.assert_array_equal(cube3.values, cube2.values)
+
@@ -456,6 +456,36 @@ def test_import_grdecl_and_bgrdecl():
     tsetup.assert_almostequal(dzv1.values.mean(), dzv2.values.mean(), 0.001)
 
 
+def test_import_grdecl_comments_and_repeats():
+    """GRDECL with comments, repeat counts and terminators in odd places."""
+    coord = []
+    for jrow in range(3):
+        for icol in range(3):
+            coord.extend([icol * 10.0, jrow * 10.0, 1000.0])
+            coord.extend([icol * 10.0, jrow * 10.0, 1010.0])
+    zcorn = "16*1000.0 16*1005 -- top and base layer 1\n16*1005 16*1010.0"
+
+    gfile = TMPDIR / "grdecl_repeats.grdecl"
+    with open(gfile, "w") as stream:
+        stream.write("-- Comment line\nGRIDUNIT\n'METRES  ' /\n\n")
+        stream.write("SPECGRID  -- dims\n 2 2 2 1 F/\n")
+        stream.write("COORD\n" + " ".join(str(val) for val in coord) + " /\n")
+        stream.write("ZCORN\n" + zcorn + "\n/\n")
+        stream.write("ACTNUM\n 3*1 0 4*1 /\nECHO\n")
+        stream.write("POROSITY\n 8*0.3 /\nPORO\n 2*0.1 0.2 0.25 4*0.3/\n")
+
+    grd = Grid(gfile, fformat="grdecl")
+    assert grd.dimensions == (2, 2, 2)
+    assert grd.nactive == 7
+    assert grd.get_dz().values.mean() == pytest.approx(5.0)
+
+    poro = GridProperty(gfile, fformat="grdecl", name="PORO", grid=grd)
+    assert poro.values[1, 1, 0] is np.ma.masked
+    assert poro.values[0, 0, 0] == pytest.approx(0.1)
+    assert poro.values[0, 1, 0] == pytest.approx(0.2)
+    assert poro.values[:, :, 1].mean() == pytest.approx(0.3)
+
+
 def test_eclgrid_import2():
     """Eclipse EGRID import, also change ACTNUM."""
     grd = Grid()
@@ -782,6 +812,103 @@ def test_bulkvol():
     assert bulk.values.sum() == pytest.approx(cellvol_rms.values.sum(), rel=0.001)
 
 
+def test_bulkvol_threads():
+    """Test that threaded cell bulk volume is identical to the serial result."""
+    grd = Grid(GRIDQC1)
+
+    bulk1 = grd.get_bulk_volume(threads=1)
+    bulk2 = grd.get_bulk_volume(threads=0)
+
+    np.testing.assert_array_equal(bulk1.values, bulk2.values)
+
+
+def test_xtgformat_conversions():
+    """Alternating methods on a grid shall not convert the geometry each time."""
+    grd = Grid(GRIDQC1)
+    grd._xtgformat1()
+    dz1 = grd.get_dz()
+    dx1, dy1 = grd.get_dxdy()
+
+    grd._xtgformat2()
+    Grid.xtgformat_conversions(reset=True)
+
+    xyz = grd.get_xyz()
+    for _ in range(2):
+        _ = grd.get_bulk_volume()
+        dz2 = grd.get_dz()
+        dx2, dy2 = grd.get_dxdy()
+        _ = grd.get_ijk_from_xyz(
+            xyz[0].values.compressed(),
+            xyz[1].values.compressed(),
+            xyz[2].values.compressed(),
+        )
+    np.testing.assert_array_equal(dz1.values, dz2.values)
+    np.testing.assert_array_equal(dx1.values, dx2.values)
+    np.testing.assert_array_equal(dy1.values, dy2.values)
+
+    assert Grid.xtgformat_conversions() == {"1to2": {}, "2to1": {}}
+
+    _ = grd.get_layer_slice(1)
+    assert Grid.xtgformat_conversions(reset=True)["2to1"] == {"get_layer_slice": 1}
+    assert Grid.xtgformat_conversions() == {"1to2": {}, "2to1": {}}
+
+
+def test_geometry_cache():
+    """Test that results with and without the per cell geometry cache are equal."""
+    grd = Grid(GRIDQC1)
+    assert grd.geometry_cache == "auto"
+    assert grd.geometry_cache_nbytes == grd.ntotal * 33 * 8
+
+    grd.geometry_cache = False
+    bulk1 = grd.get_bulk_volume()
+    qc1 = grd.get_gridquality_properties()
+    xyz1 = grd.get_xyz()
+    assert "geomcache" not in grd._tmp
+
+    grd.geometry_cache = True
+    bulk2 = grd.get_bulk_volume()
+    assert "geomcache" in grd._tmp
+    qc2 = grd.get_gridquality_properties()
+    xyz2 = grd.get_xyz()
+
+    np.testing.assert_array_equal(bulk1.values, bulk2.values)
+    for prop1, prop2 in zip(qc1.props, qc2.props):
+        np.testing.assert_array_equal(prop1.values, prop2.values)
+    for prop1, prop2 in zip(xyz1, xyz2):
+        np.testing.assert_array_equal(prop1.values, prop2.values)
+
+    # cache shall be rebuilt when the geometry is changed
+    grd.translate_coordinates(translate=(0, 0, 100))
+    grd.geometry_cache = False
+    bulk3 = grd.get_bulk_volume()
+    grd.geometry_cache = True
+    bulk4 = grd.get_bulk_volume()
+    np.testing.assert_array_equal(bulk3.values, bulk4.values)
+
+    _, _, zmid1 = grd.get_xyz()
+    grd.make_zconsistent(zsep=100.0)
+    _, _, zmid2 = grd.get_xyz()
+    grd.geometry_cache = False
+    _, _, zmid3 = grd.get_xyz()
+    assert not np.array_equal(zmid1.values, zmid2.values)
+    np.testing.assert_array_equal(zmid2.values, zmid3.values)
+
+    # and also when the geometry arrays are edited in place
+    grd.geometry_cache = True
+    _, _, zmid4 = grd.get_xyz()
+    assert "geomcache" in grd._tmp
+    grd._zcornsv += 10.0
+    _, _, zmid5 = grd.get_xyz()
+    zdiff = np.ma.filled(zmid5.values - zmid4.values, fill_value=10.0)
+    np.testing.assert_allclose(zdiff, 10.0, atol=1.0e-3)
+    grd.geometry_cache = False
+    _, _, zmid6 = grd.get_xyz()
+    np.testing.assert_array_equal(zmid5.values, zmid6.values)
+
+    with pytest.raises(ValueError):
+        grd.geometry_cache = "yes"
+
+
 @tsetup.bigtest
 def test_bulkvol_speed():
     """Test cell bulk volume calculation speed."""
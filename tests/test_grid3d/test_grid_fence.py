@@ -3,6 +3,8 @@
 
 import os
 
+import numpy as np
+
 import xtgeo
 import tests.test_common.test_xtg as tsetup
 
@@ -103,6 +105,31 @@ def test_randomline_fence_from_polygon():
         plt.show()
 
 
+def test_randomline_fence_from_polygons_instance():
+    """Randomline from a Polygons instance, where the fence is estimated from grid"""
+
+    grd = xtgeo.Grid(REEKROOT, fformat="eclipserun", initprops=["PORO"])
+    fence = xtgeo.Polygons(FENCE1)
+
+    # the fence estimate may change the grid format; the cell index must follow
+    _hmin, _hmax, _vmin, _vmax, por = grd.get_randomline(
+        fence, "PORO", zmin=1680, zmax=1750, zincrement=0.5
+    )
+    assert por.shape[0] == 141
+
+    # same fence given explicitly, on a fresh grid
+    grd2 = xtgeo.Grid(REEKROOT, fformat="eclipserun", initprops=["PORO"])
+    geom = grd2.get_geometrics()
+    distance = 0.25 * (geom[10] + geom[11])
+    fspec = fence.get_fence(distance=distance, atleast=5, nextend=2, asnumpy=True)
+
+    _hmin, _hmax, _vmin, _vmax, por2 = grd2.get_randomline(
+        fspec, "PORO", zmin=1680, zmax=1750, zincrement=0.5
+    )
+    assert np.isfinite(por).any()
+    np.testing.assert_array_equal(por, por2)
+
+
 def test_randomline_fence_calczminzmax():
     """Import ROFF grid with props and make fence from polygons, zmin/zmax auto"""
 
@@ -2,6 +2,8 @@
 """Testing: test_grid_operations"""
 
 
+import os
+import shutil
 import sys
 import warnings
 
@@ -28,6 +30,7 @@ IFILE1 = TPATH / "3dgrids/reek/REEK.INIT"
 RFILE1 = TPATH / "3dgrids/reek/REEK.UNRST"
 
 XFILE2 = TPATH / "3dgrids/reek/reek_grd_w_props.roff"
+PFILE1 = TPATH / "3dgrids/reek/reek_sim_poro.roff"
 
 # pylint: disable=logging-format-interpolation
 # pylint: disable=invalid-name
@@ -137,6 +140,64 @@ def test_import_restart():
     assert pr.values.mean() == pytest.approx(304.897, abs=0.01), txt
 
 
+def test_import_restart_lazy():
+    """Import Restart with lazy loading, compare with ordinary import"""
+
+    g = Grid()
+    g.from_file(GFILE1, fformat="egrid")
+
+    names = ["PRESSURE", "SWAT"]
+    dates = [19991201, 20010101]
+
+    x = GridProperties()
+    x.from_file(RFILE1, fformat="unrst", names=names, dates=dates, grid=g)
+
+    lx = GridProperties()
+    lx.from_file(RFILE1, fformat="unrst", names=names, dates=dates, grid=g, lazy=True)
+
+    assert lx.names == x.names
+    for prop in lx.props:
+        assert not prop.isloaded
+
+    pr = lx.get_prop_by_name("PRESSURE_20010101")
+    assert pr.name == "PRESSURE_20010101"
+    assert pr.dimensions == g.dimensions
+    assert pr.values.mean() == pytest.approx(304.897, abs=0.01)
+    assert pr.isloaded
+    assert not lx.get_prop_by_name("PRESSURE_19991201").isloaded
+
+    for prop, lprop in zip(x.props, lx.props):
+        assert lprop.name == prop.name
+        assert lprop.isdiscrete == prop.isdiscrete
+        assert lprop.values.mean() == pytest.approx(prop.values.mean())
+
+
+def test_import_init_roff_lazy():
+    """Import INIT and ROFF with lazy loading"""
+
+    g = Grid()
+    g.from_file(GFILE1, fformat="egrid")
+
+    x = GridProperties()
+    x.from_file(IFILE1, fformat="init", names=["PORO", "SATNUM"], grid=g, lazy=True)
+
+    satnum = x.get_prop_by_name("SATNUM")
+    assert satnum.isdiscrete
+    assert not satnum.isloaded
+    assert satnum.codes
+    assert satnum.isloaded
+
+    poro = x.get_prop_by_name("PORO")
+    poro.load_values()
+    assert poro.values.mean() == pytest.approx(0.1677402, abs=0.00001)
+
+    rx = GridProperties()
+    rx.from_file(PFILE1, fformat="roff", names=["PORO"], lazy=True)
+    poro = rx.get_prop_by_name("PORO")
+    assert not poro.isloaded
+    assert poro.values.mean() == pytest.approx(0.1677, abs=0.001)
+
+
 def test_import_restart_gull():
     """Import Restart Reek"""
 
@@ -224,6 +285,55 @@ def test_scan_keywords():
     assert df.loc[12, "KEYWORD"] == "SWAT"  # pylint: disable=no-member
 
 
+def test_scan_keywords_scanindex():
+    """Scan keywords with dates using a scan index sidecar file."""
+    rfile = os.path.join(TDIR, "reek_scanindex.UNRST")
+    shutil.copyfile(RFILE1, rfile)
+    if os.path.exists(rfile + ".xtgidx"):
+        os.remove(rfile + ".xtgidx")
+
+    scan = GridProperties.scan_keywords
+    df0 = scan(RFILE1, dataframe=True, dates=True)
+    df1 = scan(rfile, dataframe=True, dates=True, scanindex=True)
+    assert os.path.exists(rfile + ".xtgidx")
+
+    # second time the index is reused
+    df2 = scan(rfile, dataframe=True, dates=True, scanindex=True)
+    assert df0.equals(df1)
+    assert df0.equals(df2)
+
+    # simulate a restart file that is being written; scan index is updated
+    size = os.path.getsize(rfile)
+    with open(rfile, "r+b") as fhandle:
+        fhandle.truncate(size // 2)
+    df3 = scan(rfile, dataframe=True, dates=True, scanindex=True)
+    assert len(df3) < len(df0)
+
+    shutil.copyfile(RFILE1, rfile)
+    df4 = scan(rfile, dataframe=True, dates=True, scanindex=True)
+    assert df0.equals(df4)
+
+
+def test_scan_keywords_scanindex_invalid():
+    """An invalid record shall raise, and no scan index shall be written."""
+    rfile = os.path.join(TDIR, "reek_scanindex_invalid.UNRST")
+    shutil.copyfile(RFILE1, rfile)
+    if os.path.exists(rfile + ".xtgidx"):
+        os.remove(rfile + ".xtgidx")
+
+    df0 = GridProperties.scan_keywords(RFILE1, dataframe=True)
+    bytepos = int(df0.loc[len(df0) // 2, "BYTESTART"])
+
+    # destroy the Fortran record marker of a record in the middle of the file
+    with open(rfile, "r+b") as fhandle:
+        fhandle.seek(bytepos)
+        fhandle.write(b"\x00\x00\x00\x99")
+
+    with pytest.raises(RuntimeError, match="Invalid record"):
+        GridProperties.scan_keywords(rfile, dataframe=True, scanindex=True)
+    assert not os.path.exists(rfile + ".xtgidx")
+
+
 def test_scan_keywords_roff():
     """A static method to scan quickly keywords in a ROFF file"""
     t1 = xtg.timer()
@@ -252,6 +252,17 @@ def test_roffbin_import1_roffapiv2():
     assert x.values.mean() == pytest.approx(0.1677, abs=0.001)
 
 
+def test_roffbin_import1_truncated():
+    """Test that import of a truncated ROFF binary file fails."""
+    fname = pathlib.Path(TMPDIR) / "reek_sim_poro_truncated.roff"
+    data = TESTFILE1.read_bytes()
+    fname.write_bytes(data[: len(data) // 2])
+
+    x = GridProperty()
+    with pytest.raises(RuntimeError):
+        x.from_file(fname, fformat="roff", name="PORO")
+
+
 def test_roffbin_import1_new():
     """Test ROFF import, new code May 2018"""
     logger.info("Name is {}".format(__name__))
@@ -441,6 +452,21 @@ def test_grdecl_import_reek():
     tsetup.assert_almostequal(poro.values.mean(), porox.values.mean(), 0.001)
 
 
+def test_grdecl_export_repeats():
+    """Export to ascii grdecl where equal values are written as N*value."""
+    rgrid = Grid(TESTFILE12A, fformat="grdecl")
+    poro = GridProperty(TESTFILE12B, name="PORO", fformat="grdecl", grid=rgrid)
+    poro.values[:, :, 0:7] = 0.25
+
+    exportfile = os.path.join(TMPDIR, "reekporo_repeats.grdecl")
+    poro.to_file(exportfile, fformat="grdecl", fmt="%8.4f")
+    with open(exportfile) as stream:
+        assert "*0.2500" in stream.read()
+
+    porox = GridProperty(exportfile, name="PORO", fformat="grdecl", grid=rgrid)
+    assert npma.allclose(poro.values, porox.values, atol=0.0001)
+
+
 # def test_export_roff():
 #     """Property import from Eclipse. Then export to roff."""
 
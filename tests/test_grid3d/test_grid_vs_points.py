@@ -1,5 +1,6 @@
 # -*- coding: utf-8 -*-
 
+import numpy as np
 import pandas as pd
 import xtgeo
 
@@ -121,6 +122,28 @@ def test_get_ijk_from_points_tricky():
     assert ijk["JY"][0] == 171  # 110 171/172
 
 
+def test_get_ijk_from_points_after_set_actnum():
+    """Testing that IJK from points follows a changed ACTNUM"""
+    g1 = xtgeo.grid3d.Grid(REEKGRID)
+
+    po = xtgeo.Points([(456620.790918, 5.935660e06, 1727.649124)])  # 1, 1, 1
+
+    ijk = g1.get_ijk_from_points(po)
+    assert ijk["KZ"][0] == 1
+    assert "cellindex" in g1._tmp
+
+    act = g1.get_actnum()
+    act.values[0, 0, 0] = 0
+    g1.set_actnum(act)
+    assert "cellindex" not in g1._tmp
+
+    ijk = g1.get_ijk_from_points(po)
+    assert ijk["KZ"][0] == -1
+
+    ijk = g1.get_ijk_from_points(po, activeonly=False)
+    assert ijk["KZ"][0] == 1
+
+
 def test_get_ijk_from_points():
     """Testing getting IJK coordinates from points"""
     g1 = xtgeo.grid3d.Grid(REEKGRID)
@@ -299,3 +322,47 @@ def test_point_in_cell_compare_rms():
 
         succesrate = suc / nall
         print(cname, succesrate, suc, nall)
+
+
+def test_get_ijk_from_points_cellindex_reuse():
+    """The cell index is cached on the grid and reused in later calls"""
+
+    g1 = xtgeo.grid3d.Grid(REEKGRID)
+    df2 = g1.get_dataframe(ijk=False, xyz=True)
+
+    po = xtgeo.Points()
+    po.dataframe = df2.head(500).copy()
+
+    ijk1 = g1.get_ijk_from_points(po, includepoints=False)
+    assert "cellindex" in g1._tmp
+    cindex = g1._tmp["cellindex"]
+
+    ijk2 = g1.get_ijk_from_points(po, includepoints=False)
+    assert g1._tmp["cellindex"] is cindex
+    pd.testing.assert_frame_equal(ijk1, ijk2)
+
+
+def test_get_ijk_from_xyz_threads():
+    """Batch IJK as numpy arrays, serial vs threaded, compare with dataframe"""
+
+    g1 = xtgeo.grid3d.Grid(REEKGRID)
+    df2 = g1.get_dataframe(ijk=False, xyz=True)
+    xv = df2["X_UTME"].values
+    yv = df2["Y_UTMN"].values
+    zv = df2["Z_TVDSS"].values
+
+    iarr, jarr, karr = g1.get_ijk_from_xyz(xv, yv, zv)
+    iarr2, jarr2, karr2 = g1.get_ijk_from_xyz(xv, yv, zv, threads=0)
+
+    np.testing.assert_array_equal(iarr, iarr2)
+    np.testing.assert_array_equal(jarr, jarr2)
+    np.testing.assert_array_equal(karr, karr2)
+
+    po = xtgeo.Points()
+    po.dataframe = df2
+    ijk = g1.get_ijk_from_points(po, includepoints=False)
+    np.testing.assert_array_equal(ijk["IX"].values, iarr)
+
+    # outside
+    iarr, _, _ = g1.get_ijk_from_xyz([0.0], [0.0], [0.0], zerobased=True)
+    assert iarr[0] == -1
@@ -199,6 +199,32 @@ def test_grid_export_import_bigcase():
     print("Import bigcase using h5 with compression: ", xtg.timer(t1))
 
 
+def test_grid_import_xtgf_mmap():
+    """Import xtgf with memory mapping; views over file, but copy-on-write."""
+    grid1 = xtgeo.Grid(REEKGRID1)
+    fname = TMPD / "reek_mmap.xtgf"
+    grid1.to_xtgf(fname)
+
+    grid2 = xtgeo.Grid(fname, fformat="xtgcpgeom", mmap=True)
+    assert grid2.dimensions == grid1.dimensions
+    np.testing.assert_array_equal(grid2._zcornsv, grid1._zcornsv)
+    np.testing.assert_array_equal(grid2._coordsv, grid1._coordsv)
+    np.testing.assert_array_equal(grid2._actnumsv, grid1._actnumsv)
+
+    # the arrays are views (reshape, astype without copy) over a memmap of the file
+    base = grid2._zcornsv
+    while base is not None and not isinstance(base, np.memmap):
+        base = base.base
+    assert isinstance(base, np.memmap)
+    assert os.path.samefile(base.filename, fname)
+
+    # modifying the grid shall not change the file
+    grid2._zcornsv += 100.0
+    grid3 = xtgeo.Grid(fname, fformat="xtgf", mmap=True)
+    np.testing.assert_array_equal(grid3._zcornsv, grid1._zcornsv)
+    assert grid2._zcornsv.mean() == pytest.approx(grid1._zcornsv.mean() + 100.0)
+
+
 # ======================================================================================
 # Grid properties:
 
@@ -284,3 +310,22 @@ def test_gridprop_partial_read_bigcase():
 
     logger.info("Timing: speedratio vs gridsizeratio %s %s", readratio, gridratio)
     assert readratio < 0.5
+
+
+def test_gridprop_import_xtgcpprop_mmap():
+    """Import xtgcpprop with memory mapping."""
+    prop1 = xtgeo.GridProperty(REEKPROP1)
+    fname = TMPD / "poro_mmap.xtgcpprop"
+    prop1.to_file(fname, fformat="xtgcpprop")
+
+    prop_ref = xtgeo.GridProperty()
+    prop_ref.from_file(fname, fformat="xtgcpprop")
+
+    prop2 = xtgeo.GridProperty()
+    prop2.from_file(fname, fformat="xtgcpprop", mmap=True)
+    np.testing.assert_array_equal(prop2.values, prop_ref.values)
+
+    # modifying the property shall not change the file
+    prop2.values += 1.0
+    prop3 = xtgeo.GridProperty(fname, fformat="xtgcpprop", mmap=True)
+    np.testing.assert_array_equal(prop3.values, prop_ref.values)
@@ -13,6 +13,7 @@ import xtgeo
 from xtgeo.common import XTGeoDialog
 import tests.test_common.test_xtg as tsetup
 from xtgeo.surface.regular_surface import RegularSurface
+from xtgeo.surface import _regsurf_lowlevel
 
 if six.PY3:
     from pathlib import Path
@@ -1052,6 +1053,79 @@ def test_fence():
     tsetup.assert_almostequal(newfence[1][2], 1720.9094, 0.01)
 
 
+@pytest.mark.parametrize("sampling", ["nearest", "bilinear", "bicubic"])
+def test_fence_sampling(sampling):
+    """Test sampling methods on a rotated surface which is a plane."""
+
+    srf = xtgeo.RegularSurface(
+        xori=1000, yori=2000, ncol=50, nrow=40, xinc=25, yinc=20, rotation=30.0
+    )
+    xval, yval = srf.get_xy_values(asmasked=False)
+    srf.values = 0.2 * xval - 0.1 * yval
+
+    # points at nodes, and in between nodes in the interior
+    xnodes = xval[10:30:3, 5:25:4].ravel()
+    ynodes = yval[10:30:3, 5:25:4].ravel()
+    xmid = 0.5 * (xval[10:30, 5:25] + xval[11:31, 6:26]).ravel()
+    ymid = 0.5 * (yval[10:30, 5:25] + yval[11:31, 6:26]).ravel()
+
+    xyz = np.zeros((xnodes.size + xmid.size, 3))
+    xyz[:, 0] = np.concatenate([xnodes, xmid])
+    xyz[:, 1] = np.concatenate([ynodes, ymid])
+
+    fence = srf.get_fence(xyz, sampling=sampling)
+    expected = 0.2 * xyz[:, 0] - 0.1 * xyz[:, 1]
+
+    assert fence.mask.sum() == 0
+    if sampling == "nearest":
+        np.testing.assert_allclose(fence[: xnodes.size, 2], expected[: xnodes.size])
+    else:
+        np.testing.assert_allclose(fence[:, 2], expected)
+
+    # the same with threads
+    zval = np.zeros(xyz.shape[0])
+    _regsurf_lowlevel.sample_xyv(
+        srf, xyz[:, 0], xyz[:, 1], zval, sampling=sampling, threads=2
+    )
+    np.testing.assert_array_equal(zval, fence[:, 2])
+
+    # a masked node gives undefined, also for bicubic via the bilinear fallback
+    srf.values[20, 20] = np.ma.masked
+    xyz2 = np.array([[xval[20, 20], yval[20, 20], 0.0]])
+    fence = srf.get_fence(xyz2, sampling=sampling)
+    assert bool(fence.mask.all()) is True
+
+
+def test_fence_sampling_bicubic_quadratic():
+    """Bicubic (Catmull-Rom) sampling is exact for a quadratic surface in the
+    interior, also in between nodes, where bilinear sampling is not."""
+
+    srf = xtgeo.RegularSurface(
+        xori=1000, yori=2000, ncol=50, nrow=40, xinc=25, yinc=20, rotation=30.0
+    )
+    xval, yval = srf.get_xy_values(asmasked=False)
+
+    def quadratic(xcoord, ycoord):
+        xrel = xcoord - 1500.0
+        yrel = ycoord - 2400.0
+        return 1.0e-4 * xrel ** 2 + 2.0e-4 * yrel ** 2 + 1.0e-4 * xrel * yrel
+
+    srf.values = quadratic(xval, yval)
+
+    # cell centers in the interior
+    xyz = np.zeros((400, 3))
+    xyz[:, 0] = 0.5 * (xval[10:30, 5:25] + xval[11:31, 6:26]).ravel()
+    xyz[:, 1] = 0.5 * (yval[10:30, 5:25] + yval[11:31, 6:26]).ravel()
+    expected = quadratic(xyz[:, 0], xyz[:, 1])
+
+    bicubic = srf.get_fence(xyz.copy(), sampling="bicubic")
+    bilinear = srf.get_fence(xyz.copy(), sampling="bilinear")
+
+    np.testing.assert_allclose(bicubic[:, 2], expected, rtol=0, atol=1.0e-6)
+    # bilinear is off by the curvature times the cell size squared
+    assert np.abs(bilinear[:, 2] - expected).min() > 0.01
+
+
 def test_get_randomline_frompolygon():
 
     fence = xtgeo.Polygons(FENCE1)
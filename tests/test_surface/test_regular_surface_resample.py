@@ -158,6 +158,39 @@ def test_resample_partial_sample(reek_map):
     assert snew2.values.mean() == pytest.approx(1747.20, abs=0.2)
 
 
+@pytest.mark.parametrize("rotation2", [30.0, 40.0])
+@pytest.mark.parametrize("yflip2", [1, -1])
+def test_resample_plane(rotation2, yflip2):
+    """Resampling a plane shall give the plane, for same (separable) and other
+    rotation, and for several threads."""
+    src = RegularSurface(
+        xori=1000, yori=2000, ncol=200, nrow=150, xinc=25, yinc=20, rotation=30.0
+    )
+    xsrc, ysrc = src.get_xy_values(asmasked=False)
+    src.values = 0.02 * xsrc - 0.01 * ysrc
+
+    snew = RegularSurface(
+        xori=1500,
+        yori=2500,
+        ncol=300,
+        nrow=200,
+        xinc=7,
+        yinc=9,
+        rotation=rotation2,
+        yflip=yflip2,
+        values=0.0,
+    )
+    snew.resample(src, threads=2)
+
+    xnew, ynew = snew.get_xy_values(asmasked=False)
+    expected = 0.02 * xnew - 0.01 * ynew
+
+    assert snew.values.count() > 1000
+    np.testing.assert_allclose(
+        snew.values.compressed(), expected[~snew.values.mask], atol=0.01
+    )
+
+
 @tsetup.skipifmac  # as this often fails on travis. TODO find out why
 def test_refine(reek_map):
     """Do refining of a surface."""
@@ -226,3 +259,82 @@ def test_points_gridding(reek_map):
     tsetup.assert_almostequal(xscopy.values.mean(), xs.values.mean() + 300, 2)
 
     xscopy.to_file(os.path.join(TMPD, "reek_points_to_map.gri"), fformat="irap_binary")
+
+
+@pytest.mark.parametrize("method", ["nearest_radius", "idw", "moving_average"])
+def test_points_gridding_native(method):
+    """Grid points from a tilted plane with the C library methods."""
+    srf = RegularSurface(
+        ncol=40, nrow=30, xori=1000, yori=2000, xinc=25, yinc=25, rotation=30, values=0
+    )
+
+    # points at the nodes, where the points within the radius of an interior node
+    # (more than 2 nodes from the border) are symmetric around it, hence the
+    # plane is reproduced by all methods
+    atnodes = srf.copy()
+    xiv, yiv = atnodes.get_xy_values()
+    atnodes.values = 0.1 * xiv + 0.05 * yiv
+    res = srf.copy()
+    res.gridding(Points(atnodes), method=method, radius=60)
+    np.testing.assert_allclose(
+        res.values[3:-3, 3:-3], atnodes.values[3:-3, 3:-3], rtol=0, atol=1.0e-6
+    )
+
+    xyz = Points(srf)
+    dfr = xyz.dataframe
+    dfr[xyz.zname] = 0.1 * dfr[xyz.xname] + 0.05 * dfr[xyz.yname]
+
+    # shifted a half node, so the points are not at the nodes
+    dfr[xyz.xname] += 12.5
+    dfr[xyz.yname] += 12.5
+    dfr[xyz.zname] += 0.1 * 12.5 + 0.05 * 12.5
+
+    expected = srf.copy()
+    xiv, yiv = expected.get_xy_values()
+    expected.values = 0.1 * xiv + 0.05 * yiv
+
+    srf.gridding(xyz, method=method, radius=60, chunksize=100)
+
+    assert srf.values.count() > 0.9 * srf.ncol * srf.nrow
+    diff = np.abs(srf.values - expected.values)
+    assert diff.mean() < 2.0
+
+    # the points are ordered as the map nodes, i.e. as the search bins, so the
+    # sums per node are done in the same order for any chunk size, and each node
+    # is done by one thread; hence the results shall be identical
+    for kwargs in ({"chunksize": 10 ** 6}, {"chunksize": 100, "threads": 2}):
+        other = srf.copy()
+        other.values = 0
+        other.gridding(xyz, method=method, radius=60, **kwargs)
+        np.testing.assert_array_equal(
+            np.ma.filled(other.values, np.nan), np.ma.filled(srf.values, np.nan)
+        )
+
+
+def test_points_gridding_min_curvature_plane():
+    """Minimum curvature from sparse points on a tilted plane reproduces the plane."""
+    srf = RegularSurface(
+        ncol=40, nrow=30, xori=1000, yori=2000, xinc=25, yinc=25, rotation=30, values=0
+    )
+
+    # every 4th node of srf in both directions
+    sparse = RegularSurface(
+        ncol=10, nrow=8, xori=1000, yori=2000, xinc=100, yinc=100, rotation=30, values=0
+    )
+    xiv, yiv = sparse.get_xy_values()
+    sparse.values = 0.1 * xiv + 0.05 * yiv
+
+    srf.gridding(Points(sparse), method="min_curvature", radius=100)
+
+    assert srf.values.count() == srf.ncol * srf.nrow
+
+    xiv, yiv = srf.get_xy_values()
+    diff = np.abs(srf.values - (0.1 * xiv + 0.05 * yiv))
+
+    isdata = np.zeros(diff.shape, dtype=bool)
+    isdata[::4, ::4] = True
+    interior = np.zeros(diff.shape, dtype=bool)
+    interior[4:33, 4:25] = True
+
+    assert diff[interior & ~isdata].max() < 1.0e-4
+    assert diff.max() < 0.01
@@ -342,6 +342,35 @@ def test_slice_attr_window_max(load_cube_rsgy1):
     tsetup.assert_almostequal(ret["max"].values.mean(), 0.08619, 0.001)
 
 
+@tsetup.skipsegyio
+@pytest.mark.skipifroxar
+def test_slice_windowed_cube(load_cube_rsgy1):
+    """Slicing a windowed cube (values in file) shall equal an in-memory cube."""
+    kube = load_cube_rsgy1
+    wkube = Cube()
+    wkube.from_file(RSGY1, windowed=True, cachesize=16)
+    assert wkube.windowed
+
+    for algorithm in (1, 2):
+        xs1 = RegularSurface(RTOP1)
+        xs2 = RegularSurface(RTOP1)
+        xs1.slice_cube(kube, sampling="trilinear", algorithm=algorithm)
+        xs2.slice_cube(wkube, sampling="trilinear", algorithm=algorithm)
+        assert ma.allclose(xs1.values, xs2.values)
+
+    xs1 = RegularSurface(RTOP1)
+    xs2 = RegularSurface(RTOP1)
+    xs1.slice_cube_window(kube, attribute="max", sampling="trilinear", algorithm=2)
+    xs2.slice_cube_window(wkube, attribute="max", sampling="trilinear", algorithm=2)
+    assert ma.allclose(xs1.values, xs2.values)
+
+    info = wkube.cache_info()
+    logger.info("Brick cache: %s", info)
+    assert info["misses"] > 0
+    assert info["memory"] <= 16 * 1024 * 1024
+    assert wkube.windowed
+
+
 @tsetup.bigtest
 @tsetup.skipsegyio
 @pytest.mark.skipifroxar
@@ -307,3 +307,23 @@ def test_attrs_reek(loadsfile2):
         srf2.to_file(join(TMD, "attr2_" + att + ".gri"))
 
         assert srf1.values.mean() == pytest.approx(srf2.values.mean(), abs=0.005)
+
+
+def test_attrs_reek_threads(loadsfile2):
+    """Attributes between surfaces shall not depend on number of threads."""
+    cube2 = loadsfile2
+
+    t2a = xtgeo.RegularSurface(TOP2A)
+    t2b = xtgeo.RegularSurface(TOP2B)
+
+    attrs1 = t2a.slice_cube_window(
+        cube2, other=t2b, sampling="trilinear", attribute="all", threads=1
+    )
+    attrs2 = t2a.slice_cube_window(
+        cube2, other=t2b, sampling="trilinear", attribute="all", threads=0
+    )
+
+    for att, srf1 in attrs1.items():
+        srf2 = attrs2[att]
+        assert srf1.values.mask.sum() == srf2.values.mask.sum()
+        assert srf1.values.mean() == pytest.approx(srf2.values.mean(), rel=1e-12)
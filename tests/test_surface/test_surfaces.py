@@ -5,6 +5,7 @@ from os.path import join
 import numpy as np
 import pytest
 import xtgeo
+from xtgeo.surface import _surfs_statistics
 
 from tests.conftest import assert_almostequal
 
@@ -120,6 +121,75 @@ def test_more_statistics():
     assert res2["p10"].values.mean() == pytest.approx(16.408287142, 0.001)
 
 
+def test_statistics_streaming():
+    """Compare streaming statistics with numpy, exact and approximate."""
+    base = xtgeo.RegularSurface(TESTSET1A)
+    rng = np.random.RandomState(1234)
+
+    surfs = []
+    fnames = []
+    for inum in range(60):
+        tmp = base.copy()
+        tmp.values += rng.normal(0, 10, size=tmp.values.shape)
+        surfs.append(tmp)
+        if inum < 5:
+            fnames.append(join(TMPD, "stream_{}.gri".format(inum)))
+            tmp.to_file(fnames[-1])
+
+    xlist = np.array([np.ma.filled(srf.values, np.nan).ravel() for srf in surfs])
+
+    res = xtgeo.Surfaces(surfs).statistics(percentiles=[10, 50], threads=2)
+    np.testing.assert_allclose(
+        res["mean"].values.compressed(), np.nanmean(xlist, axis=0)[~np.isnan(xlist[0])]
+    )
+    np.testing.assert_allclose(
+        res["std"].values.compressed(),
+        np.nanstd(xlist, axis=0, ddof=1)[~np.isnan(xlist[0])],
+    )
+    p10 = np.nanpercentile(xlist, 10, axis=0)[~np.isnan(xlist[0])]
+    np.testing.assert_allclose(res["p10"].values.compressed(), p10)
+    assert res["median"] is res["p50"]
+
+    # approximate percentiles shall be within a fraction of the std
+    res2 = xtgeo.Surfaces(surfs).statistics(percentiles=[10, 50], exact=False)
+    assert np.abs(res2["p10"].values.compressed() - p10).mean() < 0.1 * 10
+    assert res2["mean"].values.mean() == pytest.approx(res["mean"].values.mean())
+
+    # streamed from files, where a sketch is exact for up to 7 surfaces
+    res3 = xtgeo.surfaces_statistics(fnames, percentiles=[10, 50], exact=False)
+    res4 = xtgeo.Surfaces(fnames).statistics(percentiles=[10, 50])
+    for key in ("mean", "std", "p10", "p50"):
+        np.testing.assert_allclose(
+            res3[key].values.compressed(), res4[key].values.compressed(), rtol=1e-5
+        )
+
+
+def test_statistics_exact_default(monkeypatch):
+    """Exact percentiles by default, but a sketch when the value stack is large."""
+    base = xtgeo.RegularSurface(TESTSET1A)
+    rng = np.random.RandomState(4321)
+    surfs = []
+    for _ in range(20):
+        tmp = base.copy()
+        tmp.values += rng.normal(0, 10, size=tmp.values.shape)
+        surfs.append(tmp)
+
+    res_exact = xtgeo.Surfaces(surfs).statistics(percentiles=[10], exact=True)
+    res_sketch = xtgeo.Surfaces(surfs).statistics(percentiles=[10], exact=False)
+
+    res = xtgeo.Surfaces(surfs).statistics(percentiles=[10])
+    np.testing.assert_array_equal(res["p10"].values, res_exact["p10"].values)
+
+    nbytes = 8 * len(surfs) * base.ncol * base.nrow
+    monkeypatch.setattr(_surfs_statistics, "EXACT_MAXBYTES", nbytes - 1)
+    res = xtgeo.Surfaces(surfs).statistics(percentiles=[10])
+    np.testing.assert_array_equal(res["p10"].values, res_sketch["p10"].values)
+
+    # an explicit exact=True is kept above the limit
+    res = xtgeo.Surfaces(surfs).statistics(percentiles=[10], exact=True)
+    np.testing.assert_array_equal(res["p10"].values, res_exact["p10"].values)
+
+
 def test_surfaces_apply():
     """Test apply function."""
     base = xtgeo.RegularSurface(TESTSET1A)
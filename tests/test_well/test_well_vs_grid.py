@@ -2,11 +2,13 @@
 
 
 from os.path import join
+import glob
 
 import pytest
+import pandas as pd
 
 
-from xtgeo.well import Well
+from xtgeo.well import Well, Wells
 from xtgeo.grid3d import Grid, GridProperty
 from xtgeo.common import XTGeoDialog
 
@@ -115,3 +117,23 @@ def test_well_get_gridprops(loadwell1, loadgrid1, loadporo1):
     tsetup.assert_almostequal(mywell.dataframe.iloc[4775]["PORO_model"], 0.2741, 0.001)
     assert mywell.dataframe.iloc[4775]["ACTNUM_model"] == 1
     assert mywell.isdiscrete("ACTNUM_model") is True
+
+
+def test_make_ijk_grid_wells_batch(loadgrid1):
+    """Make I J K logs for many wells in one batch, compare with single well"""
+
+    mygrid = loadgrid1
+
+    wlist = [Well(wfile) for wfile in glob.glob(join(TPATH, "wells/reek/1/*.w"))]
+    mywells = Wells()
+    mywells.wells = wlist
+    mywells.make_ijk_from_grid(mygrid, threads=0)
+
+    for well in mywells.wells:
+        single = Well()
+        single.dataframe = well.dataframe.loc[:, ["X_UTME", "Y_UTMN", "Z_TVDSS"]]
+        single.make_ijk_from_grid(mygrid)
+        for cname in ("ICELL", "JCELL", "KCELL"):
+            pd.testing.assert_series_equal(
+                well.dataframe[cname], single.dataframe[cname]
+            )